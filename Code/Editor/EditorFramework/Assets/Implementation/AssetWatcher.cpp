@@ -4,6 +4,7 @@
 #include <EditorFramework/Assets/AssetDocumentManager.h>
 #include <EditorFramework/Assets/AssetWatcher.h>
 #include <EditorFramework/EditorApp/EditorApp.moc.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/OSFile.h>
 
 ////////////////////////////////////////////////////////////////////////
@@ -61,6 +62,12 @@ ezAssetWatcher::ezAssetWatcher(const ezApplicationFileSystemConfig& fileSystemCo
         watcherResults.PushBack({sTemp, action});
       });
     }
+    if (!watcherResults.IsEmpty())
+    {
+      // files may have been added or removed outside of ezFileSystem
+      ezFileSystem::InvalidateFileLookupCache();
+    }
+
     for (const WatcherResult& res : watcherResults)
     {
       HandleWatcherChange(res);
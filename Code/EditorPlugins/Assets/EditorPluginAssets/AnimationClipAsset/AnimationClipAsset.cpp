@@ -18,7 +18,7 @@ EZ_BEGIN_STATIC_REFLECTED_ENUM(ezRootMotionExtractionMode, 1)
   EZ_ENUM_CONSTANTS(ezRootMotionExtractionMode::None, ezRootMotionExtractionMode::Custom, ezRootMotionExtractionMode::FromFeet, ezRootMotionExtractionMode::AvgFromFeet)
 EZ_END_STATIC_REFLECTED_ENUM;
 
-EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezAnimationClipAssetProperties, 2, ezRTTIDefaultAllocator<ezAnimationClipAssetProperties>)
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezAnimationClipAssetProperties, 3, ezRTTIDefaultAllocator<ezAnimationClipAssetProperties>)
 {
   EZ_BEGIN_PROPERTIES
   {
@@ -29,12 +29,16 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezAnimationClipAssetProperties, 2, ezRTTIDefault
     EZ_MEMBER_PROPERTY("RootMotionVelocity", m_vCustomRootMotion),
     EZ_MEMBER_PROPERTY("Joint1", m_sJoint1),
     EZ_MEMBER_PROPERTY("Joint2", m_sJoint2),
+    EZ_MEMBER_PROPERTY("CompressKeyframes", m_bCompressKeyframes),
+    EZ_MEMBER_PROPERTY("MaxTranslationError", m_fMaxTranslationError)->AddAttributes(new ezDefaultValueAttribute(0.001f), new ezClampValueAttribute(0.0f, ezVariant())),
+    EZ_MEMBER_PROPERTY("MaxRotationError", m_MaxRotationError)->AddAttributes(new ezDefaultValueAttribute(ezAngle::Degree(0.1f)), new ezClampValueAttribute(ezAngle::Degree(0.0f), ezVariant())),
+    EZ_MEMBER_PROPERTY("MaxScaleError", m_fMaxScaleError)->AddAttributes(new ezDefaultValueAttribute(0.001f), new ezClampValueAttribute(0.0f, ezVariant())),
   }
   EZ_END_PROPERTIES;
 }
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
-EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezAnimationClipAssetDocument, 2, ezRTTINoAllocator)
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezAnimationClipAssetDocument, 3, ezRTTINoAllocator)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
@@ -132,6 +136,16 @@ ezStatus ezAnimationClipAssetDocument::InternalTransformAsset(ezStreamWriter& st
     }
   }
 
+  if (pProp->m_bCompressKeyframes)
+  {
+    ezAnimationClipCompressionSettings compression;
+    compression.m_fMaxTranslationError = pProp->m_fMaxTranslationError;
+    compression.m_MaxRotationError = pProp->m_MaxRotationError;
+    compression.m_fMaxScaleError = pProp->m_fMaxScaleError;
+
+    anim.Compress(compression);
+  }
+
   anim.Save(stream);
 
   return ezStatus(EZ_SUCCESS);
@@ -37,6 +37,10 @@ public:
   ezVec3 m_vCustomRootMotion;
   ezString m_sJoint1;
   ezString m_sJoint2;
+  bool m_bCompressKeyframes = false;
+  float m_fMaxTranslationError = 0.001f;
+  ezAngle m_MaxRotationError = ezAngle::Degree(0.1f);
+  float m_fMaxScaleError = 0.001f;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -8,6 +8,15 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSpatialSystem, 1, ezRTTINoAllocator)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
+namespace
+{
+  // Number of frames for which changes are remembered. Queries for older frames conservatively report a change.
+  static constexpr ezUInt64 s_uiChangeHistoryFrames = 4;
+
+  // Upper bound for the recorded changes. If more changes happen, e.g. because a whole level is streamed in, the history is dropped.
+  static constexpr ezUInt32 s_uiMaxChangedBounds = 4096;
+} // namespace
+
 ezSpatialSystem::ezSpatialSystem()
   : m_Allocator("Spatial System", ezFoundation::GetDefaultAllocator())
   , m_AllocatorWrapper(&m_Allocator)
@@ -15,7 +24,9 @@ ezSpatialSystem::ezSpatialSystem()
   , m_DataTable(&m_Allocator)
   , m_DataStorage(&m_BlockAllocator, &m_Allocator)
   , m_DataAlwaysVisible(&m_Allocator)
+  , m_ChangedBounds(&m_Allocator)
 {
+  m_uiChangeTrackingCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
 }
 
 ezSpatialSystem::~ezSpatialSystem() = default;
@@ -32,6 +43,7 @@ ezSpatialDataHandle ezSpatialSystem::CreateSpatialData(const ezSimdBBoxSphere& b
   pData->m_Bounds = bounds;
 
   SpatialDataAdded(pData);
+  RecordChange(bounds, uiCategoryBitmask);
 
   return ezSpatialDataHandle(m_DataTable.Insert(pData));
 }
@@ -66,6 +78,7 @@ void ezSpatialSystem::DeleteSpatialData(const ezSpatialDataHandle& hData)
   else
   {
     SpatialDataRemoved(pData);
+    RecordChange(pData->m_Bounds, pData->m_uiCategoryBitmask);
   }
 
   ezSpatialData* pMovedData = nullptr;
@@ -105,7 +118,13 @@ void ezSpatialSystem::UpdateSpatialData(
     if (uiCategoryBitmask != uiOldCategoryBitmask || bounds != oldBounds)
     {
       SpatialDataChanged(pData, oldBounds, uiOldCategoryBitmask);
+
+      RecordChange(oldBounds, uiOldCategoryBitmask);
     }
+
+    // Always record the new bounds, even if they did not change, since an update usually means that the object's appearance changed,
+    // e.g. a different mesh with the same bounds.
+    RecordChange(bounds, uiCategoryBitmask);
   }
   else
   {
@@ -217,6 +236,64 @@ void ezSpatialSystem::FindVisibleObjects(
 #endif
 }
 
+void ezSpatialSystem::StartNewFrame()
+{
+  ++m_uiFrameCounter;
+
+  if (m_uiFrameCounter > s_uiChangeHistoryFrames)
+  {
+    m_uiOldestTrackedFrame = ezMath::Max(m_uiOldestTrackedFrame, m_uiFrameCounter - s_uiChangeHistoryFrames);
+  }
+
+  // changes are recorded in frame order, so all outdated entries are at the front
+  ezUInt32 uiNumOutdated = 0;
+  while (uiNumOutdated < m_ChangedBounds.GetCount() && m_ChangedBounds[uiNumOutdated].m_uiFrame < m_uiOldestTrackedFrame)
+  {
+    ++uiNumOutdated;
+  }
+
+  if (uiNumOutdated > 0)
+  {
+    m_ChangedBounds.RemoveAtAndCopy(0, uiNumOutdated);
+  }
+}
+
+bool ezSpatialSystem::HasChangedDataInFrustum(const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezUInt64 uiSinceFrame) const
+{
+  if (uiSinceFrame < m_uiOldestTrackedFrame || (uiCategoryBitmask & ~m_uiChangeTrackingCategoryBitmask) != 0)
+    return true;
+
+  for (ezUInt32 i = m_ChangedBounds.GetCount(); i-- > 0;)
+  {
+    const ChangedBounds& changedBounds = m_ChangedBounds[i];
+    if (changedBounds.m_uiFrame < uiSinceFrame)
+      break;
+
+    if ((changedBounds.m_uiCategoryBitmask & uiCategoryBitmask) != 0 && frustum.Overlaps(changedBounds.m_Bounds))
+      return true;
+  }
+
+  return false;
+}
+
+void ezSpatialSystem::RecordChange(const ezSimdBBoxSphere& bounds, ezUInt32 uiCategoryBitmask)
+{
+  uiCategoryBitmask &= m_uiChangeTrackingCategoryBitmask;
+  if (uiCategoryBitmask == 0 || m_uiOldestTrackedFrame > m_uiFrameCounter)
+    return;
+
+  if (m_ChangedBounds.GetCount() >= s_uiMaxChangedBounds)
+  {
+    // forget everything up to and including this frame, queries for these frames will report a change
+    m_ChangedBounds.Clear();
+    m_uiOldestTrackedFrame = m_uiFrameCounter + 1;
+    return;
+  }
 
+  auto& changedBounds = m_ChangedBounds.ExpandAndGetRef();
+  changedBounds.m_Bounds = bounds.GetBox();
+  changedBounds.m_uiFrame = m_uiFrameCounter;
+  changedBounds.m_uiCategoryBitmask = uiCategoryBitmask;
+}
 
 EZ_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem);
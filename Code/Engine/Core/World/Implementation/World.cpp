@@ -467,6 +467,11 @@ void ezWorld::Update()
   m_Data.m_Clock.SetPaused(!m_Data.m_bSimulateWorld);
   m_Data.m_Clock.Update();
 
+  if (ezSpatialSystem* pSpatialSystem = GetSpatialSystem())
+  {
+    pSpatialSystem->StartNewFrame();
+  }
+
   // initialize phase
   {
     EZ_PROFILE_SCOPE("Initialize Phase");
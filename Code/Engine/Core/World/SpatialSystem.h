@@ -62,8 +62,34 @@ public:
     const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects, QueryStats* pStats = nullptr) const;
 
   ///@}
+  /// \name Change Tracking
+  ///@{
+
+  /// \brief Advances the change tracking frame and discards changes that are older than the tracked history.
+  ///
+  /// Called by the world at the beginning of every update.
+  void StartNewFrame();
+
+  /// \brief Returns the current change tracking frame.
+  ezUInt64 GetFrameCounter() const { return m_uiFrameCounter; }
+
+  /// \brief Sets which categories record the bounds of added, removed and changed spatial data. Defaults to RenderStatic.
+  ///
+  /// Categories that change every frame, like RenderDynamic, should not be tracked since that would only fill up the history.
+  void SetChangeTrackingCategories(ezUInt32 uiCategoryBitmask) { m_uiChangeTrackingCategoryBitmask = uiCategoryBitmask; }
+  ezUInt32 GetChangeTrackingCategories() const { return m_uiChangeTrackingCategoryBitmask; }
+
+  /// \brief Returns whether any spatial data of the given tracked categories was added, removed or changed inside the frustum
+  /// since the given frame (inclusive).
+  ///
+  /// Conservatively returns true if the given frame is older than the tracked history or if one of the given categories is not tracked.
+  bool HasChangedDataInFrustum(const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezUInt64 uiSinceFrame) const;
+
+  ///@}
 
 protected:
+  void RecordChange(const ezSimdBBoxSphere& bounds, ezUInt32 uiCategoryBitmask);
+
   virtual void FindObjectsInSphereInternal(
     const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats) const = 0;
   virtual void FindObjectsInBoxInternal(const ezBoundingBox& box, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats) const = 0;
@@ -84,4 +110,16 @@ protected:
   DataStorage m_DataStorage;
 
   ezDynamicArray<ezSpatialData*> m_DataAlwaysVisible;
+
+  struct ChangedBounds
+  {
+    ezSimdBBox m_Bounds;
+    ezUInt64 m_uiFrame;
+    ezUInt32 m_uiCategoryBitmask;
+  };
+
+  ezUInt64 m_uiFrameCounter = 0;
+  ezUInt32 m_uiChangeTrackingCategoryBitmask = 0;
+  ezUInt64 m_uiOldestTrackedFrame = 0;
+  ezDynamicArray<ChangedBounds> m_ChangedBounds;
 };
@@ -6,6 +6,7 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Memory/MemoryUtils.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 ezProcessingStreamGroup::ezProcessingStreamGroup()
 {
@@ -22,6 +23,7 @@ void ezProcessingStreamGroup::Clear()
   ClearProcessors();
 
   m_uiPendingNumberOfElementsToSpawn = 0;
+  m_PendingRemoveMask.Clear();
   m_uiNumElements = 0;
   m_uiNumActiveElements = 0;
   m_uiHighestNumActiveElements = 0;
@@ -127,7 +129,8 @@ void ezProcessingStreamGroup::SetSize(ezUInt64 uiNumElements)
   m_uiNumElements = uiNumElements;
 
   // Also reset any pending remove and spawn operations since they refer to the old size and content
-  m_PendingRemoveIndices.Clear();
+  m_PendingRemoveMask.SetCount(static_cast<ezUInt32>((uiNumElements + 31) / 32));
+  ezMemoryUtils::ZeroFill(m_PendingRemoveMask.GetData(), m_PendingRemoveMask.GetCount());
   m_uiPendingNumberOfElementsToSpawn = 0;
 
   m_uiHighestNumActiveElements = 0;
@@ -140,12 +143,22 @@ void ezProcessingStreamGroup::SetSize(ezUInt64 uiNumElements)
 /// processors).
 void ezProcessingStreamGroup::RemoveElement(ezUInt64 uiElementIndex)
 {
-  if (m_PendingRemoveIndices.Contains(uiElementIndex))
-    return;
-
   EZ_ASSERT_DEBUG(uiElementIndex < m_uiNumActiveElements, "Element which should be removed is outside of active element range!");
 
-  m_PendingRemoveIndices.PushBack(uiElementIndex);
+  m_PendingRemoveMask[static_cast<ezUInt32>(uiElementIndex / 32)] |= static_cast<ezUInt32>(EZ_BIT(uiElementIndex % 32));
+}
+
+void ezProcessingStreamGroup::RemoveElements(ezArrayPtr<const ezUInt32> elementMask, ezUInt64 uiFirstElement)
+{
+  EZ_ASSERT_DEV(uiFirstElement % 32 == 0, "The first element index has to be a multiple of 32");
+  EZ_ASSERT_DEBUG(uiFirstElement + elementMask.GetCount() * 32 <= m_PendingRemoveMask.GetCount() * 32, "Element mask is outside of the element range!");
+
+  const ezUInt32 uiFirstWord = static_cast<ezUInt32>(uiFirstElement / 32);
+
+  for (ezUInt32 i = 0; i < elementMask.GetCount(); ++i)
+  {
+    m_PendingRemoveMask[uiFirstWord + i] |= elementMask[i];
+  }
 }
 
 /// \brief Spawns a number of new elements, they will be added as newly initialized stream elements. Safe to call from data processors since the
@@ -160,9 +173,26 @@ void ezProcessingStreamGroup::Process()
   EnsureStreamAssignmentValid();
 
   // TODO: Identify which processors work on which streams and find independent groups and use separate tasks for them?
-  for (ezProcessingStreamProcessor* pStreamProcessor : m_Processors)
+  const bool bParallel = m_uiParallelProcessingThreshold > 0 && m_uiNumActiveElements >= m_uiParallelProcessingThreshold;
+
+  for (ezUInt32 i = 0; i < m_Processors.GetCount();)
   {
-    pStreamProcessor->Process(m_uiNumActiveElements);
+    if (bParallel && m_Processors[i]->SupportsParallelProcessing())
+    {
+      ezUInt32 uiEnd = i + 1;
+      while (uiEnd < m_Processors.GetCount() && m_Processors[uiEnd]->SupportsParallelProcessing())
+      {
+        ++uiEnd;
+      }
+
+      RunProcessorsInParallel(m_Processors.GetArrayPtr().GetSubArray(i, uiEnd - i), 0, m_uiNumActiveElements, false);
+      i = uiEnd;
+    }
+    else
+    {
+      m_Processors[i]->Process(m_uiNumActiveElements);
+      ++i;
+    }
   }
 
   // Run any pending deletions which happened due to stream processor execution
@@ -176,67 +206,95 @@ void ezProcessingStreamGroup::Process()
 
 void ezProcessingStreamGroup::RunPendingDeletions()
 {
-  ezStreamGroupElementRemovedEvent e;
-  e.m_pStreamGroup = this;
+  const ezUInt32* pMask = m_PendingRemoveMask.GetData();
+  const ezUInt32 uiNumActiveWords = static_cast<ezUInt32>((m_uiNumActiveElements + 31) / 32);
+
+  bool bAnyRemoved = false;
 
-  // Remove elements
-  while (!m_PendingRemoveIndices.IsEmpty())
+  // inform any interested party about the tragic death, all data is still at its original location at this point
   {
-    if (m_uiNumActiveElements == 0)
-      break;
+    ezStreamGroupElementRemovedEvent e;
+    e.m_pStreamGroup = this;
 
-    const ezUInt64 uiLastActiveElementIndex = m_uiNumActiveElements - 1;
+    for (ezUInt32 uiWord = 0; uiWord < uiNumActiveWords; ++uiWord)
+    {
+      ezUInt32 uiBits = pMask[uiWord];
 
-    const ezUInt64 uiElementToRemove = m_PendingRemoveIndices.PeekBack();
-    m_PendingRemoveIndices.PopBack();
+      while (uiBits != 0)
+      {
+        const ezUInt32 uiBit = ezMath::FirstBitLow(uiBits);
+        uiBits &= uiBits - 1;
 
-    EZ_ASSERT_DEBUG(uiElementToRemove < m_uiNumActiveElements, "Invalid index to remove");
+        e.m_uiElementIndex = uiWord * 32ull + uiBit;
 
-    // inform any interested party about the tragic death
-    e.m_uiElementIndex = uiElementToRemove;
-    m_ElementRemovedEvent.Broadcast(e);
+        if (e.m_uiElementIndex >= m_uiNumActiveElements)
+          break;
 
-    // If the element which should be removed is the last element we can just decrement the number of active elements
-    // and no further work needs to be done
-    if (uiElementToRemove == uiLastActiveElementIndex)
-    {
-      m_uiNumActiveElements--;
-      continue;
+        bAnyRemoved = true;
+        m_ElementRemovedEvent.Broadcast(e);
+      }
     }
+  }
+
+  if (!bAnyRemoved)
+    return;
+
+  auto IsRemoved = [pMask](ezUInt64 uiElementIndex) { return (pMask[uiElementIndex / 32] & EZ_BIT(uiElementIndex % 32)) != 0; };
 
-    // Since we swap with the last element we need to make sure that any pending removals of the (current) last element are updated
-    // and point to the place where we moved the data to.
-    for (ezUInt32 i = 0; i < m_PendingRemoveIndices.GetCount(); ++i)
+  // Fill the holes from the front with the surviving elements from the back. This moves every element at most once,
+  // so all streams can be compacted afterwards with a single pass over the same list of moves.
+  m_ElementMoves.Clear();
+
+  ezUInt64 uiEnd = m_uiNumActiveElements;
+  ezUInt64 uiHole = 0;
+
+  while (true)
+  {
+    while (uiEnd > 0 && IsRemoved(uiEnd - 1))
     {
-      // Is the pending remove in the array actually the last element we use to swap with? It's simply a matter of updating it to point to the new
-      // index.
-      if (m_PendingRemoveIndices[i] == uiLastActiveElementIndex)
-      {
-        m_PendingRemoveIndices[i] = uiElementToRemove;
+      --uiEnd;
+    }
 
-        // We can break since the RemoveElement() operation takes care that each index can be in the array only once
-        break;
-      }
+    while (uiHole < uiEnd && !IsRemoved(uiHole))
+    {
+      // skip 32 elements at once, if none of them is removed
+      if (uiHole % 32 == 0 && pMask[uiHole / 32] == 0)
+        uiHole += 32;
+      else
+        ++uiHole;
     }
 
-    // Move the data
+    if (uiHole >= uiEnd)
+      break;
+
+    --uiEnd;
+
+    auto& move = m_ElementMoves.ExpandAndGetRef();
+    move.m_uiSourceIndex = uiEnd;
+    move.m_uiTargetIndex = uiHole;
+
+    ++uiHole;
+  }
+
+  m_uiNumActiveElements = uiEnd;
+
+  // Move the data
+  if (!m_ElementMoves.IsEmpty())
+  {
     for (ezProcessingStream* pStream : m_DataStreams)
     {
       const ezUInt64 uiStreamElementStride = pStream->GetElementStride();
-      const ezUInt64 uiStreamElementSize = pStream->GetElementSize();
-      const void* pSourceData =
-        ezMemoryUtils::AddByteOffset(pStream->GetData(), static_cast<ptrdiff_t>(uiLastActiveElementIndex * uiStreamElementStride));
-      void* pTargetData = ezMemoryUtils::AddByteOffset(pStream->GetWritableData(), static_cast<ptrdiff_t>(uiElementToRemove * uiStreamElementStride));
+      const size_t uiStreamElementSize = static_cast<size_t>(pStream->GetElementSize());
+      ezUInt8* pData = static_cast<ezUInt8*>(pStream->GetWritableData());
 
-      ezMemoryUtils::Copy<ezUInt8>(
-        static_cast<ezUInt8*>(pTargetData), static_cast<const ezUInt8*>(pSourceData), static_cast<size_t>(uiStreamElementSize));
+      for (const ElementMove& move : m_ElementMoves)
+      {
+        ezMemoryUtils::Copy<ezUInt8>(pData + move.m_uiTargetIndex * uiStreamElementStride, pData + move.m_uiSourceIndex * uiStreamElementStride, uiStreamElementSize);
+      }
     }
-
-    // And decrease the size since we swapped the last element to the location of the element we just removed
-    m_uiNumActiveElements--;
   }
 
-  m_PendingRemoveIndices.Clear();
+  ezMemoryUtils::ZeroFill(m_PendingRemoveMask.GetData(), m_PendingRemoveMask.GetCount());
 }
 
 void ezProcessingStreamGroup::EnsureStreamAssignmentValid()
@@ -270,9 +328,26 @@ void ezProcessingStreamGroup::RunPendingSpawns()
 
     if (m_uiPendingNumberOfElementsToSpawn)
     {
-      for (ezProcessingStreamProcessor* pSpawner : m_Processors)
+      const bool bParallel = m_uiParallelProcessingThreshold > 0 && m_uiPendingNumberOfElementsToSpawn >= m_uiParallelProcessingThreshold;
+
+      for (ezUInt32 i = 0; i < m_Processors.GetCount();)
       {
-        pSpawner->InitializeElements(m_uiNumActiveElements, m_uiPendingNumberOfElementsToSpawn);
+        if (bParallel && m_Processors[i]->SupportsParallelProcessing())
+        {
+          ezUInt32 uiEnd = i + 1;
+          while (uiEnd < m_Processors.GetCount() && m_Processors[uiEnd]->SupportsParallelProcessing())
+          {
+            ++uiEnd;
+          }
+
+          RunProcessorsInParallel(m_Processors.GetArrayPtr().GetSubArray(i, uiEnd - i), m_uiNumActiveElements, m_uiPendingNumberOfElementsToSpawn, true);
+          i = uiEnd;
+        }
+        else
+        {
+          m_Processors[i]->InitializeElements(m_uiNumActiveElements, m_uiPendingNumberOfElementsToSpawn);
+          ++i;
+        }
       }
     }
 
@@ -298,4 +373,31 @@ void ezProcessingStreamGroup::SortProcessorsByPriority()
   m_Processors.Sort(cmp);
 }
 
+void ezProcessingStreamGroup::RunProcessorsInParallel(ezArrayPtr<ezProcessingStreamProcessor*> processors, ezUInt64 uiStartIndex, ezUInt64 uiNumElements, bool bInitialize)
+{
+  const ezUInt64 uiEndIndex = uiStartIndex + uiNumElements;
+  const ezUInt32 uiNumChunks = static_cast<ezUInt32>((uiNumElements + ParallelChunkSize - 1) / ParallelChunkSize);
+
+  ezParallelForParams params;
+  params.uiBinSize = 1;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumChunks, [&](ezUInt32 uiFirstChunk, ezUInt32 uiEndChunk) {
+      for (ezUInt32 uiChunk = uiFirstChunk; uiChunk < uiEndChunk; ++uiChunk)
+      {
+        const ezUInt64 uiChunkStart = uiStartIndex + uiChunk * ParallelChunkSize;
+        const ezUInt64 uiChunkSize = ezMath::Min(ParallelChunkSize, uiEndIndex - uiChunkStart);
+
+        for (ezProcessingStreamProcessor* pProcessor : processors)
+        {
+          if (bInitialize)
+            pProcessor->InitializeElements(uiChunkStart, uiChunkSize);
+          else
+            pProcessor->ProcessRange(uiChunkStart, uiChunkSize);
+        }
+      }
+    },
+    "Process Stream Group Chunks", params);
+}
+
 EZ_STATICLINK_FILE(Foundation, Foundation_DataProcessing_Stream_Implementation_ProcessingStreamGroup);
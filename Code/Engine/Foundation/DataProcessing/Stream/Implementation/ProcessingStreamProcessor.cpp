@@ -19,6 +19,13 @@ ezProcessingStreamProcessor::~ezProcessingStreamProcessor()
   m_pStreamGroup = nullptr;
 }
 
+void ezProcessingStreamProcessor::ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
+  EZ_ASSERT_DEV(uiStartIndex == 0, "Stream processor '{0}' does not implement ProcessRange()", GetDynamicRTTI()->GetTypeName());
+
+  Process(uiNumElements);
+}
+
 
 
 EZ_STATICLINK_FILE(Foundation, Foundation_DataProcessing_Stream_Implementation_ProcessingStreamProcessor);
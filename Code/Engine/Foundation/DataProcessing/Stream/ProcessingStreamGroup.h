@@ -3,6 +3,7 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/Communication/Event.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStream.h>
 
@@ -58,8 +59,16 @@ public:
 
   /// \brief Removes an element (e.g. due to the death of a particle etc.), this will be enqueued (and thus is safe to be called from within data
   /// processors).
+  ///
+  /// Elements are marked in blocks of 32. During parallel processing every chunk starts at a multiple of 32, so processors may remove the
+  /// elements of their own range concurrently.
   void RemoveElement(ezUInt64 uiElementIndex);
 
+  /// \brief Removes many elements at once, e.g. all particles that a behavior found to be dead. Like RemoveElement() this is enqueued.
+  ///
+  /// Bit N of elementMask[i] marks the element uiFirstElement + i * 32 + N for removal. uiFirstElement has to be a multiple of 32.
+  void RemoveElements(ezArrayPtr<const ezUInt32> elementMask, ezUInt64 uiFirstElement = 0);
+
   /// \brief Spawns a number of new elements, they will be added as newly initialized stream elements. Safe to call from data processors since the
   /// spawning will be queued.
   void InitializeElements(ezUInt64 uiNumElements);
@@ -67,6 +76,20 @@ public:
   /// \brief Runs the stream processors which have been added to the stream group.
   void Process();
 
+  /// \brief Processors that support it (see ezProcessingStreamProcessor::SupportsParallelProcessing()) are run on multiple threads, once at
+  /// least this many elements are processed or spawned at once. Zero disables parallel processing, which is the default.
+  ///
+  /// The elements are split into chunks of ParallelChunkSize elements, so the ranges that each processor sees only depend on the number
+  /// of elements, not on the number of threads. Consecutive processors that support parallel processing are run on the same chunk one after
+  /// another, all other processors still see all elements at once.
+  void SetParallelProcessingThreshold(ezUInt64 uiNumElements) { m_uiParallelProcessingThreshold = uiNumElements; }
+
+  /// \brief Returns the value set with SetParallelProcessingThreshold().
+  ezUInt64 GetParallelProcessingThreshold() const { return m_uiParallelProcessingThreshold; }
+
+  /// \brief The number of elements that are processed by one task during parallel processing. A multiple of 32, see RemoveElement().
+  static constexpr ezUInt64 ParallelChunkSize = 2048;
+
   /// \brief Returns the number of elements the streams store.
   inline ezUInt64 GetNumElements() const { return m_uiNumElements; }
 
@@ -89,11 +112,25 @@ private:
 
   void SortProcessorsByPriority();
 
+  /// \brief Runs InitializeElements() or ProcessRange() of all given processors on chunks of the range, using multiple threads.
+  void RunProcessorsInParallel(ezArrayPtr<ezProcessingStreamProcessor*> processors, ezUInt64 uiStartIndex, ezUInt64 uiNumElements, bool bInitialize);
+
   ezHybridArray<ezProcessingStreamProcessor*, 8> m_Processors;
 
   ezHybridArray<ezProcessingStream*, 8> m_DataStreams;
 
-  ezHybridArray<ezUInt64, 64> m_PendingRemoveIndices;
+  struct ElementMove
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiSourceIndex;
+    ezUInt64 m_uiTargetIndex;
+  };
+
+  /// One bit per element, set for all elements that are removed in the next RunPendingDeletions()
+  ezDynamicArray<ezUInt32> m_PendingRemoveMask;
+
+  ezDynamicArray<ElementMove> m_ElementMoves;
 
   ezUInt64 m_uiPendingNumberOfElementsToSpawn;
 
@@ -103,5 +140,7 @@ private:
 
   ezUInt64 m_uiHighestNumActiveElements;
 
+  ezUInt64 m_uiParallelProcessingThreshold = 0;
+
   bool m_bStreamAssignmentDirty;
 };
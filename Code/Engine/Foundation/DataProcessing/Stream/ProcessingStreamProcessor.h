@@ -21,6 +21,10 @@ public:
   /// Used for sorting processors, to ensure a certain order. Lower priority == executed first.
   float m_fPriority = 0.0f;
 
+  /// \brief Returns true, if InitializeElements() and ProcessRange() only access the elements in the given range and may therefore run
+  /// for different ranges on multiple threads at the same time. See ezProcessingStreamGroup::SetParallelProcessingThreshold().
+  virtual bool SupportsParallelProcessing() const { return false; }
+
 protected:
   friend class ezProcessingStreamGroup;
 
@@ -35,6 +39,10 @@ protected:
   /// \brief The actual method which processes the data, will be called with the number of elements to process.
   virtual void Process(ezUInt64 uiNumElements) = 0;
 
+  /// \brief Processes the elements [uiStartIndex; uiStartIndex + uiNumElements). Only called instead of Process(), if SupportsParallelProcessing()
+  /// returns true. The default implementation only supports processing all elements at once.
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements);
+
   /// \brief Back pointer to the stream group - will be set to the owner stream group when adding the stream processor to the group.
   /// Can be used to get stream pointers in UpdateStreamBindings();
   ezProcessingStreamGroup* m_pStreamGroup;
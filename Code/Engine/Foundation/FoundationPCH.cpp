@@ -61,6 +61,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_DataProcessing_Stream_Implementation_ProcessingStreamProcessor);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_Archive);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_ArchiveBuilder);
+  EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_ArchiveChunkedEntryReader);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_ArchiveReader);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_ArchiveUtils);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_DataDirTypeArchive);
@@ -12,6 +12,7 @@ enum class ezArchiveCompressionMode : ezUInt8
   Uncompressed,
   Compressed_zstd,
   Compressed_zip,
+  Compressed_zstd_chunked, ///< zstd compressed in independent frames of ezArchiveTOC::m_uiFrameSize bytes, allows seeking and parallel decompression
 };
 
 /// \brief Data for a single file entry in an ezArchive file
@@ -23,6 +24,10 @@ public:
   ezUInt64 m_uiStoredDataSize = 0;       ///< The amount of (compressed) bytes actually stored in the ezArchive.
   ezUInt32 m_uiPathStringOffset = 0;     ///< Byte offset into ezArchiveTOC::m_AllPathStrings where the path string for this entry resides.
   ezArchiveCompressionMode m_CompressionMode = ezArchiveCompressionMode::Uncompressed;
+  ezUInt32 m_uiFirstFrame = 0; ///< For chunked entries the index of the first frame in ezArchiveTOC::m_FrameEndOffsets. Not serialized, restored by ezArchiveTOC.
+
+  /// \brief Returns the number of frames that a chunked entry is split into.
+  ezUInt32 GetNumFrames(ezUInt32 uiFrameSize) const;
 
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
@@ -100,18 +105,28 @@ struct ezHashHelper<ezArchiveStoredString>
 class EZ_FOUNDATION_DLL ezArchiveTOC
 {
 public:
+  /// the frame size that is used for writing new chunked entries
+  static constexpr ezUInt32 DefaultFrameSize = 256 * 1024;
+
   /// all files stored in the ezArchive
   ezDynamicArray<ezArchiveEntry> m_Entries;
   /// allows to map a hashed string to the index of the file entry for the file path
   ezHashTable<ezArchiveStoredString, ezUInt32> m_PathToEntryIndex;
   /// one large array holding all path strings for the file entries, to reduce allocations
   ezDynamicArray<ezUInt8> m_AllPathStrings;
+  /// the uncompressed size of all frames of ezArchiveCompressionMode::Compressed_zstd_chunked entries (except for the last frame of each entry)
+  ezUInt32 m_uiFrameSize = DefaultFrameSize;
+  /// for all chunked entries (in entry order): the byte offset where each compressed frame ends, relative to the entry's data start
+  ezDynamicArray<ezUInt64> m_FrameEndOffsets;
 
   /// \brief Returns the entry index for the given file or ezInvalidIndex, if not found.
   ezUInt32 FindEntry(const char* szFile) const;
 
   const char* GetEntryPathString(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Returns the compressed frame end offsets of the given chunked entry.
+  ezArrayPtr<const ezUInt64> GetEntryFrameEndOffsets(ezUInt32 uiEntryIdx) const;
+
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
 };
@@ -16,17 +16,26 @@ public:
     ezString m_sAbsSourcePath; ///< The source file to read
     ezString m_sRelTargetPath; ///< Under which relative path to store it in the ezArchive
     ezArchiveCompressionMode m_CompressionMode = ezArchiveCompressionMode::Uncompressed;
+    ezUInt64 m_uiFileSize = 0; ///< The size of the source file, if known. Set by AddFolder(), otherwise queried by WriteArchive() when needed.
   };
 
   // all the source files from disk that should be put into the ezArchive
   ezDeque<SourceEntry> m_Entries;
 
+  /// \brief Upper limit for the amount of source data that is being compressed, but not yet written to the archive.
+  ///
+  /// WriteArchive() compresses entries in parallel on the ezTaskSystem and appends them in order. The temporary buffers of the compressed
+  /// entries are bounded by this value. Files that are larger than this are compressed by the writing thread itself.
+  ezUInt64 m_uiMaxBytesInFlight = 512ull * 1024 * 1024;
+
   enum class InclusionMode
   {
     Exclude,       ///< Do not add this file to the archive
     Uncompressed,  ///< Add the file to the archive, but do not even try to compress it
     Compress_zstd, ///< Add the file and try out compression. If compression does not help, the file will end up uncompressed in the
                    ///< archive.
+    Compress_zstd_chunked, ///< Same as Compress_zstd, but compresses the file in independent frames. Preferable for large files, since
+                           ///< they can be read with random access and decompressed in parallel.
   };
 
   /// \brief Custom decider whether to include a file into the archive
@@ -43,6 +52,10 @@ public:
   ezResult WriteArchive(const char* szFile) const;
 
   /// \brief Writes the previously gathered files to the file stream
+  ///
+  /// Compressed entries are prepared on worker threads, see m_uiMaxBytesInFlight. WriteNextFileCallback() is still called in order
+  /// and from the calling thread, but WriteFileProgressCallback() is only called for entries that are written by the calling thread.
+  /// Uncompressed entries are aligned to ezArchiveUtils::UncompressedEntryAlignment, such that they can be accessed in-place later.
   ezResult WriteArchive(ezStreamWriter& stream) const;
 
 protected:
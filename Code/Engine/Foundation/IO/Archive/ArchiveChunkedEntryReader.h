@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Stream.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+/// \brief A stream reader that decompresses ezArchiveCompressionMode::Compressed_zstd_chunked entries directly from the archive memory.
+///
+/// Since every frame of a chunked entry is compressed independently, the reader can jump to any position by only decompressing
+/// the frame that contains it. Use DecompressEntry() to decompress all frames of an entry in parallel.
+class EZ_FOUNDATION_DLL ezArchiveChunkedEntryReader : public ezStreamReader
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezArchiveChunkedEntryReader);
+
+public:
+  ezArchiveChunkedEntryReader();
+  ~ezArchiveChunkedEntryReader();
+
+  /// \brief Configures the reader to decompress the given chunked entry and resets the read position.
+  ///
+  /// Calling this a second time on the same instance is valid and allows to reuse the decoder, which is more efficient than creating a new
+  /// one.
+  void SetEntry(const ezArchiveTOC& toc, ezUInt32 uiEntryIdx, const void* pStartOfArchiveData);
+
+  /// \brief Reads either uiBytesToRead or the amount of remaining bytes in the stream into pReadBuffer.
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override;
+
+  /// \brief Advances the read position without decompressing any of the skipped frames.
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override;
+
+  /// \brief Moves the read position to the given byte offset within the uncompressed data.
+  void SetReadPosition(ezUInt64 uiPosition);
+
+  /// \brief Returns the current read position within the uncompressed data.
+  ezUInt64 GetReadPosition() const { return m_uiReadPosition; }
+
+  /// \brief Returns the size of the uncompressed data.
+  ezUInt64 GetUncompressedSize() const { return m_uiUncompressedSize; }
+
+  /// \brief Decompresses the entire entry into \a out_Target, which must be exactly as large as the uncompressed data.
+  ///
+  /// The frames are decompressed in parallel on the ezTaskSystem worker threads.
+  static ezResult DecompressEntry(
+    const ezArchiveTOC& toc, ezUInt32 uiEntryIdx, const void* pStartOfArchiveData, ezArrayPtr<ezUInt8> out_Target);
+
+private:
+  ezResult DecompressFrame(ezUInt32 uiFrame);
+
+  const ezUInt8* m_pEntryData = nullptr;
+  ezArrayPtr<const ezUInt64> m_FrameEndOffsets;
+  ezUInt32 m_uiFrameSize = 0;
+  ezUInt64 m_uiUncompressedSize = 0;
+  ezUInt64 m_uiReadPosition = 0;
+  ezUInt32 m_uiDecompressedFrame = ezInvalidIndex;
+  ezDynamicArray<ezUInt8> m_FrameData;
+  /*ZSTD_DCtx*/ void* m_pZstdDCtx = nullptr;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/Types/UniquePtr.h>
 
+class ezArchiveChunkedEntryReader;
 class ezRawMemoryStreamReader;
 class ezStreamReader;
 
@@ -33,6 +34,23 @@ public:
   /// \brief Creates a reader that will decompress the given file entry.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Returns a view directly into the memory mapped archive for the data of the given entry.
+  ///
+  /// This only works for uncompressed entries, for compressed entries an empty array is returned and CreateEntryReader() has to be used
+  /// instead. The memory stays valid for as long as the archive is open. For archives written by ezArchiveUtils the data is aligned to
+  /// ezArchiveUtils::UncompressedEntryAlignment bytes.
+  ezArrayPtr<const ezUInt8> GetEntryDataView(ezUInt32 uiEntryIdx) const;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  /// \brief Sets up \a reader for random access into the given ezArchiveCompressionMode::Compressed_zstd_chunked entry.
+  void ConfigureChunkedEntryReader(ezUInt32 uiEntryIdx, ezArchiveChunkedEntryReader& reader) const;
+#endif
+
+  /// \brief Decompresses the entire entry into \a out_Target, which must be exactly as large as the uncompressed data.
+  ///
+  /// Chunked entries are decompressed in parallel, all other entries are decompressed on the calling thread.
+  ezResult DecompressEntry(ezUInt32 uiEntryIdx, ezArrayPtr<ezUInt8> out_Target) const;
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, const char* szSourceFile) const;
@@ -16,6 +16,15 @@ namespace ezArchiveUtils
 {
   typedef ezDelegate<bool(ezUInt64, ezUInt64)> FileWriteProgressCallback;
 
+  /// \brief The number of bytes written by WriteHeader(). All entry data offsets are relative to the end of the header.
+  constexpr ezUInt32 ArchiveHeaderSize = 16;
+
+  /// \brief Uncompressed entries are stored at file offsets that are a multiple of this value.
+  ///
+  /// Since memory mapped files always start at a page boundary, this guarantees that the data of uncompressed entries
+  /// can be accessed in-place (see ezArchiveReader::GetEntryDataView()) with cache line (and SIMD) alignment.
+  constexpr ezUInt32 UncompressedEntryAlignment = 64;
+
   /// \brief Returns a modifiable array of file extensions that the engine considers to be valid ezArchive file extensions.
   ///
   /// By default it always contains 'ezArchive'.
@@ -41,15 +50,18 @@ namespace ezArchiveUtils
   ///
   /// Appends information to the TOC for finding the data in the stream. Reads and updates inout_uiCurrentStreamPosition with the data byte
   /// offset. The progress callback is executed for every couple of KB of data that were written.
+  /// Uncompressed entries are preceded by zero padding, such that their data starts at a multiple of UncompressedEntryAlignment.
+  /// For ezArchiveCompressionMode::Compressed_zstd_chunked the end offsets of all written frames are appended to inout_pFrameEndOffsets,
+  /// which is typically ezArchiveTOC::m_FrameEndOffsets. Without it, chunked entries are written as ezArchiveCompressionMode::Compressed_zstd.
   EZ_FOUNDATION_DLL ezResult WriteEntry(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), ezDynamicArray<ezUInt64>* inout_pFrameEndOffsets = nullptr);
 
   /// \brief Similar to WriteEntry, but if compression is enabled, checks that compression makes enough of a difference.
   /// If compression does not reduce file size enough, the file is stored uncompressed instead.
   EZ_FOUNDATION_DLL ezResult WriteEntryOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), ezDynamicArray<ezUInt64>* inout_pFrameEndOffsets = nullptr);
 
   /// \brief Configures \a memReader as a view into the data stored for \a entry in the archive file.
   ///
@@ -60,6 +72,9 @@ namespace ezArchiveUtils
   /// \brief Creates a new stream reader which allows to read the uncompressed data for the given archive entry.
   ///
   /// Under the hood it may create different types of stream readers to uncompress or decode the data.
+  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveTOC& toc, ezUInt32 uiEntryIdx, const void* pStartOfArchiveData);
+
+  /// \brief Same as above, but only supports entries that are not ezArchiveCompressionMode::Compressed_zstd_chunked, since those need the TOC.
   EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData);
 
   EZ_FOUNDATION_DLL ezResult ReadZipHeader(ezStreamReader& stream, ezUInt8& out_uiVersion);
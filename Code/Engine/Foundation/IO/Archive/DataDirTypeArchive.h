@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
 #include <Foundation/IO/Archive/ArchiveReader.h>
 #include <Foundation/IO/CompressedStreamZlib.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
@@ -14,6 +15,7 @@ namespace ezDataDirectory
 {
   class ArchiveReaderUncompressed;
   class ArchiveReaderZstd;
+  class ArchiveReaderZstdChunked;
   class ArchiveReaderZip;
 
   class EZ_FOUNDATION_DLL ArchiveType : public ezDataDirectoryType
@@ -51,6 +53,8 @@ namespace ezDataDirectory
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
     ezHybridArray<ezUniquePtr<ArchiveReaderZstd>, 4> m_ReadersZstd;
     ezHybridArray<ArchiveReaderZstd*, 4> m_FreeReadersZstd;
+    ezHybridArray<ezUniquePtr<ArchiveReaderZstdChunked>, 4> m_ReadersZstdChunked;
+    ezHybridArray<ArchiveReaderZstdChunked*, 4> m_FreeReadersZstdChunked;
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
     ezHybridArray<ezUniquePtr<ArchiveReaderZip>, 4> m_ReadersZip;
@@ -68,6 +72,7 @@ namespace ezDataDirectory
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
     virtual ezUInt64 GetFileSize() const override;
+    virtual ezArrayPtr<const ezUInt8> GetMappedData() const override { return m_MappedData; }
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
@@ -78,6 +83,7 @@ namespace ezDataDirectory
     ezUInt64 m_uiUncompressedSize = 0;
     ezUInt64 m_uiCompressedSize = 0;
     ezRawMemoryStreamReader m_MemStreamReader;
+    ezArrayPtr<const ezUInt8> m_MappedData; ///< Only set for uncompressed entries.
   };
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
@@ -98,6 +104,24 @@ namespace ezDataDirectory
 
     ezCompressedStreamReaderZstd m_CompressedStreamReader;
   };
+
+  class EZ_FOUNDATION_DLL ArchiveReaderZstdChunked : public ArchiveReaderUncompressed
+  {
+    EZ_DISALLOW_COPY_AND_ASSIGN(ArchiveReaderZstdChunked);
+
+  public:
+    ArchiveReaderZstdChunked(ezInt32 iDataDirUserData);
+    ~ArchiveReaderZstdChunked();
+
+    virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+
+  protected:
+    virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
+
+    friend class ArchiveType;
+
+    ezArchiveChunkedEntryReader m_ChunkedReader;
+  };
 #endif
 
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
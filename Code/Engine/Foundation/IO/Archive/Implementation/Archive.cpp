@@ -36,9 +36,19 @@ const char* ezArchiveTOC::GetEntryPathString(ezUInt32 uiEntryIdx) const
   return reinterpret_cast<const char*>(&m_AllPathStrings[m_Entries[uiEntryIdx].m_uiPathStringOffset]);
 }
 
+ezArrayPtr<const ezUInt64> ezArchiveTOC::GetEntryFrameEndOffsets(ezUInt32 uiEntryIdx) const
+{
+  const ezArchiveEntry& entry = m_Entries[uiEntryIdx];
+
+  if (entry.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_chunked)
+    return ezArrayPtr<const ezUInt64>();
+
+  return m_FrameEndOffsets.GetArrayPtr().GetSubArray(entry.m_uiFirstFrame, entry.GetNumFrames(m_uiFrameSize));
+}
+
 ezResult ezArchiveTOC::Serialize(ezStreamWriter& stream) const
 {
-  stream.WriteVersion(2);
+  stream.WriteVersion(3);
 
   EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_Entries));
 
@@ -47,12 +57,16 @@ ezResult ezArchiveTOC::Serialize(ezStreamWriter& stream) const
 
   EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_AllPathStrings));
 
+  // version 3 added the frame index for chunked entries
+  stream << m_uiFrameSize;
+  EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_FrameEndOffsets));
+
   return EZ_SUCCESS;
 }
 
 ezResult ezArchiveTOC::Deserialize(ezStreamReader& stream)
 {
-  ezTypeVersion version = stream.ReadVersion(2);
+  ezTypeVersion version = stream.ReadVersion(3);
 
   EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_Entries));
 
@@ -108,9 +122,60 @@ ezResult ezArchiveTOC::Deserialize(ezStreamReader& stream)
     return EZ_FAILURE;
   }
 
+  if (version >= 3)
+  {
+    stream >> m_uiFrameSize;
+    EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_FrameEndOffsets));
+  }
+
+  // the frames of all chunked entries are stored consecutively, in entry order
+  {
+    ezUInt32 uiNextFrame = 0;
+
+    for (ezArchiveEntry& entry : m_Entries)
+    {
+      if (entry.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_chunked)
+        continue;
+
+      if (m_uiFrameSize == 0)
+      {
+        ezLog::Error("Archive is corrupt. Invalid frame size.");
+        return EZ_FAILURE;
+      }
+
+      const ezUInt32 uiNumFrames = entry.GetNumFrames(m_uiFrameSize);
+
+      if (uiNextFrame + uiNumFrames > m_FrameEndOffsets.GetCount())
+      {
+        ezLog::Error("Archive is corrupt. Missing frame data.");
+        return EZ_FAILURE;
+      }
+
+      entry.m_uiFirstFrame = uiNextFrame;
+      uiNextFrame += uiNumFrames;
+
+      ezUInt64 uiFrameStart = 0;
+      for (ezUInt32 i = entry.m_uiFirstFrame; i < uiNextFrame; ++i)
+      {
+        if (m_FrameEndOffsets[i] <= uiFrameStart || m_FrameEndOffsets[i] > entry.m_uiStoredDataSize)
+        {
+          ezLog::Error("Archive is corrupt. Invalid frame data range.");
+          return EZ_FAILURE;
+        }
+
+        uiFrameStart = m_FrameEndOffsets[i];
+      }
+    }
+  }
+
   return EZ_SUCCESS;
 }
 
+ezUInt32 ezArchiveEntry::GetNumFrames(ezUInt32 uiFrameSize) const
+{
+  return static_cast<ezUInt32>((m_uiUncompressedDataSize + uiFrameSize - 1) / uiFrameSize);
+}
+
 ezResult ezArchiveEntry::Serialize(ezStreamWriter& stream) const
 {
   stream << m_uiDataStartOffset;
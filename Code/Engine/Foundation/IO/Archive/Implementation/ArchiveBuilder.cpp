@@ -3,8 +3,10 @@
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 void ezArchiveBuilder::AddFolder(const char* szAbsFolderPath, ezArchiveCompressionMode defaultMode /*= ezArchiveCompressionMode::Uncompressed*/,
   InclusionCallback callback /*= InclusionCallback()*/)
@@ -46,6 +48,10 @@ void ezArchiveBuilder::AddFolder(const char* szAbsFolderPath, ezArchiveCompressi
           case InclusionMode::Compress_zstd:
             compression = ezArchiveCompressionMode::Compressed_zstd;
             break;
+
+          case InclusionMode::Compress_zstd_chunked:
+            compression = ezArchiveCompressionMode::Compressed_zstd_chunked;
+            break;
         }
       }
 
@@ -53,6 +59,7 @@ void ezArchiveBuilder::AddFolder(const char* szAbsFolderPath, ezArchiveCompressi
       e.m_sAbsSourcePath = fullPath;
       e.m_sRelTargetPath = relPath;
       e.m_CompressionMode = compression;
+      e.m_uiFileSize = stat.m_uiFileSize;
     }
 
   } while (fileIt.Next().Succeeded());
@@ -75,6 +82,59 @@ ezResult ezArchiveBuilder::WriteArchive(const char* szFile) const
   return WriteArchive(file);
 }
 
+namespace
+{
+  struct ezArchiveCompressedEntry
+  {
+    ezMemoryStreamStorage m_Storage;
+    ezArchiveEntry m_Entry;
+    ezDynamicArray<ezUInt64> m_FrameEndOffsets;
+    ezUInt64 m_uiBytesInFlight = 0;
+    ezTaskGroupID m_TaskGroup;
+    ezResult m_Result = EZ_SUCCESS;
+    bool m_bStoreUncompressed = false;
+  };
+
+  /// \brief Compresses a single archive entry into a temporary buffer, which is later appended to the archive by the writer.
+  class ezArchiveCompressEntryTask final : public ezTask
+  {
+  public:
+    ezArchiveCompressEntryTask(const ezArchiveBuilder::SourceEntry& source, ezArchiveCompressedEntry& result)
+      : m_Source(source)
+      , m_Result(result)
+    {
+      ConfigureTask("Compress Archive Entry", ezTaskNesting::Never);
+    }
+
+  private:
+    virtual void Execute() override
+    {
+      ezMemoryStreamWriter writer(&m_Result.m_Storage);
+
+      ezUInt64 uiStreamPos = 0;
+      m_Result.m_Result = ezArchiveUtils::WriteEntry(
+        writer, m_Source.m_sAbsSourcePath, 0, m_Source.m_CompressionMode, m_Result.m_Entry, uiStreamPos, {}, &m_Result.m_FrameEndOffsets);
+
+      if (m_Result.m_Result.Failed())
+        return;
+
+      // the same rule as in ezArchiveUtils::WriteEntryOptimal: less than 20% size saving -> go uncompressed
+      // uncompressed entries have to be aligned to their final position in the archive, so the writer copies those from the source file
+      if (m_Result.m_Entry.m_CompressionMode == ezArchiveCompressionMode::Uncompressed ||
+          m_Result.m_Entry.m_uiStoredDataSize * 12 >= m_Result.m_Entry.m_uiUncompressedDataSize * 10)
+      {
+        m_Result.m_bStoreUncompressed = true;
+        m_Result.m_Storage.Clear();
+        m_Result.m_Storage.Compact();
+        m_Result.m_FrameEndOffsets.Clear();
+      }
+    }
+
+    const ezArchiveBuilder::SourceEntry& m_Source;
+    ezArchiveCompressedEntry& m_Result;
+  };
+} // namespace
+
 ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream) const
 {
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteHeader(stream));
@@ -86,8 +146,68 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream) const
   ezUInt64 uiStreamSize = 0;
   const ezUInt32 uiNumEntries = m_Entries.GetCount();
 
+  ezDeque<ezArchiveCompressedEntry> compressedEntries;
+  compressedEntries.SetCount(uiNumEntries);
+
+  ezUInt32 uiNextEntryToSchedule = 0;
+  ezUInt64 uiBytesInFlight = 0;
+
+  // compresses upcoming entries on the worker threads, as long as their source data fits into the in-flight budget
+  auto ScheduleCompression = [&]() {
+    for (; uiNextEntryToSchedule < uiNumEntries; ++uiNextEntryToSchedule)
+    {
+      const SourceEntry& e = m_Entries[uiNextEntryToSchedule];
+
+      if (e.m_CompressionMode == ezArchiveCompressionMode::Uncompressed)
+        continue;
+
+      ezUInt64 uiFileSize = e.m_uiFileSize;
+
+      if (uiFileSize == 0)
+      {
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+        ezFileStats stats;
+        if (ezOSFile::GetFileStats(e.m_sAbsSourcePath, stats).Succeeded())
+        {
+          uiFileSize = stats.m_uiFileSize;
+        }
+#endif
+      }
+
+      if (uiFileSize == 0 || uiFileSize > m_uiMaxBytesInFlight)
+      {
+        // entries that are too large (or unknown) are compressed by the writer itself
+        continue;
+      }
+
+      if (uiBytesInFlight + uiFileSize > m_uiMaxBytesInFlight)
+        break;
+
+      ezArchiveCompressedEntry& ce = compressedEntries[uiNextEntryToSchedule];
+      ce.m_uiBytesInFlight = uiFileSize;
+      uiBytesInFlight += uiFileSize;
+
+      // the writer waits for these tasks, so they must not be queued behind the few threads that process long running tasks
+      ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezArchiveCompressEntryTask, e, ce);
+      ce.m_TaskGroup = ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::ThisFrame);
+    }
+  };
+
+  // the tasks reference the entries, so they must all be finished before returning
+  auto WaitForScheduledCompression = [&]() {
+    for (ezUInt32 i = 0; i < uiNextEntryToSchedule; ++i)
+    {
+      if (compressedEntries[i].m_TaskGroup.IsValid())
+      {
+        ezTaskSystem::WaitForGroup(compressedEntries[i].m_TaskGroup);
+      }
+    }
+  };
+
   for (ezUInt32 i = 0; i < uiNumEntries; ++i)
   {
+    ScheduleCompression();
+
     const SourceEntry& e = m_Entries[i];
 
     const ezUInt32 uiPathStringOffset = toc.m_AllPathStrings.GetCount();
@@ -101,10 +221,59 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream) const
       toc.m_Entries.GetCount();
 
     if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
+    {
+      WaitForScheduledCompression();
       return EZ_FAILURE;
+    }
+
+    ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
+    ezArchiveCompressedEntry& ce = compressedEntries[i];
+
+    ezResult res = EZ_SUCCESS;
+
+    if (!ce.m_TaskGroup.IsValid())
+    {
+      res = ezArchiveUtils::WriteEntryOptimal(stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, tocEntry, uiStreamSize,
+        ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this), &toc.m_FrameEndOffsets);
+    }
+    else
+    {
+      ezTaskSystem::WaitForGroup(ce.m_TaskGroup);
+      ce.m_TaskGroup.Invalidate();
+      uiBytesInFlight -= ce.m_uiBytesInFlight;
+
+      if (ce.m_Result.Failed())
+      {
+        res = EZ_FAILURE;
+      }
+      else if (ce.m_bStoreUncompressed)
+      {
+        res = ezArchiveUtils::WriteEntry(stream, e.m_sAbsSourcePath, uiPathStringOffset, ezArchiveCompressionMode::Uncompressed, tocEntry,
+          uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this));
+      }
+      else
+      {
+        tocEntry = ce.m_Entry;
+        tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+        tocEntry.m_uiDataStartOffset = uiStreamSize;
+        toc.m_FrameEndOffsets.PushBackRange(ce.m_FrameEndOffsets);
+
+        res = stream.WriteBytes(ce.m_Storage.GetData(), ce.m_Storage.GetStorageSize());
+        uiStreamSize += tocEntry.m_uiStoredDataSize;
+      }
+
+      // release the temporary buffer right away, to stay within the memory budget
+      ce.m_Storage.Clear();
+      ce.m_Storage.Compact();
+      ce.m_FrameEndOffsets.Clear();
+      ce.m_FrameEndOffsets.Compact();
+    }
 
-    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode,
-      toc.m_Entries.ExpandAndGetRef(), uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+    if (res.Failed())
+    {
+      WaitForScheduledCompression();
+      return EZ_FAILURE;
+    }
   }
 
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::AppendTOC(stream, toc));
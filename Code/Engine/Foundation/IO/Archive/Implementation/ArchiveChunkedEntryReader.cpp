@@ -0,0 +1,185 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+#  include <zstd/zstd.h>
+
+namespace
+{
+  struct FrameRange
+  {
+    const ezUInt8* m_pCompressedData = nullptr;
+    ezUInt64 m_uiCompressedSize = 0;
+    ezUInt64 m_uiUncompressedOffset = 0;
+    ezUInt32 m_uiUncompressedSize = 0;
+  };
+
+  FrameRange GetFrameRange(const ezUInt8* pEntryData, ezArrayPtr<const ezUInt64> frameEndOffsets, ezUInt32 uiFrameSize,
+    ezUInt64 uiUncompressedSize, ezUInt32 uiFrame)
+  {
+    FrameRange range;
+
+    const ezUInt64 uiFrameStart = (uiFrame > 0) ? frameEndOffsets[uiFrame - 1] : 0;
+
+    range.m_pCompressedData = pEntryData + uiFrameStart;
+    range.m_uiCompressedSize = frameEndOffsets[uiFrame] - uiFrameStart;
+    range.m_uiUncompressedOffset = static_cast<ezUInt64>(uiFrame) * uiFrameSize;
+    range.m_uiUncompressedSize = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiFrameSize, uiUncompressedSize - range.m_uiUncompressedOffset));
+
+    return range;
+  }
+} // namespace
+
+ezArchiveChunkedEntryReader::ezArchiveChunkedEntryReader() = default;
+
+ezArchiveChunkedEntryReader::~ezArchiveChunkedEntryReader()
+{
+  if (m_pZstdDCtx != nullptr)
+  {
+    ZSTD_freeDCtx(reinterpret_cast<ZSTD_DCtx*>(m_pZstdDCtx));
+    m_pZstdDCtx = nullptr;
+  }
+}
+
+void ezArchiveChunkedEntryReader::SetEntry(const ezArchiveTOC& toc, ezUInt32 uiEntryIdx, const void* pStartOfArchiveData)
+{
+  const ezArchiveEntry& entry = toc.m_Entries[uiEntryIdx];
+
+  EZ_ASSERT_DEV(entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked, "Archive entry {} is not chunked", uiEntryIdx);
+
+  m_pEntryData = static_cast<const ezUInt8*>(ezMemoryUtils::AddByteOffset(pStartOfArchiveData, entry.m_uiDataStartOffset));
+  m_FrameEndOffsets = toc.GetEntryFrameEndOffsets(uiEntryIdx);
+  m_uiFrameSize = toc.m_uiFrameSize;
+  m_uiUncompressedSize = entry.m_uiUncompressedDataSize;
+  m_uiReadPosition = 0;
+  m_uiDecompressedFrame = ezInvalidIndex;
+
+  if (m_pZstdDCtx == nullptr)
+  {
+    m_pZstdDCtx = ZSTD_createDCtx();
+  }
+}
+
+ezUInt64 ezArchiveChunkedEntryReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
+{
+  ezUInt8* pTarget = static_cast<ezUInt8*>(pReadBuffer);
+  ezUInt64 uiBytesRead = 0;
+
+  uiBytesToRead = ezMath::Min(uiBytesToRead, m_uiUncompressedSize - m_uiReadPosition);
+
+  while (uiBytesToRead > 0)
+  {
+    const ezUInt32 uiFrame = static_cast<ezUInt32>(m_uiReadPosition / m_uiFrameSize);
+
+    if (uiFrame != m_uiDecompressedFrame && DecompressFrame(uiFrame).Failed())
+      break;
+
+    const ezUInt32 uiOffsetInFrame = static_cast<ezUInt32>(m_uiReadPosition % m_uiFrameSize);
+    const ezUInt32 uiToCopy = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiBytesToRead, m_FrameData.GetCount() - uiOffsetInFrame));
+
+    if (pTarget != nullptr)
+    {
+      ezMemoryUtils::Copy(pTarget, m_FrameData.GetData() + uiOffsetInFrame, uiToCopy);
+      pTarget += uiToCopy;
+    }
+
+    m_uiReadPosition += uiToCopy;
+    uiBytesRead += uiToCopy;
+    uiBytesToRead -= uiToCopy;
+  }
+
+  return uiBytesRead;
+}
+
+ezUInt64 ezArchiveChunkedEntryReader::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  const ezUInt64 uiSkipped = ezMath::Min(uiBytesToSkip, m_uiUncompressedSize - m_uiReadPosition);
+  m_uiReadPosition += uiSkipped;
+  return uiSkipped;
+}
+
+void ezArchiveChunkedEntryReader::SetReadPosition(ezUInt64 uiPosition)
+{
+  EZ_ASSERT_DEV(uiPosition <= m_uiUncompressedSize, "Read position {} is outside the entry data (size {})", uiPosition, m_uiUncompressedSize);
+  m_uiReadPosition = uiPosition;
+}
+
+ezResult ezArchiveChunkedEntryReader::DecompressFrame(ezUInt32 uiFrame)
+{
+  const FrameRange range = GetFrameRange(m_pEntryData, m_FrameEndOffsets, m_uiFrameSize, m_uiUncompressedSize, uiFrame);
+
+  m_FrameData.SetCountUninitialized(range.m_uiUncompressedSize);
+  m_uiDecompressedFrame = ezInvalidIndex;
+
+  const size_t res = ZSTD_decompressDCtx(reinterpret_cast<ZSTD_DCtx*>(m_pZstdDCtx), m_FrameData.GetData(), m_FrameData.GetCount(),
+    range.m_pCompressedData, static_cast<size_t>(range.m_uiCompressedSize));
+
+  if (ZSTD_isError(res) || res != range.m_uiUncompressedSize)
+  {
+    ezLog::Error("Decompressing archive frame {} failed", uiFrame);
+    return EZ_FAILURE;
+  }
+
+  m_uiDecompressedFrame = uiFrame;
+  return EZ_SUCCESS;
+}
+
+ezResult ezArchiveChunkedEntryReader::DecompressEntry(
+  const ezArchiveTOC& toc, ezUInt32 uiEntryIdx, const void* pStartOfArchiveData, ezArrayPtr<ezUInt8> out_Target)
+{
+  const ezArchiveEntry& entry = toc.m_Entries[uiEntryIdx];
+
+  EZ_ASSERT_DEV(entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked, "Archive entry {} is not chunked", uiEntryIdx);
+  EZ_ASSERT_DEV(out_Target.GetCount() == entry.m_uiUncompressedDataSize, "Target buffer has the wrong size");
+
+  struct Context
+  {
+    const ezUInt8* m_pEntryData;
+    ezArrayPtr<const ezUInt64> m_FrameEndOffsets;
+    ezUInt32 m_uiFrameSize;
+    ezArrayPtr<ezUInt8> m_Target;
+    ezAtomicInteger32 m_iFailedFrames;
+  };
+
+  Context ctx;
+  ctx.m_pEntryData = static_cast<const ezUInt8*>(ezMemoryUtils::AddByteOffset(pStartOfArchiveData, entry.m_uiDataStartOffset));
+  ctx.m_FrameEndOffsets = toc.GetEntryFrameEndOffsets(uiEntryIdx);
+  ctx.m_uiFrameSize = toc.m_uiFrameSize;
+  ctx.m_Target = out_Target;
+
+  Context* pCtx = &ctx;
+
+  ezTaskSystem::ParallelForIndexed(0, ctx.m_FrameEndOffsets.GetCount(),
+    [pCtx](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 uiFrame = uiStartIndex; uiFrame < uiEndIndex; ++uiFrame)
+      {
+        const FrameRange range =
+          GetFrameRange(pCtx->m_pEntryData, pCtx->m_FrameEndOffsets, pCtx->m_uiFrameSize, pCtx->m_Target.GetCount(), uiFrame);
+
+        const size_t res = ZSTD_decompress(pCtx->m_Target.GetPtr() + range.m_uiUncompressedOffset, range.m_uiUncompressedSize,
+          range.m_pCompressedData, static_cast<size_t>(range.m_uiCompressedSize));
+
+        if (ZSTD_isError(res) || res != range.m_uiUncompressedSize)
+        {
+          pCtx->m_iFailedFrames.Increment();
+        }
+      }
+    },
+    "DecompressArchiveEntry");
+
+  if (ctx.m_iFailedFrames > 0)
+  {
+    ezLog::Error("Decompressing {} frames of archive entry '{}' failed", ctx.m_iFailedFrames, toc.GetEntryPathString(uiEntryIdx));
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Archive_Implementation_ArchiveChunkedEntryReader);
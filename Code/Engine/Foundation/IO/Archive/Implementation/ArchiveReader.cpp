@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
 #include <Foundation/IO/Archive/ArchiveReader.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 
@@ -29,7 +30,7 @@ ezResult ezArchiveReader::OpenArchive(const char* szPath)
     {
       EZ_SUCCEED_OR_RETURN(ezArchiveUtils::ReadHeader(reader, m_uiArchiveVersion));
 
-      m_pDataStart = m_MemFile.GetReadPointer(16, ezMemoryMappedFile::OffsetBase::Start);
+      m_pDataStart = m_MemFile.GetReadPointer(ezArchiveUtils::ArchiveHeaderSize, ezMemoryMappedFile::OffsetBase::Start);
 
       EZ_SUCCEED_OR_RETURN(ezArchiveUtils::ExtractTOC(m_MemFile, m_ArchiveTOC, m_uiArchiveVersion));
     }
@@ -122,7 +123,62 @@ void ezArchiveReader::ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawM
 
 ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryIdx) const
 {
-  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
+  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC, uiEntryIdx, m_pDataStart);
+}
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+void ezArchiveReader::ConfigureChunkedEntryReader(ezUInt32 uiEntryIdx, ezArchiveChunkedEntryReader& reader) const
+{
+  reader.SetEntry(m_ArchiveTOC, uiEntryIdx, m_pDataStart);
+}
+#endif
+
+ezResult ezArchiveReader::DecompressEntry(ezUInt32 uiEntryIdx, ezArrayPtr<ezUInt8> out_Target) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  if (out_Target.GetCount() != entry.m_uiUncompressedDataSize)
+  {
+    ezLog::Error("Target buffer for archive entry '{}' has the wrong size", m_ArchiveTOC.GetEntryPathString(uiEntryIdx));
+    return EZ_FAILURE;
+  }
+
+  switch (entry.m_CompressionMode)
+  {
+    case ezArchiveCompressionMode::Uncompressed:
+    {
+      // GetEntryDataView() returns an empty view for entries that are larger than 4 GB, so access the data directly
+      const void* pData = ezMemoryUtils::AddByteOffset(m_pDataStart, entry.m_uiDataStartOffset);
+      ezMemoryUtils::Copy(out_Target.GetPtr(), static_cast<const ezUInt8*>(pData), out_Target.GetCount());
+      return EZ_SUCCESS;
+    }
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    case ezArchiveCompressionMode::Compressed_zstd_chunked:
+      return ezArchiveChunkedEntryReader::DecompressEntry(m_ArchiveTOC, uiEntryIdx, m_pDataStart, out_Target);
+#endif
+
+    default:
+    {
+      ezUniquePtr<ezStreamReader> pReader = CreateEntryReader(uiEntryIdx);
+
+      if (pReader == nullptr || pReader->ReadBytes(out_Target.GetPtr(), out_Target.GetCount()) != out_Target.GetCount())
+        return EZ_FAILURE;
+
+      return EZ_SUCCESS;
+    }
+  }
+}
+
+ezArrayPtr<const ezUInt8> ezArchiveReader::GetEntryDataView(ezUInt32 uiEntryIdx) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  if (entry.m_CompressionMode != ezArchiveCompressionMode::Uncompressed || entry.m_uiStoredDataSize > ezMath::MaxValue<ezUInt32>())
+    return ezArrayPtr<const ezUInt8>();
+
+  const ezUInt8* pData = static_cast<const ezUInt8*>(ezMemoryUtils::AddByteOffset(m_pDataStart, entry.m_uiDataStartOffset));
+  return ezArrayPtr<const ezUInt8>(pData, static_cast<ezUInt32>(entry.m_uiStoredDataSize));
 }
 
 ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, const char* szTargetFolder) const
@@ -2,6 +2,7 @@
 
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
 #include <Foundation/IO/CompressedStreamZlib.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
@@ -9,6 +10,10 @@
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Logging/Log.h>
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+#  include <zstd/zstd.h>
+#endif
+
 ezHybridArray<ezString, 4, ezStaticAllocatorWrapper>& ezArchiveUtils::GetAcceptedArchiveFileExtensions()
 {
   static ezHybridArray<ezString, 4, ezStaticAllocatorWrapper> extensions;
@@ -37,14 +42,17 @@ ezResult ezArchiveUtils::WriteHeader(ezStreamWriter& stream)
   const char* szTag = "EZARCHIVE";
   EZ_SUCCEED_OR_RETURN(stream.WriteBytes(szTag, 10));
 
-  const ezUInt8 uiArchiveVersion = 3;
+  const ezUInt8 uiArchiveVersion = 4;
   // Version 2: Added end-of-file marker for file corruption (cutoff) detection
   // Version 3: HashedStrings changed from MurmurHash to xxHash
+  // Version 4: TOC stores the frame index for chunked entries
   stream << uiArchiveVersion;
 
   const ezUInt8 uiPadding[5] = {0, 0, 0, 0, 0};
   EZ_SUCCEED_OR_RETURN(stream.WriteBytes(uiPadding, 5));
 
+  static_assert(10 + sizeof(uiArchiveVersion) + 5 == ArchiveHeaderSize, "ArchiveHeaderSize doesn't match the written header");
+
   return EZ_SUCCESS;
 }
 
@@ -60,7 +68,7 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersi
   out_uiVersion = 0;
   stream >> out_uiVersion;
 
-  if (out_uiVersion != 1 && out_uiVersion != 2 && out_uiVersion != 3)
+  if (out_uiVersion < 1 || out_uiVersion > 4)
   {
     ezLog::Error("Unsupported archive version '{}'.", out_uiVersion);
     return EZ_FAILURE;
@@ -84,10 +92,95 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersi
   return EZ_SUCCESS;
 }
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+/// \brief Compresses all incoming data in independent zstd frames of ezArchiveTOC::DefaultFrameSize and records where each frame ends.
+class ezArchiveChunkedWriterZstd : public ezStreamWriter
+{
+public:
+  ezArchiveChunkedWriterZstd(ezStreamWriter& stream, ezDynamicArray<ezUInt64>& out_FrameEndOffsets)
+    : m_Stream(stream)
+    , m_FrameEndOffsets(out_FrameEndOffsets)
+  {
+    m_pZstdCCtx = ZSTD_createCCtx();
+    m_Frame.Reserve(ezArchiveTOC::DefaultFrameSize);
+    m_CompressedFrame.SetCountUninitialized(static_cast<ezUInt32>(ZSTD_compressBound(ezArchiveTOC::DefaultFrameSize)));
+  }
+
+  ~ezArchiveChunkedWriterZstd() { ZSTD_freeCCtx(m_pZstdCCtx); }
+
+  virtual ezResult WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite) override
+  {
+    const ezUInt8* pBytes = static_cast<const ezUInt8*>(pWriteBuffer);
+
+    while (uiBytesToWrite > 0)
+    {
+      const ezUInt32 uiToCopy = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiBytesToWrite, ezArchiveTOC::DefaultFrameSize - m_Frame.GetCount()));
+
+      m_Frame.PushBackRange(ezArrayPtr<const ezUInt8>(pBytes, uiToCopy));
+      pBytes += uiToCopy;
+      uiBytesToWrite -= uiToCopy;
+
+      if (m_Frame.GetCount() == ezArchiveTOC::DefaultFrameSize)
+      {
+        EZ_SUCCEED_OR_RETURN(CompressFrame());
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  ezResult FinishCompressedStream()
+  {
+    if (m_Frame.IsEmpty())
+      return EZ_SUCCESS;
+
+    return CompressFrame();
+  }
+
+  ezUInt64 GetWrittenBytes() const { return m_uiWrittenBytes; }
+
+private:
+  ezResult CompressFrame()
+  {
+    const size_t uiCompressedSize = ZSTD_compressCCtx(m_pZstdCCtx, m_CompressedFrame.GetData(), m_CompressedFrame.GetCount(), m_Frame.GetData(),
+      m_Frame.GetCount(), ezCompressedStreamWriterZstd::Compression::Default);
+
+    if (ZSTD_isError(uiCompressedSize))
+    {
+      ezLog::Error("Compressing archive frame failed: '{0}'", ZSTD_getErrorName(uiCompressedSize));
+      return EZ_FAILURE;
+    }
+
+    EZ_SUCCEED_OR_RETURN(m_Stream.WriteBytes(m_CompressedFrame.GetData(), uiCompressedSize));
+
+    m_uiWrittenBytes += uiCompressedSize;
+    m_FrameEndOffsets.PushBack(m_uiWrittenBytes);
+    m_Frame.Clear();
+
+    return EZ_SUCCESS;
+  }
+
+  ezStreamWriter& m_Stream;
+  ezDynamicArray<ezUInt64>& m_FrameEndOffsets;
+  ezDynamicArray<ezUInt8> m_Frame;
+  ezDynamicArray<ezUInt8> m_CompressedFrame;
+  ezUInt64 m_uiWrittenBytes = 0;
+  ZSTD_CCtx* m_pZstdCCtx = nullptr;
+};
+
+#endif
+
 ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
   ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, ezDynamicArray<ezUInt64>* inout_pFrameEndOffsets /*= nullptr*/)
 {
+  if (compression == ezArchiveCompressionMode::Compressed_zstd_chunked && inout_pFrameEndOffsets == nullptr)
+  {
+    // the frame offsets cannot be stored anywhere, so the entry would not be readable
+    compression = ezArchiveCompressionMode::Compressed_zstd;
+  }
+
   ezFileReader file;
   EZ_SUCCEED_OR_RETURN(file.Open(szAbsSourcePath, 1024 * 1024));
 
@@ -95,14 +188,12 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
 
   ezUInt8 uiTemp[1024 * 8];
 
-  tocEntry.m_uiPathStringOffset = uiPathStringOffset;
-  tocEntry.m_uiDataStartOffset = inout_uiCurrentStreamPosition;
-  tocEntry.m_uiUncompressedDataSize = 0;
-
   ezStreamWriter* pWriter = &stream;
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
   ezCompressedStreamWriterZstd zstdWriter;
+  ezDynamicArray<ezUInt64> unusedFrameEndOffsets;
+  ezArchiveChunkedWriterZstd chunkedWriter(stream, inout_pFrameEndOffsets != nullptr ? *inout_pFrameEndOffsets : unusedFrameEndOffsets);
 #endif
 
   switch (compression)
@@ -119,10 +210,35 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
 #endif
       break;
 
+    case ezArchiveCompressionMode::Compressed_zstd_chunked:
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      pWriter = &chunkedWriter;
+#else
+      compression = ezArchiveCompressionMode::Uncompressed;
+#endif
+      break;
+
     default:
       EZ_ASSERT_NOT_IMPLEMENTED;
   }
 
+  if (compression == ezArchiveCompressionMode::Uncompressed)
+  {
+    // pad the stream such that the entry data can be accessed in-place and properly aligned from a memory mapped archive
+    const ezUInt64 uiFileOffset = ArchiveHeaderSize + inout_uiCurrentStreamPosition;
+    const ezUInt32 uiPadding = static_cast<ezUInt32>(ezMemoryUtils::AlignSize<ezUInt64>(uiFileOffset, UncompressedEntryAlignment) - uiFileOffset);
+
+    if (uiPadding > 0)
+    {
+      const ezUInt8 uiZeroPadding[UncompressedEntryAlignment] = {};
+      EZ_SUCCEED_OR_RETURN(stream.WriteBytes(uiZeroPadding, uiPadding));
+      inout_uiCurrentStreamPosition += uiPadding;
+    }
+  }
+
+  tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+  tocEntry.m_uiDataStartOffset = inout_uiCurrentStreamPosition;
+  tocEntry.m_uiUncompressedDataSize = 0;
   tocEntry.m_CompressionMode = compression;
 
   ezUInt64 uiRead = 0;
@@ -152,6 +268,11 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
       EZ_SUCCEED_OR_RETURN(zstdWriter.FinishCompressedStream());
       tocEntry.m_uiStoredDataSize = zstdWriter.GetWrittenBytes();
       break;
+
+    case ezArchiveCompressionMode::Compressed_zstd_chunked:
+      EZ_SUCCEED_OR_RETURN(chunkedWriter.FinishCompressedStream());
+      tocEntry.m_uiStoredDataSize = chunkedWriter.GetWrittenBytes();
+      break;
 #endif
 
     case ezArchiveCompressionMode::Uncompressed:
@@ -167,26 +288,34 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
 
 ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
   ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+  FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, ezDynamicArray<ezUInt64>* inout_pFrameEndOffsets /*= nullptr*/)
 {
   if (compression == ezArchiveCompressionMode::Uncompressed)
   {
-    return WriteEntry(
-      stream, szAbsSourcePath, uiPathStringOffset, ezArchiveCompressionMode::Uncompressed, tocEntry, inout_uiCurrentStreamPosition, progress);
+    return WriteEntry(stream, szAbsSourcePath, uiPathStringOffset, ezArchiveCompressionMode::Uncompressed, tocEntry,
+      inout_uiCurrentStreamPosition, progress);
   }
   else
   {
     ezMemoryStreamStorage storage;
     ezMemoryStreamWriter writer(&storage);
 
+    const ezUInt32 uiNumFrames = inout_pFrameEndOffsets != nullptr ? inout_pFrameEndOffsets->GetCount() : 0;
+
     ezUInt64 streamPos = inout_uiCurrentStreamPosition;
-    EZ_SUCCEED_OR_RETURN(WriteEntry(writer, szAbsSourcePath, uiPathStringOffset, compression, tocEntry, streamPos, progress));
+    EZ_SUCCEED_OR_RETURN(
+      WriteEntry(writer, szAbsSourcePath, uiPathStringOffset, compression, tocEntry, streamPos, progress, inout_pFrameEndOffsets));
 
     if (tocEntry.m_uiStoredDataSize * 12 >= tocEntry.m_uiUncompressedDataSize * 10)
     {
       // less than 20% size saving -> go uncompressed
-      return WriteEntry(
-        stream, szAbsSourcePath, uiPathStringOffset, ezArchiveCompressionMode::Uncompressed, tocEntry, inout_uiCurrentStreamPosition, progress);
+      if (inout_pFrameEndOffsets != nullptr)
+      {
+        inout_pFrameEndOffsets->SetCount(uiNumFrames);
+      }
+
+      return WriteEntry(stream, szAbsSourcePath, uiPathStringOffset, ezArchiveCompressionMode::Uncompressed, tocEntry,
+        inout_uiCurrentStreamPosition, progress);
     }
     else
     {
@@ -218,6 +347,20 @@ public:
 
 #endif
 
+ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveTOC& toc, ezUInt32 uiEntryIdx, const void* pStartOfArchiveData)
+{
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (toc.m_Entries[uiEntryIdx].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked)
+  {
+    ezUniquePtr<ezArchiveChunkedEntryReader> reader = EZ_DEFAULT_NEW(ezArchiveChunkedEntryReader);
+    reader->SetEntry(toc, uiEntryIdx, pStartOfArchiveData);
+    return std::move(reader);
+  }
+#endif
+
+  return CreateEntryReader(toc.m_Entries[uiEntryIdx], pStartOfArchiveData);
+}
+
 ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData)
 {
   ezUniquePtr<ezStreamReader> reader;
@@ -88,6 +88,26 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(
         }
         break;
       }
+
+      case ezArchiveCompressionMode::Compressed_zstd_chunked:
+      {
+        ArchiveReaderZstdChunked* pChunkedReader = nullptr;
+
+        if (!m_FreeReadersZstdChunked.IsEmpty())
+        {
+          pChunkedReader = m_FreeReadersZstdChunked.PeekBack();
+          m_FreeReadersZstdChunked.PopBack();
+        }
+        else
+        {
+          m_ReadersZstdChunked.PushBack(EZ_DEFAULT_NEW(ArchiveReaderZstdChunked, 3));
+          pChunkedReader = m_ReadersZstdChunked.PeekBack().Borrow();
+        }
+
+        m_ArchiveReader.ConfigureChunkedEntryReader(uiEntryIndex, pChunkedReader->m_ChunkedReader);
+        pReader = pChunkedReader;
+        break;
+      }
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
       case ezArchiveCompressionMode::Compressed_zip:
@@ -116,6 +136,7 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
 
   m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
+  pReader->m_MappedData = m_ArchiveReader.GetEntryDataView(uiEntryIndex);
 
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
@@ -241,6 +262,12 @@ void ezDataDirectory::ArchiveType::OnReaderWriterClose(ezDataDirectoryReaderWrit
     m_FreeReadersZstd.PushBack(static_cast<ArchiveReaderZstd*>(pClosed));
     return;
   }
+
+  if (pClosed->GetDataDirUserData() == 3)
+  {
+    m_FreeReadersZstdChunked.PushBack(static_cast<ArchiveReaderZstdChunked*>(pClosed));
+    return;
+  }
 #endif
 
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
@@ -312,6 +339,29 @@ ezResult ezDataDirectory::ArchiveReaderZstd::InternalOpen(ezFileShareMode::Enum
   return EZ_SUCCESS;
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+ezDataDirectory::ArchiveReaderZstdChunked::ArchiveReaderZstdChunked(ezInt32 iDataDirUserData)
+  : ArchiveReaderUncompressed(iDataDirUserData)
+{
+}
+
+ezDataDirectory::ArchiveReaderZstdChunked::~ArchiveReaderZstdChunked() = default;
+
+ezUInt64 ezDataDirectory::ArchiveReaderZstdChunked::Read(void* pBuffer, ezUInt64 uiBytes)
+{
+  return m_ChunkedReader.ReadBytes(pBuffer, uiBytes);
+}
+
+ezResult ezDataDirectory::ArchiveReaderZstdChunked::InternalOpen(ezFileShareMode::Enum FileShareMode)
+{
+  EZ_ASSERT_DEBUG(
+    FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
+
+  // the chunked reader is already configured for the entry
+  return EZ_SUCCESS;
+}
+
 #endif
 
 //////////////////////////////////////////////////////////////////////////
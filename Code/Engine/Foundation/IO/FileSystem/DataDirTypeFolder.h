@@ -61,8 +61,24 @@ namespace ezDataDirectory
 
     void LoadRedirectionFile();
 
-    mutable ezMutex m_ReaderWriterMutex; ///< Locks m_Readers / m_Writers as well as the m_bIsInUse flag of each reader / writer.
-    ezHybridArray<ezDataDirectory::FolderReader*, 4> m_Readers;
+    /// \brief Readers are pooled per thread, so that threads that open files concurrently don't contend on the same mutex.
+    ///
+    /// Each thread is assigned one of the pools round-robin the first time it opens a file. With up to NumReaderPools threads,
+    /// every thread thus has a pool of its own.
+    struct ReaderPool
+    {
+      ezMutex m_Mutex; ///< Locks m_Readers as well as the m_bIsInUse flag of each reader in this pool.
+      ezHybridArray<ezDataDirectory::FolderReader*, 4> m_Readers;
+    };
+
+    static constexpr ezUInt32 NumReaderPools = 16;
+
+    /// \brief Returns the index of the reader pool that the calling thread should use.
+    static ezUInt32 GetReaderPoolIndex();
+
+    ReaderPool m_ReaderPools[NumReaderPools];
+
+    mutable ezMutex m_ReaderWriterMutex; ///< Locks m_Writers as well as the m_bIsInUse flag of each writer.
     ezHybridArray<ezDataDirectory::FolderWriter*, 4> m_Writers;
 
     mutable ezMutex m_RedirectionMutex;
@@ -93,6 +109,7 @@ namespace ezDataDirectory
     friend class FolderType;
 
     bool m_bIsInUse;
+    ezUInt8 m_uiReaderPool = 0;
     ezOSFile m_File;
   };
 
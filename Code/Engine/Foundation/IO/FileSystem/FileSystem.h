@@ -1,11 +1,15 @@
 #pragma once
 
 #include <Foundation/Communication/Event.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Mutex.h>
 
+#include <atomic>
+
 /// \brief The ezFileSystem provides high-level functionality to manage files in a virtual file system.
 ///
 /// There are two sides at which the file system can be extended:
@@ -33,11 +37,13 @@
 /// This allows to hook into the system and implement stuff like automatic asset transformations before/after certain
 /// file accesses, checking out files from revision control systems, or simply logging all file activity.
 ///
-/// All operations that go through the ezFileSystem are protected by a mutex, which means that opening, closing, deleting
+/// Administrative operations that go through the ezFileSystem are protected by a mutex, which means that creating and deleting
 /// files, as well as adding or removing data directories etc. will be synchronized and cannot happen in parallel.
+/// Opening files for reading does not take that mutex. The list of data directories is published as an immutable snapshot,
+/// which readers on any thread can use without locking, so files can be opened and read from many threads concurrently.
 /// Reading/writing file streams can happen in parallel, only the administrative tasks need to be protected.
 /// File events are broadcast as they occur, that means they will be executed on whichever thread triggered them.
-/// Since they are executed from within the filesystem mutex, they cannot occur in parallel.
+/// Events for opening files for reading may therefore be broadcast from several threads at the same time.
 class EZ_FOUNDATION_DLL ezFileSystem
 {
 public:
@@ -183,10 +189,44 @@ public:
 
   /// \brief Returns the (recursive) mutex that is used internally by the file system which can be used to guard bundled operations on the file
   /// system.
+  ///
+  /// \note Opening files for reading does not lock this mutex, so it cannot be used to prevent other threads from reading files.
   static ezMutex& GetMutex();
 
   ///@}
 
+  /// \name File Lookup Cache
+  ///@{
+
+  /// \brief Enables or disables the cache that remembers in which data directory a file was found when it was opened for reading.
+  ///
+  /// With the cache enabled, opening a file that was opened before only costs a hash table lookup and a single open attempt
+  /// in the data directory that owns the file, instead of trying every data directory from last to first.
+  /// If a cached data directory cannot open the file anymore (e.g. the file was deleted), the entry is dropped and all data
+  /// directories are searched again.
+  ///
+  /// If \a bCacheMissingFiles is true, files that could not be found are remembered as well, so that repeated attempts to open
+  /// non-existing files fail immediately. This is only safe, if all file modifications go through ezFileSystem, or if the
+  /// application calls InvalidateFileLookupCache() when it detects file changes (e.g. through an ezDirectoryWatcher).
+  ///
+  /// The cache is disabled by default, because nothing watches the data directories for changes. Files that other processes, tools
+  /// or hot reloading create or delete would otherwise be hidden or still be found until the next remount. Applications that enable it
+  /// should call InvalidateFileLookupCache() whenever they detect such changes.
+  /// ezGameApplicationBase enables the cache (without bCacheMissingFiles) when it sets up its data directories, unless the command line
+  /// option "-noFileLookupCache" is given. ezGameApplication invalidates it when it reloads all resources.
+  /// The cache is cleared automatically whenever data directories are added or removed, files are written or deleted through
+  /// ezFileSystem, or ReloadAllExternalDataDirectoryConfigs() is called.
+  static void SetFileLookupCacheEnabled(bool bEnable, bool bCacheMissingFiles = false); // [tested]
+
+  /// \brief Returns whether the file lookup cache is currently enabled.
+  static bool IsFileLookupCacheEnabled();
+
+  /// \brief Clears all entries from the file lookup cache. Should be called when files were added, moved or removed outside of
+  /// ezFileSystem.
+  static void InvalidateFileLookupCache(); // [tested]
+
+  ///@}
+
   static ezResult CreateDirectoryStructure(const char* szPath);
 
 public:
@@ -253,6 +293,9 @@ private:
   /// itself, which should not trigger an endless recursion of file events.
   static ezDataDirectoryWriter* GetFileWriter(const char* szFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents);
 
+  /// \brief Lets the given data directory try to open the file for reading and broadcasts the corresponding file events.
+  static ezDataDirectoryReader* OpenFileToReadInDataDir(ezDataDirectoryType* pDataDir, const char* szPath, const ezString& sRootName,
+    ezFileShareMode::Enum FileShareMode, bool bOneSpecificDataDir, bool bAllowFileEvents);
 
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, FileSystem);
@@ -281,22 +324,106 @@ private:
     ezDataDirFactory m_Factory;
   };
 
+  struct FileLookupCacheShard
+  {
+    ezMutex m_Mutex;
+    ezHashTable<ezString, ezInt32> m_Entries; ///< Maps root name + clean path to the index of the data dir that owns the file, or -1.
+  };
+
+  /// \brief An immutable snapshot of all active data directories.
+  ///
+  /// Adding or removing data directories builds a new list under m_FsMutex and publishes it atomically. Readers only ever look
+  /// at the currently published list through a DataDirectoryListReader and thus never need to lock m_FsMutex. Lists that were
+  /// replaced and data directories that were removed are retired and only destroyed once no reader is active anymore, because
+  /// other threads may still use them.
+  /// The file lookup cache belongs to the list, since it stores indices into it. It is split into several shards with their own mutex
+  /// to keep threads that open different files from contending.
+  struct DataDirectoryList
+  {
+    static constexpr ezUInt32 NumFileLookupCacheShards = 16;
+
+    ezHybridArray<DataDirectory, 16> m_DataDirectories;
+    mutable FileLookupCacheShard m_FileLookupCache[NumFileLookupCacheShards];
+  };
+
+  /// \brief Counts the DataDirectoryListReader instances of a group of threads.
+  ///
+  /// Every file access creates a reader, so a single counter would make all threads that open files contend on the same cache line.
+  /// Instead each thread always uses the same shard, and shards are kept on separate cache lines. Since every reader decrements the
+  /// shard that it incremented, no shard ever drops below zero and the file system is unused when all shards are zero.
+  struct EZ_ALIGN(ReaderCounterShard, 64)
+  {
+    ezAtomicInteger32 m_iNumActiveReaders;
+  };
+
   struct FileSystemData
   {
+    static constexpr ezUInt32 NumReaderCounterShards = 16;
+
     ezHybridArray<Factory, 4> m_DataDirFactories;
-    ezHybridArray<DataDirectory, 16> m_DataDirectories;
+
+    std::atomic<DataDirectoryList*> m_pDataDirectories = {nullptr};
+    ReaderCounterShard m_ReaderCounters[NumReaderCounterShards]; ///< The number of DataDirectoryListReader instances on all threads.
+    ezAtomicBool m_bHasRetiredData;        ///< Whether any list or data directory waits to be destroyed.
+    ezDynamicArray<DataDirectoryList*> m_RetiredDataDirectoryLists;
+    ezDynamicArray<ezDataDirectoryType*> m_RetiredDataDirectories;
 
     ezEvent<const FileEvent&, ezMutex> m_Event;
+    ezAtomicInteger32 m_iNumEventHandlers; ///< Allows to skip broadcasting (and thus locking the event's mutex) when nobody listens.
     ezMutex m_FsMutex;
+
+    ezAtomicBool m_bFileLookupCacheEnabled = false;
+    ezAtomicBool m_bCacheMissingFiles = false;
+  };
+
+  /// \brief Gives access to the currently published list of data directories from any thread without locking m_FsMutex.
+  ///
+  /// The list and all data directories in it stay alive as long as the reader exists. Readers should therefore be short-lived.
+  class DataDirectoryListReader
+  {
+  public:
+    DataDirectoryListReader();
+    ~DataDirectoryListReader();
+
+    const DataDirectoryList& GetList() const { return *m_pList; }
+
+  private:
+    const DataDirectoryList* m_pList;
+    ReaderCounterShard* m_pCounter;
   };
 
+  /// \brief Returns whether any DataDirectoryListReader is active on any thread.
+  static bool HasActiveReaders();
+
+  /// \brief Returns the currently published list of data directories. Must be called while m_FsMutex is locked, otherwise use a
+  /// DataDirectoryListReader.
+  static const DataDirectoryList& GetDataDirectoryList() { return *s_Data->m_pDataDirectories.load(std::memory_order_acquire); }
+
+  /// \brief Replaces the currently published list of data directories. Must be called while m_FsMutex is locked.
+  ///
+  /// The given data directories were removed from the list and are destroyed together with the old list.
+  static void PublishDataDirectoryList(const ezHybridArray<DataDirectory, 16>& dataDirs, ezArrayPtr<ezDataDirectoryType*> removedDataDirs = {});
+
+  /// \brief Destroys all retired lists and data directories, if no DataDirectoryListReader is active. Must be called while m_FsMutex
+  /// is locked.
+  static void DestroyRetiredDataDirectoryLists();
+
+  /// \brief Removes all entries from the file lookup cache of the given list.
+  static void ClearFileLookupCache(const DataDirectoryList& list);
+
+  /// \brief Returns the file lookup cache shard that is responsible for the given key.
+  static FileLookupCacheShard& GetFileLookupCacheShard(const DataDirectoryList& list, const ezStringBuilder& sKey);
+
+  /// \brief Broadcasts the given event, unless no event handler is registered at all.
+  static void BroadcastFileEvent(const FileEvent& fe);
+
   /// \brief Returns a list of data directory categories that were embedded in the path.
   static const char* ExtractRootName(const char* szPath, ezString& rootName);
 
   /// \brief Returns the given path relative to its data directory. The path must be inside the given data directory.
-  static const char* GetDataDirRelativePath(const char* szPath, ezUInt32 uiDataDir);
+  static const char* GetDataDirRelativePath(const char* szPath, const ezDataDirectoryType* pDataDir);
 
-  static DataDirectory* GetDataDirForRoot(const ezString& sRoot);
+  static const DataDirectory* GetDataDirForRoot(const DataDirectoryList& list, const ezString& sRoot);
 
   static void CleanUpRootName(ezStringBuilder& sRoot);
 
@@ -163,6 +163,12 @@ public:
   }
 
   virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) = 0;
+
+  /// \brief If the entire file content is available in memory (e.g. an uncompressed file in a memory mapped archive), this returns a view
+  /// of it, otherwise an empty array.
+  ///
+  /// The view is independent of the current read position and stays valid until the reader is closed.
+  virtual ezArrayPtr<const ezUInt8> GetMappedData() const { return ezArrayPtr<const ezUInt8>(); }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
@@ -65,13 +65,17 @@ namespace ezDataDirectory
 
   void FolderType::RemoveDataDirectory()
   {
+    for (ReaderPool& pool : m_ReaderPools)
     {
-      EZ_LOCK(m_ReaderWriterMutex);
-      for (ezUInt32 i = 0; i < m_Readers.GetCount(); ++i)
+      EZ_LOCK(pool.m_Mutex);
+      for (ezUInt32 i = 0; i < pool.m_Readers.GetCount(); ++i)
       {
-        EZ_ASSERT_DEV(!m_Readers[i]->m_bIsInUse, "Cannot remove a data directory while there are still files open in it.");
+        EZ_ASSERT_DEV(!pool.m_Readers[i]->m_bIsInUse, "Cannot remove a data directory while there are still files open in it.");
       }
+    }
 
+    {
+      EZ_LOCK(m_ReaderWriterMutex);
       for (ezUInt32 i = 0; i < m_Writers.GetCount(); ++i)
       {
         EZ_ASSERT_DEV(!m_Writers[i]->m_bIsInUse, "Cannot remove a data directory while there are still files open in it.");
@@ -91,9 +95,14 @@ namespace ezDataDirectory
 
   FolderType::~FolderType()
   {
+    for (ReaderPool& pool : m_ReaderPools)
+    {
+      EZ_LOCK(pool.m_Mutex);
+      for (ezUInt32 i = 0; i < pool.m_Readers.GetCount(); ++i)
+        EZ_DEFAULT_DELETE(pool.m_Readers[i]);
+    }
+
     EZ_LOCK(m_ReaderWriterMutex);
-    for (ezUInt32 i = 0; i < m_Readers.GetCount(); ++i)
-      EZ_DEFAULT_DELETE(m_Readers[i]);
 
     for (ezUInt32 i = 0; i < m_Writers.GetCount(); ++i)
       EZ_DEFAULT_DELETE(m_Writers[i]);
@@ -218,19 +227,30 @@ namespace ezDataDirectory
 
   void FolderType::OnReaderWriterClose(ezDataDirectoryReaderWriterBase* pClosed)
   {
-    EZ_LOCK(m_ReaderWriterMutex);
     if (pClosed->IsReader())
     {
       FolderReader* pReader = (FolderReader*)pClosed;
+
+      // the reader may be closed on a different thread than it was opened on, so always return it to the pool it came from
+      EZ_LOCK(m_ReaderPools[pReader->m_uiReaderPool].m_Mutex);
       pReader->m_bIsInUse = false;
     }
     else
     {
+      EZ_LOCK(m_ReaderWriterMutex);
       FolderWriter* pWriter = (FolderWriter*)pClosed;
       pWriter->m_bIsInUse = false;
     }
   }
 
+  ezUInt32 FolderType::GetReaderPoolIndex()
+  {
+    static ezAtomicInteger32 s_iNextReaderPool;
+    static thread_local ezUInt32 s_uiReaderPool = static_cast<ezUInt32>(s_iNextReaderPool.PostIncrement()) % NumReaderPools;
+
+    return s_uiReaderPool;
+  }
+
   ezDataDirectory::FolderReader* FolderType::CreateFolderReader() const { return EZ_DEFAULT_NEW(FolderReader, 0); }
 
   ezDataDirectory::FolderWriter* FolderType::CreateFolderWriter() const { return EZ_DEFAULT_NEW(FolderWriter, 0); }
@@ -244,19 +264,26 @@ namespace ezDataDirectory
     if (ezConversionUtils::IsStringUuid(sFileToOpen))
       return nullptr;
 
+    const ezUInt32 uiReaderPool = GetReaderPoolIndex();
+    ReaderPool& pool = m_ReaderPools[uiReaderPool];
+
     FolderReader* pReader = nullptr;
     {
-      EZ_LOCK(m_ReaderWriterMutex);
-      for (ezUInt32 i = 0; i < m_Readers.GetCount(); ++i)
+      EZ_LOCK(pool.m_Mutex);
+      for (ezUInt32 i = 0; i < pool.m_Readers.GetCount(); ++i)
       {
-        if (!m_Readers[i]->m_bIsInUse)
-          pReader = m_Readers[i];
+        if (!pool.m_Readers[i]->m_bIsInUse)
+        {
+          pReader = pool.m_Readers[i];
+          break;
+        }
       }
 
       if (pReader == nullptr)
       {
-        m_Readers.PushBack(CreateFolderReader());
-        pReader = m_Readers.PeekBack();
+        pool.m_Readers.PushBack(CreateFolderReader());
+        pReader = pool.m_Readers.PeekBack();
+        pReader->m_uiReaderPool = static_cast<ezUInt8>(uiReaderPool);
       }
       pReader->m_bIsInUse = true;
     }
@@ -264,7 +291,7 @@ namespace ezDataDirectory
     // if opening the file fails, the reader's m_bIsInUse needs to be reset.
     if (pReader->Open(sFileToOpen, this, FileShareMode) == EZ_FAILURE)
     {
-      EZ_LOCK(m_ReaderWriterMutex);
+      EZ_LOCK(pool.m_Mutex);
       pReader->m_bIsInUse = false;
       return nullptr;
     }
@@ -36,6 +36,11 @@ public:
   /// \brief Returns the current total size of the file.
   ezUInt64 GetFileSize() const { return m_pDataDirReader->GetFileSize(); }
 
+  /// \brief Returns a view of the entire file content, if the data directory can provide it without copying, otherwise an empty array.
+  ///
+  /// This allows loaders to consume files from memory mapped archives in-place. The data stays valid until the file is closed.
+  ezArrayPtr<const ezUInt8> GetMappedData() const { return m_pDataDirReader->GetMappedData(); }
+
 protected:
   ezDataDirectoryReader* GetFileReader(const char* szFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
   {
@@ -39,6 +39,7 @@ ezEventSubscriptionID ezFileSystem::RegisterEventHandler(ezEvent<const FileEvent
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
+  s_Data->m_iNumEventHandlers.Increment();
   return s_Data->m_Event.AddEventHandler(handler);
 }
 
@@ -47,13 +48,27 @@ void ezFileSystem::UnregisterEventHandler(ezEvent<const FileEvent&>::Handler han
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
   s_Data->m_Event.RemoveEventHandler(handler);
+  s_Data->m_iNumEventHandlers.Decrement();
 }
 
 void ezFileSystem::UnregisterEventHandler(ezEventSubscriptionID subscriptionId)
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
+  if (subscriptionId == 0)
+    return;
+
   s_Data->m_Event.RemoveEventHandler(subscriptionId);
+  s_Data->m_iNumEventHandlers.Decrement();
+}
+
+void ezFileSystem::BroadcastFileEvent(const FileEvent& fe)
+{
+  // the event locks its mutex while broadcasting, don't let concurrent file accesses contend on it when nobody is listening
+  if (s_Data->m_iNumEventHandlers > 0)
+  {
+    s_Data->m_Event.Broadcast(fe);
+  }
 }
 
 void ezFileSystem::CleanUpRootName(ezStringBuilder& sRoot)
@@ -72,6 +87,104 @@ void ezFileSystem::CleanUpRootName(ezStringBuilder& sRoot)
   sRoot.ToUpper();
 }
 
+ezFileSystem::DataDirectoryListReader::DataDirectoryListReader()
+{
+  // spread the threads evenly over the shards, each thread keeps its shard for its whole lifetime
+  static ezAtomicInteger32 s_iNextCounterShard;
+  thread_local const ezUInt32 tl_uiCounterShard = static_cast<ezUInt32>(s_iNextCounterShard.Increment()) % FileSystemData::NumReaderCounterShards;
+
+  m_pCounter = &s_Data->m_ReaderCounters[tl_uiCounterShard];
+
+  // announce the reader before loading the list, see DestroyRetiredDataDirectoryLists()
+  m_pCounter->m_iNumActiveReaders.Increment();
+  m_pList = s_Data->m_pDataDirectories.load(std::memory_order_seq_cst);
+}
+
+ezFileSystem::DataDirectoryListReader::~DataDirectoryListReader()
+{
+  // other shards may still be in use, DestroyRetiredDataDirectoryLists() checks all of them
+  if (m_pCounter->m_iNumActiveReaders.Decrement() == 0 && s_Data->m_bHasRetiredData)
+  {
+    // if the mutex is busy, the next writer or the next reader that finishes cleans up instead
+    if (s_Data->m_FsMutex.TryLock())
+    {
+      DestroyRetiredDataDirectoryLists();
+      s_Data->m_FsMutex.Unlock();
+    }
+  }
+}
+
+bool ezFileSystem::HasActiveReaders()
+{
+  for (const ReaderCounterShard& counter : s_Data->m_ReaderCounters)
+  {
+    if (counter.m_iNumActiveReaders != 0)
+      return true;
+  }
+
+  return false;
+}
+
+void ezFileSystem::PublishDataDirectoryList(const ezHybridArray<DataDirectory, 16>& dataDirs, ezArrayPtr<ezDataDirectoryType*> removedDataDirs)
+{
+  DataDirectoryList* pNewList = EZ_DEFAULT_NEW(DataDirectoryList);
+  pNewList->m_DataDirectories = dataDirs;
+
+  DataDirectoryList* pOldList = s_Data->m_pDataDirectories.exchange(pNewList, std::memory_order_seq_cst);
+
+  // readers on other threads may still use the old list and the removed data directories
+  if (pOldList != nullptr)
+  {
+    s_Data->m_RetiredDataDirectoryLists.PushBack(pOldList);
+  }
+
+  s_Data->m_RetiredDataDirectories.PushBackRange(removedDataDirs);
+
+  s_Data->m_bHasRetiredData = true;
+  DestroyRetiredDataDirectoryLists();
+}
+
+void ezFileSystem::DestroyRetiredDataDirectoryLists()
+{
+  // readers increment their counter before they load the list pointer and writers exchange the pointer before they get here
+  // both is sequentially consistent, so a reader whose shard was already checked when it announced itself can only ever see the
+  // currently published list
+  if (HasActiveReaders())
+    return;
+
+  s_Data->m_bHasRetiredData = false;
+
+  ezHybridArray<DataDirectoryList*, 4> retiredLists;
+  ezHybridArray<ezDataDirectoryType*, 4> retiredDataDirs;
+  retiredLists.Swap(s_Data->m_RetiredDataDirectoryLists);
+  retiredDataDirs.Swap(s_Data->m_RetiredDataDirectories);
+
+  for (DataDirectoryList* pList : retiredLists)
+  {
+    EZ_DEFAULT_DELETE(pList);
+  }
+
+  for (ezDataDirectoryType* pDataDir : retiredDataDirs)
+  {
+    pDataDir->RemoveDataDirectory();
+  }
+}
+
+void ezFileSystem::ClearFileLookupCache(const DataDirectoryList& list)
+{
+  for (ezUInt32 i = 0; i < DataDirectoryList::NumFileLookupCacheShards; ++i)
+  {
+    EZ_LOCK(list.m_FileLookupCache[i].m_Mutex);
+    list.m_FileLookupCache[i].m_Entries.Clear();
+  }
+}
+
+ezFileSystem::FileLookupCacheShard& ezFileSystem::GetFileLookupCacheShard(const DataDirectoryList& list, const ezStringBuilder& sKey)
+{
+  const ezUInt32 uiHash = ezHashingUtils::xxHash32(sKey.GetData(), sKey.GetElementCount());
+  return list.m_FileLookupCache[uiHash % DataDirectoryList::NumFileLookupCacheShards];
+}
+
 ezResult ezFileSystem::AddDataDirectory(const char* szDataDirectory, const char* szGroup, const char* szRootName, DataDirUsage Usage)
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
@@ -107,13 +220,15 @@ ezResult ezFileSystem::AddDataDirectory(const char* szDataDirectory, const char*
 
       if (pDataDir != nullptr)
       {
-        DataDirectory dd;
+        ezHybridArray<DataDirectory, 16> dataDirs = GetDataDirectoryList().m_DataDirectories;
+
+        DataDirectory& dd = dataDirs.ExpandAndGetRef();
         dd.m_Usage = Usage;
         dd.m_pDataDirectory = pDataDir;
         dd.m_sRootName = sCleanRootName;
         dd.m_sGroup = szGroup;
 
-        s_Data->m_DataDirectories.PushBack(dd);
+        PublishDataDirectoryList(dataDirs);
 
         {
           // Broadcast that a data directory was added
@@ -122,7 +237,7 @@ ezResult ezFileSystem::AddDataDirectory(const char* szDataDirectory, const char*
           fe.m_szFileOrDirectory = sPath;
           fe.m_szOther = sCleanRootName;
           fe.m_pDataDir = pDataDir;
-          s_Data->m_Event.Broadcast(fe);
+          BroadcastFileEvent(fe);
         }
 
         return EZ_SUCCESS;
@@ -136,7 +251,7 @@ ezResult ezFileSystem::AddDataDirectory(const char* szDataDirectory, const char*
     fe.m_EventType = FileEventType::AddDataDirectoryFailed;
     fe.m_szFileOrDirectory = sPath;
     fe.m_szOther = sCleanRootName;
-    s_Data->m_Event.Broadcast(fe);
+    BroadcastFileEvent(fe);
   }
 
   ezLog::Error("Adding Data Directory '{0}' failed.", ezArgSensitive(szDataDirectory, "Path"));
@@ -151,27 +266,28 @@ bool ezFileSystem::RemoveDataDirectory(const char* szRootName)
 
   EZ_LOCK(s_Data->m_FsMutex);
 
-  for (ezUInt32 i = 0; i < s_Data->m_DataDirectories.GetCount();)
+  ezHybridArray<DataDirectory, 16> dataDirs = GetDataDirectoryList().m_DataDirectories;
+
+  for (ezUInt32 i = 0; i < dataDirs.GetCount(); ++i)
   {
-    if (s_Data->m_DataDirectories[i].m_sRootName == sCleanRootName)
+    if (dataDirs[i].m_sRootName == sCleanRootName)
     {
       {
         // Broadcast that a data directory is about to be removed
         FileEvent fe;
         fe.m_EventType = FileEventType::RemoveDataDirectory;
-        fe.m_szFileOrDirectory = s_Data->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
-        fe.m_szOther = s_Data->m_DataDirectories[i].m_sRootName;
-        fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-        s_Data->m_Event.Broadcast(fe);
+        fe.m_szFileOrDirectory = dataDirs[i].m_pDataDirectory->GetDataDirectoryPath();
+        fe.m_szOther = dataDirs[i].m_sRootName;
+        fe.m_pDataDir = dataDirs[i].m_pDataDirectory;
+        BroadcastFileEvent(fe);
       }
 
-      s_Data->m_DataDirectories[i].m_pDataDirectory->RemoveDataDirectory();
-      s_Data->m_DataDirectories.RemoveAtAndCopy(i);
+      ezDataDirectoryType* pDataDir = dataDirs[i].m_pDataDirectory;
+      dataDirs.RemoveAtAndCopy(i);
 
+      PublishDataDirectoryList(dataDirs, ezMakeArrayPtr(&pDataDir, 1));
       return true;
     }
-    else
-      ++i;
   }
 
   return false;
@@ -183,32 +299,36 @@ ezUInt32 ezFileSystem::RemoveDataDirectoryGroup(const char* szGroup)
 
   EZ_LOCK(s_Data->m_FsMutex);
 
-  ezUInt32 uiRemoved = 0;
+  ezHybridArray<DataDirectory, 16> dataDirs = GetDataDirectoryList().m_DataDirectories;
+  ezHybridArray<ezDataDirectoryType*, 16> removedDataDirs;
 
-  for (ezUInt32 i = 0; i < s_Data->m_DataDirectories.GetCount();)
+  for (ezUInt32 i = 0; i < dataDirs.GetCount();)
   {
-    if (s_Data->m_DataDirectories[i].m_sGroup == szGroup)
+    if (dataDirs[i].m_sGroup == szGroup)
     {
       {
         // Broadcast that a data directory is about to be removed
         FileEvent fe;
         fe.m_EventType = FileEventType::RemoveDataDirectory;
-        fe.m_szFileOrDirectory = s_Data->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
-        fe.m_szOther = s_Data->m_DataDirectories[i].m_sRootName;
-        fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-        s_Data->m_Event.Broadcast(fe);
+        fe.m_szFileOrDirectory = dataDirs[i].m_pDataDirectory->GetDataDirectoryPath();
+        fe.m_szOther = dataDirs[i].m_sRootName;
+        fe.m_pDataDir = dataDirs[i].m_pDataDirectory;
+        BroadcastFileEvent(fe);
       }
 
-      ++uiRemoved;
-
-      s_Data->m_DataDirectories[i].m_pDataDirectory->RemoveDataDirectory();
-      s_Data->m_DataDirectories.RemoveAtAndCopy(i);
+      removedDataDirs.PushBack(dataDirs[i].m_pDataDirectory);
+      dataDirs.RemoveAtAndCopy(i);
     }
     else
       ++i;
   }
 
-  return uiRemoved;
+  if (!removedDataDirs.IsEmpty())
+  {
+    PublishDataDirectoryList(dataDirs, removedDataDirs);
+  }
+
+  return removedDataDirs.GetCount();
 }
 
 void ezFileSystem::ClearAllDataDirectories()
@@ -217,22 +337,23 @@ void ezFileSystem::ClearAllDataDirectories()
 
   EZ_LOCK(s_Data->m_FsMutex);
 
-  for (ezInt32 i = s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  const ezHybridArray<DataDirectory, 16> dataDirs = GetDataDirectoryList().m_DataDirectories;
+  ezHybridArray<ezDataDirectoryType*, 16> removedDataDirs;
+
+  for (ezInt32 i = dataDirs.GetCount() - 1; i >= 0; --i)
   {
-    {
-      // Broadcast that a data directory is about to be removed
-      FileEvent fe;
-      fe.m_EventType = FileEventType::RemoveDataDirectory;
-      fe.m_szFileOrDirectory = s_Data->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
-      fe.m_szOther = s_Data->m_DataDirectories[i].m_sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-      s_Data->m_Event.Broadcast(fe);
-    }
+    // Broadcast that a data directory is about to be removed
+    FileEvent fe;
+    fe.m_EventType = FileEventType::RemoveDataDirectory;
+    fe.m_szFileOrDirectory = dataDirs[i].m_pDataDirectory->GetDataDirectoryPath();
+    fe.m_szOther = dataDirs[i].m_sRootName;
+    fe.m_pDataDir = dataDirs[i].m_pDataDirectory;
+    BroadcastFileEvent(fe);
 
-    s_Data->m_DataDirectories[i].m_pDataDirectory->RemoveDataDirectory();
+    removedDataDirs.PushBack(dataDirs[i].m_pDataDirectory);
   }
 
-  s_Data->m_DataDirectories.Clear();
+  PublishDataDirectoryList(ezHybridArray<DataDirectory, 16>(), removedDataDirs);
 }
 
 ezDataDirectoryType* ezFileSystem::FindDataDirectoryWithRoot(const char* szRootName)
@@ -240,9 +361,9 @@ ezDataDirectoryType* ezFileSystem::FindDataDirectoryWithRoot(const char* szRootN
   if (ezStringUtils::IsNullOrEmpty(szRootName))
     return nullptr;
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  DataDirectoryListReader reader;
 
-  for (const auto& dd : s_Data->m_DataDirectories)
+  for (const auto& dd : reader.GetList().m_DataDirectories)
   {
     if (dd.m_sRootName.IsEqual_NoCase(szRootName))
     {
@@ -257,26 +378,26 @@ ezUInt32 ezFileSystem::GetNumDataDirectories()
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  return s_Data->m_DataDirectories.GetCount();
+  DataDirectoryListReader reader;
+  return reader.GetList().m_DataDirectories.GetCount();
 }
 
 ezDataDirectoryType* ezFileSystem::GetDataDirectory(ezUInt32 uiDataDirIndex)
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  return s_Data->m_DataDirectories[uiDataDirIndex].m_pDataDirectory;
+  DataDirectoryListReader reader;
+  return reader.GetList().m_DataDirectories[uiDataDirIndex].m_pDataDirectory;
 }
 
-const char* ezFileSystem::GetDataDirRelativePath(const char* szPath, ezUInt32 uiDataDir)
+const char* ezFileSystem::GetDataDirRelativePath(const char* szPath, const ezDataDirectoryType* pDataDir)
 {
-  EZ_LOCK(s_Data->m_FsMutex);
-
   // if an absolute path is given, this will check whether the absolute path would fall into this data directory
   // if yes, the prefix path is removed and then only the relative path is given to the data directory type
   // otherwise the data directory would prepend its own path and thus create an invalid path to work with
 
   // first check the redirected directory
-  const ezString128& sRedDirPath = s_Data->m_DataDirectories[uiDataDir].m_pDataDirectory->GetRedirectedDataDirectoryPath();
+  const ezString128& sRedDirPath = pDataDir->GetRedirectedDataDirectoryPath();
 
   if (!sRedDirPath.IsEmpty() && ezStringUtils::StartsWith_NoCase(szPath, sRedDirPath))
   {
@@ -290,7 +411,7 @@ const char* ezFileSystem::GetDataDirRelativePath(const char* szPath, ezUInt32 ui
   }
 
   // then check the original mount path
-  const ezString128& sDirPath = s_Data->m_DataDirectories[uiDataDir].m_pDataDirectory->GetDataDirectoryPath();
+  const ezString128& sDirPath = pDataDir->GetDataDirectoryPath();
 
   // If the data dir is empty we return the paths as is or the code below would remove the '/' in front of an
   // absolute path.
@@ -309,14 +430,12 @@ const char* ezFileSystem::GetDataDirRelativePath(const char* szPath, ezUInt32 ui
 }
 
 
-ezFileSystem::DataDirectory* ezFileSystem::GetDataDirForRoot(const ezString& sRoot)
+const ezFileSystem::DataDirectory* ezFileSystem::GetDataDirForRoot(const DataDirectoryList& list, const ezString& sRoot)
 {
-  EZ_LOCK(s_Data->m_FsMutex);
-
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  for (ezInt32 i = (ezInt32)list.m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
-    if (s_Data->m_DataDirectories[i].m_sRootName == sRoot)
-      return &s_Data->m_DataDirectories[i];
+    if (list.m_DataDirectories[i].m_sRootName == sRoot)
+      return &list.m_DataDirectories[i];
   }
 
   return nullptr;
@@ -330,6 +449,7 @@ void ezFileSystem::DeleteFile(const char* szFile)
   if (ezPathUtils::IsAbsolutePath(szFile))
   {
     ezOSFile::DeleteFile(szFile);
+    InvalidateFileLookupCache();
     return;
   }
 
@@ -343,16 +463,22 @@ void ezFileSystem::DeleteFile(const char* szFile)
 
   EZ_LOCK(s_Data->m_FsMutex);
 
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  const DataDirectoryList& list = GetDataDirectoryList();
+
+  ClearFileLookupCache(list);
+
+  for (ezInt32 i = (ezInt32)list.m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
+    const DataDirectory& dd = list.m_DataDirectories[i];
+
     // do not delete data from directories that are mounted as read only
-    if (s_Data->m_DataDirectories[i].m_Usage != AllowWrites)
+    if (dd.m_Usage != AllowWrites)
       continue;
 
-    if (s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+    if (dd.m_sRootName != sRootName)
       continue;
 
-    const char* szRelPath = GetDataDirRelativePath(szFile, i);
+    const char* szRelPath = GetDataDirRelativePath(szFile, dd.m_pDataDirectory);
 
     {
       // Broadcast that a file is about to be deleted
@@ -360,12 +486,12 @@ void ezFileSystem::DeleteFile(const char* szFile)
       FileEvent fe;
       fe.m_EventType = FileEventType::DeleteFile;
       fe.m_szFileOrDirectory = szRelPath;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+      fe.m_pDataDir = dd.m_pDataDirectory;
       fe.m_szOther = sRootName;
-      s_Data->m_Event.Broadcast(fe);
+      BroadcastFileEvent(fe);
     }
 
-    s_Data->m_DataDirectories[i].m_pDataDirectory->DeleteFile(szRelPath);
+    dd.m_pDataDirectory->DeleteFile(szRelPath);
   }
 }
 
@@ -378,16 +504,19 @@ bool ezFileSystem::ExistsFile(const char* szFile)
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  DataDirectoryListReader reader;
+  const DataDirectoryList& list = reader.GetList();
 
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  for (ezInt32 i = (ezInt32)list.m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
-    if (!sRootName.IsEmpty() && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+    const DataDirectory& dd = list.m_DataDirectories[i];
+
+    if (!sRootName.IsEmpty() && dd.m_sRootName != sRootName)
       continue;
 
-    const char* szRelPath = GetDataDirRelativePath(szFile, i);
+    const char* szRelPath = GetDataDirRelativePath(szFile, dd.m_pDataDirectory);
 
-    if (s_Data->m_DataDirectories[i].m_pDataDirectory->ExistsFile(szRelPath, bOneSpecificDataDir))
+    if (dd.m_pDataDirectory->ExistsFile(szRelPath, bOneSpecificDataDir))
       return true;
   }
 
@@ -399,21 +528,24 @@ ezResult ezFileSystem::GetFileStats(const char* szFileOrFolder, ezFileStats& out
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
   ezString sRootName;
   szFileOrFolder = ExtractRootName(szFileOrFolder, sRootName);
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  DataDirectoryListReader reader;
+  const DataDirectoryList& list = reader.GetList();
+
+  for (ezInt32 i = (ezInt32)list.m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
-    if (!sRootName.IsEmpty() && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+    const DataDirectory& dd = list.m_DataDirectories[i];
+
+    if (!sRootName.IsEmpty() && dd.m_sRootName != sRootName)
       continue;
 
-    const char* szRelPath = GetDataDirRelativePath(szFileOrFolder, i);
+    const char* szRelPath = GetDataDirRelativePath(szFileOrFolder, dd.m_pDataDirectory);
 
-    if (s_Data->m_DataDirectories[i].m_pDataDirectory->GetFileStats(szRelPath, bOneSpecificDataDir, out_Stats).Succeeded())
+    if (dd.m_pDataDirectory->GetFileStats(szRelPath, bOneSpecificDataDir, out_Stats).Succeeded())
       return EZ_SUCCESS;
   }
 
@@ -447,6 +579,40 @@ const char* ezFileSystem::ExtractRootName(const char* szPath, ezString& rootName
   return it.GetStartPointer(); // return the string after the data-dir filter declaration
 }
 
+ezDataDirectoryReader* ezFileSystem::OpenFileToReadInDataDir(ezDataDirectoryType* pDataDir, const char* szPath, const ezString& sRootName,
+  ezFileShareMode::Enum FileShareMode, bool bOneSpecificDataDir, bool bAllowFileEvents)
+{
+  const char* szRelPath = GetDataDirRelativePath(szPath, pDataDir);
+
+  if (bAllowFileEvents)
+  {
+    // Broadcast that we now try to open this file
+    // Could be useful to check this file out before it is accessed
+    FileEvent fe;
+    fe.m_EventType = FileEventType::OpenFileAttempt;
+    fe.m_szFileOrDirectory = szRelPath;
+    fe.m_szOther = sRootName;
+    fe.m_pDataDir = pDataDir;
+    BroadcastFileEvent(fe);
+  }
+
+  // Let the data directory try to open the file.
+  ezDataDirectoryReader* pReader = pDataDir->OpenFileToRead(szRelPath, FileShareMode, bOneSpecificDataDir);
+
+  if (bAllowFileEvents && pReader != nullptr)
+  {
+    // Broadcast that this file has been opened.
+    FileEvent fe;
+    fe.m_EventType = FileEventType::OpenFileSucceeded;
+    fe.m_szFileOrDirectory = szRelPath;
+    fe.m_szOther = sRootName;
+    fe.m_pDataDir = pDataDir;
+    BroadcastFileEvent(fe);
+  }
+
+  return pReader;
+}
+
 ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
@@ -454,7 +620,9 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
   if (ezStringUtils::IsNullOrEmpty(szFile))
     return nullptr;
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  // no locking here, the data directory list is an immutable snapshot
+  DataDirectoryListReader reader;
+  const DataDirectoryList& list = reader.GetList();
 
   ezString sRootName;
   szFile = ExtractRootName(szFile, sRootName);
@@ -465,41 +633,77 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  // the last added data directory has the highest priority
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  const bool bUseCache = s_Data->m_bFileLookupCacheEnabled;
+  const bool bCacheMissingFiles = s_Data->m_bCacheMissingFiles;
+  ezStringBuilder sCacheKey;
+  bool bKnownToBeMissing = false;
+
+  if (bUseCache)
   {
-    // if a root is used, ignore all directories that do not have the same root name
-    if (bOneSpecificDataDir && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
-      continue;
+    // the root name can't contain a '|', so this can't produce ambiguous keys
+    sCacheKey.Set(sRootName, "|", sPath);
 
-    const char* szRelPath = GetDataDirRelativePath(sPath, i);
+    FileLookupCacheShard& shard = GetFileLookupCacheShard(list, sCacheKey);
+
+    ezInt32 iCachedDataDir = -1;
+    bool bFound = false;
 
-    if (bAllowFileEvents)
     {
-      // Broadcast that we now try to open this file
-      // Could be useful to check this file out before it is accessed
-      FileEvent fe;
-      fe.m_EventType = FileEventType::OpenFileAttempt;
-      fe.m_szFileOrDirectory = szRelPath;
-      fe.m_szOther = sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-      s_Data->m_Event.Broadcast(fe);
+      EZ_LOCK(shard.m_Mutex);
+      bFound = shard.m_Entries.TryGetValue(sCacheKey, iCachedDataDir);
     }
 
-    // Let the data directory try to open the file.
-    ezDataDirectoryReader* pReader = s_Data->m_DataDirectories[i].m_pDataDirectory->OpenFileToRead(szRelPath, FileShareMode, bOneSpecificDataDir);
+    if (bFound)
+    {
+      if (iCachedDataDir < 0)
+      {
+        bKnownToBeMissing = true;
+      }
+      else
+      {
+        ezDataDirectoryType* pDataDir = list.m_DataDirectories[iCachedDataDir].m_pDataDirectory;
 
-    if (bAllowFileEvents && pReader != nullptr)
+        if (ezDataDirectoryReader* pReader = OpenFileToReadInDataDir(pDataDir, sPath, sRootName, FileShareMode, bOneSpecificDataDir, bAllowFileEvents))
+          return pReader;
+
+        // the file is not where we expected it anymore, search all data directories again
+        EZ_LOCK(shard.m_Mutex);
+        shard.m_Entries.Remove(sCacheKey);
+      }
+    }
+  }
+
+  if (!bKnownToBeMissing)
+  {
+    // the last added data directory has the highest priority
+    for (ezInt32 i = (ezInt32)list.m_DataDirectories.GetCount() - 1; i >= 0; --i)
     {
-      // Broadcast that this file has been opened.
-      FileEvent fe;
-      fe.m_EventType = FileEventType::OpenFileSucceeded;
-      fe.m_szFileOrDirectory = szRelPath;
-      fe.m_szOther = sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-      s_Data->m_Event.Broadcast(fe);
+      const DataDirectory& dd = list.m_DataDirectories[i];
+
+      // if a root is used, ignore all directories that do not have the same root name
+      if (bOneSpecificDataDir && dd.m_sRootName != sRootName)
+        continue;
 
-      return pReader;
+      ezDataDirectoryReader* pReader = OpenFileToReadInDataDir(dd.m_pDataDirectory, sPath, sRootName, FileShareMode, bOneSpecificDataDir, bAllowFileEvents);
+
+      if (pReader != nullptr)
+      {
+        if (bUseCache)
+        {
+          FileLookupCacheShard& shard = GetFileLookupCacheShard(list, sCacheKey);
+          EZ_LOCK(shard.m_Mutex);
+          shard.m_Entries.Insert(sCacheKey, i);
+        }
+
+        return pReader;
+      }
+    }
+
+    if (bUseCache && bCacheMissingFiles)
+    {
+      FileLookupCacheShard& shard = GetFileLookupCacheShard(list, sCacheKey);
+      EZ_LOCK(shard.m_Mutex);
+      shard.m_Entries.Insert(sCacheKey, -1);
     }
   }
 
@@ -509,7 +713,7 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
     FileEvent fe;
     fe.m_EventType = FileEventType::OpenFileFailed;
     fe.m_szFileOrDirectory = sPath;
-    s_Data->m_Event.Broadcast(fe);
+    BroadcastFileEvent(fe);
   }
 
   return nullptr;
@@ -539,17 +743,21 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(const char* szFile, ezFileSha
   ezStringBuilder sPath = szFile;
   sPath.MakeCleanPath();
 
+  const DataDirectoryList& list = GetDataDirectoryList();
+
   // the last added data directory has the highest priority
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  for (ezInt32 i = (ezInt32)list.m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
-    if (s_Data->m_DataDirectories[i].m_Usage != AllowWrites)
+    const DataDirectory& dd = list.m_DataDirectories[i];
+
+    if (dd.m_Usage != AllowWrites)
       continue;
 
     // ignore all directories that have not the category that is currently requested
-    if (s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+    if (dd.m_sRootName != sRootName)
       continue;
 
-    const char* szRelPath = GetDataDirRelativePath(szFile, i);
+    const char* szRelPath = GetDataDirRelativePath(szFile, dd.m_pDataDirectory);
 
     if (bAllowFileEvents)
     {
@@ -559,11 +767,17 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(const char* szFile, ezFileSha
       fe.m_EventType = FileEventType::CreateFileAttempt;
       fe.m_szFileOrDirectory = szRelPath;
       fe.m_szOther = sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-      s_Data->m_Event.Broadcast(fe);
+      fe.m_pDataDir = dd.m_pDataDirectory;
+      BroadcastFileEvent(fe);
     }
 
-    ezDataDirectoryWriter* pWriter = s_Data->m_DataDirectories[i].m_pDataDirectory->OpenFileToWrite(szRelPath, FileShareMode);
+    ezDataDirectoryWriter* pWriter = dd.m_pDataDirectory->OpenFileToWrite(szRelPath, FileShareMode);
+
+    if (pWriter != nullptr)
+    {
+      // the file might not have existed before or it may now shadow a file in a data directory with lower priority
+      ClearFileLookupCache(list);
+    }
 
     if (bAllowFileEvents && pWriter != nullptr)
     {
@@ -572,8 +786,8 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(const char* szFile, ezFileSha
       fe.m_EventType = FileEventType::CreateFileSucceeded;
       fe.m_szFileOrDirectory = szRelPath;
       fe.m_szOther = sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-      s_Data->m_Event.Broadcast(fe);
+      fe.m_pDataDir = dd.m_pDataDirectory;
+      BroadcastFileEvent(fe);
 
       return pWriter;
     }
@@ -585,7 +799,7 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(const char* szFile, ezFileSha
     FileEvent fe;
     fe.m_EventType = FileEventType::CreateFileFailed;
     fe.m_szFileOrDirectory = sPath;
-    s_Data->m_Event.Broadcast(fe);
+    BroadcastFileEvent(fe);
   }
 
   return nullptr;
@@ -596,8 +810,6 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
   ezStringBuilder absPath, relPath;
 
   if (ezStringUtils::StartsWith(szPath, ":"))
@@ -606,7 +818,8 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
     ezString sRootName;
     ExtractRootName(szPath, sRootName);
 
-    DataDirectory* pDataDir = GetDataDirForRoot(sRootName);
+    DataDirectoryListReader reader;
+    const DataDirectory* pDataDir = GetDataDirForRoot(reader.GetList(), sRootName);
 
     if (pDataDir == nullptr)
       return EZ_FAILURE;
@@ -624,9 +837,12 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
     absPath = szPath;
     absPath.MakeCleanPath();
 
-    for (ezUInt32 dd = s_Data->m_DataDirectories.GetCount(); dd > 0; --dd)
+    DataDirectoryListReader reader;
+    const DataDirectoryList& list = reader.GetList();
+
+    for (ezUInt32 dd = list.m_DataDirectories.GetCount(); dd > 0; --dd)
     {
-      auto& dir = s_Data->m_DataDirectories[dd - 1];
+      auto& dir = list.m_DataDirectories[dd - 1];
 
       if (ezPathUtils::IsSubPath(dir.m_pDataDirectory->GetRedirectedDataDirectoryPath(), absPath))
       {
@@ -722,9 +938,9 @@ ezResult ezFileSystem::FindFolderWithSubPath(const char* szStartDirectory, const
 
 bool ezFileSystem::ResolveAssetRedirection(const char* szPathOrAssetGuid, ezStringBuilder& out_sRedirection)
 {
-  EZ_LOCK(s_Data->m_FsMutex);
+  DataDirectoryListReader reader;
 
-  for (auto& dd : s_Data->m_DataDirectories)
+  for (auto& dd : reader.GetList().m_DataDirectories)
   {
     if (dd.m_pDataDirectory->ResolveAssetRedirection(szPathOrAssetGuid, out_sRedirection))
       return true;
@@ -740,15 +956,23 @@ void ezFileSystem::ReloadAllExternalDataDirectoryConfigs()
 
   EZ_LOCK(s_Data->m_FsMutex);
 
-  for (auto& dd : s_Data->m_DataDirectories)
+  const DataDirectoryList& list = GetDataDirectoryList();
+
+  for (auto& dd : list.m_DataDirectories)
   {
     dd.m_pDataDirectory->ReloadExternalConfigs();
   }
+
+  // asset redirections may have changed which file a path refers to
+  ClearFileLookupCache(list);
 }
 
 void ezFileSystem::Startup()
 {
   s_Data = EZ_DEFAULT_NEW(FileSystemData);
+
+  EZ_LOCK(s_Data->m_FsMutex);
+  PublishDataDirectoryList(ezHybridArray<DataDirectory, 16>());
 }
 
 void ezFileSystem::Shutdown()
@@ -759,6 +983,12 @@ void ezFileSystem::Shutdown()
     s_Data->m_DataDirFactories.Clear();
 
     ClearAllDataDirectories();
+
+    EZ_ASSERT_DEV(!HasActiveReaders(), "The file system is still in use on another thread during shutdown.");
+    DestroyRetiredDataDirectoryLists();
+
+    DataDirectoryList* pList = s_Data->m_pDataDirectories.exchange(nullptr);
+    EZ_DEFAULT_DELETE(pList);
   }
 
   EZ_DEFAULT_DELETE(s_Data);
@@ -888,6 +1118,32 @@ ezMutex& ezFileSystem::GetMutex()
   return s_Data->m_FsMutex;
 }
 
+void ezFileSystem::SetFileLookupCacheEnabled(bool bEnable, bool bCacheMissingFiles /*= false*/)
+{
+  EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
+
+  EZ_LOCK(s_Data->m_FsMutex);
+
+  s_Data->m_bFileLookupCacheEnabled = bEnable;
+  s_Data->m_bCacheMissingFiles = bCacheMissingFiles;
+  ClearFileLookupCache(GetDataDirectoryList());
+}
+
+bool ezFileSystem::IsFileLookupCacheEnabled()
+{
+  EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
+
+  return s_Data->m_bFileLookupCacheEnabled;
+}
+
+void ezFileSystem::InvalidateFileLookupCache()
+{
+  EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
+
+  DataDirectoryListReader reader;
+  ClearFileLookupCache(reader.GetList());
+}
+
 ezResult ezFileSystem::CreateDirectoryStructure(const char* szPath)
 {
   ezStringBuilder sRedir;
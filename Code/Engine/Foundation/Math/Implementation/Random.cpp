@@ -32,6 +32,23 @@ void ezRandom::Initialize(ezUInt64 uiSeed)
   }
 }
 
+void ezRandom::InitializeFromHashedSeed(ezUInt64 uiSeed)
+{
+  m_uiIndex = 0;
+
+  for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(m_uiState); i += 2)
+  {
+    // SplitMix64, see http://xoshiro.di.unimi.it/splitmix64.c
+    uiSeed += 0x9E3779B97F4A7C15ull;
+    ezUInt64 z = uiSeed;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z = z ^ (z >> 31);
+
+    m_uiState[i + 0] = z & 0xFFFFFFFF;
+    m_uiState[i + 1] = (z >> 32) & 0xFFFFFFFF;
+  }
+}
 
 void ezRandom::InitializeFromCurrentTime()
 {
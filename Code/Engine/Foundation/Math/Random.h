@@ -17,6 +17,12 @@ public:
   /// Not very sophisticated, but good enough for things that do not need to be secure.
   void InitializeFromCurrentTime();
 
+  /// \brief Initializes the RNG by scrambling the seed with SplitMix64, which is much cheaper than Initialize().
+  ///
+  /// Seeds that only differ in a few bits still result in unrelated sequences, so no warm-up is done.
+  /// Use this when many short lived RNGs are created from similar seeds, e.g. one per batch of work items.
+  void InitializeFromHashedSeed(ezUInt64 uiSeed); // [tested]
+
   /// \brief Serializes the current state
   void Save(ezStreamWriter& stream) const; // [tested]
 
@@ -92,7 +92,7 @@ void ezTaskSystem::ParallelForIndexed(
   if (uiMultiplicity == 0)
   {
     IndexedTask indexedTask(uiStartIndex, uiNumItems, std::move(taskCallback), uiItemsPerInvocation);
-    indexedTask.ConfigureTask(taskName ? taskName : "Generic Indexed Task", ezTaskNesting::Never);
+    indexedTask.ConfigureTask(taskName ? taskName : "Generic Indexed Task", params.nestingMode);
 
     EZ_PROFILE_SCOPE(indexedTask.m_sTaskName);
     indexedTask.Execute();
@@ -102,7 +102,7 @@ void ezTaskSystem::ParallelForIndexed(
     ezAllocatorBase* pAllocator = (params.pTaskAllocator != nullptr) ? params.pTaskAllocator : ezFoundation::GetDefaultAllocator();
 
     ezSharedPtr<IndexedTask> pIndexedTask = EZ_NEW(pAllocator, IndexedTask, uiStartIndex, uiNumItems, std::move(taskCallback), uiItemsPerInvocation);
-    pIndexedTask->ConfigureTask(taskName ? taskName : "Generic Indexed Task", ezTaskNesting::Never);
+    pIndexedTask->ConfigureTask(taskName ? taskName : "Generic Indexed Task", params.nestingMode);
 
     pIndexedTask->SetMultiplicity(uiMultiplicity);
     ezTaskGroupID taskGroupId = ezTaskSystem::StartSingleTask(pIndexedTask, ezTaskPriority::EarlyThisFrame);
@@ -2,7 +2,7 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/HybridArray.h>
-#include <Foundation/Math/Declarations.h>
+#include <Foundation/Math/Color.h>
 
 class ezStreamWriter;
 class ezStreamReader;
@@ -114,6 +114,30 @@ public:
   /// \brief Evaluates only the intensity curve.
   void EvaluateIntensity(double x, float& intensity) const;
 
+  /// \brief Evaluates the curve at all given x-coordinates and returns RGBA and intensity combined, like the single value Evaluate().
+  ///
+  /// If CreateBakedLookupTable() was called, the colors are interpolated from the lookup table, otherwise every position is evaluated
+  /// exactly.
+  void Evaluate(ezArrayPtr<const float> positions, ezArrayPtr<ezColor> out_Hdr) const;
+
+  /// \brief Same as the batch Evaluate(), but ignores the intensity curve.
+  void EvaluateColorAndAlpha(ezArrayPtr<const float> positions, ezArrayPtr<ezColor> out_Rgba) const;
+
+  /// \brief Samples color, alpha and intensity at \a uiNumSamples evenly spaced positions into a lookup table, which is used by the
+  /// batch evaluation functions.
+  ///
+  /// Clear(), SortControlPoints() and Load() discard the lookup table, so it has to be baked again after every modification.
+  void CreateBakedLookupTable(ezUInt32 uiNumSamples = 256);
+
+  /// \brief Whether CreateBakedLookupTable() was called since the last modification.
+  bool HasBakedLookupTable() const { return !m_BakedColors.IsEmpty(); }
+
+  /// \brief Whether two color, alpha or intensity control points are closer together than two samples of a lookup table with
+  /// \a uiNumSamples samples.
+  ///
+  /// Interpolating the lookup table would smooth out such steps, so these gradients should not be baked.
+  bool HasStepKeys(ezUInt32 uiNumSamples) const;
+
   /// \brief How much heap memory the curve uses.
   ezUInt64 GetHeapMemoryUsage() const;
 
@@ -125,8 +149,14 @@ public:
 
 private:
   void PrecomputeLerpNormalizer();
+  void EvaluateBatch(ezArrayPtr<const float> positions, ezArrayPtr<ezColor> out_Colors, bool bApplyIntensity) const;
 
   ezHybridArray<ColorCP, 8> m_ColorCPs;
   ezHybridArray<AlphaCP, 8> m_AlphaCPs;
   ezHybridArray<IntensityCP, 8> m_IntensityCPs;
+
+  float m_fBakedMinX = 0.0f;
+  float m_fBakedInvStepX = 0.0f;
+  ezDynamicArray<ezColor> m_BakedColors;
+  ezDynamicArray<float> m_BakedIntensities;
 };
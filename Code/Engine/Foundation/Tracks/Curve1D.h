@@ -101,6 +101,12 @@ public:
   /// \sa CreateLinearApproximation
   double Evaluate(double position) const;
 
+  /// \brief Evaluates the curve at all given positions and writes the Y values to \a out_Values.
+  ///
+  /// If CreateBakedLookupTable() was called, four values at a time are interpolated from the lookup table.
+  /// Otherwise every position is evaluated like with the single value Evaluate().
+  void Evaluate(ezArrayPtr<const float> positions, ezArrayPtr<float> out_Values) const;
+
   /// \brief Takes the normalized x coordinate [0;1] and converts it into a valid position on the curve
   ///
   /// \note This only works when the curve extents are available. See QueryExtents() and RecomputeExtents().
@@ -130,6 +136,21 @@ public:
 
   const ezHybridArray<ezVec2d, 24>& GetLinearApproximation() const { return m_LinearApproximation; }
 
+  /// \brief Samples the curve at \a uiNumSamples evenly spaced positions into a lookup table, which is used by the batch Evaluate().
+  ///
+  /// \note The linear approximation must have been computed first. Clear() and CreateLinearApproximation() discard the lookup table,
+  /// so it has to be baked again after every modification.
+  void CreateBakedLookupTable(ezUInt32 uiNumSamples = 256);
+
+  /// \brief Whether CreateBakedLookupTable() was called since the last modification.
+  bool HasBakedLookupTable() const { return !m_BakedLookupTable.IsEmpty(); }
+
+  /// \brief Whether two control points are closer together than two samples of a lookup table with \a uiNumSamples samples.
+  ///
+  /// Interpolating the lookup table would smooth out such steps, so these curves should not be baked.
+  /// \note The linear approximation must have been computed first.
+  bool HasStepKeys(ezUInt32 uiNumSamples) const;
+
   /// \brief Adjusts the tangents such that the curve cannot make loopings
   void ClampTangents();
 
@@ -163,4 +184,8 @@ private:
   double m_fMinY, m_fMaxY;
   ezHybridArray<ControlPoint, 8> m_ControlPoints;
   ezHybridArray<ezVec2d, 24> m_LinearApproximation;
+
+  float m_fBakedMinX = 0.0f;
+  float m_fBakedInvStepX = 0.0f;
+  ezDynamicArray<float> m_BakedLookupTable;
 };
@@ -1,6 +1,7 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/IO/Stream.h>
+#include <Foundation/SimdMath/SimdVec4i.h>
 #include <Foundation/Tracks/ColorGradient.h>
 
 ezColorGradient::ezColorGradient()
@@ -14,6 +15,8 @@ void ezColorGradient::Clear()
   m_ColorCPs.Clear();
   m_AlphaCPs.Clear();
   m_IntensityCPs.Clear();
+  m_BakedColors.Clear();
+  m_BakedIntensities.Clear();
 }
 
 
@@ -85,6 +88,9 @@ void ezColorGradient::SortControlPoints()
   m_IntensityCPs.Sort();
 
   PrecomputeLerpNormalizer();
+
+  m_BakedColors.Clear();
+  m_BakedIntensities.Clear();
 }
 
 void ezColorGradient::PrecomputeLerpNormalizer()
@@ -318,9 +324,165 @@ void ezColorGradient::EvaluateIntensity(double x, float& intensity) const
   }
 }
 
+void ezColorGradient::Evaluate(ezArrayPtr<const float> positions, ezArrayPtr<ezColor> out_Hdr) const
+{
+  EvaluateBatch(positions, out_Hdr, true);
+}
+
+void ezColorGradient::EvaluateColorAndAlpha(ezArrayPtr<const float> positions, ezArrayPtr<ezColor> out_Rgba) const
+{
+  EvaluateBatch(positions, out_Rgba, false);
+}
+
+void ezColorGradient::EvaluateBatch(ezArrayPtr<const float> positions, ezArrayPtr<ezColor> out_Colors, bool bApplyIntensity) const
+{
+  EZ_ASSERT_DEBUG(positions.GetCount() == out_Colors.GetCount(), "Number of positions and output colors must be identical");
+
+  const ezUInt32 uiNumValues = positions.GetCount();
+
+  if (m_BakedColors.IsEmpty())
+  {
+    for (ezUInt32 i = 0; i < uiNumValues; ++i)
+    {
+      ezColor& rgba = out_Colors[i];
+      ezUInt8 alpha;
+
+      EvaluateColor(positions[i], rgba);
+      EvaluateAlpha(positions[i], alpha);
+
+      if (bApplyIntensity)
+      {
+        float intensity;
+        EvaluateIntensity(positions[i], intensity);
+        rgba.ScaleRGB(intensity);
+      }
+
+      rgba.a = ezMath::ColorByteToFloat(alpha);
+    }
+
+    return;
+  }
+
+  const ezColor* pColors = m_BakedColors.GetData();
+  const float* pIntensities = m_BakedIntensities.GetData();
+  const ezSimdVec4f vMinX(m_fBakedMinX);
+  const ezSimdVec4f vInvStepX(m_fBakedInvStepX);
+  const ezSimdVec4f vMaxIndex((float)(m_BakedColors.GetCount() - 2));
+  const ezSimdVec4f vZero = ezSimdVec4f::ZeroVector();
+
+  for (ezUInt32 i = 0; i < uiNumValues; i += 4)
+  {
+    const ezUInt32 uiBlockSize = ezMath::Min(uiNumValues - i, 4u);
+
+    // the last block is padded by repeating the last position
+    float pos[4];
+    for (ezUInt32 j = 0; j < 4; ++j)
+    {
+      pos[j] = positions[i + ezMath::Min(j, uiBlockSize - 1)];
+    }
+
+    ezSimdVec4f vPos;
+    vPos.Load<4>(pos);
+
+    const ezSimdVec4f vSample = (vPos - vMinX).CompMul(vInvStepX).CompMax(vZero).CompMin(vMaxIndex);
+    const ezSimdVec4i vIndex = ezSimdVec4i::Truncate(vSample);
+
+    float fraction[4];
+    (vSample - vIndex.ToFloat()).Store<4>(fraction);
+
+    const ezInt32 index[4] = {vIndex.x(), vIndex.y(), vIndex.z(), vIndex.w()};
+
+    // interpolate all four channels at once, the table has one more entry than samples, so the right neighbor is always valid
+    for (ezUInt32 j = 0; j < uiBlockSize; ++j)
+    {
+      ezSimdVec4f vLeft, vRight;
+      vLeft.Load<4>(&pColors[index[j]].r);
+      vRight.Load<4>(&pColors[index[j] + 1].r);
+
+      ezSimdVec4f vColor = ezSimdVec4f::Lerp(vLeft, vRight, ezSimdVec4f(fraction[j]));
+
+      if (bApplyIntensity)
+      {
+        const float fIntensity = ezMath::Lerp(pIntensities[index[j]], pIntensities[index[j] + 1], fraction[j]);
+        vColor = vColor.CompMul(ezSimdVec4f(fIntensity, fIntensity, fIntensity, 1.0f));
+      }
+
+      vColor.Store<4>(&out_Colors[i + j].r);
+    }
+  }
+}
+
+void ezColorGradient::CreateBakedLookupTable(ezUInt32 uiNumSamples /*= 256*/)
+{
+  EZ_ASSERT_DEV(uiNumSamples >= 2, "The lookup table needs at least two samples");
+
+  double fMinX, fMaxX;
+  if (!GetExtents(fMinX, fMaxX))
+  {
+    fMinX = 0;
+    fMaxX = 0;
+  }
+
+  const double fStepX = (fMaxX - fMinX) / (uiNumSamples - 1);
+
+  m_fBakedMinX = (float)fMinX;
+  m_fBakedInvStepX = fStepX > 0 ? (float)(1.0 / fStepX) : 0.0f;
+
+  // duplicate the last sample, so that interpolating at the right end never reads past the table
+  m_BakedColors.SetCountUninitialized(uiNumSamples + 1);
+  m_BakedIntensities.SetCountUninitialized(uiNumSamples + 1);
+
+  for (ezUInt32 i = 0; i < uiNumSamples; ++i)
+  {
+    const double x = fMinX + i * fStepX;
+
+    ezColor& rgba = m_BakedColors[i];
+    ezUInt8 alpha;
+
+    EvaluateColor(x, rgba);
+    EvaluateAlpha(x, alpha);
+    EvaluateIntensity(x, m_BakedIntensities[i]);
+
+    rgba.a = ezMath::ColorByteToFloat(alpha);
+  }
+
+  m_BakedColors[uiNumSamples] = m_BakedColors[uiNumSamples - 1];
+  m_BakedIntensities[uiNumSamples] = m_BakedIntensities[uiNumSamples - 1];
+}
+
+namespace
+{
+  template <typename ControlPoints>
+  bool HasControlPointsCloserThan(const ControlPoints& controlPoints, double fMinDistance)
+  {
+    for (ezUInt32 i = 1; i < controlPoints.GetCount(); ++i)
+    {
+      if (controlPoints[i].m_PosX - controlPoints[i - 1].m_PosX < fMinDistance)
+        return true;
+    }
+
+    return false;
+  }
+} // namespace
+
+bool ezColorGradient::HasStepKeys(ezUInt32 uiNumSamples) const
+{
+  EZ_ASSERT_DEV(uiNumSamples >= 2, "The lookup table needs at least two samples");
+
+  double fMinX, fMaxX;
+  if (!GetExtents(fMinX, fMaxX))
+    return false;
+
+  const double fMinDistance = 2.0 * (fMaxX - fMinX) / (uiNumSamples - 1);
+
+  return HasControlPointsCloserThan(m_ColorCPs, fMinDistance) || HasControlPointsCloserThan(m_AlphaCPs, fMinDistance) ||
+         HasControlPointsCloserThan(m_IntensityCPs, fMinDistance);
+}
+
 ezUInt64 ezColorGradient::GetHeapMemoryUsage() const
 {
-  return m_ColorCPs.GetHeapMemoryUsage() + m_AlphaCPs.GetHeapMemoryUsage() + m_IntensityCPs.GetHeapMemoryUsage();
+  return m_ColorCPs.GetHeapMemoryUsage() + m_AlphaCPs.GetHeapMemoryUsage() + m_IntensityCPs.GetHeapMemoryUsage() + m_BakedColors.GetHeapMemoryUsage() +
+         m_BakedIntensities.GetHeapMemoryUsage();
 }
 
 void ezColorGradient::Save(ezStreamWriter& stream) const
@@ -427,6 +589,9 @@ void ezColorGradient::Load(ezStreamReader& stream)
   }
 
   PrecomputeLerpNormalizer();
+
+  m_BakedColors.Clear();
+  m_BakedIntensities.Clear();
 }
 
 
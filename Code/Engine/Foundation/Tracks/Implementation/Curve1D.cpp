@@ -1,6 +1,7 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/IO/Stream.h>
+#include <Foundation/SimdMath/SimdVec4i.h>
 #include <Foundation/Tracks/Curve1D.h>
 
 ezCurve1D::ControlPoint::ControlPoint()
@@ -24,6 +25,7 @@ void ezCurve1D::Clear()
   m_fMaxY = 0;
 
   m_ControlPoints.Clear();
+  m_BakedLookupTable.Clear();
 }
 
 bool ezCurve1D::IsEmpty() const
@@ -145,6 +147,60 @@ double ezCurve1D::Evaluate(double x) const
   return 0;
 }
 
+void ezCurve1D::Evaluate(ezArrayPtr<const float> positions, ezArrayPtr<float> out_Values) const
+{
+  EZ_ASSERT_DEBUG(positions.GetCount() == out_Values.GetCount(), "Number of positions and output values must be identical");
+
+  const ezUInt32 uiNumValues = positions.GetCount();
+
+  if (m_BakedLookupTable.IsEmpty())
+  {
+    for (ezUInt32 i = 0; i < uiNumValues; ++i)
+    {
+      out_Values[i] = (float)Evaluate(positions[i]);
+    }
+
+    return;
+  }
+
+  const float* pTable = m_BakedLookupTable.GetData();
+  const ezSimdVec4f vMinX(m_fBakedMinX);
+  const ezSimdVec4f vInvStepX(m_fBakedInvStepX);
+  const ezSimdVec4f vMaxIndex((float)(m_BakedLookupTable.GetCount() - 2));
+  const ezSimdVec4f vZero = ezSimdVec4f::ZeroVector();
+
+  for (ezUInt32 i = 0; i < uiNumValues; i += 4)
+  {
+    const ezUInt32 uiBlockSize = ezMath::Min(uiNumValues - i, 4u);
+
+    // the last block is padded by repeating the last position
+    float pos[4];
+    for (ezUInt32 j = 0; j < 4; ++j)
+    {
+      pos[j] = positions[i + ezMath::Min(j, uiBlockSize - 1)];
+    }
+
+    ezSimdVec4f vPos;
+    vPos.Load<4>(pos);
+
+    const ezSimdVec4f vSample = (vPos - vMinX).CompMul(vInvStepX).CompMax(vZero).CompMin(vMaxIndex);
+    const ezSimdVec4i vIndex = ezSimdVec4i::Truncate(vSample);
+    const ezSimdVec4f vFraction = vSample - vIndex.ToFloat();
+
+    // the table has one more entry than samples, so reading the right neighbor is always valid
+    const ezSimdVec4f vLeft(pTable[vIndex.x()], pTable[vIndex.y()], pTable[vIndex.z()], pTable[vIndex.w()]);
+    const ezSimdVec4f vRight(pTable[vIndex.x() + 1], pTable[vIndex.y() + 1], pTable[vIndex.z() + 1], pTable[vIndex.w() + 1]);
+
+    float res[4];
+    ezSimdVec4f::Lerp(vLeft, vRight, vFraction).Store<4>(res);
+
+    for (ezUInt32 j = 0; j < uiBlockSize; ++j)
+    {
+      out_Values[i + j] = res[j];
+    }
+  }
+}
+
 double ezCurve1D::ConvertNormalizedPos(double pos) const
 {
   double fMin, fMax;
@@ -167,7 +223,7 @@ double ezCurve1D::NormalizeValue(double value) const
 
 ezUInt64 ezCurve1D::GetHeapMemoryUsage() const
 {
-  return m_ControlPoints.GetHeapMemoryUsage();
+  return m_ControlPoints.GetHeapMemoryUsage() + m_BakedLookupTable.GetHeapMemoryUsage();
 }
 
 void ezCurve1D::Save(ezStreamWriter& stream) const
@@ -238,6 +294,7 @@ void ezCurve1D::Load(ezStreamReader& stream)
 void ezCurve1D::CreateLinearApproximation(double fMaxError /*= 0.01f*/, ezUInt8 uiMaxSubDivs /*= 8*/)
 {
   m_LinearApproximation.Clear();
+  m_BakedLookupTable.Clear();
 
   /// \todo Since we do this, we actually don't need the linear approximation anymore and could just evaluate the full curve
   ApplyTangentModes();
@@ -273,6 +330,47 @@ void ezCurve1D::CreateLinearApproximation(double fMaxError /*= 0.01f*/, ezUInt8
   RecomputeLinearApproxExtremes();
 }
 
+void ezCurve1D::CreateBakedLookupTable(ezUInt32 uiNumSamples /*= 256*/)
+{
+  EZ_ASSERT_DEV(uiNumSamples >= 2, "The lookup table needs at least two samples");
+  EZ_ASSERT_DEV(!m_LinearApproximation.IsEmpty(), "Cannot bake curve without precomputing curve approximation data first. Call "
+                                                  "CreateLinearApproximation() on curve before calling CreateBakedLookupTable().");
+
+  const double fMinX = m_LinearApproximation[0].x;
+  const double fMaxX = m_LinearApproximation.PeekBack().x;
+  const double fStepX = (fMaxX - fMinX) / (uiNumSamples - 1);
+
+  m_fBakedMinX = (float)fMinX;
+  m_fBakedInvStepX = fStepX > 0 ? (float)(1.0 / fStepX) : 0.0f;
+
+  // duplicate the last sample, so that interpolating at the right end never reads past the table
+  m_BakedLookupTable.SetCountUninitialized(uiNumSamples + 1);
+
+  for (ezUInt32 i = 0; i < uiNumSamples; ++i)
+  {
+    m_BakedLookupTable[i] = (float)Evaluate(fMinX + i * fStepX);
+  }
+
+  m_BakedLookupTable[uiNumSamples] = m_BakedLookupTable[uiNumSamples - 1];
+}
+
+bool ezCurve1D::HasStepKeys(ezUInt32 uiNumSamples) const
+{
+  EZ_ASSERT_DEV(uiNumSamples >= 2, "The lookup table needs at least two samples");
+  EZ_ASSERT_DEV(!m_LinearApproximation.IsEmpty(), "Cannot check for step keys without precomputing curve approximation data first. Call "
+                                                  "CreateLinearApproximation() on curve before calling HasStepKeys().");
+
+  const double fSampleSpacing = (m_LinearApproximation.PeekBack().x - m_LinearApproximation[0].x) / (uiNumSamples - 1);
+
+  for (ezUInt32 i = 1; i < m_ControlPoints.GetCount(); ++i)
+  {
+    if (m_ControlPoints[i].m_Position.x - m_ControlPoints[i - 1].m_Position.x < 2.0 * fSampleSpacing)
+      return true;
+  }
+
+  return false;
+}
+
 void ezCurve1D::RecomputeExtents()
 {
   m_fMinX = ezMath::MaxValue<float>();
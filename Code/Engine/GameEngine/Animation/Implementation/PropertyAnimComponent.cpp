@@ -629,7 +629,11 @@ void ezPropertyAnimComponent::ApplySingleFloatAnimation(const FloatBinding& bind
     if (curve.IsEmpty())
       return;
 
-    fFinalValue = curve.Evaluate(lookupTime.GetSeconds());
+    const float fLookupTime = lookupTime.AsFloatInSeconds();
+    float fValue = 0.0f;
+    curve.Evaluate(ezMakeArrayPtr(&fLookupTime, 1), ezMakeArrayPtr(&fValue, 1));
+
+    fFinalValue = fValue;
   }
 
   if (pRtti == ezGetStaticRTTI<bool>())
@@ -715,6 +719,7 @@ void ezPropertyAnimComponent::ApplyFloatAnimation(const FloatBinding& binding, e
   }
 
   // evaluate all available curves
+  const float fLookupTime = lookupTime.AsFloatInSeconds();
   for (ezUInt32 i = 0; i < 4; ++i)
   {
     if (binding.m_pAnimation[i] != nullptr)
@@ -723,7 +728,7 @@ void ezPropertyAnimComponent::ApplyFloatAnimation(const FloatBinding& binding, e
 
       if (!curve.IsEmpty())
       {
-        fCurValue[i] = (float)curve.Evaluate(lookupTime.GetSeconds());
+        curve.Evaluate(ezMakeArrayPtr(&fLookupTime, 1), ezMakeArrayPtr(&fCurValue[i], 1));
       }
     }
   }
@@ -761,23 +766,22 @@ void ezPropertyAnimComponent::ApplyColorAnimation(const ColorBinding& binding, e
 {
   const ezRTTI* pRtti = binding.m_pMemberProperty->GetSpecificType();
 
+  const float fLookupTime = lookupTime.AsFloatInSeconds();
+
   if (pRtti == ezGetStaticRTTI<ezColorGammaUB>())
   {
-    ezColorGammaUB gamma;
-    float intensity;
-    binding.m_pAnimation->m_Gradient.Evaluate(lookupTime.AsFloatInSeconds(), gamma, intensity);
+    ezColor rgba;
+    binding.m_pAnimation->m_Gradient.EvaluateColorAndAlpha(ezMakeArrayPtr(&fLookupTime, 1), ezMakeArrayPtr(&rgba, 1));
+
+    ezColorGammaUB gamma = rgba;
     binding.m_pMemberProperty->SetValuePtr(binding.m_pObject, &gamma);
     return;
   }
 
   if (pRtti == ezGetStaticRTTI<ezColor>())
   {
-    ezColorGammaUB gamma;
-    float intensity;
-    binding.m_pAnimation->m_Gradient.Evaluate(lookupTime.AsFloatInSeconds(), gamma, intensity);
-
-    ezColor finalColor = gamma;
-    finalColor.ScaleRGB(intensity);
+    ezColor finalColor;
+    binding.m_pAnimation->m_Gradient.Evaluate(ezMakeArrayPtr(&fLookupTime, 1), ezMakeArrayPtr(&finalColor, 1));
     binding.m_pMemberProperty->SetValuePtr(binding.m_pObject, &finalColor);
     return;
   }
@@ -141,6 +141,47 @@ void ezPropertyAnimResourceDescriptor::Save(ezStreamWriter& stream) const
   m_EventTrack.Save(stream);
 }
 
+namespace
+{
+  /// Longer curves are evaluated exactly instead of baking ever larger lookup tables.
+  constexpr ezUInt32 s_uiMaxBakedSamples = 4096;
+
+  /// Computes how many samples a lookup table for the range [fMinX; fMaxX] needs to have at least 60 samples per second,
+  /// so that fast changes are not smoothed out.
+  ezUInt32 ComputeNumBakedSamples(double fMinX, double fMaxX)
+  {
+    return ezMath::Max(static_cast<ezUInt32>(ezMath::Ceil((fMaxX - fMinX) * 60.0)) + 1, 256u);
+  }
+
+  void BakeCurve(ezCurve1D& curve)
+  {
+    const auto& approx = curve.GetLinearApproximation();
+    if (approx.IsEmpty())
+      return;
+
+    const ezUInt32 uiNumSamples = ComputeNumBakedSamples(approx[0].x, approx.PeekBack().x);
+
+    if (uiNumSamples > s_uiMaxBakedSamples || curve.HasStepKeys(uiNumSamples))
+      return;
+
+    curve.CreateBakedLookupTable(uiNumSamples);
+  }
+
+  void BakeGradient(ezColorGradient& gradient)
+  {
+    double fMinX, fMaxX;
+    if (!gradient.GetExtents(fMinX, fMaxX))
+      return;
+
+    const ezUInt32 uiNumSamples = ComputeNumBakedSamples(fMinX, fMaxX);
+
+    if (uiNumSamples > s_uiMaxBakedSamples || gradient.HasStepKeys(uiNumSamples))
+      return;
+
+    gradient.CreateBakedLookupTable(uiNumSamples);
+  }
+} // namespace
+
 void ezPropertyAnimResourceDescriptor::Load(ezStreamReader& stream)
 {
   ezUInt8 uiVersion = 0;
@@ -176,6 +217,9 @@ void ezPropertyAnimResourceDescriptor::Load(ezStreamReader& stream)
     anim.m_Curve.SortControlPoints();
     anim.m_Curve.CreateLinearApproximation();
 
+    // long curves and curves with step keys are not baked and get evaluated exactly instead
+    BakeCurve(anim.m_Curve);
+
     if (!anim.m_sComponentType.IsEmpty())
       anim.m_pComponentRtti = ezRTTI::FindTypeByName(anim.m_sComponentType);
   }
@@ -192,6 +236,7 @@ void ezPropertyAnimResourceDescriptor::Load(ezStreamReader& stream)
     stream >> anim.m_sPropertyPath;
     stream >> anim.m_Target;
     anim.m_Gradient.Load(stream);
+    BakeGradient(anim.m_Gradient);
 
     if (!anim.m_sComponentType.IsEmpty())
       anim.m_pComponentRtti = ezRTTI::FindTypeByName(anim.m_sComponentType);
@@ -3,13 +3,32 @@
 #include <GameEngine/GameEngineDLL.h>
 #include <RendererCore/AnimationSystem/AnimationGraph/AnimationClipSampler.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/LocalAnimationPose.h>
 #include <RendererCore/Meshes/SkinnedMeshComponent.h>
 
 struct ezSkeletonResourceDescriptor;
 typedef ezTypedResourceHandle<class ezAnimationClipResource> ezAnimationClipResourceHandle;
 typedef ezTypedResourceHandle<class ezSkeletonResource> ezSkeletonResourceHandle;
 
-typedef ezComponentManagerSimple<class ezAnimatedMeshComponent, ezComponentUpdateType::WhenSimulating> ezAnimatedMeshComponentManager;
+/// \brief Updates all animated meshes of a world.
+///
+/// Sampling the animation clips and computing the object space and skinning space poses only touches data of the component itself,
+/// so this is done for all components in parallel during the async phase. Everything that modifies the world, ie. sending
+/// ezMsgAnimationPoseUpdated, debug visualization and applying root motion, is done serially in the post async phase afterwards.
+///
+/// Note that this used to happen in the pre async phase. Root motion still moves the owner before the transforms of the frame are
+/// updated, but components that update in the pre async or async phase now see the pose and owner position of the previous frame.
+class EZ_GAMEENGINE_DLL ezAnimatedMeshComponentManager : public ezComponentManager<class ezAnimatedMeshComponent, ezBlockStorageType::FreeList>
+{
+public:
+  ezAnimatedMeshComponentManager(ezWorld* pWorld);
+
+  virtual void Initialize() override;
+
+private:
+  void UpdatePoses(const ezWorldModule::UpdateContext& context);
+  void ApplyPoses(const ezWorldModule::UpdateContext& context);
+};
 
 class EZ_GAMEENGINE_DLL ezAnimatedMeshComponent : public ezSkinnedMeshComponent
 {
@@ -48,14 +67,25 @@ public:
 
 
 protected:
-  void Update();
+  /// \brief Samples the animation, computes the new pose and writes the skinning matrices for the renderer into a frame allocated array.
+  /// Only modifies data of this component and may run on any thread.
+  void UpdatePose();
+
+  /// \brief Informs other components about the new pose and applies root motion.
+  void ApplyPose();
+
   void CreatePhysicsShapes(const ezSkeletonResourceDescriptor& skeleton, const ezAnimationPose& pose);
 
   void* m_pRagdoll = nullptr;
 
   bool m_bApplyRootMotion = false;
   bool m_bVisualizeSkeleton = false;
-  ezAnimationPose m_AnimationPose;
+  bool m_bPoseUpdated = false; ///< Set by UpdatePose() when m_AnimationPose and m_SkinningMatrices hold a new pose that ApplyPose() needs to use
+  ezAnimationPose m_AnimationPose; ///< In object space
+  ezTransform m_RootMotion;
+  ezLocalAnimationPose m_LocalPose;
+  ezLocalAnimationPose m_BindPose;
+  ezUInt32 m_uiBindPoseRevision = 0; ///< Revision of the skeleton that m_BindPose was created from
   ezSkeletonResourceHandle m_hSkeleton;
   ezAnimationClipSampler m_AnimationClipSampler;
 };
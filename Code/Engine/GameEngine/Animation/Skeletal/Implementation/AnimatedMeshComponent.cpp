@@ -82,20 +82,11 @@ void ezAnimatedMeshComponent::OnSimulationStarted()
 
     CreatePhysicsShapes(pSkeleton->GetDescriptor(), m_AnimationPose);
 
-    m_AnimationPose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
+    ezDynamicArray<ezShaderTransform> skinningTransforms;
+    skinningTransforms.SetCount(m_AnimationPose.GetTransformCount());
+    m_AnimationPose.ComputeSkinningTransforms(skeleton, skinningTransforms);
 
-    // m_SkinningMatrices = m_AnimationPose.GetAllTransforms();
-
-    // Create the buffer for the skinning matrices
-    ezGALBufferCreationDescription BufferDesc;
-    BufferDesc.m_uiStructSize = sizeof(ezMat4);
-    BufferDesc.m_uiTotalSize = BufferDesc.m_uiStructSize * m_AnimationPose.GetTransformCount();
-    BufferDesc.m_bUseAsStructuredBuffer = true;
-    BufferDesc.m_bAllowShaderResourceView = true;
-    BufferDesc.m_ResourceAccess.m_bImmutable = false;
-
-    m_hSkinningTransformsBuffer = ezGALDevice::GetDefaultDevice()->CreateBuffer(
-      BufferDesc, ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(m_AnimationPose.GetAllTransforms().GetPtr()), BufferDesc.m_uiTotalSize));
+    CreateSkinningTransformBuffer(skinningTransforms);
   }
 
   m_AnimationClipSampler.RestartAnimation();
@@ -152,30 +143,64 @@ void ezAnimatedMeshComponent::SetAnimationSpeed(float speed)
   m_AnimationClipSampler.SetPlaybackSpeed(speed);
 }
 
-void ezAnimatedMeshComponent::Update()
+void ezAnimatedMeshComponent::UpdatePose()
 {
+  m_bPoseUpdated = false;
+
   if (!m_AnimationClipSampler.GetAnimationClip().IsValid() || !m_hSkeleton.IsValid())
     return;
 
   ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
   const ezSkeleton& skeleton = pSkeleton->GetDescriptor().m_Skeleton;
 
-  ezTransform rootMotion;
-  rootMotion.SetIdentity();
+  m_RootMotion.SetIdentity();
 
-  m_AnimationPose.SetToBindPoseInLocalSpace(skeleton);
+  if (m_uiBindPoseRevision != skeleton.GetRevision())
+  {
+    m_BindPose.Configure(skeleton);
+    m_uiBindPoseRevision = skeleton.GetRevision();
+  }
+
+  m_LocalPose = m_BindPose;
   m_AnimationClipSampler.Step(GetWorld()->GetClock().GetTimeDiff());
-  m_AnimationClipSampler.Execute(skeleton, m_AnimationPose, &rootMotion);
+  m_AnimationClipSampler.Execute(skeleton, m_LocalPose, &m_RootMotion);
+  m_LocalPose.ConvertToMatrices(m_AnimationPose);
 
   m_AnimationPose.ConvertFromLocalSpaceToObjectSpace(skeleton);
 
+  // The object space pose is still needed for ezMsgAnimationPoseUpdated, so the skinning transforms are written directly into the
+  // frame allocated array that is handed to the renderer. The frame allocator is thread-safe.
+  ezArrayPtr<ezShaderTransform> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezShaderTransform, m_AnimationPose.GetTransformCount());
+  m_AnimationPose.ComputeSkinningTransforms(skeleton, pRenderMatrices);
+
+  m_SkinningMatrices = pRenderMatrices;
+
+  m_bPoseUpdated = true;
+}
+
+void ezAnimatedMeshComponent::ApplyPose()
+{
+  if (!m_bPoseUpdated)
+    return;
+
+  m_bPoseUpdated = false;
+
+  ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
+  const ezSkeleton& skeleton = pSkeleton->GetDescriptor().m_Skeleton;
+
+  // the skeleton may have been reloaded in between, the pose doesn't fit it anymore in that case
+  if (skeleton.GetRevision() != m_uiBindPoseRevision)
+  {
+    m_SkinningMatrices = {};
+    return;
+  }
+
   if (m_bVisualizeSkeleton)
   {
     m_AnimationPose.VisualizePose(GetWorld(), skeleton, GetOwner()->GetGlobalTransform());
   }
 
   // inform child nodes/components that a new skinning pose is available
-  // do this before the pose is transformed into skinning space
   {
     ezMsgAnimationPoseUpdated msg;
     msg.m_pSkeleton = &skeleton;
@@ -184,20 +209,13 @@ void ezAnimatedMeshComponent::Update()
     GetOwner()->SendMessageRecursive(msg);
   }
 
-  m_AnimationPose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
-
-  ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, m_AnimationPose.GetTransformCount());
-  ezMemoryUtils::Copy(pRenderMatrices.GetPtr(), m_AnimationPose.GetAllTransforms().GetPtr(), m_AnimationPose.GetTransformCount());
-
-  m_SkinningMatrices = pRenderMatrices;
-
   if (m_bApplyRootMotion)
   {
     auto* pOwner = GetOwner();
 
     const ezQuat qOldRot = pOwner->GetLocalRotation();
-    const ezVec3 vNewPos = qOldRot * (rootMotion.m_vPosition * pOwner->GetGlobalScaling().x) + pOwner->GetLocalPosition();
-    const ezQuat qNewRot = rootMotion.m_qRotation * qOldRot;
+    const ezVec3 vNewPos = qOldRot * (m_RootMotion.m_vPosition * pOwner->GetGlobalScaling().x) + pOwner->GetLocalPosition();
+    const ezQuat qNewRot = m_RootMotion.m_qRotation * qOldRot;
 
     pOwner->SetLocalPosition(vNewPos);
     pOwner->SetLocalRotation(qNewRot);
@@ -216,6 +234,55 @@ void ezAnimatedMeshComponent::CreatePhysicsShapes(const ezSkeletonResourceDescri
 
 //////////////////////////////////////////////////////////////////////////
 
+ezAnimatedMeshComponentManager::ezAnimatedMeshComponentManager(ezWorld* pWorld)
+  : ezComponentManager<class ezAnimatedMeshComponent, ezBlockStorageType::FreeList>(pWorld)
+{
+}
+
+void ezAnimatedMeshComponentManager::Initialize()
+{
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimatedMeshComponentManager::UpdatePoses, this);
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::Async;
+    desc.m_uiGranularity = 16;
+
+    RegisterUpdateFunction(desc);
+  }
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimatedMeshComponentManager::ApplyPoses, this);
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PostAsync;
+
+    RegisterUpdateFunction(desc);
+  }
+}
+
+void ezAnimatedMeshComponentManager::UpdatePoses(const ezWorldModule::UpdateContext& context)
+{
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    if (it->IsActiveAndInitialized())
+    {
+      it->UpdatePose();
+    }
+  }
+}
+
+void ezAnimatedMeshComponentManager::ApplyPoses(const ezWorldModule::UpdateContext& context)
+{
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    if (it->IsActiveAndInitialized())
+    {
+      it->ApplyPose();
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 #include <Foundation/Serialization/GraphPatch.h>
 
 class ezAnimatedMeshComponentPatch_4_5 : public ezGraphPatch
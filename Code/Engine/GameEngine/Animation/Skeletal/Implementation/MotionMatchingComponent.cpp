@@ -70,20 +70,12 @@ void ezMotionMatchingComponent::OnSimulationStarted()
     const ezSkeleton& skeleton = pSkeleton->GetDescriptor().m_Skeleton;
     m_AnimationPose.Configure(skeleton);
     m_AnimationPose.ConvertFromLocalSpaceToObjectSpace(skeleton);
-    m_AnimationPose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
 
-    // m_SkinningMatrices = m_AnimationPose.GetAllTransforms();
+    ezDynamicArray<ezShaderTransform> skinningTransforms;
+    skinningTransforms.SetCount(m_AnimationPose.GetTransformCount());
+    m_AnimationPose.ComputeSkinningTransforms(skeleton, skinningTransforms);
 
-    // Create the buffer for the skinning matrices
-    ezGALBufferCreationDescription BufferDesc;
-    BufferDesc.m_uiStructSize = sizeof(ezMat4);
-    BufferDesc.m_uiTotalSize = BufferDesc.m_uiStructSize * m_AnimationPose.GetTransformCount();
-    BufferDesc.m_bUseAsStructuredBuffer = true;
-    BufferDesc.m_bAllowShaderResourceView = true;
-    BufferDesc.m_ResourceAccess.m_bImmutable = false;
-
-    m_hSkinningTransformsBuffer = ezGALDevice::GetDefaultDevice()->CreateBuffer(
-      BufferDesc, ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(m_AnimationPose.GetAllTransforms().GetPtr()), BufferDesc.m_uiTotalSize));
+    CreateSkinningTransformBuffer(skinningTransforms);
   }
 
   // m_AnimationClipSampler.RestartAnimation();
@@ -96,12 +88,18 @@ void ezMotionMatchingComponent::OnSimulationStarted()
   m_Keyframe1.m_uiAnimClip = 0;
   m_Keyframe1.m_uiKeyframe = 1;
 
-  for (ezUInt32 anim = 0; anim < m_Animations.GetCount(); ++anim)
   {
-    ezResourceLock<ezAnimationClipResource> pClip(m_Animations[anim], ezResourceAcquireMode::BlockTillLoaded);
-    ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
+    ezDynamicArray<ezMotionMatchingDatabase::Frame> motionData;
+
+    for (ezUInt32 anim = 0; anim < m_Animations.GetCount(); ++anim)
+    {
+      ezResourceLock<ezAnimationClipResource> pClip(m_Animations[anim], ezResourceAcquireMode::BlockTillLoaded);
+      ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::AllowLoadingFallback);
+
+      PrecomputeMotion(motionData, "Bip01_L_Foot", "Bip01_R_Foot", pClip->GetDescriptor(), anim, pSkeleton->GetDescriptor().m_Skeleton);
+    }
 
-    PrecomputeMotion(m_MotionData, "Bip01_L_Foot", "Bip01_R_Foot", pClip->GetDescriptor(), anim, pSkeleton->GetDescriptor().m_Skeleton);
+    m_MotionDatabase.Build(motionData);
   }
 
   m_vLeftFootPos.SetZero();
@@ -228,11 +226,8 @@ void ezMotionMatchingComponent::Update()
       const ezUInt16 uiSkeletonJointIdx = skeleton.FindJointByName(sJointName);
       if (uiSkeletonJointIdx != ezInvalidJointIndex)
       {
-        ezArrayPtr<const ezTransform> pTransforms0 = animDesc0.GetJointKeyframes(uiAnimJointIdx0);
-        ezArrayPtr<const ezTransform> pTransforms1 = animDesc1.GetJointKeyframes(uiAnimJointIdx1);
-
-        const ezTransform jointTransform1 = pTransforms0[m_Keyframe0.m_uiKeyframe];
-        const ezTransform jointTransform2 = pTransforms1[m_Keyframe1.m_uiKeyframe];
+        const ezTransform jointTransform1 = animDesc0.GetJointKeyframe(static_cast<ezUInt16>(uiAnimJointIdx0), m_Keyframe0.m_uiKeyframe);
+        const ezTransform jointTransform2 = animDesc1.GetJointKeyframe(static_cast<ezUInt16>(uiAnimJointIdx1), m_Keyframe1.m_uiKeyframe);
 
         ezTransform res;
         res.m_vPosition = ezMath::Lerp(jointTransform1.m_vPosition, jointTransform2.m_vPosition, m_fKeyframeLerp);
@@ -252,9 +247,9 @@ void ezMotionMatchingComponent::Update()
       vRootMotion1.SetZero();
 
       if (animDesc0.HasRootMotion())
-        vRootMotion0 = animDesc0.GetJointKeyframes(animDesc0.GetRootMotionJoint())[m_Keyframe0.m_uiKeyframe].m_vPosition;
+        vRootMotion0 = animDesc0.GetJointKeyframe(animDesc0.GetRootMotionJoint(), m_Keyframe0.m_uiKeyframe).m_vPosition;
       if (animDesc1.HasRootMotion())
-        vRootMotion1 = animDesc1.GetJointKeyframes(animDesc1.GetRootMotionJoint())[m_Keyframe1.m_uiKeyframe].m_vPosition;
+        vRootMotion1 = animDesc1.GetJointKeyframe(animDesc1.GetRootMotionJoint(), m_Keyframe1.m_uiKeyframe).m_vPosition;
 
       const ezVec3 vRootMotion = ezMath::Lerp(vRootMotion0, vRootMotion1, m_fKeyframeLerp) * fKeyframeFraction * pOwner->GetGlobalScaling().x;
 
@@ -293,10 +288,9 @@ void ezMotionMatchingComponent::Update()
     m_vRightFootPos = tRight.m_vPosition;
   }
 
-  m_AnimationPose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
-
-  ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, m_AnimationPose.GetTransformCount());
-  ezMemoryUtils::Copy(pRenderMatrices.GetPtr(), m_AnimationPose.GetAllTransforms().GetPtr(), m_AnimationPose.GetTransformCount());
+  // write the skinning transforms directly into the frame allocated array that is handed to the renderer
+  ezArrayPtr<ezShaderTransform> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezShaderTransform, m_AnimationPose.GetTransformCount());
+  m_AnimationPose.ComputeSkinningTransforms(skeleton, pRenderMatrices);
 
   m_SkinningMatrices = pRenderMatrices;
 }
@@ -373,15 +367,25 @@ ezMotionMatchingComponent::TargetKeyframe ezMotionMatchingComponent::FindNextKey
     const ezVec3 vLeftFootPos = m_vLeftFootPos;   // animClip.GetJointKeyframes(uiLeftFootJoint)[current.m_uiKeyframe].m_vPosition;
     const ezVec3 vRightFootPos = m_vRightFootPos; // animClip.GetJointKeyframes(uiRightFootJoint)[current.m_uiKeyframe].m_vPosition;
 
-    const ezUInt32 uiBestMM = FindBestKeyframe(current, vLeftFootPos, vRightFootPos, vTargetDir);
+    ezMotionMatchingDatabase::Query query;
+    query.m_uiCurrentAnimClip = current.m_uiAnimClip;
+    query.m_uiCurrentKeyframe = current.m_uiKeyframe;
+    query.m_vLeftFootPosition = vLeftFootPos;
+    query.m_vRightFootPosition = vRightFootPos;
+    query.m_vTargetDir = vTargetDir;
 
-    TargetKeyframe nkf;
-    nkf.m_uiAnimClip = m_MotionData[uiBestMM].m_uiAnimClipIndex;
-    nkf.m_uiKeyframe = m_MotionData[uiBestMM].m_uiKeyframeIndex;
+    const ezUInt32 uiBestMM = m_MotionDatabase.FindBestFrame(query);
 
-    if ((nkf.m_uiAnimClip != kf.m_uiAnimClip) || (nkf.m_uiKeyframe != kf.m_uiKeyframe && nkf.m_uiKeyframe != current.m_uiKeyframe))
+    if (uiBestMM != ezInvalidIndex)
     {
-      kf = nkf;
+      TargetKeyframe nkf;
+      nkf.m_uiAnimClip = m_MotionDatabase.GetFrame(uiBestMM).m_uiAnimClipIndex;
+      nkf.m_uiKeyframe = m_MotionDatabase.GetFrame(uiBestMM).m_uiKeyframeIndex;
+
+      if ((nkf.m_uiAnimClip != kf.m_uiAnimClip) || (nkf.m_uiKeyframe != kf.m_uiKeyframe && nkf.m_uiKeyframe != current.m_uiKeyframe))
+      {
+        kf = nkf;
+      }
     }
   }
 
@@ -396,7 +400,7 @@ ezMotionMatchingComponent::TargetKeyframe ezMotionMatchingComponent::FindNextKey
   return kf;
 }
 
-void ezMotionMatchingComponent::PrecomputeMotion(ezDynamicArray<MotionData>& motionData, ezTempHashedString jointName1, ezTempHashedString jointName2,
+void ezMotionMatchingComponent::PrecomputeMotion(ezDynamicArray<ezMotionMatchingDatabase::Frame>& motionData, ezTempHashedString jointName1, ezTempHashedString jointName2,
   const ezAnimationClipResourceDescriptor& animClip, ezUInt16 uiAnimClipIndex, const ezSkeleton& skeleton)
 {
   const ezUInt16 uiRootJoint = animClip.HasRootMotion() ? animClip.GetRootMotionJoint() : 0xFFFFu;
@@ -427,7 +431,7 @@ void ezMotionMatchingComponent::PrecomputeMotion(ezDynamicArray<MotionData>& mot
       const ezUInt16 uiJointIndexInPose = skeleton.FindJointByName(jointNamesToIndices.GetKey(b));
       if (uiJointIndexInPose != ezInvalidJointIndex)
       {
-        const ezTransform jointTransform = animClip.GetJointKeyframes(jointNamesToIndices.GetValue(b))[uiFrameIdx];
+        const ezTransform jointTransform = animClip.GetJointKeyframe(jointNamesToIndices.GetValue(b), uiFrameIdx);
 
         pose.SetTransform(uiJointIndexInPose, jointTransform.GetAsMat4());
       }
@@ -435,7 +439,7 @@ void ezMotionMatchingComponent::PrecomputeMotion(ezDynamicArray<MotionData>& mot
 
     pose.ConvertFromLocalSpaceToObjectSpace(skeleton);
 
-    MotionData& md = motionData.ExpandAndGetRef();
+    ezMotionMatchingDatabase::Frame& md = motionData.ExpandAndGetRef();
     md.m_vLeftFootPosition = pose.GetTransform(uiJoint1IndexInSkeleton).GetTranslationVector();
     md.m_vRightFootPosition = pose.GetTransform(uiJoint2IndexInSkeleton).GetTranslationVector();
     md.m_uiAnimClipIndex = uiAnimClipIndex;
@@ -443,7 +447,7 @@ void ezMotionMatchingComponent::PrecomputeMotion(ezDynamicArray<MotionData>& mot
     md.m_vLeftFootVelocity.SetZero();
     md.m_vRightFootVelocity.SetZero();
     md.m_vRootVelocity =
-      animClip.HasRootMotion() ? fRootMotionToVelocity * animClip.GetJointKeyframes(uiRootJoint)[uiFrameIdx].m_vPosition : ezVec3::ZeroVector();
+      animClip.HasRootMotion() ? fRootMotionToVelocity * animClip.GetJointKeyframe(uiRootJoint, uiFrameIdx).m_vPosition : ezVec3::ZeroVector();
   }
 
   // now compute the velocity
@@ -468,52 +472,4 @@ void ezMotionMatchingComponent::PrecomputeMotion(ezDynamicArray<MotionData>& mot
   }
 }
 
-ezUInt32 ezMotionMatchingComponent::FindBestKeyframe(
-  const TargetKeyframe& current, ezVec3 vLeftFootPosition, ezVec3 vRightFootPosition, ezVec3 vTargetDir) const
-{
-  float fClosest = 1000000000.0f;
-  ezUInt32 uiClosest = 0xFFFFFFFFu;
-
-  const float fDirWeight = 3.0f;
-
-  for (ezUInt32 i = 0; i < m_MotionData.GetCount(); ++i)
-  {
-    const auto& md = m_MotionData[i];
-
-    float penaltyMul = 1.1f;
-    float penaltyAdd = 100;
-
-    if (md.m_uiAnimClipIndex == current.m_uiAnimClip)
-    {
-      // do NOT allow to transition backwards to a keyframe within a certain range
-      if (md.m_uiKeyframeIndex < current.m_uiKeyframe && md.m_uiKeyframeIndex + 10 > current.m_uiKeyframe)
-        continue;
-
-      penaltyMul = 1.0f;
-
-      if (md.m_uiKeyframeIndex == current.m_uiKeyframe)
-      {
-        penaltyAdd = 0;
-        penaltyMul = 0.9f;
-      }
-    }
-
-    const float dirDist = ezMath::Pow((md.m_vRootVelocity - vTargetDir).GetLength(), fDirWeight);
-    const float leftFootDist = (md.m_vLeftFootPosition - vLeftFootPosition).GetLengthSquared();
-    const float rightFootDist = (md.m_vRightFootPosition - vRightFootPosition).GetLengthSquared();
-
-    const float fScore = dirDist + (leftFootDist + rightFootDist) * penaltyMul + penaltyAdd;
-
-    if (fScore < fClosest)
-    {
-      fClosest = fScore;
-      uiClosest = i;
-    }
-  }
-
-  return uiClosest;
-}
-
-
-
 EZ_STATICLINK_FILE(GameEngine, GameEngine_Animation_Skeletal_Implementation_MotionMatchingComponent);
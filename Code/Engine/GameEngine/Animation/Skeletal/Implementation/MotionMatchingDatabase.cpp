@@ -0,0 +1,315 @@
+#include <GameEnginePCH.h>
+
+#include <GameEngine/Animation/Skeletal/MotionMatchingDatabase.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiMaxFramesPerCluster = 16;
+
+  // unused lanes of a batch get features that are so far away from anything, that they never win
+  constexpr float s_fPaddingFeature = 1e10f;
+
+  // do NOT allow to transition backwards to a keyframe within this range
+  constexpr ezUInt32 s_uiBackwardsBlockRange = 10;
+
+  constexpr float s_fOtherClipPenaltyMul = 1.1f;
+  constexpr float s_fOtherClipPenaltyAdd = 100.0f;
+  constexpr float s_fSameClipPenaltyMul = 1.0f;
+  constexpr float s_fSameClipPenaltyAdd = 100.0f;
+  constexpr float s_fSameKeyframePenaltyMul = 0.9f;
+  constexpr float s_fSameKeyframePenaltyAdd = 0.0f;
+
+  /// \brief Applies the penalties for frames of the clip that is currently playing. Returns false if the frame must not be used.
+  bool GetSameClipPenalty(ezUInt16 uiKeyframe, ezUInt16 uiCurrentKeyframe, float& out_fPenaltyMul, float& out_fPenaltyAdd)
+  {
+    if (uiKeyframe < uiCurrentKeyframe && uiKeyframe + s_uiBackwardsBlockRange > uiCurrentKeyframe)
+      return false;
+
+    if (uiKeyframe == uiCurrentKeyframe)
+    {
+      out_fPenaltyMul = s_fSameKeyframePenaltyMul;
+      out_fPenaltyAdd = s_fSameKeyframePenaltyAdd;
+    }
+    else
+    {
+      out_fPenaltyMul = s_fSameClipPenaltyMul;
+      out_fPenaltyAdd = s_fSameClipPenaltyAdd;
+    }
+
+    return true;
+  }
+
+  EZ_ALWAYS_INLINE void ConsiderFrame(ezUInt32 uiFrame, float fScore, float& inout_fBestScore, ezUInt32& inout_uiBestFrame)
+  {
+    // prefer the lower index on equal scores, so that the result doesn't depend on the order in which the clusters are searched
+    if (fScore < inout_fBestScore || (fScore == inout_fBestScore && uiFrame < inout_uiBestFrame))
+    {
+      inout_fBestScore = fScore;
+      inout_uiBestFrame = uiFrame;
+    }
+  }
+} // namespace
+
+ezMotionMatchingDatabase::ezMotionMatchingDatabase() = default;
+ezMotionMatchingDatabase::~ezMotionMatchingDatabase() = default;
+
+void ezMotionMatchingDatabase::Clear()
+{
+  m_Frames.Clear();
+  m_Batches.Clear();
+  m_Clusters.Clear();
+}
+
+void ezMotionMatchingDatabase::Build(ezArrayPtr<const Frame> frames)
+{
+  Clear();
+
+  m_Frames = frames;
+
+  const ezUInt32 uiNumFrames = m_Frames.GetCount();
+  ezUInt32 uiFrame = 0;
+
+  while (uiFrame < uiNumFrames)
+  {
+    Cluster& cluster = m_Clusters.ExpandAndGetRef();
+    cluster.m_uiFirstFrame = uiFrame;
+    cluster.m_uiFirstBatch = m_Batches.GetCount();
+    cluster.m_uiNumFrames = 0;
+    cluster.m_uiAnimClipIndex = m_Frames[uiFrame].m_uiAnimClipIndex;
+    cluster.m_uiMinKeyframe = m_Frames[uiFrame].m_uiKeyframeIndex;
+    cluster.m_uiMaxKeyframe = m_Frames[uiFrame].m_uiKeyframeIndex;
+    cluster.m_LeftFootBounds.SetInvalid();
+    cluster.m_RightFootBounds.SetInvalid();
+    cluster.m_RootVelocityBounds.SetInvalid();
+
+    while (uiFrame < uiNumFrames && cluster.m_uiNumFrames < s_uiMaxFramesPerCluster && m_Frames[uiFrame].m_uiAnimClipIndex == cluster.m_uiAnimClipIndex)
+    {
+      const Frame& frame = m_Frames[uiFrame];
+
+      cluster.m_LeftFootBounds.ExpandToInclude(frame.m_vLeftFootPosition);
+      cluster.m_RightFootBounds.ExpandToInclude(frame.m_vRightFootPosition);
+      cluster.m_RootVelocityBounds.ExpandToInclude(frame.m_vRootVelocity);
+      cluster.m_uiMinKeyframe = ezMath::Min(cluster.m_uiMinKeyframe, frame.m_uiKeyframeIndex);
+      cluster.m_uiMaxKeyframe = ezMath::Max(cluster.m_uiMaxKeyframe, frame.m_uiKeyframeIndex);
+
+      ++cluster.m_uiNumFrames;
+      ++uiFrame;
+    }
+
+    for (ezUInt32 uiFirstInBatch = 0; uiFirstInBatch < cluster.m_uiNumFrames; uiFirstInBatch += 4)
+    {
+      float features[9][4];
+
+      for (ezUInt32 lane = 0; lane < 4; ++lane)
+      {
+        if (uiFirstInBatch + lane < cluster.m_uiNumFrames)
+        {
+          const Frame& frame = m_Frames[cluster.m_uiFirstFrame + uiFirstInBatch + lane];
+
+          for (ezUInt32 c = 0; c < 3; ++c)
+          {
+            features[0 + c][lane] = frame.m_vLeftFootPosition.GetData()[c];
+            features[3 + c][lane] = frame.m_vRightFootPosition.GetData()[c];
+            features[6 + c][lane] = frame.m_vRootVelocity.GetData()[c];
+          }
+        }
+        else
+        {
+          for (ezUInt32 f = 0; f < 9; ++f)
+          {
+            features[f][lane] = s_fPaddingFeature;
+          }
+        }
+      }
+
+      FeatureBatch& batch = m_Batches.ExpandAndGetRef();
+      batch.m_LeftFootX.Load<4>(features[0]);
+      batch.m_LeftFootY.Load<4>(features[1]);
+      batch.m_LeftFootZ.Load<4>(features[2]);
+      batch.m_RightFootX.Load<4>(features[3]);
+      batch.m_RightFootY.Load<4>(features[4]);
+      batch.m_RightFootZ.Load<4>(features[5]);
+      batch.m_RootVelocityX.Load<4>(features[6]);
+      batch.m_RootVelocityY.Load<4>(features[7]);
+      batch.m_RootVelocityZ.Load<4>(features[8]);
+    }
+  }
+}
+
+// static
+float ezMotionMatchingDatabase::ComputeScore(const Frame& frame, const Query& query)
+{
+  float fPenaltyMul = s_fOtherClipPenaltyMul;
+  float fPenaltyAdd = s_fOtherClipPenaltyAdd;
+
+  if (frame.m_uiAnimClipIndex == query.m_uiCurrentAnimClip)
+  {
+    if (!GetSameClipPenalty(frame.m_uiKeyframeIndex, query.m_uiCurrentKeyframe, fPenaltyMul, fPenaltyAdd))
+      return ezMath::MaxValue<float>();
+  }
+
+  const float fDirLength = (frame.m_vRootVelocity - query.m_vTargetDir).GetLength();
+  const float fDirDist = fDirLength * fDirLength * fDirLength;
+  const float fLeftFootDist = (frame.m_vLeftFootPosition - query.m_vLeftFootPosition).GetLengthSquared();
+  const float fRightFootDist = (frame.m_vRightFootPosition - query.m_vRightFootPosition).GetLengthSquared();
+
+  return fDirDist + (fLeftFootDist + fRightFootDist) * fPenaltyMul + fPenaltyAdd;
+}
+
+ezUInt32 ezMotionMatchingDatabase::FindBestFrame(const Query& query) const
+{
+  ezUInt32 uiResult = ezInvalidIndex;
+  FindBestFrames(ezMakeArrayPtr(&query, 1), ezMakeArrayPtr(&uiResult, 1));
+  return uiResult;
+}
+
+void ezMotionMatchingDatabase::FindBestFrames(ezArrayPtr<const Query> queries, ezArrayPtr<ezUInt32> out_FrameIndices) const
+{
+  EZ_ASSERT_DEV(queries.GetCount() == out_FrameIndices.GetCount(), "Need one output index per query");
+
+  ezHybridArray<SearchState, 32> states;
+  states.SetCount(queries.GetCount());
+
+  // start with the cluster that continues the current animation, it usually holds the best match
+  // and then allows to skip most other clusters right away
+  ezHybridArray<ezUInt32, 32> startClusters;
+  startClusters.SetCount(queries.GetCount(), ezInvalidIndex);
+
+  for (ezUInt32 q = 0; q < queries.GetCount(); ++q)
+  {
+    const Query& query = queries[q];
+
+    for (ezUInt32 c = 0; c < m_Clusters.GetCount(); ++c)
+    {
+      const Cluster& cluster = m_Clusters[c];
+
+      if (cluster.m_uiAnimClipIndex == query.m_uiCurrentAnimClip && cluster.m_uiMinKeyframe <= query.m_uiCurrentKeyframe && query.m_uiCurrentKeyframe <= cluster.m_uiMaxKeyframe)
+      {
+        startClusters[q] = c;
+        SearchCluster(cluster, query, states[q]);
+        break;
+      }
+    }
+  }
+
+  for (ezUInt32 c = 0; c < m_Clusters.GetCount(); ++c)
+  {
+    const Cluster& cluster = m_Clusters[c];
+
+    for (ezUInt32 q = 0; q < queries.GetCount(); ++q)
+    {
+      if (startClusters[q] == c)
+        continue;
+
+      if (ComputeLowerBound(cluster, queries[q]) > states[q].m_fBestScore)
+        continue;
+
+      SearchCluster(cluster, queries[q], states[q]);
+    }
+  }
+
+  for (ezUInt32 q = 0; q < queries.GetCount(); ++q)
+  {
+    out_FrameIndices[q] = states[q].m_uiBestFrame;
+  }
+}
+
+float ezMotionMatchingDatabase::ComputeLowerBound(const Cluster& cluster, const Query& query) const
+{
+  float fPenaltyMul = s_fOtherClipPenaltyMul;
+  float fPenaltyAdd = s_fOtherClipPenaltyAdd;
+
+  if (cluster.m_uiAnimClipIndex == query.m_uiCurrentAnimClip)
+  {
+    const bool bContainsCurrent = cluster.m_uiMinKeyframe <= query.m_uiCurrentKeyframe && query.m_uiCurrentKeyframe <= cluster.m_uiMaxKeyframe;
+
+    fPenaltyMul = bContainsCurrent ? s_fSameKeyframePenaltyMul : s_fSameClipPenaltyMul;
+    fPenaltyAdd = bContainsCurrent ? s_fSameKeyframePenaltyAdd : s_fSameClipPenaltyAdd;
+  }
+
+  const float fDirLength = ezMath::Sqrt(cluster.m_RootVelocityBounds.GetDistanceSquaredTo(query.m_vTargetDir));
+  const float fDirDist = fDirLength * fDirLength * fDirLength;
+  const float fLeftFootDist = cluster.m_LeftFootBounds.GetDistanceSquaredTo(query.m_vLeftFootPosition);
+  const float fRightFootDist = cluster.m_RightFootBounds.GetDistanceSquaredTo(query.m_vRightFootPosition);
+
+  return fDirDist + (fLeftFootDist + fRightFootDist) * fPenaltyMul + fPenaltyAdd;
+}
+
+void ezMotionMatchingDatabase::SearchCluster(const Cluster& cluster, const Query& query, SearchState& inout_State) const
+{
+  const ezSimdVec4f vLeftFootX(query.m_vLeftFootPosition.x);
+  const ezSimdVec4f vLeftFootY(query.m_vLeftFootPosition.y);
+  const ezSimdVec4f vLeftFootZ(query.m_vLeftFootPosition.z);
+  const ezSimdVec4f vRightFootX(query.m_vRightFootPosition.x);
+  const ezSimdVec4f vRightFootY(query.m_vRightFootPosition.y);
+  const ezSimdVec4f vRightFootZ(query.m_vRightFootPosition.z);
+  const ezSimdVec4f vTargetDirX(query.m_vTargetDir.x);
+  const ezSimdVec4f vTargetDirY(query.m_vTargetDir.y);
+  const ezSimdVec4f vTargetDirZ(query.m_vTargetDir.z);
+
+  const bool bCurrentClip = cluster.m_uiAnimClipIndex == query.m_uiCurrentAnimClip;
+  const ezSimdVec4f vPenaltyMul(s_fOtherClipPenaltyMul);
+  const ezSimdVec4f vPenaltyAdd(s_fOtherClipPenaltyAdd);
+
+  const ezUInt32 uiNumBatches = (cluster.m_uiNumFrames + 3) / 4;
+
+  for (ezUInt32 b = 0; b < uiNumBatches; ++b)
+  {
+    const FeatureBatch& batch = m_Batches[cluster.m_uiFirstBatch + b];
+
+    const ezSimdVec4f vLeftX = batch.m_LeftFootX - vLeftFootX;
+    const ezSimdVec4f vLeftY = batch.m_LeftFootY - vLeftFootY;
+    const ezSimdVec4f vLeftZ = batch.m_LeftFootZ - vLeftFootZ;
+    const ezSimdVec4f vRightX = batch.m_RightFootX - vRightFootX;
+    const ezSimdVec4f vRightY = batch.m_RightFootY - vRightFootY;
+    const ezSimdVec4f vRightZ = batch.m_RightFootZ - vRightFootZ;
+    const ezSimdVec4f vDirX = batch.m_RootVelocityX - vTargetDirX;
+    const ezSimdVec4f vDirY = batch.m_RootVelocityY - vTargetDirY;
+    const ezSimdVec4f vDirZ = batch.m_RootVelocityZ - vTargetDirZ;
+
+    const ezSimdVec4f vLeftDist = ezSimdVec4f::MulAdd(vLeftX, vLeftX, ezSimdVec4f::MulAdd(vLeftY, vLeftY, vLeftZ.CompMul(vLeftZ)));
+    const ezSimdVec4f vRightDist = ezSimdVec4f::MulAdd(vRightX, vRightX, ezSimdVec4f::MulAdd(vRightY, vRightY, vRightZ.CompMul(vRightZ)));
+    const ezSimdVec4f vFootDist = vLeftDist + vRightDist;
+    const ezSimdVec4f vDirLength = ezSimdVec4f::MulAdd(vDirX, vDirX, ezSimdVec4f::MulAdd(vDirY, vDirY, vDirZ.CompMul(vDirZ))).GetSqrt();
+    const ezSimdVec4f vDirDist = vDirLength.CompMul(vDirLength).CompMul(vDirLength);
+
+    const ezUInt32 uiFirstFrame = cluster.m_uiFirstFrame + b * 4;
+    const ezUInt32 uiNumLanes = ezMath::Min<ezUInt32>(4, cluster.m_uiNumFrames - b * 4);
+
+    if (!bCurrentClip)
+    {
+      const ezSimdVec4f vScore = ezSimdVec4f::MulAdd(vFootDist, vPenaltyMul, vDirDist + vPenaltyAdd);
+
+      if ((float)vScore.HorizontalMin<4>() > inout_State.m_fBestScore)
+        continue;
+
+      float scores[4];
+      vScore.Store<4>(scores);
+
+      for (ezUInt32 lane = 0; lane < uiNumLanes; ++lane)
+      {
+        ConsiderFrame(uiFirstFrame + lane, scores[lane], inout_State.m_fBestScore, inout_State.m_uiBestFrame);
+      }
+    }
+    else
+    {
+      // the penalties depend on the keyframe, which is rare enough to be done per frame
+      float footDist[4];
+      float dirDist[4];
+      vFootDist.Store<4>(footDist);
+      vDirDist.Store<4>(dirDist);
+
+      for (ezUInt32 lane = 0; lane < uiNumLanes; ++lane)
+      {
+        float fPenaltyMul, fPenaltyAdd;
+        if (!GetSameClipPenalty(m_Frames[uiFirstFrame + lane].m_uiKeyframeIndex, query.m_uiCurrentKeyframe, fPenaltyMul, fPenaltyAdd))
+          continue;
+
+        ConsiderFrame(uiFirstFrame + lane, dirDist[lane] + footDist[lane] * fPenaltyMul + fPenaltyAdd, inout_State.m_fBestScore, inout_State.m_uiBestFrame);
+      }
+    }
+  }
+}
+
+
+EZ_STATICLINK_FILE(GameEngine, GameEngine_Animation_Skeletal_Implementation_MotionMatchingDatabase);
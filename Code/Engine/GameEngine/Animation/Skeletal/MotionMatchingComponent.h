@@ -1,5 +1,6 @@
 #pragma once
 
+#include <GameEngine/Animation/Skeletal/MotionMatchingDatabase.h>
 #include <GameEngine/GameEngineDLL.h>
 #include <RendererCore/AnimationSystem/AnimationGraph/AnimationClipSampler.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
@@ -56,17 +57,6 @@ protected:
   ezVec3 m_vLeftFootPos;
   ezVec3 m_vRightFootPos;
 
-  struct MotionData
-  {
-    ezUInt16 m_uiAnimClipIndex;
-    ezUInt16 m_uiKeyframeIndex;
-    ezVec3 m_vLeftFootPosition;
-    ezVec3 m_vLeftFootVelocity;
-    ezVec3 m_vRightFootPosition;
-    ezVec3 m_vRightFootVelocity;
-    ezVec3 m_vRootVelocity;
-  };
-
   struct TargetKeyframe
   {
     ezUInt16 m_uiAnimClip;
@@ -79,10 +69,8 @@ protected:
 
   TargetKeyframe FindNextKeyframe(const TargetKeyframe& current, const ezVec3& vTargetDir) const;
 
-  ezDynamicArray<MotionData> m_MotionData;
+  ezMotionMatchingDatabase m_MotionDatabase;
 
-  static void PrecomputeMotion(ezDynamicArray<MotionData>& motionData, ezTempHashedString jointName1, ezTempHashedString jointName2,
+  static void PrecomputeMotion(ezDynamicArray<ezMotionMatchingDatabase::Frame>& motionData, ezTempHashedString jointName1, ezTempHashedString jointName2,
     const ezAnimationClipResourceDescriptor& animClip, ezUInt16 uiAnimClipIndex, const ezSkeleton& skeleton);
-
-  ezUInt32 FindBestKeyframe(const TargetKeyframe& current, ezVec3 vLeftFootPosition, ezVec3 vRightFootPosition, ezVec3 vTargetDir) const;
 };
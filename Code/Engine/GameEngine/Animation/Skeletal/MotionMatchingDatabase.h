@@ -0,0 +1,107 @@
+#pragma once
+
+#include <GameEngine/GameEngineDLL.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/BoundingBox.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+
+/// \brief Stores the motion features of all keyframes of a set of animation clips and finds the keyframe that fits a query best.
+///
+/// The features are stored as a structure of arrays, so that four keyframes are scored at once with SIMD math. Consecutive keyframes
+/// of the same clip are grouped into small clusters with bounding boxes around their features. A cluster is only evaluated, if the
+/// lowest score that any of its keyframes could possibly reach is not worse than the best match found so far. Since neighboring
+/// keyframes are very similar, this skips most of the database. The bounds never overestimate a score, so the search finds a keyframe
+/// with the same score as scoring every keyframe, up to the rounding of the SIMD math. If several keyframes score (almost) the same,
+/// it may return a different one of them.
+class EZ_GAMEENGINE_DLL ezMotionMatchingDatabase
+{
+public:
+  /// \brief The features of one keyframe in the database.
+  struct Frame
+  {
+    ezUInt16 m_uiAnimClipIndex;
+    ezUInt16 m_uiKeyframeIndex;
+    ezVec3 m_vLeftFootPosition;
+    ezVec3 m_vLeftFootVelocity;
+    ezVec3 m_vRightFootPosition;
+    ezVec3 m_vRightFootVelocity;
+    ezVec3 m_vRootVelocity;
+  };
+
+  /// \brief Describes the current state of an agent and where it wants to go.
+  struct Query
+  {
+    ezUInt16 m_uiCurrentAnimClip;
+    ezUInt16 m_uiCurrentKeyframe;
+    ezVec3 m_vLeftFootPosition;
+    ezVec3 m_vRightFootPosition;
+    ezVec3 m_vTargetDir;
+  };
+
+  ezMotionMatchingDatabase();
+  ~ezMotionMatchingDatabase();
+
+  void Clear();
+
+  /// \brief Builds the database from the given frames. Keyframes of the same clip should be stored consecutively for best performance.
+  void Build(ezArrayPtr<const Frame> frames);
+
+  bool IsEmpty() const { return m_Frames.IsEmpty(); }
+  ezUInt32 GetFrameCount() const { return m_Frames.GetCount(); }
+  const Frame& GetFrame(ezUInt32 uiFrameIndex) const { return m_Frames[uiFrameIndex]; }
+
+  /// \brief Computes how well the given frame fits the query. Lower is better, frames that must not be used return ezMath::MaxValue().
+  static float ComputeScore(const Frame& frame, const Query& query);
+
+  /// \brief Returns the index of the frame with the lowest score for the query, or ezInvalidIndex if no frame is allowed.
+  ezUInt32 FindBestFrame(const Query& query) const;
+
+  /// \brief Runs FindBestFrame() for many queries against this database at once.
+  ///
+  /// Each cluster is tested against all queries before moving on to the next one, which keeps the feature data in the cache.
+  /// This function only reads from the database, so it can be called from multiple tasks at the same time.
+  /// ezMotionMatchingComponent doesn't use this, since every component builds its own database and runs one query per update.
+  void FindBestFrames(ezArrayPtr<const Query> queries, ezArrayPtr<ezUInt32> out_FrameIndices) const;
+
+private:
+  /// \brief The features of four consecutive frames of the same clip.
+  struct FeatureBatch
+  {
+    ezSimdVec4f m_LeftFootX;
+    ezSimdVec4f m_LeftFootY;
+    ezSimdVec4f m_LeftFootZ;
+    ezSimdVec4f m_RightFootX;
+    ezSimdVec4f m_RightFootY;
+    ezSimdVec4f m_RightFootZ;
+    ezSimdVec4f m_RootVelocityX;
+    ezSimdVec4f m_RootVelocityY;
+    ezSimdVec4f m_RootVelocityZ;
+  };
+
+  struct Cluster
+  {
+    ezBoundingBox m_LeftFootBounds;
+    ezBoundingBox m_RightFootBounds;
+    ezBoundingBox m_RootVelocityBounds;
+    ezUInt32 m_uiFirstFrame;
+    ezUInt32 m_uiFirstBatch;
+    ezUInt16 m_uiNumFrames;
+    ezUInt16 m_uiAnimClipIndex;
+    ezUInt16 m_uiMinKeyframe;
+    ezUInt16 m_uiMaxKeyframe;
+  };
+
+  struct SearchState
+  {
+    float m_fBestScore = ezMath::MaxValue<float>();
+    ezUInt32 m_uiBestFrame = ezInvalidIndex;
+  };
+
+  float ComputeLowerBound(const Cluster& cluster, const Query& query) const;
+  void SearchCluster(const Cluster& cluster, const Query& query, SearchState& inout_State) const;
+
+  ezDynamicArray<Frame> m_Frames;
+  ezDynamicArray<FeatureBatch, ezAlignedAllocatorWrapper> m_Batches;
+  ezDynamicArray<Cluster> m_Clusters;
+};
@@ -92,6 +92,12 @@ void ezColorGradientResourceDescriptor::Load(ezStreamReader& stream)
   EZ_ASSERT_DEV(uiVersion == 1, "Invalid file version {0}", uiVersion);
 
   m_Gradient.Load(stream);
+
+  // the lookup table would smooth out step keys, those gradients are evaluated exactly instead
+  if (!m_Gradient.HasStepKeys(256))
+  {
+    m_Gradient.CreateBakedLookupTable(256);
+  }
 }
 
 
@@ -113,6 +113,12 @@ void ezCurve1DResourceDescriptor::Load(ezStreamReader& stream)
     /// \todo We can do this on load, or somehow ensure this is always already correctly saved
     m_Curves[i].SortControlPoints();
     m_Curves[i].CreateLinearApproximation();
+
+    // the lookup table would smooth out step keys, those curves are evaluated exactly instead
+    if (!m_Curves[i].HasStepKeys(256))
+    {
+      m_Curves[i].CreateBakedLookupTable(256);
+    }
   }
 }
 
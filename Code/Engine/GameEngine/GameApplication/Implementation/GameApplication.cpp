@@ -410,6 +410,8 @@ bool ezGameApplication::Run_ProcessApplicationInput()
 
   if (ezInputManager::GetInputActionState(s_szInputSet, s_szReloadResourcesAction) == ezKeyState::Pressed)
   {
+    // files may have been added or removed outside of the application
+    ezFileSystem::InvalidateFileLookupCache();
     ezResourceManager::ReloadAllResources(false);
   }
 
@@ -118,6 +118,13 @@ void ezGameApplicationBase::Init_FileSystem_ConfigureDataDirs()
   // ":base/" for reading the core engine files
   ezFileSystem::AddDataDirectory(GetBaseDataDirectoryPath(), "GameApplicationBase", "base", ezFileSystem::DataDirUsage::ReadOnly);
 
+  // a game does not expect its data to change while it is running, so remember in which data directory each file was found
+  // ezGameApplication clears the cache when it reloads all resources
+  if (!ezCommandLineUtils::GetGlobalInstance()->GetBoolOption("-noFileLookupCache", false))
+  {
+    ezFileSystem::SetFileLookupCacheEnabled(true);
+  }
+
   // ":project/" for reading the project specific files
   ezFileSystem::AddDataDirectory(GetProjectDataDirectoryPath(), "GameApplicationBase", "project", ezFileSystem::DataDirUsage::ReadOnly);
 
@@ -3,10 +3,23 @@
 #include <Core/ResourceManager/Resource.h>
 #include <Foundation/Containers/ArrayMap.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Mutex.h>
 #include <RendererCore/RendererCoreDLL.h>
 
 class ezAnimationPose;
+class ezJointMapping;
+class ezLocalAnimationPose;
 class ezSkeleton;
+class ezSimdTransform;
+class ezSimdFloat;
+
+/// \brief The error that is allowed per keyframe, when compressing an animation clip with ezAnimationClipResourceDescriptor::Compress().
+struct ezAnimationClipCompressionSettings
+{
+  float m_fMaxTranslationError = 0.001f;
+  ezAngle m_MaxRotationError = ezAngle::Degree(0.1f);
+  float m_fMaxScaleError = 0.001f;
+};
 
 struct EZ_RENDERERCORE_DLL ezAnimationClipResourceDescriptor
 {
@@ -25,9 +38,22 @@ public:
   /// \brief returns ezInvalidJointIndex if no joint with the given name is known
   ezUInt16 FindJointIndexByName(const ezTempHashedString& sJointName) const;
 
+  /// \brief Gives access to the uncompressed keyframes of a joint. Must not be called once the clip has been compressed.
   ezArrayPtr<const ezTransform> GetJointKeyframes(ezUInt16 uiJoint) const;
   ezArrayPtr<ezTransform> GetJointKeyframes(ezUInt16 uiJoint);
 
+  /// \brief Returns a single keyframe of a joint, works for compressed and uncompressed clips.
+  ezTransform GetJointKeyframe(ezUInt16 uiJoint, ezUInt16 uiKeyframe) const;
+
+  /// \brief Replaces the keyframes with a compressed representation that stays within the given error bounds.
+  ///
+  /// Rotations, translations and scales of every joint are stored separately. A channel that doesn't change more than the allowed
+  /// error is stored only once. Otherwise the values are quantized to 16 bit per component, relative to the value range of that channel,
+  /// and only if that exceeds the allowed error as well, the channel is stored uncompressed.
+  void Compress(const ezAnimationClipCompressionSettings& settings);
+
+  bool IsCompressed() const { return !m_CompressedTracks.IsEmpty(); }
+
   void Save(ezStreamWriter& stream) const;
   void Load(ezStreamReader& stream);
 
@@ -42,7 +68,41 @@ public:
   void SetPoseToKeyframe(ezAnimationPose& pose, const ezSkeleton& skeleton, ezUInt16 uiKeyframe) const;
   void SetPoseToBlendedKeyframe(ezAnimationPose& pose, const ezSkeleton& skeleton, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const;
 
+  /// \brief Same as above, but uses a mapping that was created for this clip and the pose's skeleton up front, instead of looking up every joint by name.
+  void SetPoseToKeyframe(ezAnimationPose& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe) const;
+  void SetPoseToBlendedKeyframe(ezAnimationPose& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const;
+  void SetPoseToBlendedKeyframe(ezLocalAnimationPose& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const;
+
 private:
+  enum class ChannelFormat : ezUInt8
+  {
+    Constant,
+    Quantized,
+    Raw,
+  };
+
+  struct CompressedChannel
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezVec4 m_vOffset; ///< The value of a constant channel, or the minimum of a quantized one.
+    ezVec4 m_vScale;  ///< The quantized values are multiplied by this and added to m_vOffset.
+    ezUInt32 m_uiDataOffset;
+    ChannelFormat m_Format;
+  };
+
+  struct CompressedTrack
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    CompressedChannel m_Rotation;
+    CompressedChannel m_Translation;
+    CompressedChannel m_Scale;
+  };
+
+  void CompressChannel(ezArrayPtr<const ezVec4> values, bool bIsRotation, float fMaxError, CompressedChannel& out_Channel);
+  ezSimdTransform SampleCompressedJoint(ezUInt16 uiJoint, ezUInt16 uiKeyframe0, const ezSimdFloat& fBlendToKeyframe1) const;
+
   ezUInt16 m_uiNumJoints = 0;
   ezUInt16 m_uiNumFrames = 0;
   ezUInt8 m_uiFramesPerSecond = 0;
@@ -51,6 +111,11 @@ private:
 
   ezDynamicArray<ezTransform> m_JointTransforms;
   ezArrayMap<ezHashedString, ezUInt16> m_JointNameToIndex;
+
+  // compressed keyframes, m_JointTransforms is empty when these are used
+  ezDynamicArray<CompressedTrack> m_CompressedTracks;
+  ezDynamicArray<ezUInt16> m_QuantizedKeyframes; ///< Four values per keyframe
+  ezDynamicArray<ezVec4> m_RawKeyframes;
 };
 
 typedef ezTypedResourceHandle<class ezAnimationClipResource> ezAnimationClipResourceHandle;
@@ -63,13 +128,33 @@ class EZ_RENDERERCORE_DLL ezAnimationClipResource : public ezResource
 
 public:
   ezAnimationClipResource();
+  ~ezAnimationClipResource();
 
   const ezAnimationClipResourceDescriptor& GetDescriptor() const { return m_Descriptor; }
 
+  /// \brief Returns the mapping from the joints of this clip to the joints of the given skeleton.
+  ///
+  /// The mapping is created on first use and cached for the revision of the skeleton (see ezSkeleton::GetRevision()), until this clip
+  /// gets reloaded. Once the same skeleton shows up with a new revision, its outdated mapping is rebuilt in place, so the returned
+  /// reference stays valid as long as the resource is acquired and the skeleton isn't modified.
+  /// Looking up a mapping that already exists doesn't take a lock.
+  const ezJointMapping& GetJointMapping(const ezSkeleton& skeleton) const;
+
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
   virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override;
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
+  void ClearJointMappings();
+
   ezAnimationClipResourceDescriptor m_Descriptor;
+
+  struct CachedJointMapping;
+
+  /// \brief Singly linked list of the mappings, one per skeleton, newest first.
+  ///
+  /// Entries are never removed while the clip is loaded, so readers walk the list without a lock.
+  /// New entries are only prepended and outdated entries are only rebuilt under m_JointMappingMutex.
+  mutable ezMutex m_JointMappingMutex;
+  mutable CachedJointMapping* m_pJointMappings = nullptr;
 };
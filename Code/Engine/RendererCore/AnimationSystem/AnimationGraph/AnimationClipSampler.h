@@ -3,6 +3,7 @@
 #include <RendererCore/AnimationSystem/AnimationGraph/AnimationGraphNode.h>
 
 struct ezAnimationClipResourceDescriptor;
+class ezLocalAnimationPose;
 class ezStreamWriter;
 class ezStreamReader;
 
@@ -22,6 +23,9 @@ public:
   virtual void Step(ezTime tDiff) override;
   virtual bool Execute(const ezSkeleton& skeleton, ezAnimationPose& currentPose, ezTransform* pRootMotion) override;
 
+  /// \brief Same as above, but samples the clip into a structure-of-arrays local space pose, which is cheaper to blend.
+  bool Execute(const ezSkeleton& skeleton, ezLocalAnimationPose& currentPose, ezTransform* pRootMotion);
+
   void Save(ezStreamWriter& stream) const;
   void Load(ezStreamReader& stream);
 
@@ -44,6 +48,9 @@ public:
   bool GetLooping() const { return m_bLoop; }
 
 private:
+  template <typename POSE>
+  bool ExecuteInternal(const ezSkeleton& skeleton, POSE& currentPose, ezTransform* pRootMotion);
+
   void AdjustSampleTime();
   ezTransform ComputeRootMotion(const ezAnimationClipResourceDescriptor& animDesc, ezTime tPrev, ezTime tNow) const;
 
@@ -4,6 +4,8 @@
 #include <Foundation/IO/Stream.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/AnimationGraph/AnimationClipSampler.h>
+#include <RendererCore/AnimationSystem/JointMapping.h>
+#include <RendererCore/AnimationSystem/LocalAnimationPose.h>
 #include <RendererCore/AnimationSystem/Skeleton.h>
 #include <RendererCore/AnimationSystem/SkeletonResource.h>
 
@@ -21,6 +23,17 @@ void ezAnimationClipSampler::Step(ezTime tDiff)
 }
 
 bool ezAnimationClipSampler::Execute(const ezSkeleton& skeleton, ezAnimationPose& currentPose, ezTransform* pRootMotion)
+{
+  return ExecuteInternal(skeleton, currentPose, pRootMotion);
+}
+
+bool ezAnimationClipSampler::Execute(const ezSkeleton& skeleton, ezLocalAnimationPose& currentPose, ezTransform* pRootMotion)
+{
+  return ExecuteInternal(skeleton, currentPose, pRootMotion);
+}
+
+template <typename POSE>
+bool ezAnimationClipSampler::ExecuteInternal(const ezSkeleton& skeleton, POSE& currentPose, ezTransform* pRootMotion)
 {
   // early out, when this is already known
   if (m_State == ezAnimationClipSamplerState::Stopped)
@@ -57,7 +70,7 @@ bool ezAnimationClipSampler::Execute(const ezSkeleton& skeleton, ezAnimationPose
     }
   }
 
-  animDesc.SetPoseToBlendedKeyframe(currentPose, skeleton, uiFirstFrame, (float)fAnimLerp);
+  animDesc.SetPoseToBlendedKeyframe(currentPose, pAnimClip->GetJointMapping(skeleton), uiFirstFrame, (float)fAnimLerp);
 
   return true;
 }
@@ -173,14 +186,12 @@ ezTransform ezAnimationClipSampler::ComputeRootMotion(const ezAnimationClipResou
   double fAnimLerpLast = 0;
   const ezUInt32 uiLastFrame = animDesc.GetFrameAt(tNow, fAnimLerpLast);
 
-  ezArrayPtr<const ezTransform> pKeyframes = animDesc.GetJointKeyframes(uiRootMotionJoint);
-
   ezTransform res;
   res.SetIdentity();
 
   if (uiFirstFrame == uiLastFrame)
   {
-    const ezTransform rm = pKeyframes[uiFirstFrame];
+    const ezTransform rm = animDesc.GetJointKeyframe(uiRootMotionJoint, static_cast<ezUInt16>(uiFirstFrame));
 
     const float fFraction = (float)(fAnimLerpLast - fAnimLerpFirst);
 
@@ -190,7 +201,7 @@ ezTransform ezAnimationClipSampler::ComputeRootMotion(const ezAnimationClipResou
   else
   {
     {
-      const ezTransform rm = pKeyframes[uiFirstFrame];
+      const ezTransform rm = animDesc.GetJointKeyframe(uiRootMotionJoint, static_cast<ezUInt16>(uiFirstFrame));
 
       const float fFraction = (float)(1.0 - fAnimLerpFirst);
 
@@ -200,7 +211,7 @@ ezTransform ezAnimationClipSampler::ComputeRootMotion(const ezAnimationClipResou
 
     for (ezUInt32 i = uiFirstFrame + 1; i < uiLastFrame; ++i)
     {
-      const ezTransform rm = pKeyframes[i];
+      const ezTransform rm = animDesc.GetJointKeyframe(uiRootMotionJoint, static_cast<ezUInt16>(i));
 
       res.m_vPosition += rm.m_vPosition;
       // rotation
@@ -208,7 +219,7 @@ ezTransform ezAnimationClipSampler::ComputeRootMotion(const ezAnimationClipResou
 
 
     {
-      const ezTransform rm = pKeyframes[uiLastFrame];
+      const ezTransform rm = animDesc.GetJointKeyframe(uiRootMotionJoint, static_cast<ezUInt16>(uiLastFrame));
 
       const float fFraction = (float)fAnimLerpLast;
 
@@ -8,6 +8,7 @@
 
 class ezSkeleton;
 class ezDebugRendererContext;
+class ezShaderTransform;
 
 /// \brief The animation pose encapsulates the final transform matrices for each joint in a given skeleton.
 /// For each joint there is also a bit flag indicating whether the transform is valid or not. An IK system for example may only
@@ -36,6 +37,13 @@ public:
   /// This is typically the very last operation done on a pose before it is sent to the GPU for skinning.
   void ConvertFromObjectSpaceToSkinningSpace(const ezSkeleton& skeleton);
 
+  /// \brief Computes the skinning space transform of each joint from this object space pose and writes it in the 3x4 layout that the
+  /// skinning shader reads.
+  ///
+  /// This is the same computation as ConvertFromObjectSpaceToSkinningSpace(), but the pose itself stays in object space and the result can
+  /// be written directly into the buffer that is uploaded to the GPU. \a out_Transforms needs to hold one element per joint.
+  void ComputeSkinningTransforms(const ezSkeleton& skeleton, ezArrayPtr<ezShaderTransform> out_Transforms) const;
+
   const ezMat4& GetTransform(ezUInt16 uiJointIndex) const { return m_Transforms[uiJointIndex]; }
 
   ezArrayPtr<const ezMat4> GetAllTransforms() const { return m_Transforms.GetArrayPtr(); }
@@ -1,8 +1,14 @@
 #include <RendererCorePCH.h>
 
 #include <Core/Assets/AssetFileHeader.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/SimdMath/SimdTransform.h>
+#include <Foundation/SimdMath/SimdVec4i.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/JointMapping.h>
+#include <RendererCore/AnimationSystem/LocalAnimationPose.h>
 #include <RendererCore/AnimationSystem/Skeleton.h>
 
 // clang-format off
@@ -12,13 +18,28 @@ EZ_END_DYNAMIC_REFLECTED_TYPE;
 EZ_RESOURCE_IMPLEMENT_COMMON_CODE(ezAnimationClipResource);
 // clang-format on
 
+struct ezAnimationClipResource::CachedJointMapping
+{
+  /// \brief Zero while the mapping is rebuilt, skeleton revisions start at one.
+  ezAtomicInteger32 m_iSkeletonRevision;
+  const ezSkeleton* m_pSkeleton = nullptr;
+  ezJointMapping m_Mapping;
+  CachedJointMapping* m_pNext = nullptr;
+};
+
 ezAnimationClipResource::ezAnimationClipResource()
   : ezResource(DoUpdate::OnAnyThread, 1)
 {
 }
 
+ezAnimationClipResource::~ezAnimationClipResource()
+{
+  ClearJointMappings();
+}
+
 EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezAnimationClipResource, ezAnimationClipResourceDescriptor)
 {
+  ClearJointMappings();
   m_Descriptor = descriptor;
 
   ezResourceLoadDesc res;
@@ -31,6 +52,8 @@ EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezAnimationClipResource, ezAnimationClipResourc
 
 ezResourceLoadDesc ezAnimationClipResource::UnloadData(Unload WhatToUnload)
 {
+  ClearJointMappings();
+
   ezResourceLoadDesc res;
   res.m_uiQualityLevelsDiscardable = 0;
   res.m_uiQualityLevelsLoadable = 0;
@@ -63,6 +86,7 @@ ezResourceLoadDesc ezAnimationClipResource::UpdateContent(ezStreamReader* Stream
   ezAssetFileHeader AssetHash;
   AssetHash.Read(*Stream);
 
+  ClearJointMappings();
   m_Descriptor.Load(*Stream);
 
   res.m_State = ezResourceState::Loaded;
@@ -75,6 +99,72 @@ void ezAnimationClipResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
   out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezAnimationClipResource) + static_cast<ezUInt32>(m_Descriptor.GetHeapMemoryUsage());
 }
 
+const ezJointMapping& ezAnimationClipResource::GetJointMapping(const ezSkeleton& skeleton) const
+{
+  const ezInt32 iSkeletonRevision = static_cast<ezInt32>(skeleton.GetRevision());
+
+  // there is usually only one skeleton per clip, so the list is very short
+  for (CachedJointMapping* pEntry = m_pJointMappings; pEntry != nullptr; pEntry = pEntry->m_pNext)
+  {
+    if (pEntry->m_iSkeletonRevision == iSkeletonRevision)
+      return pEntry->m_Mapping;
+  }
+
+  EZ_LOCK(m_JointMappingMutex);
+
+  // another thread may have created the mapping while we were waiting for the lock
+  CachedJointMapping* pHead = m_pJointMappings;
+  CachedJointMapping* pOutdatedEntry = nullptr;
+  for (CachedJointMapping* pEntry = pHead; pEntry != nullptr; pEntry = pEntry->m_pNext)
+  {
+    if (pEntry->m_iSkeletonRevision == iSkeletonRevision)
+      return pEntry->m_Mapping;
+
+    if (pEntry->m_pSkeleton == &skeleton)
+    {
+      pOutdatedEntry = pEntry;
+    }
+  }
+
+  // The skeleton was rebuilt, nobody can ask for its old revision anymore. Reuse the entry instead of growing the list with every rebuild.
+  if (pOutdatedEntry != nullptr)
+  {
+    pOutdatedEntry->m_iSkeletonRevision = 0;
+    pOutdatedEntry->m_Mapping = ezJointMapping();
+    pOutdatedEntry->m_Mapping.CreateMapping(skeleton, m_Descriptor);
+    pOutdatedEntry->m_iSkeletonRevision = iSkeletonRevision;
+
+    return pOutdatedEntry->m_Mapping;
+  }
+
+  CachedJointMapping* pNewEntry = EZ_DEFAULT_NEW(CachedJointMapping);
+  pNewEntry->m_iSkeletonRevision = iSkeletonRevision;
+  pNewEntry->m_pSkeleton = &skeleton;
+  pNewEntry->m_Mapping.CreateMapping(skeleton, m_Descriptor);
+  pNewEntry->m_pNext = pHead;
+
+  // the entry has to be complete before other threads can see it
+  ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(&m_pJointMappings), pHead, pNewEntry);
+
+  return pNewEntry->m_Mapping;
+}
+
+void ezAnimationClipResource::ClearJointMappings()
+{
+  // Only called when the clip is unloaded or replaced, at which point no one may sample it anymore.
+  EZ_LOCK(m_JointMappingMutex);
+
+  CachedJointMapping* pEntry = m_pJointMappings;
+  m_pJointMappings = nullptr;
+
+  while (pEntry != nullptr)
+  {
+    CachedJointMapping* pNext = pEntry->m_pNext;
+    EZ_DEFAULT_DELETE(pEntry);
+    pEntry = pNext;
+  }
+}
+
 void ezAnimationClipResourceDescriptor::Configure(ezUInt16 uiNumJoints, ezUInt16 uiNumFrames, ezUInt8 uiFramesPerSecond, bool bIncludeRootMotion)
 {
   EZ_ASSERT_DEV(uiNumFrames >= 2, "Invalid number of key frames");
@@ -98,6 +188,10 @@ void ezAnimationClipResourceDescriptor::Configure(ezUInt16 uiNumJoints, ezUInt16
   }
 
   m_JointTransforms.SetCount(uiNumTransforms);
+
+  m_CompressedTracks.Clear();
+  m_QuantizedKeyframes.Clear();
+  m_RawKeyframes.Clear();
 }
 
 ezUInt16 ezAnimationClipResourceDescriptor::GetFrameAt(ezTime time, double& out_fLerpToNext) const
@@ -136,17 +230,19 @@ ezUInt16 ezAnimationClipResourceDescriptor::FindJointIndexByName(const ezTempHas
 
 ezArrayPtr<const ezTransform> ezAnimationClipResourceDescriptor::GetJointKeyframes(ezUInt16 uiJoint) const
 {
+  EZ_ASSERT_DEBUG(!IsCompressed(), "The keyframes of a compressed animation clip can't be accessed directly, use GetJointKeyframe()");
   return ezArrayPtr<const ezTransform>(&m_JointTransforms[uiJoint * m_uiNumFrames], m_uiNumFrames);
 }
 
 ezArrayPtr<ezTransform> ezAnimationClipResourceDescriptor::GetJointKeyframes(ezUInt16 uiJoint)
 {
+  EZ_ASSERT_DEBUG(!IsCompressed(), "The keyframes of a compressed animation clip can't be accessed directly, use GetJointKeyframe()");
   return ezArrayPtr<ezTransform>(&m_JointTransforms[uiJoint * m_uiNumFrames], m_uiNumFrames);
 }
 
 void ezAnimationClipResourceDescriptor::Save(ezStreamWriter& stream) const
 {
-  const ezUInt8 uiVersion = 2;
+  const ezUInt8 uiVersion = 3;
   stream << uiVersion;
 
   stream << m_uiNumJoints;
@@ -166,6 +262,26 @@ void ezAnimationClipResourceDescriptor::Save(ezStreamWriter& stream) const
       stream << m_JointNameToIndex.GetValue(b);
     }
   }
+
+  // version 3
+  {
+    const ezUInt32 uiTrackCount = m_CompressedTracks.GetCount();
+    stream << uiTrackCount;
+
+    for (const CompressedTrack& track : m_CompressedTracks)
+    {
+      for (const CompressedChannel* pChannel : {&track.m_Rotation, &track.m_Translation, &track.m_Scale})
+      {
+        stream << pChannel->m_vOffset;
+        stream << pChannel->m_vScale;
+        stream << pChannel->m_uiDataOffset;
+        stream << static_cast<ezUInt8>(pChannel->m_Format);
+      }
+    }
+
+    stream.WriteArray(m_QuantizedKeyframes);
+    stream.WriteArray(m_RawKeyframes);
+  }
 }
 
 void ezAnimationClipResourceDescriptor::Load(ezStreamReader& stream)
@@ -202,12 +318,41 @@ void ezAnimationClipResourceDescriptor::Load(ezStreamReader& stream)
     // should do nothing
     m_JointNameToIndex.Sort();
   }
+
+  m_CompressedTracks.Clear();
+  m_QuantizedKeyframes.Clear();
+  m_RawKeyframes.Clear();
+
+  // version 3
+  if (uiVersion >= 3)
+  {
+    ezUInt32 uiTrackCount = 0;
+    stream >> uiTrackCount;
+    m_CompressedTracks.SetCountUninitialized(uiTrackCount);
+
+    for (CompressedTrack& track : m_CompressedTracks)
+    {
+      for (CompressedChannel* pChannel : {&track.m_Rotation, &track.m_Translation, &track.m_Scale})
+      {
+        ezUInt8 uiFormat = 0;
+        stream >> pChannel->m_vOffset;
+        stream >> pChannel->m_vScale;
+        stream >> pChannel->m_uiDataOffset;
+        stream >> uiFormat;
+        pChannel->m_Format = static_cast<ChannelFormat>(uiFormat);
+      }
+    }
+
+    stream.ReadArray(m_QuantizedKeyframes);
+    stream.ReadArray(m_RawKeyframes);
+  }
 }
 
 
 ezUInt64 ezAnimationClipResourceDescriptor::GetHeapMemoryUsage() const
 {
-  return m_JointTransforms.GetHeapMemoryUsage();
+  return m_JointTransforms.GetHeapMemoryUsage() + m_CompressedTracks.GetHeapMemoryUsage() + m_QuantizedKeyframes.GetHeapMemoryUsage() +
+         m_RawKeyframes.GetHeapMemoryUsage();
 }
 
 bool ezAnimationClipResourceDescriptor::HasRootMotion() const
@@ -233,45 +378,301 @@ ezUInt16 ezAnimationClipResourceDescriptor::GetRootMotionJoint() const
 
 void ezAnimationClipResourceDescriptor::SetPoseToKeyframe(ezAnimationPose& pose, const ezSkeleton& skeleton, ezUInt16 uiKeyframe) const
 {
-  for (ezUInt32 b = 0; b < m_JointNameToIndex.GetCount(); ++b)
-  {
-    const ezHashedString& sJointName = m_JointNameToIndex.GetKey(b);
-    const ezUInt32 uiAnimJointIdx = m_JointNameToIndex.GetValue(b);
+  ezJointMapping mapping;
+  mapping.CreateMapping(skeleton, *this);
 
-    const ezUInt16 uiSkeletonJointIdx = skeleton.FindJointByName(sJointName);
-    if (uiSkeletonJointIdx != ezInvalidJointIndex)
+  SetPoseToKeyframe(pose, mapping, uiKeyframe);
+}
+
+void ezAnimationClipResourceDescriptor::SetPoseToBlendedKeyframe(
+  ezAnimationPose& pose, const ezSkeleton& skeleton, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const
+{
+  ezJointMapping mapping;
+  mapping.CreateMapping(skeleton, *this);
+
+  SetPoseToBlendedKeyframe(pose, mapping, uiKeyframe0, fBlendToKeyframe1);
+}
+
+void ezAnimationClipResourceDescriptor::SetPoseToKeyframe(ezAnimationPose& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe) const
+{
+  if (IsCompressed())
+  {
+    for (const ezJointMapping::Mapping& m : mapping.GetAllMappings())
     {
-      ezArrayPtr<const ezTransform> pTransforms = GetJointKeyframes(uiAnimJointIdx);
+      const ezSimdTransform jointTransform = SampleCompressedJoint(m.m_uiJointInAnimation, uiKeyframe, 0.0f);
 
-      pose.SetTransform(uiSkeletonJointIdx, pTransforms[uiKeyframe].GetAsMat4());
+      pose.SetTransform(m.m_uiJointInSkeleton, ezSimdConversion::ToMat4(jointTransform.GetAsMat4()));
     }
+
+    return;
+  }
+
+  for (const ezJointMapping::Mapping& m : mapping.GetAllMappings())
+  {
+    const ezTransform& jointTransform = m_JointTransforms[m.m_uiJointInAnimation * m_uiNumFrames + uiKeyframe];
+
+    pose.SetTransform(m.m_uiJointInSkeleton, jointTransform.GetAsMat4());
   }
 }
 
+void ezAnimationClipResourceDescriptor::SetPoseToBlendedKeyframe(
+  ezAnimationPose& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const
+{
+  if (IsCompressed())
+  {
+    const ezSimdFloat fLerp = fBlendToKeyframe1;
+
+    for (const ezJointMapping::Mapping& m : mapping.GetAllMappings())
+    {
+      const ezSimdTransform jointTransform = SampleCompressedJoint(m.m_uiJointInAnimation, uiKeyframe0, fLerp);
+
+      pose.SetTransform(m.m_uiJointInSkeleton, ezSimdConversion::ToMat4(jointTransform.GetAsMat4()));
+    }
+
+    return;
+  }
+
+  for (const ezJointMapping::Mapping& m : mapping.GetAllMappings())
+  {
+    const ezTransform* pKeyframes = &m_JointTransforms[m.m_uiJointInAnimation * m_uiNumFrames + uiKeyframe0];
+    const ezTransform& jointTransform1 = pKeyframes[0];
+    const ezTransform& jointTransform2 = pKeyframes[1];
+
+    ezTransform res;
+    res.m_vPosition = ezMath::Lerp(jointTransform1.m_vPosition, jointTransform2.m_vPosition, fBlendToKeyframe1);
+    res.m_qRotation.SetSlerp(jointTransform1.m_qRotation, jointTransform2.m_qRotation, fBlendToKeyframe1);
+    res.m_vScale = ezMath::Lerp(jointTransform1.m_vScale, jointTransform2.m_vScale, fBlendToKeyframe1);
+
+    pose.SetTransform(m.m_uiJointInSkeleton, res.GetAsMat4());
+  }
+}
 
 void ezAnimationClipResourceDescriptor::SetPoseToBlendedKeyframe(
-  ezAnimationPose& pose, const ezSkeleton& skeleton, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const
+  ezLocalAnimationPose& pose, const ezJointMapping& mapping, ezUInt16 uiKeyframe0, float fBlendToKeyframe1) const
+{
+  const ezSimdFloat fLerp = fBlendToKeyframe1;
+
+  if (IsCompressed())
+  {
+    for (const ezJointMapping::Mapping& m : mapping.GetAllMappings())
+    {
+      pose.SetTransform(m.m_uiJointInSkeleton, SampleCompressedJoint(m.m_uiJointInAnimation, uiKeyframe0, fLerp));
+    }
+
+    return;
+  }
+
+  const ezSimdVec4f vLerp(fLerp);
+
+  for (const ezJointMapping::Mapping& m : mapping.GetAllMappings())
+  {
+    const ezTransform* pKeyframes = &m_JointTransforms[m.m_uiJointInAnimation * m_uiNumFrames + uiKeyframe0];
+    const ezSimdTransform jointTransform1 = ezSimdConversion::ToTransform(pKeyframes[0]);
+    const ezSimdTransform jointTransform2 = ezSimdConversion::ToTransform(pKeyframes[1]);
+
+    ezSimdTransform res;
+    res.m_Position = ezSimdVec4f::Lerp(jointTransform1.m_Position, jointTransform2.m_Position, vLerp);
+    res.m_Rotation.SetSlerp(jointTransform1.m_Rotation, jointTransform2.m_Rotation, fLerp);
+    res.m_Scale = ezSimdVec4f::Lerp(jointTransform1.m_Scale, jointTransform2.m_Scale, vLerp);
+
+    pose.SetTransform(m.m_uiJointInSkeleton, res);
+  }
+}
+
+ezTransform ezAnimationClipResourceDescriptor::GetJointKeyframe(ezUInt16 uiJoint, ezUInt16 uiKeyframe) const
 {
-  for (ezUInt32 b = 0; b < m_JointNameToIndex.GetCount(); ++b)
+  if (IsCompressed())
   {
-    const ezHashedString& sJointName = m_JointNameToIndex.GetKey(b);
-    const ezUInt32 uiAnimJointIdx = m_JointNameToIndex.GetValue(b);
+    return ezSimdConversion::ToTransform(SampleCompressedJoint(uiJoint, uiKeyframe, 0.0f));
+  }
+
+  return m_JointTransforms[uiJoint * m_uiNumFrames + uiKeyframe];
+}
 
-    const ezUInt16 uiSkeletonJointIdx = skeleton.FindJointByName(sJointName);
-    if (uiSkeletonJointIdx != ezInvalidJointIndex)
+namespace
+{
+  float ComputeChannelError(const ezVec4& vOriginal, const ezVec4& vDecoded, bool bIsRotation)
+  {
+    if (bIsRotation)
     {
-      ezArrayPtr<const ezTransform> pTransforms = GetJointKeyframes(uiAnimJointIdx);
-      const ezTransform jointTransform1 = pTransforms[uiKeyframe0];
-      const ezTransform jointTransform2 = pTransforms[uiKeyframe0 + 1];
+      ezQuat q;
+      q.v = vDecoded.GetAsVec3();
+      q.w = vDecoded.w;
+      q.Normalize();
+
+      const float fDot = ezMath::Abs(vOriginal.x * q.v.x + vOriginal.y * q.v.y + vOriginal.z * q.v.z + vOriginal.w * q.w);
+      return 2.0f * ezMath::ACos(ezMath::Min(fDot, 1.0f)).GetRadian();
+    }
+
+    return (vOriginal.GetAsVec3() - vDecoded.GetAsVec3()).GetLength();
+  }
+
+  EZ_ALWAYS_INLINE ezSimdVec4f DecodeQuantized(const ezUInt16* pValues, const ezSimdVec4f& vScale, const ezSimdVec4f& vOffset)
+  {
+    const ezSimdVec4f vQuantized = ezSimdVec4i(pValues[0], pValues[1], pValues[2], pValues[3]).ToFloat();
+    return ezSimdVec4f::MulAdd(vQuantized, vScale, vOffset);
+  }
+} // namespace
+
+void ezAnimationClipResourceDescriptor::Compress(const ezAnimationClipCompressionSettings& settings)
+{
+  if (IsCompressed() || m_JointTransforms.IsEmpty())
+    return;
+
+  const ezUInt32 uiNumTracks = m_JointTransforms.GetCount() / m_uiNumFrames;
+  m_CompressedTracks.SetCountUninitialized(uiNumTracks);
 
-      ezTransform res;
-      res.m_vPosition = ezMath::Lerp(jointTransform1.m_vPosition, jointTransform2.m_vPosition, fBlendToKeyframe1);
-      res.m_qRotation.SetSlerp(jointTransform1.m_qRotation, jointTransform2.m_qRotation, fBlendToKeyframe1);
-      res.m_vScale = ezMath::Lerp(jointTransform1.m_vScale, jointTransform2.m_vScale, fBlendToKeyframe1);
+  ezDynamicArray<ezVec4> rotations, translations, scales;
+  rotations.SetCountUninitialized(m_uiNumFrames);
+  translations.SetCountUninitialized(m_uiNumFrames);
+  scales.SetCountUninitialized(m_uiNumFrames);
 
-      pose.SetTransform(uiSkeletonJointIdx, res.GetAsMat4());
+  for (ezUInt32 uiTrack = 0; uiTrack < uiNumTracks; ++uiTrack)
+  {
+    const ezTransform* pKeyframes = &m_JointTransforms[uiTrack * m_uiNumFrames];
+
+    for (ezUInt32 f = 0; f < m_uiNumFrames; ++f)
+    {
+      rotations[f] = ezVec4(pKeyframes[f].m_qRotation.v.x, pKeyframes[f].m_qRotation.v.y, pKeyframes[f].m_qRotation.v.z, pKeyframes[f].m_qRotation.w);
+      translations[f] = pKeyframes[f].m_vPosition.GetAsVec4(0.0f);
+      scales[f] = pKeyframes[f].m_vScale.GetAsVec4(0.0f);
     }
+
+    CompressedTrack& track = m_CompressedTracks[uiTrack];
+    CompressChannel(rotations, true, settings.m_MaxRotationError.GetRadian(), track.m_Rotation);
+    CompressChannel(translations, false, settings.m_fMaxTranslationError, track.m_Translation);
+    CompressChannel(scales, false, settings.m_fMaxScaleError, track.m_Scale);
   }
+
+  m_QuantizedKeyframes.Compact();
+  m_RawKeyframes.Compact();
+
+  m_JointTransforms.Clear();
+  m_JointTransforms.Compact();
+}
+
+void ezAnimationClipResourceDescriptor::CompressChannel(ezArrayPtr<const ezVec4> values, bool bIsRotation, float fMaxError, CompressedChannel& out_Channel)
+{
+  out_Channel.m_uiDataOffset = 0;
+  out_Channel.m_vScale.SetZero();
+
+  // constant channel
+  {
+    float fError = 0.0f;
+    for (const ezVec4& v : values)
+    {
+      fError = ezMath::Max(fError, ComputeChannelError(v, values[0], bIsRotation));
+    }
+
+    if (fError <= fMaxError)
+    {
+      out_Channel.m_Format = ChannelFormat::Constant;
+      out_Channel.m_vOffset = values[0];
+      return;
+    }
+  }
+
+  // quantized to 16 bit per component within the value range of this channel
+  {
+    ezVec4 vMin = values[0];
+    ezVec4 vMax = values[0];
+    for (const ezVec4& v : values)
+    {
+      vMin = vMin.CompMin(v);
+      vMax = vMax.CompMax(v);
+    }
+
+    const ezVec4 vScale = (vMax - vMin) / 65535.0f;
+
+    ezHybridArray<ezUInt16, 4 * 64> quantized;
+    quantized.SetCountUninitialized(values.GetCount() * 4);
+
+    float fError = 0.0f;
+    for (ezUInt32 f = 0; f < values.GetCount(); ++f)
+    {
+      ezVec4 vDecoded;
+      for (ezUInt32 c = 0; c < 4; ++c)
+      {
+        const float fRange = (&vScale.x)[c];
+        const float fNormalized = fRange > 0.0f ? ((&values[f].x)[c] - (&vMin.x)[c]) / fRange : 0.0f;
+        const ezUInt16 uiValue = static_cast<ezUInt16>(ezMath::Clamp(ezMath::Round(fNormalized), 0.0f, 65535.0f));
+
+        quantized[f * 4 + c] = uiValue;
+        (&vDecoded.x)[c] = (&vMin.x)[c] + uiValue * fRange;
+      }
+
+      fError = ezMath::Max(fError, ComputeChannelError(values[f], vDecoded, bIsRotation));
+    }
+
+    if (fError <= fMaxError)
+    {
+      out_Channel.m_Format = ChannelFormat::Quantized;
+      out_Channel.m_vOffset = vMin;
+      out_Channel.m_vScale = vScale;
+      out_Channel.m_uiDataOffset = m_QuantizedKeyframes.GetCount();
+      m_QuantizedKeyframes.PushBackRange(quantized);
+      return;
+    }
+  }
+
+  out_Channel.m_Format = ChannelFormat::Raw;
+  out_Channel.m_vOffset.SetZero();
+  out_Channel.m_uiDataOffset = m_RawKeyframes.GetCount();
+  m_RawKeyframes.PushBackRange(values);
+}
+
+ezSimdTransform ezAnimationClipResourceDescriptor::SampleCompressedJoint(ezUInt16 uiJoint, ezUInt16 uiKeyframe0, const ezSimdFloat& fBlendToKeyframe1) const
+{
+  const CompressedTrack& track = m_CompressedTracks[uiJoint];
+  const ezUInt16 uiKeyframe1 = ezMath::Min<ezUInt16>(uiKeyframe0 + 1, m_uiNumFrames - 1);
+
+  // decodes the value of a channel at both keyframes and interpolates between them
+  auto sampleChannel = [&](const CompressedChannel& channel, ezSimdVec4f& out_v0, ezSimdVec4f& out_v1) -> bool {
+    switch (channel.m_Format)
+    {
+      case ChannelFormat::Constant:
+        out_v0 = ezSimdConversion::ToVec4(channel.m_vOffset);
+        return false;
+
+      case ChannelFormat::Quantized:
+      {
+        const ezSimdVec4f vScale = ezSimdConversion::ToVec4(channel.m_vScale);
+        const ezSimdVec4f vOffset = ezSimdConversion::ToVec4(channel.m_vOffset);
+        const ezUInt16* pValues = &m_QuantizedKeyframes[channel.m_uiDataOffset];
+        out_v0 = DecodeQuantized(pValues + uiKeyframe0 * 4, vScale, vOffset);
+        out_v1 = DecodeQuantized(pValues + uiKeyframe1 * 4, vScale, vOffset);
+        return true;
+      }
+
+      default:
+        out_v0 = ezSimdConversion::ToVec4(m_RawKeyframes[channel.m_uiDataOffset + uiKeyframe0]);
+        out_v1 = ezSimdConversion::ToVec4(m_RawKeyframes[channel.m_uiDataOffset + uiKeyframe1]);
+        return true;
+    }
+  };
+
+  ezSimdTransform res;
+  ezSimdVec4f v0, v1;
+
+  if (sampleChannel(track.m_Rotation, v0, v1))
+  {
+    ezSimdQuat q0(v0);
+    ezSimdQuat q1(v1);
+    q0.Normalize();
+    q1.Normalize();
+    res.m_Rotation.SetSlerp(q0, q1, fBlendToKeyframe1);
+  }
+  else
+  {
+    res.m_Rotation = ezSimdQuat(v0);
+  }
+
+  const ezSimdVec4f vLerp(fBlendToKeyframe1);
+
+  res.m_Position = sampleChannel(track.m_Translation, v0, v1) ? ezSimdVec4f::Lerp(v0, v1, vLerp) : v0;
+  res.m_Scale = sampleChannel(track.m_Scale, v0, v1) ? ezSimdVec4f::Lerp(v0, v1, vLerp) : v0;
+
+  return res;
 }
 
 ezTime ezAnimationClipResourceDescriptor::GetDuration() const
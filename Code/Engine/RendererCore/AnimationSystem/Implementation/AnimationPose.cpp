@@ -1,8 +1,10 @@
 #include <RendererCorePCH.h>
 
+#include <Foundation/SimdMath/SimdConversion.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
 #include <RendererCore/AnimationSystem/Skeleton.h>
 #include <RendererCore/Debug/DebugRenderer.h>
+#include <RendererCore/Shader/Types.h>
 
 EZ_IMPLEMENT_MESSAGE_TYPE(ezMsgAnimationPoseUpdated);
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgAnimationPoseUpdated, 1, ezRTTIDefaultAllocator<ezMsgAnimationPoseUpdated>)
@@ -59,7 +61,10 @@ void ezAnimationPose::ConvertFromLocalSpaceToObjectSpace(const ezSkeleton& skele
     if (!joint.IsRootJoint())
     {
       // else grab transform of parent joint and use it to make the final transform for this joint
-      m_Transforms[i] = m_Transforms[joint.GetParentIndex()] * m_Transforms[i];
+      const ezSimdMat4f parent(m_Transforms[joint.GetParentIndex()].m_fElementsCM, ezMatrixLayout::ColumnMajor);
+      const ezSimdMat4f local(m_Transforms[i].m_fElementsCM, ezMatrixLayout::ColumnMajor);
+
+      (parent * local).GetAsArray(m_Transforms[i].m_fElementsCM, ezMatrixLayout::ColumnMajor);
     }
   }
 }
@@ -79,6 +84,22 @@ void ezAnimationPose::ConvertFromObjectSpaceToSkinningSpace(const ezSkeleton& sk
   }
 }
 
+void ezAnimationPose::ComputeSkinningTransforms(const ezSkeleton& skeleton, ezArrayPtr<ezShaderTransform> out_Transforms) const
+{
+  const ezUInt32 numTransforms = GetTransformCount();
+
+  EZ_ASSERT_DEV(skeleton.GetJointCount() == numTransforms, "Pose and skeleton have different joint count!");
+  EZ_ASSERT_DEV(out_Transforms.GetCount() == numTransforms, "Output array needs to hold {} transforms but has room for {}", numTransforms, out_Transforms.GetCount());
+
+  for (ezUInt32 i = 0; i < numTransforms; ++i)
+  {
+    const ezSimdMat4f objectSpace(m_Transforms[i].m_fElementsCM, ezMatrixLayout::ColumnMajor);
+    const ezSimdMat4f inverseBindPose = ezSimdConversion::ToTransform(skeleton.GetJointByIndex(i).GetInverseBindPoseGlobalTransform()).GetAsMat4();
+
+    out_Transforms[i] = objectSpace * inverseBindPose;
+  }
+}
+
 ezVec3 ezAnimationPose::SkinPositionWithSingleJoint(const ezVec3& Position, ezUInt32 uiIndex) const
 {
   return m_Transforms[uiIndex].TransformPosition(Position);
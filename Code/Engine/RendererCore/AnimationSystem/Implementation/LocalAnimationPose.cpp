@@ -0,0 +1,317 @@
+#include <RendererCorePCH.h>
+
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/LocalAnimationPose.h>
+#include <RendererCore/AnimationSystem/Skeleton.h>
+
+namespace
+{
+  struct QuatBatch
+  {
+    ezSimdVec4f x;
+    ezSimdVec4f y;
+    ezSimdVec4f z;
+    ezSimdVec4f w;
+  };
+
+  EZ_ALWAYS_INLINE QuatBatch Multiply(const QuatBatch& a, const QuatBatch& b)
+  {
+    QuatBatch r;
+    r.x = a.w.CompMul(b.x) + a.x.CompMul(b.w) + a.y.CompMul(b.z) - a.z.CompMul(b.y);
+    r.y = a.w.CompMul(b.y) - a.x.CompMul(b.z) + a.y.CompMul(b.w) + a.z.CompMul(b.x);
+    r.z = a.w.CompMul(b.z) + a.x.CompMul(b.y) - a.y.CompMul(b.x) + a.z.CompMul(b.w);
+    r.w = a.w.CompMul(b.w) - a.x.CompMul(b.x) - a.y.CompMul(b.y) - a.z.CompMul(b.z);
+    return r;
+  }
+
+  /// Normalized lerp from a to b along the shortest path, for four quaternions at once.
+  EZ_ALWAYS_INLINE QuatBatch NLerp(const QuatBatch& a, const QuatBatch& b, const ezSimdVec4f& t)
+  {
+    const ezSimdVec4f dot = a.x.CompMul(b.x) + a.y.CompMul(b.y) + a.z.CompMul(b.z) + a.w.CompMul(b.w);
+    const ezSimdVec4b flip = dot < ezSimdVec4f::ZeroVector();
+
+    QuatBatch r;
+    r.x = ezSimdVec4f::Lerp(a.x, b.x.FlipSign(flip), t);
+    r.y = ezSimdVec4f::Lerp(a.y, b.y.FlipSign(flip), t);
+    r.z = ezSimdVec4f::Lerp(a.z, b.z.FlipSign(flip), t);
+    r.w = ezSimdVec4f::Lerp(a.w, b.w.FlipSign(flip), t);
+
+    const ezSimdVec4f invLength = (r.x.CompMul(r.x) + r.y.CompMul(r.y) + r.z.CompMul(r.z) + r.w.CompMul(r.w)).GetInvSqrt();
+    r.x = r.x.CompMul(invLength);
+    r.y = r.y.CompMul(invLength);
+    r.z = r.z.CompMul(invLength);
+    r.w = r.w.CompMul(invLength);
+    return r;
+  }
+
+  template <typename BATCH>
+  EZ_ALWAYS_INLINE void BlendBatch(BATCH& dst, const BATCH& src, const ezSimdVec4f& t)
+  {
+    const QuatBatch r = NLerp({dst.m_RotationX, dst.m_RotationY, dst.m_RotationZ, dst.m_RotationW},
+      {src.m_RotationX, src.m_RotationY, src.m_RotationZ, src.m_RotationW}, t);
+    dst.m_RotationX = r.x;
+    dst.m_RotationY = r.y;
+    dst.m_RotationZ = r.z;
+    dst.m_RotationW = r.w;
+
+    dst.m_TranslationX = ezSimdVec4f::Lerp(dst.m_TranslationX, src.m_TranslationX, t);
+    dst.m_TranslationY = ezSimdVec4f::Lerp(dst.m_TranslationY, src.m_TranslationY, t);
+    dst.m_TranslationZ = ezSimdVec4f::Lerp(dst.m_TranslationZ, src.m_TranslationZ, t);
+    dst.m_ScaleX = ezSimdVec4f::Lerp(dst.m_ScaleX, src.m_ScaleX, t);
+    dst.m_ScaleY = ezSimdVec4f::Lerp(dst.m_ScaleY, src.m_ScaleY, t);
+    dst.m_ScaleZ = ezSimdVec4f::Lerp(dst.m_ScaleZ, src.m_ScaleZ, t);
+  }
+
+  EZ_ALWAYS_INLINE ezSimdVec4f LoadWeights(ezArrayPtr<const float> weights, ezUInt32 uiFirstJoint)
+  {
+    if (uiFirstJoint + 4 <= weights.GetCount())
+    {
+      ezSimdVec4f v;
+      v.Load<4>(&weights[uiFirstJoint]);
+      return v;
+    }
+
+    float tmp[4] = {0, 0, 0, 0};
+    for (ezUInt32 i = uiFirstJoint; i < weights.GetCount(); ++i)
+    {
+      tmp[i - uiFirstJoint] = weights[i];
+    }
+
+    ezSimdVec4f v;
+    v.Load<4>(tmp);
+    return v;
+  }
+} // namespace
+
+ezLocalAnimationPose::ezLocalAnimationPose() = default;
+ezLocalAnimationPose::~ezLocalAnimationPose() = default;
+
+void ezLocalAnimationPose::Configure(const ezSkeleton& skeleton)
+{
+  m_uiJointCount = skeleton.GetJointCount();
+  m_Batches.SetCount((m_uiJointCount + 3) / 4);
+
+  // unused lanes in the last batch keep the identity, so that normalizing them doesn't produce NaNs
+  const ezSimdVec4f zero = ezSimdVec4f::ZeroVector();
+  const ezSimdVec4f one(1.0f);
+
+  for (JointBatch& batch : m_Batches)
+  {
+    batch.m_RotationX = zero;
+    batch.m_RotationY = zero;
+    batch.m_RotationZ = zero;
+    batch.m_RotationW = one;
+    batch.m_TranslationX = zero;
+    batch.m_TranslationY = zero;
+    batch.m_TranslationZ = zero;
+    batch.m_ScaleX = one;
+    batch.m_ScaleY = one;
+    batch.m_ScaleZ = one;
+  }
+
+  SetToBindPose(skeleton);
+}
+
+void ezLocalAnimationPose::SetToBindPose(const ezSkeleton& skeleton)
+{
+  EZ_ASSERT_DEBUG(skeleton.GetJointCount() == m_uiJointCount, "Pose is not configured for this skeleton");
+
+  for (ezUInt16 i = 0; i < m_uiJointCount; ++i)
+  {
+    SetTransform(i, ezSimdConversion::ToTransform(skeleton.GetJointByIndex(i).GetBindPoseLocalTransform()));
+  }
+}
+
+void ezLocalAnimationPose::SetTransform(ezUInt16 uiJoint, const ezSimdTransform& transform)
+{
+  EZ_ASSERT_DEBUG(uiJoint < m_uiJointCount, "Invalid joint index");
+
+  ezVec4 r, t, s;
+  transform.m_Rotation.m_v.Store<4>(&r.x);
+  transform.m_Position.Store<4>(&t.x);
+  transform.m_Scale.Store<4>(&s.x);
+
+  float* pBatch = reinterpret_cast<float*>(&m_Batches[uiJoint / 4]);
+  const ezUInt32 uiLane = uiJoint % 4;
+
+  pBatch[0 + uiLane] = r.x;
+  pBatch[4 + uiLane] = r.y;
+  pBatch[8 + uiLane] = r.z;
+  pBatch[12 + uiLane] = r.w;
+  pBatch[16 + uiLane] = t.x;
+  pBatch[20 + uiLane] = t.y;
+  pBatch[24 + uiLane] = t.z;
+  pBatch[28 + uiLane] = s.x;
+  pBatch[32 + uiLane] = s.y;
+  pBatch[36 + uiLane] = s.z;
+}
+
+ezSimdTransform ezLocalAnimationPose::GetTransform(ezUInt16 uiJoint) const
+{
+  EZ_ASSERT_DEBUG(uiJoint < m_uiJointCount, "Invalid joint index");
+
+  const float* pBatch = reinterpret_cast<const float*>(&m_Batches[uiJoint / 4]);
+  const ezUInt32 uiLane = uiJoint % 4;
+
+  ezSimdTransform res;
+  res.m_Rotation = ezSimdQuat(ezSimdVec4f(pBatch[0 + uiLane], pBatch[4 + uiLane], pBatch[8 + uiLane], pBatch[12 + uiLane]));
+  res.m_Position = ezSimdVec4f(pBatch[16 + uiLane], pBatch[20 + uiLane], pBatch[24 + uiLane], 0.0f);
+  res.m_Scale = ezSimdVec4f(pBatch[28 + uiLane], pBatch[32 + uiLane], pBatch[36 + uiLane], 0.0f);
+  return res;
+}
+
+void ezLocalAnimationPose::BlendTowards(const ezLocalAnimationPose& other, float fWeight)
+{
+  EZ_ASSERT_DEBUG(other.m_uiJointCount == m_uiJointCount, "Poses must have the same number of joints");
+
+  const ezSimdVec4f t(fWeight);
+
+  for (ezUInt32 b = 0; b < m_Batches.GetCount(); ++b)
+  {
+    BlendBatch(m_Batches[b], other.m_Batches[b], t);
+  }
+}
+
+void ezLocalAnimationPose::BlendTowardsMasked(const ezLocalAnimationPose& other, ezArrayPtr<const float> jointWeights)
+{
+  EZ_ASSERT_DEBUG(other.m_uiJointCount == m_uiJointCount, "Poses must have the same number of joints");
+  EZ_ASSERT_DEBUG(jointWeights.GetCount() >= m_uiJointCount, "Need one weight per joint");
+
+  for (ezUInt32 b = 0; b < m_Batches.GetCount(); ++b)
+  {
+    BlendBatch(m_Batches[b], other.m_Batches[b], LoadWeights(jointWeights, b * 4));
+  }
+}
+
+void ezLocalAnimationPose::MakeAdditive(const ezLocalAnimationPose& reference)
+{
+  EZ_ASSERT_DEBUG(reference.m_uiJointCount == m_uiJointCount, "Poses must have the same number of joints");
+
+  for (ezUInt32 b = 0; b < m_Batches.GetCount(); ++b)
+  {
+    JointBatch& dst = m_Batches[b];
+    const JointBatch& ref = reference.m_Batches[b];
+
+    // delta rotation = inverse(reference) * pose, the inverse of a unit quaternion is its conjugate
+    const QuatBatch r = Multiply({-ref.m_RotationX, -ref.m_RotationY, -ref.m_RotationZ, ref.m_RotationW},
+      {dst.m_RotationX, dst.m_RotationY, dst.m_RotationZ, dst.m_RotationW});
+    dst.m_RotationX = r.x;
+    dst.m_RotationY = r.y;
+    dst.m_RotationZ = r.z;
+    dst.m_RotationW = r.w;
+
+    dst.m_TranslationX -= ref.m_TranslationX;
+    dst.m_TranslationY -= ref.m_TranslationY;
+    dst.m_TranslationZ -= ref.m_TranslationZ;
+    dst.m_ScaleX = dst.m_ScaleX.CompDiv(ref.m_ScaleX);
+    dst.m_ScaleY = dst.m_ScaleY.CompDiv(ref.m_ScaleY);
+    dst.m_ScaleZ = dst.m_ScaleZ.CompDiv(ref.m_ScaleZ);
+  }
+}
+
+void ezLocalAnimationPose::AddAdditive(const ezLocalAnimationPose& additive, float fWeight)
+{
+  EZ_ASSERT_DEBUG(additive.m_uiJointCount == m_uiJointCount, "Poses must have the same number of joints");
+
+  const ezSimdVec4f t(fWeight);
+  const ezSimdVec4f zero = ezSimdVec4f::ZeroVector();
+  const ezSimdVec4f one(1.0f);
+  const QuatBatch identity = {zero, zero, zero, one};
+
+  for (ezUInt32 b = 0; b < m_Batches.GetCount(); ++b)
+  {
+    JointBatch& dst = m_Batches[b];
+    const JointBatch& add = additive.m_Batches[b];
+
+    const QuatBatch delta = NLerp(identity, {add.m_RotationX, add.m_RotationY, add.m_RotationZ, add.m_RotationW}, t);
+    const QuatBatch r = Multiply({dst.m_RotationX, dst.m_RotationY, dst.m_RotationZ, dst.m_RotationW}, delta);
+    dst.m_RotationX = r.x;
+    dst.m_RotationY = r.y;
+    dst.m_RotationZ = r.z;
+    dst.m_RotationW = r.w;
+
+    dst.m_TranslationX = ezSimdVec4f::MulAdd(add.m_TranslationX, t, dst.m_TranslationX);
+    dst.m_TranslationY = ezSimdVec4f::MulAdd(add.m_TranslationY, t, dst.m_TranslationY);
+    dst.m_TranslationZ = ezSimdVec4f::MulAdd(add.m_TranslationZ, t, dst.m_TranslationZ);
+    dst.m_ScaleX = dst.m_ScaleX.CompMul(ezSimdVec4f::Lerp(one, add.m_ScaleX, t));
+    dst.m_ScaleY = dst.m_ScaleY.CompMul(ezSimdVec4f::Lerp(one, add.m_ScaleY, t));
+    dst.m_ScaleZ = dst.m_ScaleZ.CompMul(ezSimdVec4f::Lerp(one, add.m_ScaleZ, t));
+  }
+}
+
+void ezLocalAnimationPose::ConvertToMatrices(ezAnimationPose& out_Pose) const
+{
+  EZ_ASSERT_DEBUG(out_Pose.GetTransformCount() == m_uiJointCount, "Pose is not configured for the same skeleton");
+
+  const ezSimdVec4f one(1.0f);
+
+  // each batch computes the 3x4 part of four matrices at once, same math as ezTransform::GetAsMat4()
+  ezVec4 columns[12];
+
+  for (ezUInt32 b = 0; b < m_Batches.GetCount(); ++b)
+  {
+    const JointBatch& batch = m_Batches[b];
+
+    const ezSimdVec4f tx = batch.m_RotationX + batch.m_RotationX;
+    const ezSimdVec4f ty = batch.m_RotationY + batch.m_RotationY;
+    const ezSimdVec4f tz = batch.m_RotationZ + batch.m_RotationZ;
+    const ezSimdVec4f twx = tx.CompMul(batch.m_RotationW);
+    const ezSimdVec4f twy = ty.CompMul(batch.m_RotationW);
+    const ezSimdVec4f twz = tz.CompMul(batch.m_RotationW);
+    const ezSimdVec4f txx = tx.CompMul(batch.m_RotationX);
+    const ezSimdVec4f txy = ty.CompMul(batch.m_RotationX);
+    const ezSimdVec4f txz = tz.CompMul(batch.m_RotationX);
+    const ezSimdVec4f tyy = ty.CompMul(batch.m_RotationY);
+    const ezSimdVec4f tyz = tz.CompMul(batch.m_RotationY);
+    const ezSimdVec4f tzz = tz.CompMul(batch.m_RotationZ);
+
+    (one - (tyy + tzz)).CompMul(batch.m_ScaleX).Store<4>(&columns[0].x);
+    (txy + twz).CompMul(batch.m_ScaleX).Store<4>(&columns[1].x);
+    (txz - twy).CompMul(batch.m_ScaleX).Store<4>(&columns[2].x);
+
+    (txy - twz).CompMul(batch.m_ScaleY).Store<4>(&columns[3].x);
+    (one - (txx + tzz)).CompMul(batch.m_ScaleY).Store<4>(&columns[4].x);
+    (tyz + twx).CompMul(batch.m_ScaleY).Store<4>(&columns[5].x);
+
+    (txz + twy).CompMul(batch.m_ScaleZ).Store<4>(&columns[6].x);
+    (tyz - twx).CompMul(batch.m_ScaleZ).Store<4>(&columns[7].x);
+    (one - (txx + tyy)).CompMul(batch.m_ScaleZ).Store<4>(&columns[8].x);
+
+    batch.m_TranslationX.Store<4>(&columns[9].x);
+    batch.m_TranslationY.Store<4>(&columns[10].x);
+    batch.m_TranslationZ.Store<4>(&columns[11].x);
+
+    const ezUInt32 uiFirstJoint = b * 4;
+    const ezUInt32 uiNumLanes = ezMath::Min<ezUInt32>(4, m_uiJointCount - uiFirstJoint);
+
+    for (ezUInt32 uiLane = 0; uiLane < uiNumLanes; ++uiLane)
+    {
+      const float* c = &columns[0].x + uiLane;
+
+      ezMat4 m;
+      m.m_fElementsCM[0] = c[0];
+      m.m_fElementsCM[1] = c[4];
+      m.m_fElementsCM[2] = c[8];
+      m.m_fElementsCM[3] = 0.0f;
+      m.m_fElementsCM[4] = c[12];
+      m.m_fElementsCM[5] = c[16];
+      m.m_fElementsCM[6] = c[20];
+      m.m_fElementsCM[7] = 0.0f;
+      m.m_fElementsCM[8] = c[24];
+      m.m_fElementsCM[9] = c[28];
+      m.m_fElementsCM[10] = c[32];
+      m.m_fElementsCM[11] = 0.0f;
+      m.m_fElementsCM[12] = c[36];
+      m.m_fElementsCM[13] = c[40];
+      m.m_fElementsCM[14] = c[44];
+      m.m_fElementsCM[15] = 1.0f;
+
+      out_Pose.SetTransform(static_cast<ezUInt16>(uiFirstJoint + uiLane), m);
+    }
+  }
+}
+
+
+
+EZ_STATICLINK_FILE(RendererCore, RendererCore_AnimationSystem_Implementation_LocalAnimationPose);
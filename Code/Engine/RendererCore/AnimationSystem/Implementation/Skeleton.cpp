@@ -1,8 +1,18 @@
 #include <RendererCorePCH.h>
 
+#include <Foundation/Threading/AtomicInteger.h>
 #include <RendererCore/AnimationSystem/Skeleton.h>
 
-ezSkeleton::ezSkeleton() = default;
+namespace
+{
+  ezAtomicInteger32 s_iSkeletonRevision;
+}
+
+ezSkeleton::ezSkeleton()
+{
+  UpdateRevision();
+}
+
 ezSkeleton::~ezSkeleton() = default;
 
 ezUInt16 ezSkeleton::FindJointByName(const ezTempHashedString& sJointName) const
@@ -71,6 +81,7 @@ void ezSkeleton::Save(ezStreamWriter& stream) const
 void ezSkeleton::Load(ezStreamReader& stream)
 {
   m_Joints.Clear();
+  UpdateRevision();
 
   ezUInt32 uiVersion = 0;
   stream >> uiVersion;
@@ -126,6 +137,11 @@ bool ezSkeleton::IsJointDescendantOf(ezUInt16 uiJoint, ezUInt16 uiExpectedParent
   return false;
 }
 
+void ezSkeleton::UpdateRevision()
+{
+  m_uiRevision = static_cast<ezUInt32>(s_iSkeletonRevision.Increment());
+}
+
 // void ezSkeleton::ApplyGlobalTransform(const ezMat3& transform)
 //{
 //  ezMat4 totalTransform(transform, ezVec3::ZeroVector());
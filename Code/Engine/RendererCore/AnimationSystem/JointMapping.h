@@ -6,7 +6,8 @@
 
 class ezSkeleton;
 
-class ezJointMapping
+/// \brief Maps the joints of an animation clip to the joints of a skeleton, such that a pose can be sampled without looking up joint names.
+class EZ_RENDERERCORE_DLL ezJointMapping
 {
 public:
   struct Mapping
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <RendererCore/AnimationSystem/Declarations.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/SimdMath/SimdTransform.h>
+
+class ezSkeleton;
+class ezAnimationPose;
+
+/// \brief Stores the local space transforms of all joints of a skeleton as rotations, translations and scales.
+///
+/// The data is laid out as a structure of arrays in batches of four joints, so that sampling and blending operate on four joints at
+/// once with ezSimdVec4f math. Matrices are only computed at the very end, when the result is written to an ezAnimationPose.
+/// Rotations are blended with a normalized lerp along the shortest path.
+class EZ_RENDERERCORE_DLL ezLocalAnimationPose
+{
+public:
+  ezLocalAnimationPose();
+  ~ezLocalAnimationPose();
+
+  /// \brief Allocates the transforms for the given skeleton and sets them to its bind pose.
+  void Configure(const ezSkeleton& skeleton);
+
+  /// \brief Sets all transforms to the local bind pose of the skeleton.
+  void SetToBindPose(const ezSkeleton& skeleton);
+
+  ezUInt16 GetJointCount() const { return m_uiJointCount; }
+
+  void SetTransform(ezUInt16 uiJoint, const ezSimdTransform& transform);
+  ezSimdTransform GetTransform(ezUInt16 uiJoint) const;
+
+  /// \brief Blends all joints of this pose towards \a other. A weight of zero keeps this pose, a weight of one results in \a other.
+  void BlendTowards(const ezLocalAnimationPose& other, float fWeight);
+
+  /// \brief Same as BlendTowards() but with an individual weight per joint, e.g. to only blend the upper body.
+  ///
+  /// \a jointWeights needs to hold one value per joint.
+  void BlendTowardsMasked(const ezLocalAnimationPose& other, ezArrayPtr<const float> jointWeights);
+
+  /// \brief Turns this pose into the difference to the given reference pose, such that it can be applied with AddAdditive().
+  void MakeAdditive(const ezLocalAnimationPose& reference);
+
+  /// \brief Applies a pose that was created with MakeAdditive() on top of this pose, scaled by \a fWeight.
+  void AddAdditive(const ezLocalAnimationPose& additive, float fWeight);
+
+  /// \brief Computes the matrix of every joint and writes it into \a out_Pose, which has to be configured for the same skeleton.
+  void ConvertToMatrices(ezAnimationPose& out_Pose) const;
+
+private:
+  struct JointBatch
+  {
+    ezSimdVec4f m_RotationX;
+    ezSimdVec4f m_RotationY;
+    ezSimdVec4f m_RotationZ;
+    ezSimdVec4f m_RotationW;
+    ezSimdVec4f m_TranslationX;
+    ezSimdVec4f m_TranslationY;
+    ezSimdVec4f m_TranslationZ;
+    ezSimdVec4f m_ScaleX;
+    ezSimdVec4f m_ScaleY;
+    ezSimdVec4f m_ScaleZ;
+  };
+
+  ezUInt16 m_uiJointCount = 0;
+  ezDynamicArray<JointBatch, ezAlignedAllocatorWrapper> m_Batches;
+};
@@ -66,11 +66,20 @@ public:
 
   bool IsJointDescendantOf(ezUInt16 uiJoint, ezUInt16 uiExpectedParent) const;
 
+  /// \brief Returns a number that identifies the current joint structure of this skeleton.
+  ///
+  /// Every newly built or loaded skeleton gets a unique revision, copies share the revision of their source.
+  /// This allows to cache data that depends on the joint names and indices, e.g. joint mappings of animation clips.
+  ezUInt32 GetRevision() const { return m_uiRevision; }
+
   /// \brief Applies a global transform to the skeleton (used by the importer to correct scale and up-axis)
   // void ApplyGlobalTransform(const ezMat3& transform);
 
 protected:
   friend ezSkeletonBuilder;
 
+  void UpdateRevision();
+
   ezDynamicArray<ezSkeletonJoint> m_Joints;
+  ezUInt32 m_uiRevision = 0;
 };
@@ -28,6 +28,22 @@ public:
     ezVec3 m_end;
   };
 
+  /// \brief A line with its own colors, which are multiplied with the color that is passed to DrawLines().
+  struct ColoredLine
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ColoredLine();
+    ColoredLine(const ezVec3& start, const ezVec3& end, const ezColor& color);
+    ColoredLine(const ezVec3& start, const ezVec3& end, const ezColor& startColor, const ezColor& endColor);
+
+    ezVec3 m_start;
+    ezVec3 m_end;
+
+    ezColor m_startColor;
+    ezColor m_endColor;
+  };
+
   struct Triangle
   {
     EZ_DECLARE_POD_TYPE();
@@ -38,6 +54,18 @@ public:
     ezVec3 m_position[3];
   };
 
+  /// \brief A triangle with its own color, which is multiplied with the color that is passed to DrawSolidTriangles().
+  struct ColoredTriangle
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ColoredTriangle();
+    ColoredTriangle(const ezVec3& p0, const ezVec3& p1, const ezVec3& p2, const ezColor& color);
+
+    ezVec3 m_position[3];
+    ezColor m_color;
+  };
+
   struct TexturedTriangle
   {
     EZ_DECLARE_POD_TYPE();
@@ -69,6 +97,9 @@ public:
 
   static void DrawLines(const ezDebugRendererContext& context, ezArrayPtr<Line> lines, const ezColor& color);
 
+  /// \brief Same as DrawLines() above, but every line has its own colors. This allows to submit differently colored lines in one call.
+  static void DrawLines(const ezDebugRendererContext& context, ezArrayPtr<const ColoredLine> lines, const ezColor& color = ezColor::White);
+
   static void Draw2DLines(const ezDebugRendererContext& context, ezArrayPtr<Line> lines, const ezColor& color);
 
   static void DrawCross(const ezDebugRendererContext& context, const ezVec3& globalPosition, float fLineLength, const ezColor& color,
@@ -83,6 +114,14 @@ public:
   static void DrawLineSphere(const ezDebugRendererContext& context, const ezBoundingSphere& sphere, const ezColor& color,
     const ezTransform& transform = ezTransform::IdentityTransform());
 
+  /// \brief Same as calling DrawLineBox() for every box, but only takes the lock once.
+  static void DrawLineBoxes(const ezDebugRendererContext& context, ezArrayPtr<const ezBoundingBox> boxes, const ezColor& color,
+    const ezTransform& transform = ezTransform::IdentityTransform());
+
+  /// \brief Same as calling DrawLineSphere() for every sphere. Large batches are generated in parallel.
+  static void DrawLineSpheres(const ezDebugRendererContext& context, ezArrayPtr<const ezBoundingSphere> spheres, const ezColor& color,
+    const ezTransform& transform = ezTransform::IdentityTransform());
+
   static void DrawLineCapsuleZ(const ezDebugRendererContext& context, float fLength, float fRadius, const ezColor& color,
     const ezTransform& transform = ezTransform::IdentityTransform());
 
@@ -93,6 +132,9 @@ public:
 
   static void DrawSolidTriangles(const ezDebugRendererContext& context, ezArrayPtr<Triangle> triangles, const ezColor& color);
 
+  /// \brief Same as DrawSolidTriangles() above, but every triangle has its own color.
+  static void DrawSolidTriangles(const ezDebugRendererContext& context, ezArrayPtr<const ColoredTriangle> triangles, const ezColor& color = ezColor::White);
+
   static void DrawTexturedTriangles(
     const ezDebugRendererContext& context, ezArrayPtr<TexturedTriangle> triangles, const ezColor& color, const ezTexture2DResourceHandle& hTexture);
 
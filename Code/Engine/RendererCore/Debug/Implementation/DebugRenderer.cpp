@@ -3,6 +3,9 @@
 #include <Core/Graphics/Geometry.h>
 #include <Core/World/World.h>
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/SimdMath/SimdTransform.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Debug/SimpleASCIIFont.h>
 #include <RendererCore/Meshes/MeshBufferResource.h>
@@ -30,6 +33,8 @@ namespace
 {
   struct EZ_ALIGN_16(Vertex)
   {
+    EZ_DECLARE_POD_TYPE();
+
     ezVec3 m_position;
     ezColorLinearUB m_color;
   };
@@ -48,6 +53,8 @@ namespace
 
   struct EZ_ALIGN_16(BoxData)
   {
+    EZ_DECLARE_POD_TYPE();
+
     ezShaderTransform m_transform;
     ezColor m_color;
   };
@@ -301,6 +308,142 @@ namespace
     }
   }
 
+  using VertexArray = ezDynamicArray<Vertex, ezAlignedAllocatorWrapper>;
+
+  // Batches with at least this many primitives generate their vertices in parallel and without holding the lock.
+  static constexpr ezUInt32 s_uiParallelGenerationThreshold = 4096;
+
+  /// Appends uiNumPrimitives * uiVerticesPerPrimitive vertices to the given vertex array of the context.
+  /// func(uiStartPrimitive, uiEndPrimitive, pVertices) must write the vertices of the given range of primitives.
+  template <typename GenerateFunc>
+  static void AddVertices(const ezDebugRendererContext& context, VertexArray PerContextData::*pVertexArray, ezUInt32 uiNumPrimitives,
+    ezUInt32 uiVerticesPerPrimitive, GenerateFunc func)
+  {
+    if (uiNumPrimitives < s_uiParallelGenerationThreshold)
+    {
+      EZ_LOCK(s_Mutex);
+
+      VertexArray& vertices = GetDataForExtraction(context).*pVertexArray;
+      const ezUInt32 uiStartVertex = vertices.GetCount();
+      vertices.SetCountUninitialized(uiStartVertex + uiNumPrimitives * uiVerticesPerPrimitive);
+
+      func(0, uiNumPrimitives, vertices.GetData() + uiStartVertex);
+      return;
+    }
+
+    VertexArray tempVertices;
+    tempVertices.SetCountUninitialized(uiNumPrimitives * uiVerticesPerPrimitive);
+    Vertex* pTempVertices = tempVertices.GetData();
+
+    ezParallelForParams params;
+    params.uiBinSize = 1024;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumPrimitives,
+      [&](ezUInt32 uiStartPrimitive, ezUInt32 uiEndPrimitive) {
+        func(uiStartPrimitive, uiEndPrimitive, pTempVertices + uiStartPrimitive * uiVerticesPerPrimitive);
+      },
+      "DebugRenderer Vertex Generation", params);
+
+    EZ_LOCK(s_Mutex);
+
+    (GetDataForExtraction(context).*pVertexArray).PushBackRange(tempVertices);
+  }
+
+  // Plain lines and triangles use the color of the draw call, colored ones multiply it with their own colors.
+  EZ_ALWAYS_INLINE const ezColor& GetStartColor(const ezDebugRenderer::Line& /*line*/, const ezColor& color) { return color; }
+  EZ_ALWAYS_INLINE const ezColor& GetEndColor(const ezDebugRenderer::Line& /*line*/, const ezColor& color) { return color; }
+  EZ_ALWAYS_INLINE ezColor GetStartColor(const ezDebugRenderer::ColoredLine& line, const ezColor& color) { return color * line.m_startColor; }
+  EZ_ALWAYS_INLINE ezColor GetEndColor(const ezDebugRenderer::ColoredLine& line, const ezColor& color) { return color * line.m_endColor; }
+  EZ_ALWAYS_INLINE const ezColor& GetColor(const ezDebugRenderer::Triangle& /*triangle*/, const ezColor& color) { return color; }
+  EZ_ALWAYS_INLINE ezColor GetColor(const ezDebugRenderer::ColoredTriangle& triangle, const ezColor& color) { return color * triangle.m_color; }
+
+  template <typename LineType>
+  static void AddLines(const ezDebugRendererContext& context, VertexArray PerContextData::*pVertexArray, ezArrayPtr<const LineType> lines,
+    const ezColor& color)
+  {
+    if (lines.IsEmpty())
+      return;
+
+    const LineType* pLines = lines.GetPtr();
+
+    AddVertices(context, pVertexArray, lines.GetCount(), 2, [&](ezUInt32 uiStartLine, ezUInt32 uiEndLine, Vertex* pVertices) {
+      for (ezUInt32 i = uiStartLine; i < uiEndLine; ++i)
+      {
+        const LineType& line = pLines[i];
+
+        pVertices[0].m_position = line.m_start;
+        pVertices[0].m_color = GetStartColor(line, color);
+        pVertices[1].m_position = line.m_end;
+        pVertices[1].m_color = GetEndColor(line, color);
+
+        pVertices += 2;
+      }
+    });
+  }
+
+  template <typename TriangleType>
+  static void AddTriangles(const ezDebugRendererContext& context, ezArrayPtr<const TriangleType> triangles, const ezColor& color)
+  {
+    if (triangles.IsEmpty())
+      return;
+
+    const TriangleType* pTriangles = triangles.GetPtr();
+
+    AddVertices(context, &PerContextData::m_triangleVertices, triangles.GetCount(), 3,
+      [&](ezUInt32 uiStartTriangle, ezUInt32 uiEndTriangle, Vertex* pVertices) {
+        for (ezUInt32 i = uiStartTriangle; i < uiEndTriangle; ++i)
+        {
+          const TriangleType& triangle = pTriangles[i];
+          const ezColorLinearUB vertexColor = GetColor(triangle, color);
+
+          for (ezUInt32 v = 0; v < 3; ++v)
+          {
+            pVertices[v].m_position = triangle.m_position[v];
+            pVertices[v].m_color = vertexColor;
+          }
+
+          pVertices += 3;
+        }
+      });
+  }
+
+  enum
+  {
+    SPHERE_SEGMENTS = 32,
+    SPHERE_LINES = SPHERE_SEGMENTS * 3,
+  };
+
+  // Line start and end points of a unit sphere, see ezDebugRenderer::DrawLineSpheres()
+  static ezSimdVec4f s_UnitSpherePoints[SPHERE_LINES * 2];
+
+  static void InitUnitSpherePoints()
+  {
+    const ezAngle stepAngle = ezAngle::Degree(360.0f / SPHERE_SEGMENTS);
+
+    for (ezUInt32 s = 0; s < SPHERE_SEGMENTS; ++s)
+    {
+      const float fS1 = (float)s;
+      const float fS2 = (float)(s + 1);
+
+      const float fCos1 = ezMath::Cos(fS1 * stepAngle);
+      const float fCos2 = ezMath::Cos(fS2 * stepAngle);
+
+      const float fSin1 = ezMath::Sin(fS1 * stepAngle);
+      const float fSin2 = ezMath::Sin(fS2 * stepAngle);
+
+      ezSimdVec4f* pPoints = s_UnitSpherePoints + s * 6;
+      pPoints[0].Set(0.0f, fCos1, fSin1, 0.0f);
+      pPoints[1].Set(0.0f, fCos2, fSin2, 0.0f);
+
+      pPoints[2].Set(fCos1, 0.0f, fSin1, 0.0f);
+      pPoints[3].Set(fCos2, 0.0f, fSin2, 0.0f);
+
+      pPoints[4].Set(fCos1, fSin1, 0.0f, 0.0f);
+      pPoints[5].Set(fCos2, fSin2, 0.0f, 0.0f);
+    }
+  }
+
   static void AppendGlyphs(ezDynamicArray<GlyphData, ezAlignedAllocatorWrapper>& glyphs, const TextLineData2D& textLine)
   {
     ezVec2 currentPos = textLine.m_topLeftCorner;
@@ -343,46 +486,18 @@ EZ_END_SUBSYSTEM_DECLARATION;
 // static
 void ezDebugRenderer::DrawLines(const ezDebugRendererContext& context, ezArrayPtr<Line> lines, const ezColor& color)
 {
-  if (lines.IsEmpty())
-    return;
-
-  EZ_LOCK(s_Mutex);
-
-  auto& data = GetDataForExtraction(context);
-
-  for (auto& line : lines)
-  {
-    ezVec3* pPositions = &line.m_start;
+  AddLines<Line>(context, &PerContextData::m_lineVertices, lines, color);
+}
 
-    for (ezUInt32 i = 0; i < 2; ++i)
-    {
-      auto& vertex = data.m_lineVertices.ExpandAndGetRef();
-      vertex.m_position = pPositions[i];
-      vertex.m_color = color;
-    }
-  }
+// static
+void ezDebugRenderer::DrawLines(const ezDebugRendererContext& context, ezArrayPtr<const ColoredLine> lines, const ezColor& color /*= ezColor::White*/)
+{
+  AddLines<ColoredLine>(context, &PerContextData::m_lineVertices, lines, color);
 }
 
 void ezDebugRenderer::Draw2DLines(const ezDebugRendererContext& context, ezArrayPtr<Line> lines, const ezColor& color)
 {
-  if (lines.IsEmpty())
-    return;
-
-  EZ_LOCK(s_Mutex);
-
-  auto& data = GetDataForExtraction(context);
-
-  for (auto& line : lines)
-  {
-    ezVec3* pPositions = &line.m_start;
-
-    for (ezUInt32 i = 0; i < 2; ++i)
-    {
-      auto& vertex = data.m_line2DVertices.ExpandAndGetRef();
-      vertex.m_position = pPositions[i];
-      vertex.m_color = color;
-    }
-  }
+  AddLines<Line>(context, &PerContextData::m_line2DVertices, lines, color);
 }
 
 // static
@@ -407,16 +522,7 @@ void ezDebugRenderer::DrawCross(const ezDebugRendererContext& context, const ezV
 // static
 void ezDebugRenderer::DrawLineBox(const ezDebugRendererContext& context, const ezBoundingBox& box, const ezColor& color, const ezTransform& transform)
 {
-  EZ_LOCK(s_Mutex);
-
-  auto& data = GetDataForExtraction(context);
-
-  auto& boxData = data.m_lineBoxes.ExpandAndGetRef();
-
-  ezTransform boxTransform(box.GetCenter(), ezQuat::IdentityQuaternion(), box.GetHalfExtents());
-
-  boxData.m_transform = transform * boxTransform;
-  boxData.m_color = color;
+  DrawLineBoxes(context, ezMakeArrayPtr(&box, 1), color, transform);
 }
 
 // static
@@ -468,40 +574,62 @@ void ezDebugRenderer::DrawLineBoxCorners(
 void ezDebugRenderer::DrawLineSphere(const ezDebugRendererContext& context, const ezBoundingSphere& sphere, const ezColor& color,
   const ezTransform& transform /*= ezTransform::IdentityTransform()*/)
 {
-  enum
-  {
-    NUM_SEGMENTS = 32
-  };
-
-  const ezVec3 vCenter = sphere.m_vCenter;
-  const float fRadius = sphere.m_fRadius;
-  const ezAngle stepAngle = ezAngle::Degree(360.0f / NUM_SEGMENTS);
+  DrawLineSpheres(context, ezMakeArrayPtr(&sphere, 1), color, transform);
+}
 
-  Line lines[NUM_SEGMENTS * 3];
-  for (ezUInt32 s = 0; s < NUM_SEGMENTS; ++s)
-  {
-    const float fS1 = (float)s;
-    const float fS2 = (float)(s + 1);
+// static
+void ezDebugRenderer::DrawLineBoxes(const ezDebugRendererContext& context, ezArrayPtr<const ezBoundingBox> boxes, const ezColor& color,
+  const ezTransform& transform /*= ezTransform::IdentityTransform()*/)
+{
+  if (boxes.IsEmpty())
+    return;
 
-    const float fCos1 = ezMath::Cos(fS1 * stepAngle);
-    const float fCos2 = ezMath::Cos(fS2 * stepAngle);
+  EZ_LOCK(s_Mutex);
 
-    const float fSin1 = ezMath::Sin(fS1 * stepAngle);
-    const float fSin2 = ezMath::Sin(fS2 * stepAngle);
+  auto& data = GetDataForExtraction(context);
 
-    lines[s * 3 + 0].m_start = transform * (vCenter + ezVec3(0.0f, fCos1, fSin1) * fRadius);
-    lines[s * 3 + 0].m_end = transform * (vCenter + ezVec3(0.0f, fCos2, fSin2) * fRadius);
+  const ezUInt32 uiStartIndex = data.m_lineBoxes.GetCount();
+  data.m_lineBoxes.SetCountUninitialized(uiStartIndex + boxes.GetCount());
 
-    lines[s * 3 + 1].m_start = transform * (vCenter + ezVec3(fCos1, 0.0f, fSin1) * fRadius);
-    lines[s * 3 + 1].m_end = transform * (vCenter + ezVec3(fCos2, 0.0f, fSin2) * fRadius);
+  BoxData* pBoxData = data.m_lineBoxes.GetData() + uiStartIndex;
+  for (const ezBoundingBox& box : boxes)
+  {
+    ezTransform boxTransform(box.GetCenter(), ezQuat::IdentityQuaternion(), box.GetHalfExtents());
 
-    lines[s * 3 + 2].m_start = transform * (vCenter + ezVec3(fCos1, fSin1, 0.0f) * fRadius);
-    lines[s * 3 + 2].m_end = transform * (vCenter + ezVec3(fCos2, fSin2, 0.0f) * fRadius);
+    pBoxData->m_transform = transform * boxTransform;
+    pBoxData->m_color = color;
+    ++pBoxData;
   }
-
-  DrawLines(context, lines, color);
 }
 
+// static
+void ezDebugRenderer::DrawLineSpheres(const ezDebugRendererContext& context, ezArrayPtr<const ezBoundingSphere> spheres, const ezColor& color,
+  const ezTransform& transform /*= ezTransform::IdentityTransform()*/)
+{
+  if (spheres.IsEmpty())
+    return;
+
+  const ezSimdTransform simdTransform = ezSimdConversion::ToTransform(transform);
+  const ezColorLinearUB vertexColor = color;
+  const ezBoundingSphere* pSpheres = spheres.GetPtr();
+
+  AddVertices(context, &PerContextData::m_lineVertices, spheres.GetCount(), SPHERE_LINES * 2,
+    [&](ezUInt32 uiStartSphere, ezUInt32 uiEndSphere, Vertex* pVertices) {
+      for (ezUInt32 i = uiStartSphere; i < uiEndSphere; ++i)
+      {
+        const ezSimdVec4f vCenter = ezSimdConversion::ToVec3(pSpheres[i].m_vCenter);
+        const ezSimdFloat fRadius = pSpheres[i].m_fRadius;
+
+        for (ezUInt32 p = 0; p < SPHERE_LINES * 2; ++p)
+        {
+          const ezSimdVec4f vPosition = simdTransform.TransformPosition(ezSimdVec4f::MulAdd(s_UnitSpherePoints[p], fRadius, vCenter));
+          vPosition.Store<3>(&pVertices->m_position.x);
+          pVertices->m_color = vertexColor;
+          ++pVertices;
+        }
+      }
+    });
+}
 
 void ezDebugRenderer::DrawLineCapsuleZ(const ezDebugRendererContext& context, float fLength, float fRadius, const ezColor& color,
   const ezTransform& transform /*= ezTransform::IdentityTransform()*/)
@@ -687,22 +815,14 @@ void ezDebugRenderer::DrawSolidBox(
 // static
 void ezDebugRenderer::DrawSolidTriangles(const ezDebugRendererContext& context, ezArrayPtr<Triangle> triangles, const ezColor& color)
 {
-  if (triangles.IsEmpty())
-    return;
-
-  EZ_LOCK(s_Mutex);
-
-  auto& data = GetDataForExtraction(context);
+  AddTriangles<Triangle>(context, triangles, color);
+}
 
-  for (auto& triangle : triangles)
-  {
-    for (ezUInt32 i = 0; i < 3; ++i)
-    {
-      auto& vertex = data.m_triangleVertices.ExpandAndGetRef();
-      vertex.m_position = triangle.m_position[i];
-      vertex.m_color = color;
-    }
-  }
+// static
+void ezDebugRenderer::DrawSolidTriangles(
+  const ezDebugRendererContext& context, ezArrayPtr<const ColoredTriangle> triangles, const ezColor& color /*= ezColor::White*/)
+{
+  AddTriangles<ColoredTriangle>(context, triangles, color);
 }
 
 void ezDebugRenderer::DrawTexturedTriangles(
@@ -1167,6 +1287,8 @@ void ezDebugRenderer::RenderInternal(const ezDebugRendererContext& context, cons
 
 void ezDebugRenderer::OnEngineStartup()
 {
+  InitUnitSpherePoints();
+
   {
     ezGeometry geom;
     geom.AddLineBox(ezVec3(2.0f), ezColor::White);
@@ -9,6 +9,26 @@ EZ_ALWAYS_INLINE ezDebugRenderer::Line::Line(const ezVec3& start, const ezVec3&
 
 //////////////////////////////////////////////////////////////////////////
 
+EZ_ALWAYS_INLINE ezDebugRenderer::ColoredLine::ColoredLine() = default;
+
+EZ_ALWAYS_INLINE ezDebugRenderer::ColoredLine::ColoredLine(const ezVec3& start, const ezVec3& end, const ezColor& color)
+  : m_start(start)
+  , m_end(end)
+  , m_startColor(color)
+  , m_endColor(color)
+{
+}
+
+EZ_ALWAYS_INLINE ezDebugRenderer::ColoredLine::ColoredLine(const ezVec3& start, const ezVec3& end, const ezColor& startColor, const ezColor& endColor)
+  : m_start(start)
+  , m_end(end)
+  , m_startColor(startColor)
+  , m_endColor(endColor)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 EZ_ALWAYS_INLINE ezDebugRenderer::Triangle::Triangle() = default;
 
 EZ_ALWAYS_INLINE ezDebugRenderer::Triangle::Triangle(const ezVec3& p0, const ezVec3& p1, const ezVec3& p2)
@@ -18,3 +38,15 @@ EZ_ALWAYS_INLINE ezDebugRenderer::Triangle::Triangle(const ezVec3& p0, const ezV
   m_position[1] = p1;
   m_position[2] = p2;
 }
+
+//////////////////////////////////////////////////////////////////////////
+
+EZ_ALWAYS_INLINE ezDebugRenderer::ColoredTriangle::ColoredTriangle() = default;
+
+EZ_ALWAYS_INLINE ezDebugRenderer::ColoredTriangle::ColoredTriangle(const ezVec3& p0, const ezVec3& p1, const ezVec3& p2, const ezColor& color)
+  : m_color(color)
+{
+  m_position[0] = p0;
+  m_position[1] = p1;
+  m_position[2] = p2;
+}
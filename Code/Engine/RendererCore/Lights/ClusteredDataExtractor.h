@@ -6,6 +6,7 @@
 struct ezPerLightData;
 struct ezPerDecalData;
 struct ezPerClusterData;
+class ezDecalRenderData;
 
 class ezClusteredDataCPU : public ezRenderData
 {
@@ -48,7 +49,7 @@ public:
     const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& extractedRenderData) override;
 
 private:
-  void FillItemListAndClusterData(ezClusteredDataCPU* pData);
+  void FillItemListAndClusterData(ezClusteredDataCPU* pData, bool bParallel);
 
   template <ezUInt32 MaxData>
   struct TempCluster
@@ -62,7 +63,8 @@ private:
   ezDynamicArray<ezPerDecalData, ezAlignedAllocatorWrapper> m_TempDecalData;
   ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_LIGHT_DATA>> m_TempLightsClusters;
   ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_DECAL_DATA>> m_TempDecalsClusters;
-  ezDynamicArray<ezUInt32> m_TempClusterItemList;
+  ezDynamicArray<const ezRenderData*> m_TempLightRenderData;
+  ezDynamicArray<const ezDecalRenderData*> m_TempDecalRenderData;
 
   ezDynamicArray<ezSimdBSphere, ezAlignedAllocatorWrapper> m_ClusterBoundingSpheres;
 };
@@ -3,6 +3,7 @@
 #include <Core/Graphics/Camera.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Components/FogComponent.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Lights/AmbientLightComponent.h>
@@ -11,17 +12,30 @@
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/View.h>
 
+ezCVarBool CVarParallelClusteredBinning(
+  "r_ParallelClusteredBinning", true, ezCVarFlags::Default, "Bins lights and decals into the light clusters and builds the cluster item list in parallel");
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 ezCVarBool CVarVisClusteredData("r_VisClusteredData", false, ezCVarFlags::Default, "Enables debug visualization of clustered light data");
 ezCVarInt CVarVisClusterDepthSlice("r_VisClusterDepthSlice", -1, ezCVarFlags::Default, "Show the debug visualization only for the given depth slice");
 
 namespace
 {
-  void VisualizeClusteredData(const ezView& view, const ezClusteredDataCPU* pData, ezArrayPtr<ezSimdBSphere> boundingSpheres)
+  void VisualizeClusteredData(
+    const ezView& view, const ezClusteredDataCPU* pData, ezArrayPtr<ezSimdBSphere> boundingSpheres, ezTime binningTime, ezTime itemListTime)
   {
     if (!CVarVisClusteredData)
       return;
 
+    {
+      ezStringBuilder sb;
+      sb.Format("Clustered Data: {0} lights, {1} decals, {2} items", pData->m_LightData.GetCount(), pData->m_DecalData.GetCount(), pData->m_ClusterItemList.GetCount());
+      ezDebugRenderer::Draw2DText(view.GetHandle(), sb, ezVec2I32(10, 320), ezColor::LimeGreen);
+
+      sb.Format("Binning: {0} ms, Item List: {1} ms", ezArgF(binningTime.GetMilliseconds(), 3), ezArgF(itemListTime.GetMilliseconds(), 3));
+      ezDebugRenderer::Draw2DText(view.GetHandle(), sb, ezVec2I32(10, 340), ezColor::LimeGreen);
+    }
+
     const ezCamera* pCamera = view.GetCullingCamera();
 
     if (pCamera->IsOrthographic())
@@ -39,6 +53,11 @@ namespace
 
     bool bDrawBoundingSphere = false;
 
+    // collect everything and submit it in one go, a single depth slice alone has thousands of clusters
+    ezDynamicArray<ezDebugRenderer::ColoredTriangle> tris;
+    ezDynamicArray<ezDebugRenderer::ColoredLine> lines;
+    ezDynamicArray<ezBoundingSphere> spheres;
+
     for (ezUInt32 z = maxSlice; z-- > minSlice;)
     {
       float fZf = GetDepthFromSliceIndex(z);
@@ -54,8 +73,7 @@ namespace
           {
             if (bDrawBoundingSphere)
             {
-              ezBoundingSphere s = ezSimdConversion::ToBSphere(boundingSpheres[clusterIndex]);
-              ezDebugRenderer::DrawLineSphere(view.GetHandle(), s, lineColor);
+              spheres.PushBack(ezSimdConversion::ToBSphere(boundingSpheres[clusterIndex]));
             }
 
             ezVec3 cc[8];
@@ -66,45 +84,43 @@ namespace
             float r = ezMath::Clamp(lightCount / 16.0f, 0.0f, 1.0f);
             float g = ezMath::Clamp(decalCount / 16.0f, 0.0f, 1.0f);
 
-            ezDebugRenderer::Triangle tris[12];
+            const ezColor triangleColor = ezColor(r, g, 0.0f, 0.1f);
+
             // back
-            tris[0] = ezDebugRenderer::Triangle(cc[0], cc[2], cc[1]);
-            tris[1] = ezDebugRenderer::Triangle(cc[2], cc[3], cc[1]);
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[0], cc[2], cc[1], triangleColor));
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[2], cc[3], cc[1], triangleColor));
             // front
-            tris[2] = ezDebugRenderer::Triangle(cc[4], cc[5], cc[6]);
-            tris[3] = ezDebugRenderer::Triangle(cc[6], cc[5], cc[7]);
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[4], cc[5], cc[6], triangleColor));
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[6], cc[5], cc[7], triangleColor));
             // top
-            tris[4] = ezDebugRenderer::Triangle(cc[4], cc[0], cc[5]);
-            tris[5] = ezDebugRenderer::Triangle(cc[0], cc[1], cc[5]);
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[4], cc[0], cc[5], triangleColor));
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[0], cc[1], cc[5], triangleColor));
             // bottom
-            tris[6] = ezDebugRenderer::Triangle(cc[6], cc[7], cc[2]);
-            tris[7] = ezDebugRenderer::Triangle(cc[2], cc[7], cc[3]);
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[6], cc[7], cc[2], triangleColor));
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[2], cc[7], cc[3], triangleColor));
             // left
-            tris[8] = ezDebugRenderer::Triangle(cc[4], cc[6], cc[0]);
-            tris[9] = ezDebugRenderer::Triangle(cc[0], cc[6], cc[2]);
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[4], cc[6], cc[0], triangleColor));
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[0], cc[6], cc[2], triangleColor));
             // right
-            tris[10] = ezDebugRenderer::Triangle(cc[5], cc[1], cc[7]);
-            tris[11] = ezDebugRenderer::Triangle(cc[1], cc[3], cc[7]);
-
-            ezDebugRenderer::DrawSolidTriangles(view.GetHandle(), tris, ezColor(r, g, 0.0f, 0.1f));
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[5], cc[1], cc[7], triangleColor));
+            tris.PushBack(ezDebugRenderer::ColoredTriangle(cc[1], cc[3], cc[7], triangleColor));
 
-            ezDebugRenderer::Line lines[12];
-            lines[0] = ezDebugRenderer::Line(cc[4], cc[5]);
-            lines[1] = ezDebugRenderer::Line(cc[5], cc[7]);
-            lines[2] = ezDebugRenderer::Line(cc[7], cc[6]);
-            lines[3] = ezDebugRenderer::Line(cc[6], cc[4]);
+            const ezColor clusterLineColor = ezColor(r, g, 0.0f);
 
-            lines[4] = ezDebugRenderer::Line(cc[0], cc[1]);
-            lines[5] = ezDebugRenderer::Line(cc[1], cc[3]);
-            lines[6] = ezDebugRenderer::Line(cc[3], cc[2]);
-            lines[7] = ezDebugRenderer::Line(cc[2], cc[0]);
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[4], cc[5], clusterLineColor));
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[5], cc[7], clusterLineColor));
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[7], cc[6], clusterLineColor));
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[6], cc[4], clusterLineColor));
 
-            lines[8] = ezDebugRenderer::Line(cc[4], cc[0]);
-            lines[9] = ezDebugRenderer::Line(cc[5], cc[1]);
-            lines[10] = ezDebugRenderer::Line(cc[7], cc[3]);
-            lines[11] = ezDebugRenderer::Line(cc[6], cc[2]);
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[0], cc[1], clusterLineColor));
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[1], cc[3], clusterLineColor));
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[3], cc[2], clusterLineColor));
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[2], cc[0], clusterLineColor));
 
-            ezDebugRenderer::DrawLines(view.GetHandle(), lines, ezColor(r, g, 0.0f));
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[4], cc[0], clusterLineColor));
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[5], cc[1], clusterLineColor));
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[7], cc[3], clusterLineColor));
+            lines.PushBack(ezDebugRenderer::ColoredLine(cc[6], cc[2], clusterLineColor));
           }
         }
       }
@@ -119,15 +135,16 @@ namespace
         ezVec3 p2 = depthFar - halfWidth - halfHeight;
         ezVec3 p3 = depthFar - halfWidth + halfHeight;
 
-        ezDebugRenderer::Line lines[4];
-        lines[0] = ezDebugRenderer::Line(p0, p1);
-        lines[1] = ezDebugRenderer::Line(p1, p2);
-        lines[2] = ezDebugRenderer::Line(p2, p3);
-        lines[3] = ezDebugRenderer::Line(p3, p0);
-
-        ezDebugRenderer::DrawLines(view.GetHandle(), lines, lineColor);
+        lines.PushBack(ezDebugRenderer::ColoredLine(p0, p1, lineColor));
+        lines.PushBack(ezDebugRenderer::ColoredLine(p1, p2, lineColor));
+        lines.PushBack(ezDebugRenderer::ColoredLine(p2, p3, lineColor));
+        lines.PushBack(ezDebugRenderer::ColoredLine(p3, p0, lineColor));
       }
     }
+
+    ezDebugRenderer::DrawSolidTriangles(view.GetHandle(), tris);
+    ezDebugRenderer::DrawLines(view.GetHandle(), lines);
+    ezDebugRenderer::DrawLineSpheres(view.GetHandle(), spheres, lineColor);
   }
 } // namespace
 #endif
@@ -178,6 +195,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
   // Lights
   {
     m_TempLightData.Clear();
+    m_TempLightRenderData.Clear();
     ezMemoryUtils::ZeroFill(m_TempLightsClusters.GetData(), NUM_CLUSTERS);
 
     auto batchList = extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Light);
@@ -199,42 +217,17 @@ void ezClusteredDataExtractor::PostSortAndBatch(
         if (auto pPointLightRenderData = ezDynamicCast<const ezPointLightRenderData*>(it))
         {
           FillPointLightData(m_TempLightData.ExpandAndGetRef(), pPointLightRenderData);
-
-          ezSimdBSphere pointLightSphere =
-            ezSimdBSphere(ezSimdConversion::ToVec3(pPointLightRenderData->m_GlobalTransform.m_vPosition), pPointLightRenderData->m_fRange);
-          RasterizePointLight(
-            pointLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
-
-          if (false)
-          {
-            ezSimdBBox ssb = GetScreenSpaceBounds(pointLightSphere, viewMatrix, projectionMatrix);
-            float minX = ((float)ssb.m_Min.x() * 0.5f + 0.5f) * view.GetViewport().width;
-            float maxX = ((float)ssb.m_Max.x() * 0.5f + 0.5f) * view.GetViewport().width;
-            float minY = ((float)ssb.m_Max.y() * -0.5f + 0.5f) * view.GetViewport().height;
-            float maxY = ((float)ssb.m_Min.y() * -0.5f + 0.5f) * view.GetViewport().height;
-
-            ezRectFloat rect(minX, minY, maxX - minX, maxY - minY);
-            ezDebugRenderer::Draw2DRectangle(view.GetHandle(), rect, 0.0f, ezColor::Blue.WithAlpha(0.3f));
-          }
+          m_TempLightRenderData.PushBack(pPointLightRenderData);
         }
         else if (auto pSpotLightRenderData = ezDynamicCast<const ezSpotLightRenderData*>(it))
         {
           FillSpotLightData(m_TempLightData.ExpandAndGetRef(), pSpotLightRenderData);
-
-          ezAngle halfAngle = pSpotLightRenderData->m_OuterSpotAngle / 2.0f;
-
-          BoundingCone cone;
-          cone.m_PositionAndRange = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_vPosition);
-          cone.m_PositionAndRange.SetW(pSpotLightRenderData->m_fRange);
-          cone.m_ForwardDir = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_qRotation * ezVec3(1.0f, 0.0f, 0.0f));
-          cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
-          RasterizeSpotLight(cone, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          m_TempLightRenderData.PushBack(pSpotLightRenderData);
         }
         else if (auto pDirLightRenderData = ezDynamicCast<const ezDirectionalLightRenderData*>(it))
         {
           FillDirLightData(m_TempLightData.ExpandAndGetRef(), pDirLightRenderData);
-
-          RasterizeDirLight(pDirLightRenderData, uiLightIndex, m_TempLightsClusters.GetArrayPtr());
+          m_TempLightRenderData.PushBack(pDirLightRenderData);
         }
         else if (auto pFogRenderData = ezDynamicCast<const ezFogRenderData*>(it))
         {
@@ -270,6 +263,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
   // Decals
   {
     m_TempDecalData.Clear();
+    m_TempDecalRenderData.Clear();
     ezMemoryUtils::ZeroFill(m_TempDecalsClusters.GetData(), NUM_CLUSTERS);
 
     auto batchList = extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Decal);
@@ -291,8 +285,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
         if (auto pDecalRenderData = ezDynamicCast<const ezDecalRenderData*>(it))
         {
           FillDecalData(m_TempDecalData.ExpandAndGetRef(), pDecalRenderData);
-
-          RasterizeDecal(pDecalRenderData, uiDecalIndex, viewProjectionMatrix, m_TempDecalsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          m_TempDecalRenderData.PushBack(pDecalRenderData);
         }
         else
         {
@@ -305,12 +298,87 @@ void ezClusteredDataExtractor::PostSortAndBatch(
     pData->m_DecalData.CopyFrom(m_TempDecalData);
   }
 
-  FillItemListAndClusterData(pData);
+  const bool bParallel = CVarParallelClusteredBinning;
+
+  // Binning
+  ezTime binningStartTime = ezTime::Now();
+  {
+    EZ_PROFILE_SCOPE("Light and Decal Binning");
+
+    // Every light and decal only sets its own bit in the cluster bitmasks. All items of one 32 bit block are rasterized by the same
+    // invocation, so invocations never write to the same bitmask entries and no synchronization or merging is needed.
+    const ezUInt32 uiNumLightBlocks = (m_TempLightRenderData.GetCount() + 31) / 32;
+    const ezUInt32 uiNumDecalBlocks = (m_TempDecalRenderData.GetCount() + 31) / 32;
+
+    auto rasterizeBlocks = [&](ezUInt32 uiStartBlock, ezUInt32 uiEndBlock) {
+      for (ezUInt32 uiBlock = uiStartBlock; uiBlock < uiEndBlock; ++uiBlock)
+      {
+        if (uiBlock < uiNumLightBlocks)
+        {
+          const ezUInt32 uiEndIndex = ezMath::Min((uiBlock + 1) * 32, m_TempLightRenderData.GetCount());
+          for (ezUInt32 uiLightIndex = uiBlock * 32; uiLightIndex < uiEndIndex; ++uiLightIndex)
+          {
+            const ezRenderData* pRenderData = m_TempLightRenderData[uiLightIndex];
+
+            if (auto pPointLightRenderData = ezDynamicCast<const ezPointLightRenderData*>(pRenderData))
+            {
+              ezSimdBSphere pointLightSphere =
+                ezSimdBSphere(ezSimdConversion::ToVec3(pPointLightRenderData->m_GlobalTransform.m_vPosition), pPointLightRenderData->m_fRange);
+              RasterizePointLight(
+                pointLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+            }
+            else if (auto pSpotLightRenderData = ezDynamicCast<const ezSpotLightRenderData*>(pRenderData))
+            {
+              ezAngle halfAngle = pSpotLightRenderData->m_OuterSpotAngle / 2.0f;
+
+              BoundingCone cone;
+              cone.m_PositionAndRange = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_vPosition);
+              cone.m_PositionAndRange.SetW(pSpotLightRenderData->m_fRange);
+              cone.m_ForwardDir = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_qRotation * ezVec3(1.0f, 0.0f, 0.0f));
+              cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
+              RasterizeSpotLight(cone, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+            }
+            else if (auto pDirLightRenderData = ezDynamicCast<const ezDirectionalLightRenderData*>(pRenderData))
+            {
+              RasterizeDirLight(pDirLightRenderData, uiLightIndex, m_TempLightsClusters.GetArrayPtr());
+            }
+          }
+        }
+        else
+        {
+          const ezUInt32 uiDecalBlock = uiBlock - uiNumLightBlocks;
+          const ezUInt32 uiEndIndex = ezMath::Min((uiDecalBlock + 1) * 32, m_TempDecalRenderData.GetCount());
+          for (ezUInt32 uiDecalIndex = uiDecalBlock * 32; uiDecalIndex < uiEndIndex; ++uiDecalIndex)
+          {
+            RasterizeDecal(m_TempDecalRenderData[uiDecalIndex], uiDecalIndex, viewProjectionMatrix, m_TempDecalsClusters.GetData(),
+              m_ClusterBoundingSpheres.GetData());
+          }
+        }
+      }
+    };
+
+    const ezUInt32 uiNumBlocks = uiNumLightBlocks + uiNumDecalBlocks;
+    if (bParallel && uiNumBlocks > 1)
+    {
+      ezParallelForParams params;
+      params.uiBinSize = 1;
+
+      ezTaskSystem::ParallelForIndexed(0, uiNumBlocks, rasterizeBlocks, "RasterizeLightsAndDecals", params);
+    }
+    else
+    {
+      rasterizeBlocks(0, uiNumBlocks);
+    }
+  }
+
+  ezTime itemListStartTime = ezTime::Now();
+  FillItemListAndClusterData(pData, bParallel);
+  ezTime endTime = ezTime::Now();
 
   extractedRenderData.AddFrameData(pData);
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  VisualizeClusteredData(view, pData, m_ClusterBoundingSpheres);
+  VisualizeClusteredData(view, pData, m_ClusterBoundingSpheres, itemListStartTime - binningStartTime, endTime - itemListStartTime);
 #endif
 }
 
@@ -319,9 +387,9 @@ namespace
   ezUInt32 PackIndex(ezUInt32 uiLightIndex, ezUInt32 uiDecalIndex) { return uiDecalIndex << 10 | uiLightIndex; }
 } // namespace
 
-void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pData)
+void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pData, bool bParallel)
 {
-  m_TempClusterItemList.Clear();
+  EZ_PROFILE_SCOPE("FillItemListAndClusterData");
 
   const ezUInt32 uiNumLights = m_TempLightData.GetCount();
   const ezUInt32 uiMaxLightBlockIndex = (uiNumLights + 31) / 32;
@@ -329,71 +397,115 @@ void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pD
   const ezUInt32 uiNumDecals = m_TempDecalData.GetCount();
   const ezUInt32 uiMaxDecalBlockIndex = (uiNumDecals + 31) / 32;
 
-  for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
-  {
-    ezUInt32 uiOffset = m_TempClusterItemList.GetCount();
-    ezUInt32 uiLightCount = 0;
-
-    // Lights
+  // Each invocation handles whole depth slices, the item list of a cluster only depends on the cluster's own bitmasks.
+  auto runForDepthSlices = [&](auto func, const char* szTaskName) {
+    if (bParallel)
     {
-      auto& tempCluster = m_TempLightsClusters[i];
-      for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxLightBlockIndex; ++uiBlockIndex)
-      {
-        ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
+      ezParallelForParams params;
+      params.uiBinSize = 1;
+
+      ezTaskSystem::ParallelForIndexed(
+        0, NUM_CLUSTERS_Z,
+        [&](ezUInt32 uiStartSlice, ezUInt32 uiEndSlice) {
+          func(uiStartSlice * NUM_CLUSTERS_XY, uiEndSlice * NUM_CLUSTERS_XY);
+        },
+        szTaskName, params);
+    }
+    else
+    {
+      func(0, NUM_CLUSTERS);
+    }
+  };
 
-        while (mask > 0)
+  // Count the items per cluster
+  runForDepthSlices(
+    [&](ezUInt32 uiStartCluster, ezUInt32 uiEndCluster) {
+      for (ezUInt32 i = uiStartCluster; i < uiEndCluster; ++i)
+      {
+        ezUInt32 uiLightCount = 0;
+        for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxLightBlockIndex; ++uiBlockIndex)
         {
-          ezUInt32 uiLightIndex = ezMath::FirstBitLow(mask);
-          mask &= ~(1 << uiLightIndex);
+          uiLightCount += ezMath::CountBits(m_TempLightsClusters[i].m_BitMask[uiBlockIndex]);
+        }
 
-          uiLightIndex += uiBlockIndex * 32;
-          m_TempClusterItemList.PushBack(uiLightIndex);
-          ++uiLightCount;
+        ezUInt32 uiDecalCount = 0;
+        for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxDecalBlockIndex; ++uiBlockIndex)
+        {
+          uiDecalCount += ezMath::CountBits(m_TempDecalsClusters[i].m_BitMask[uiBlockIndex]);
         }
+
+        pData->m_ClusterData[i].counts = PackIndex(uiLightCount, uiDecalCount);
       }
-    }
+    },
+    "CountClusterItems");
 
-    ezUInt32 uiDecalCount = 0;
+  // Lights and decals share the items of a cluster, so the number of items is the larger of both counts.
+  ezUInt32 uiNumItems = 0;
+  for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
+  {
+    auto& clusterData = pData->m_ClusterData[i];
+    clusterData.offset = uiNumItems;
 
-    // Decals
-    {
-      auto& tempCluster = m_TempDecalsClusters[i];
-      for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxDecalBlockIndex; ++uiBlockIndex)
+    const ezUInt32 uiCounts = clusterData.counts;
+    uiNumItems += ezMath::Max<ezUInt32>(GET_LIGHT_INDEX(uiCounts), GET_DECAL_INDEX(uiCounts));
+  }
+
+  pData->m_ClusterItemList = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, uiNumItems);
+
+  // Fill the items
+  runForDepthSlices(
+    [&](ezUInt32 uiStartCluster, ezUInt32 uiEndCluster) {
+      for (ezUInt32 i = uiStartCluster; i < uiEndCluster; ++i)
       {
-        ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
+        ezUInt32* pItems = pData->m_ClusterItemList.GetPtr() + pData->m_ClusterData[i].offset;
+        ezUInt32 uiLightCount = 0;
 
-        while (mask > 0)
+        // Lights
         {
-          ezUInt32 uiDecalIndex = ezMath::FirstBitLow(mask);
-          mask &= ~(1 << uiDecalIndex);
+          auto& tempCluster = m_TempLightsClusters[i];
+          for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxLightBlockIndex; ++uiBlockIndex)
+          {
+            ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
 
-          uiDecalIndex += uiBlockIndex * 32;
+            while (mask > 0)
+            {
+              ezUInt32 uiLightIndex = ezMath::FirstBitLow(mask);
+              mask &= ~(1 << uiLightIndex);
 
-          if (uiDecalCount < uiLightCount)
-          {
-            auto& item = m_TempClusterItemList[uiOffset + uiDecalCount];
-            item = PackIndex(item, uiDecalIndex);
+              uiLightIndex += uiBlockIndex * 32;
+              pItems[uiLightCount] = uiLightIndex;
+              ++uiLightCount;
+            }
           }
-          else
+        }
+
+        ezUInt32 uiDecalCount = 0;
+
+        // Decals
+        {
+          auto& tempCluster = m_TempDecalsClusters[i];
+          for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxDecalBlockIndex; ++uiBlockIndex)
           {
-            auto& item = m_TempClusterItemList.ExpandAndGetRef();
-            item = PackIndex(0, uiDecalIndex);
-          }
+            ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
 
-          ++uiDecalCount;
-        }
-      }
-    }
+            while (mask > 0)
+            {
+              ezUInt32 uiDecalIndex = ezMath::FirstBitLow(mask);
+              mask &= ~(1 << uiDecalIndex);
 
-    auto& clusterData = pData->m_ClusterData[i];
-    clusterData.offset = uiOffset;
-    clusterData.counts = PackIndex(uiLightCount, uiDecalCount);
-  }
+              uiDecalIndex += uiBlockIndex * 32;
 
-  pData->m_ClusterItemList = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, m_TempClusterItemList.GetCount());
-  pData->m_ClusterItemList.CopyFrom(m_TempClusterItemList);
-}
+              auto& item = pItems[uiDecalCount];
+              item = PackIndex(uiDecalCount < uiLightCount ? item : 0, uiDecalIndex);
 
+              ++uiDecalCount;
+            }
+          }
+        }
+      }
+    },
+    "FillClusterItems");
+}
 
 
 EZ_STATICLINK_FILE(RendererCore, RendererCore_Lights_Implementation_ClusteredDataExtractor);
@@ -1,6 +1,8 @@
 #include <RendererCorePCH.h>
 
 #include <Core/Graphics/Camera.h>
+#include <Core/World/SpatialSystem.h>
+#include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Math/Rect.h>
@@ -11,7 +13,9 @@
 #include <RendererCore/Lights/PointLightComponent.h>
 #include <RendererCore/Lights/SpotLightComponent.h>
 #include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderContext/RenderContext.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererCore/Shader/ShaderResource.h>
 #include <RendererFoundation/Context/Context.h>
 #include <RendererFoundation/Device/Device.h>
 #include <RendererFoundation/Resources/Texture.h>
@@ -44,6 +48,8 @@ EZ_END_SUBSYSTEM_DECLARATION;
 ezCVarBool CVarShadowPoolStats("r_ShadowPoolStats", false, ezCVarFlags::Default, "Display same stats of the shadow pool");
 #endif
 
+ezCVarBool CVarShadowCaching("r_ShadowCaching", true, ezCVarFlags::Default, "Re-use shadow maps of lights whose shadow casters did not change since the last frame");
+
 namespace
 {
   static ezUInt32 s_uiShadowAtlasTextureWidth = 4096; ///\todo make this configurable
@@ -70,6 +76,17 @@ namespace
     float m_fFadeOutStart;
     float m_fMinRange;
     ezUInt32 m_uiPackedDataOffset; // in 16 bytes steps
+
+    bool m_bCached;                           // shadow maps are still valid from the last frame and the views are not rendered
+    ezHybridArray<ezRectU32, 6> m_AtlasRects; // atlas location of the shadow maps, known up front for cached shadow maps
+  };
+
+  struct CachedShadowData
+  {
+    ezHybridArray<ezCamera, 6> m_Cameras;
+    ezHybridArray<ezRectU32, 6> m_AtlasRects;
+    ezUInt64 m_uiLastFrame = 0;    // render world frame in which the shadow maps were valid the last time
+    ezUInt64 m_uiSpatialFrame = 0; // spatial system frame from which on changes in the light frustum invalidate the shadow maps
   };
 
   struct LightAndRefView
@@ -187,6 +204,81 @@ namespace
     return ezRectU32(0, 0, 0, 0);
   }
 
+  // Reserves exactly the given rect. Used to keep cached shadow maps at the location they were rendered to.
+  static bool InsertAt(AtlasCell* pCell, const ezRectU32& rect, ezUInt32 uiDataIndex)
+  {
+    if (pCell->m_Rect.x > rect.x || pCell->m_Rect.y > rect.y || pCell->m_Rect.x + pCell->m_Rect.width < rect.x + rect.width ||
+        pCell->m_Rect.y + pCell->m_Rect.height < rect.y + rect.height)
+      return false;
+
+    if (pCell->IsLeaf())
+    {
+      if (pCell->m_uiDataIndex != ezInvalidIndex)
+        return false;
+
+      if (pCell->m_Rect.width == rect.width && pCell->m_Rect.height == rect.height)
+      {
+        pCell->m_uiDataIndex = uiDataIndex;
+        return true;
+      }
+
+      if (pCell->m_Rect.width / 2 < rect.width || pCell->m_Rect.height / 2 < rect.height)
+        return false;
+
+      // Split
+      ezUInt32 x = pCell->m_Rect.x;
+      ezUInt32 y = pCell->m_Rect.y;
+      ezUInt32 w = pCell->m_Rect.width / 2;
+      ezUInt32 h = pCell->m_Rect.height / 2;
+
+      ezUInt32 uiCellIndex = s_AtlasCells.GetCount();
+      s_AtlasCells.ExpandAndGetRef().m_Rect = ezRectU32(x, y, w, h);
+      s_AtlasCells.ExpandAndGetRef().m_Rect = ezRectU32(x + w, y, w, h);
+      s_AtlasCells.ExpandAndGetRef().m_Rect = ezRectU32(x, y + h, w, h);
+      s_AtlasCells.ExpandAndGetRef().m_Rect = ezRectU32(x + w, y + h, w, h);
+
+      for (ezUInt32 i = 0; i < 4; ++i)
+      {
+        pCell->m_uiChildIndices[i] = uiCellIndex + i;
+      }
+    }
+    else if (pCell->m_Rect.width == rect.width && pCell->m_Rect.height == rect.height)
+    {
+      // already split, thus parts of it are in use
+      return false;
+    }
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      if (InsertAt(&s_AtlasCells[pCell->m_uiChildIndices[i]], rect, uiDataIndex))
+        return true;
+    }
+
+    return false;
+  }
+
+  static ezUInt32 GetShadowMapSize(ezUInt32 uiType, float fShadowMapScale)
+  {
+    ezUInt32 uiShadowMapSize = s_uiShadowMapSize;
+    float fadeOutStart = s_fFadeOutScaleStart;
+
+    // point lights use a lot of atlas space thus we cut the shadow map size in half
+    if (uiType == LIGHT_TYPE_POINT)
+    {
+      uiShadowMapSize /= 2;
+      fadeOutStart *= 2.0f;
+    }
+
+    return ezMath::PowerOfTwo_Ceil((ezUInt32)(uiShadowMapSize * ezMath::Clamp(fShadowMapScale, fadeOutStart, 1.0f)));
+  }
+
+  static bool IsSameCamera(const ezCamera& a, const ezCamera& b)
+  {
+    return a.GetCameraMode() == b.GetCameraMode() && a.GetFovOrDim() == b.GetFovOrDim() && a.GetNearPlane() == b.GetNearPlane() &&
+           a.GetFarPlane() == b.GetFarPlane() && a.GetPosition() == b.GetPosition() && a.GetDirForwards() == b.GetDirForwards() &&
+           a.GetDirUp() == b.GetDirUp();
+  }
+
   static float AddSafeBorder(ezAngle fov, float fPenumbraSize)
   {
     float fHalfHeight = ezMath::Tan(fov * 0.5f);
@@ -247,6 +339,8 @@ struct ezShadowPool::Data
       desc.SetAsRenderTarget(s_uiShadowAtlasTextureWidth, s_uiShadowAtlasTextureHeight, ezGALResourceFormat::D16);
 
       m_hShadowAtlasTexture = ezGALDevice::GetDefaultDevice()->CreateTexture(desc);
+
+      m_hShadowAtlasClearShader = ezResourceManager::LoadResource<ezShaderResource>("Shaders/Pipeline/ShadowAtlasClear.ezShader");
     }
   }
 
@@ -339,6 +433,8 @@ struct ezShadowPool::Data
     out_pData->m_fFadeOutStart = 1.0f;
     out_pData->m_fMinRange = 1.0f;
     out_pData->m_uiPackedDataOffset = m_uiUsedPackedShadowData;
+    out_pData->m_bCached = false;
+    out_pData->m_AtlasRects.Clear();
 
     m_LightToShadowDataTable.Insert(key, m_uiUsedShadowData);
 
@@ -348,6 +444,135 @@ struct ezShadowPool::Data
     return false;
   }
 
+  /// \brief Checks whether the shadow maps of the given light can be re-used from the last frame and thus its views don't need to be
+  /// rendered.
+  ///
+  /// This is the case if the shadow cameras did not change and no shadow caster inside the light frustums was added, removed or moved.
+  /// Since dynamic objects are not tracked by the spatial system, any dynamic shadow caster inside the frustums prevents caching.
+  bool TryUseCachedShadowMaps(const ezLightComponent* pLight, const ezView* pReferenceView, ShadowData* pData)
+  {
+    if (!CVarShadowCaching)
+      return false;
+
+    LightAndRefView key = {pLight, pReferenceView};
+
+    const CachedShadowData* pCachedData = m_CachedShadowData.GetValue(key);
+    if (pCachedData == nullptr || pCachedData->m_uiLastFrame + 1 != ezRenderWorld::GetFrameCounter() ||
+        pCachedData->m_Cameras.GetCount() != pData->m_Views.GetCount())
+      return false;
+
+    // the shadow map resolution depends on the screen space size of the light
+    if (pCachedData->m_AtlasRects[0].width != GetShadowMapSize(pData->m_uiType, pData->m_fShadowMapScale))
+      return false;
+
+    const ezSpatialSystem* pSpatialSystem = pLight->GetWorld()->GetSpatialSystem();
+    if (pSpatialSystem == nullptr)
+      return false;
+
+    const ezUInt32 uiStaticCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+    const ezUInt32 uiDynamicCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+    const ezTag& tagCastShadows = ezTagRegistry::GetGlobalRegistry().RegisterTag("CastShadow");
+
+    ezHybridArray<const ezGameObject*, 32> dynamicObjects;
+
+    for (ezUInt32 uiViewIndex = 0; uiViewIndex < pData->m_Views.GetCount(); ++uiViewIndex)
+    {
+      ezView* pView = nullptr;
+      if (!ezRenderWorld::TryGetView(pData->m_Views[uiViewIndex], pView) || !IsSameCamera(*pView->GetCamera(), pCachedData->m_Cameras[uiViewIndex]))
+        return false;
+
+      ezFrustum frustum;
+      pView->ComputeCullingFrustum(frustum);
+
+      if (pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, pCachedData->m_uiSpatialFrame))
+        return false;
+
+      dynamicObjects.Clear();
+      pSpatialSystem->FindVisibleObjects(frustum, uiDynamicCategoryBitmask, dynamicObjects);
+
+      for (const ezGameObject* pObject : dynamicObjects)
+      {
+        if (pObject->GetTags().IsSet(tagCastShadows))
+          return false;
+      }
+    }
+
+    pData->m_bCached = true;
+    pData->m_AtlasRects = pCachedData->m_AtlasRects;
+    return true;
+  }
+
+  void AddViewsToRender(const ezLightComponent* pLight, const ezView* pReferenceView, ShadowData* pData)
+  {
+    if (TryUseCachedShadowMaps(pLight, pReferenceView, pData))
+      return;
+
+    for (auto hView : pData->m_Views)
+    {
+      ezRenderWorld::AddViewToRender(hView);
+    }
+  }
+
+  void UpdateCachedShadowData()
+  {
+    const ezUInt64 uiFrameCounter = ezRenderWorld::GetFrameCounter();
+
+    for (auto it = m_LightToShadowDataTable.GetIterator(); it.IsValid(); ++it)
+    {
+      const ShadowData& shadowData = m_ShadowData[it.Value()];
+
+      ezHybridArray<ezView*, 6> shadowViews;
+      bool bValid = true;
+
+      for (ezUInt32 uiViewIndex = 0; uiViewIndex < shadowData.m_Views.GetCount(); ++uiViewIndex)
+      {
+        ezView* pShadowView = nullptr;
+        ezRenderWorld::TryGetView(shadowData.m_Views[uiViewIndex], pShadowView);
+        shadowViews.PushBack(pShadowView);
+
+        bValid &= shadowData.m_AtlasRects[uiViewIndex].HasNonZeroArea();
+      }
+
+      const ezSpatialSystem* pSpatialSystem = shadowViews.IsEmpty() ? nullptr : shadowViews[0]->GetWorld()->GetSpatialSystem();
+      if (!bValid || pSpatialSystem == nullptr)
+      {
+        m_CachedShadowData.Remove(it.Key());
+        continue;
+      }
+
+      CachedShadowData& cachedData = m_CachedShadowData[it.Key()];
+      cachedData.m_uiLastFrame = uiFrameCounter;
+
+      if (!shadowData.m_bCached)
+      {
+        cachedData.m_Cameras.Clear();
+        for (ezView* pShadowView : shadowViews)
+        {
+          cachedData.m_Cameras.PushBack(*pShadowView->GetCamera());
+        }
+
+        cachedData.m_AtlasRects = shadowData.m_AtlasRects;
+      }
+
+      // Changes that happen after this point are tagged with the current or a later spatial frame. Changes earlier in the current frame
+      // have already been checked or rendered, checking them again next frame is merely conservative.
+      cachedData.m_uiSpatialFrame = pSpatialSystem->GetFrameCounter();
+    }
+
+    // remove lights that have not been extracted this frame
+    for (auto it = m_CachedShadowData.GetIterator(); it.IsValid();)
+    {
+      if (it.Value().m_uiLastFrame != uiFrameCounter)
+      {
+        it = m_CachedShadowData.Remove(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
   void Clear()
   {
     m_uiUsedViews = 0;
@@ -367,11 +592,16 @@ struct ezShadowPool::Data
   ezUInt32 m_uiUsedShadowData = 0;
   ezHashTable<LightAndRefView, ezUInt32> m_LightToShadowDataTable;
 
+  ezHashTable<LightAndRefView, CachedShadowData> m_CachedShadowData;
+  ezDynamicArray<ezRectU32> m_AtlasClearRects[2]; // atlas locations of shadow maps that are rendered this frame
+  bool m_bClearWholeAtlas[2] = {true, true};       // no shadow maps are re-used thus a regular clear is cheaper
+
   ezDynamicArray<ezVec4, ezAlignedAllocatorWrapper> m_PackedShadowData[2];
   ezUInt32 m_uiUsedPackedShadowData = 0; // in 16 bytes steps (sizeof(ezVec4))
 
   ezGALTextureHandle m_hShadowAtlasTexture;
   ezGALBufferHandle m_hShadowDataBuffer;
+  ezShaderResourceHandle m_hShadowAtlasClearShader;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -499,10 +729,10 @@ ezUInt32 ezShadowPool::AddDirectionalLight(const ezDirectionalLightComponent* pD
 
       camera.MoveLocally(0.0f, offset.x, offset.y);
     }
-
-    ezRenderWorld::AddViewToRender(shadowView.m_hView);
   }
 
+  s_pData->AddViewsToRender(pDirLight, pReferenceView, pData);
+
   return pData->m_uiPackedDataOffset;
 }
 
@@ -573,10 +803,10 @@ ezUInt32 ezShadowPool::AddPointLight(const ezPointLightComponent* pPointLight, f
       camera.LookAt(vPosition, vPosition + vForward, vUp);
       camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, fFov, fNearPlane, fFarPlane);
     }
-
-    ezRenderWorld::AddViewToRender(shadowView.m_hView);
   }
 
+  s_pData->AddViewsToRender(pPointLight, nullptr, pData);
+
   return pData->m_uiPackedDataOffset;
 }
 
@@ -625,7 +855,7 @@ ezUInt32 ezShadowPool::AddSpotLight(const ezSpotLightComponent* pSpotLight, floa
     camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, fFov, fNearPlane, fFarPlane);
   }
 
-  ezRenderWorld::AddViewToRender(shadowView.m_hView);
+  s_pData->AddViewsToRender(pSpotLight, nullptr, pData);
 
   return pData->m_uiPackedDataOffset;
 }
@@ -672,8 +902,15 @@ void ezShadowPool::OnExtractionEvent(const ezRenderWorldExtractionEvent& e)
   auto& packedShadowData = s_pData->m_PackedShadowData[uiDataIndex];
   packedShadowData.SetCountUninitialized(s_pData->m_uiUsedPackedShadowData);
 
+  auto& atlasClearRects = s_pData->m_AtlasClearRects[uiDataIndex];
+  atlasClearRects.Clear();
+  s_pData->m_bClearWholeAtlas[uiDataIndex] = true;
+
   if (s_pData->m_uiUsedShadowData == 0)
+  {
+    s_pData->UpdateCachedShadowData();
     return;
+  }
 
   // Sort by shadow map scale
   s_SortedShadowData.Clear();
@@ -693,6 +930,28 @@ void ezShadowPool::OnExtractionEvent(const ezRenderWorldExtractionEvent& e)
   s_AtlasCells.Clear();
   s_AtlasCells.ExpandAndGetRef().m_Rect = ezRectU32(0, 0, s_uiShadowAtlasTextureWidth, s_uiShadowAtlasTextureHeight);
 
+  // Cached shadow maps have to stay where they are, so reserve their atlas space first
+  ezUInt32 uiNumCachedShadows = 0;
+  for (ezUInt32 uiShadowDataIndex = 0; uiShadowDataIndex < s_pData->m_uiUsedShadowData; ++uiShadowDataIndex)
+  {
+    auto& shadowData = s_pData->m_ShadowData[uiShadowDataIndex];
+    if (!shadowData.m_bCached)
+      continue;
+
+    for (auto& atlasRect : shadowData.m_AtlasRects)
+    {
+      // can only fail if the atlas layout of the last frame was broken, the light has no shadow then since its views are not rendered
+      if (!InsertAt(&s_AtlasCells[0], atlasRect, uiShadowDataIndex))
+      {
+        atlasRect = ezRectU32(0, 0, 0, 0);
+      }
+    }
+
+    ++uiNumCachedShadows;
+  }
+
+  s_pData->m_bClearWholeAtlas[uiDataIndex] = uiNumCachedShadows == 0;
+
   float fAtlasInvWidth = 1.0f / s_uiShadowAtlasTextureWidth;
   float fAtlasInvHeight = 1.0f / s_uiShadowAtlasTextureWidth;
 
@@ -716,22 +975,29 @@ void ezShadowPool::OnExtractionEvent(const ezRenderWorldExtractionEvent& e)
     ezUInt32 uiShadowDataIndex = sorted.m_uiIndex;
     auto& shadowData = s_pData->m_ShadowData[uiShadowDataIndex];
 
-    ezUInt32 uiShadowMapSize = s_uiShadowMapSize;
     float fadeOutStart = s_fFadeOutScaleStart;
     float fadeOutEnd = s_fFadeOutScaleEnd;
 
     // point lights use a lot of atlas space thus we cut the shadow map size in half
     if (shadowData.m_uiType == LIGHT_TYPE_POINT)
     {
-      uiShadowMapSize /= 2;
       fadeOutStart *= 2.0f;
       fadeOutEnd *= 2.0f;
     }
 
-    uiShadowMapSize = ezMath::PowerOfTwo_Ceil((ezUInt32)(uiShadowMapSize * ezMath::Clamp(shadowData.m_fShadowMapScale, fadeOutStart, 1.0f)));
+    // cached shadow maps keep their size, the cache is invalidated as soon as the desired size changes
+    ezUInt32 uiShadowMapSize = GetShadowMapSize(shadowData.m_uiType, shadowData.m_fShadowMapScale);
+    if (shadowData.m_bCached)
+    {
+      uiShadowMapSize = shadowData.m_AtlasRects[0].width;
+    }
+    else
+    {
+      shadowData.m_AtlasRects.Clear();
+    }
 
     ezHybridArray<ezView*, 8> shadowViews;
-    ezHybridArray<ezRectU32, 8> atlasRects;
+    auto& atlasRects = shadowData.m_AtlasRects;
 
     // Fill atlas
     for (ezUInt32 uiViewIndex = 0; uiViewIndex < shadowData.m_Views.GetCount(); ++uiViewIndex)
@@ -742,16 +1008,25 @@ void ezShadowPool::OnExtractionEvent(const ezRenderWorldExtractionEvent& e)
 
       EZ_ASSERT_DEV(pShadowView != nullptr, "Implementation error");
 
-      ezRectU32 atlasRect = FindAtlasRect(uiShadowMapSize, uiShadowDataIndex);
-      atlasRects.PushBack(atlasRect);
+      if (!shadowData.m_bCached)
+      {
+        ezRectU32 atlasRect = FindAtlasRect(uiShadowMapSize, uiShadowDataIndex);
+        atlasRects.PushBack(atlasRect);
 
+        if (atlasRect.HasNonZeroArea())
+        {
+          atlasClearRects.PushBack(atlasRect);
+        }
+      }
+
+      const ezRectU32& atlasRect = atlasRects[uiViewIndex];
       pShadowView->SetViewport(ezRectFloat((float)atlasRect.x, (float)atlasRect.y, (float)atlasRect.width, (float)atlasRect.height));
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
       if (CVarShadowPoolStats)
       {
         ezStringBuilder sb;
-        sb.Format("{0}: {1} - {2}x{3}", pShadowView->GetName(), atlasRect.width, atlasRect.x, atlasRect.y);
+        sb.Format("{0}: {1} - {2}x{3}{4}", pShadowView->GetName(), atlasRect.width, atlasRect.x, atlasRect.y, shadowData.m_bCached ? " (cached)" : "");
 
         ezDebugRenderer::Draw2DText(debugContext, sb, ezVec2I32(10, iCurrentStatsOffset), ezColor::LightSteelBlue);
         iCurrentStatsOffset += 20;
@@ -932,12 +1207,14 @@ void ezShadowPool::OnExtractionEvent(const ezRenderWorldExtractionEvent& e)
   if (CVarShadowPoolStats)
   {
     ezStringBuilder sb;
-    sb.Format("Atlas Utilization: {0}%%", ezArgF(100.0 * (double)uiUsedAtlasSize / uiTotalAtlasSize, 2));
+    sb.Format("Atlas Utilization: {0}%%, Cached Lights: {1}/{2}", ezArgF(100.0 * (double)uiUsedAtlasSize / uiTotalAtlasSize, 2), uiNumCachedShadows,
+      s_pData->m_uiUsedShadowData);
 
     ezDebugRenderer::Draw2DText(debugContext, sb, ezVec2I32(10, 220), ezColor::LightSteelBlue);
   }
 #endif
 
+  s_pData->UpdateCachedShadowData();
   s_pData->Clear();
 }
 
@@ -949,6 +1226,7 @@ void ezShadowPool::OnRenderEvent(const ezRenderWorldRenderEvent& e)
 
   ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
   ezGALContext* pGALContext = pDevice->GetPrimaryContext();
+  ezUInt32 uiDataIndex = ezRenderWorld::GetDataIndexForRendering();
 
   if (!s_pData->m_hShadowAtlasTexture.IsInvalidated())
   {
@@ -957,13 +1235,29 @@ void ezShadowPool::OnRenderEvent(const ezRenderWorldRenderEvent& e)
     ezGALRenderTargetSetup renderTargetSetup;
     renderTargetSetup.SetDepthStencilTarget(pDevice->GetDefaultRenderTargetView(s_pData->m_hShadowAtlasTexture));
 
-    pGALContext->SetRenderTargetSetup(renderTargetSetup);
-    pGALContext->Clear(ezColor::White);
+    if (s_pData->m_bClearWholeAtlas[uiDataIndex])
+    {
+      pGALContext->SetRenderTargetSetup(renderTargetSetup);
+      pGALContext->Clear(ezColor::White);
+    }
+    else if (!s_pData->m_AtlasClearRects[uiDataIndex].IsEmpty())
+    {
+      // Only clear the shadow maps that are rendered this frame, the others are re-used from the last frame
+      ezRenderContext* pRenderContext = ezRenderContext::GetDefaultInstance();
+      pRenderContext->BindShader(s_pData->m_hShadowAtlasClearShader);
+      pRenderContext->BindMeshBuffer(ezGALBufferHandle(), ezGALBufferHandle(), nullptr, ezGALPrimitiveTopology::Triangles, 1);
+
+      for (const ezRectU32& atlasRect : s_pData->m_AtlasClearRects[uiDataIndex])
+      {
+        pRenderContext->SetViewportAndRenderTargetSetup(
+          ezRectFloat((float)atlasRect.x, (float)atlasRect.y, (float)atlasRect.width, (float)atlasRect.height), renderTargetSetup);
+        pRenderContext->DrawMeshBuffer();
+      }
+    }
   }
 
   if (!s_pData->m_hShadowDataBuffer.IsInvalidated())
   {
-    ezUInt32 uiDataIndex = ezRenderWorld::GetDataIndexForRendering();
     auto& packedShadowData = s_pData->m_PackedShadowData[uiDataIndex];
     if (!packedShadowData.IsEmpty())
     {
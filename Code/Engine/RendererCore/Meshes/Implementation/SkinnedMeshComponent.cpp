@@ -71,12 +71,12 @@ ezMeshRenderData* ezSkinnedMeshComponent::CreateRenderData() const
   return pRenderData;
 }
 
-void ezSkinnedMeshComponent::CreateSkinningTransformBuffer(ezArrayPtr<const ezMat4> skinningMatrices)
+void ezSkinnedMeshComponent::CreateSkinningTransformBuffer(ezArrayPtr<const ezShaderTransform> skinningMatrices)
 {
   EZ_ASSERT_DEBUG(m_hSkinningTransformsBuffer.IsInvalidated(), "The skinning buffer should not exist at this time");
 
   ezGALBufferCreationDescription BufferDesc;
-  BufferDesc.m_uiStructSize = sizeof(ezMat4);
+  BufferDesc.m_uiStructSize = sizeof(ezShaderTransform);
   BufferDesc.m_uiTotalSize = BufferDesc.m_uiStructSize * skinningMatrices.GetCount();
   BufferDesc.m_bUseAsStructuredBuffer = true;
   BufferDesc.m_bAllowShaderResourceView = true;
@@ -85,14 +85,6 @@ void ezSkinnedMeshComponent::CreateSkinningTransformBuffer(ezArrayPtr<const ezMa
   m_hSkinningTransformsBuffer = ezGALDevice::GetDefaultDevice()->CreateBuffer(BufferDesc, skinningMatrices.ToByteArray());
 }
 
-void ezSkinnedMeshComponent::UpdateSkinningTransformBuffer(ezArrayPtr<const ezMat4> skinningMatrices)
-{
-  ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, skinningMatrices.GetCount());
-  pRenderMatrices.CopyFrom(skinningMatrices);
-
-  m_SkinningMatrices = pRenderMatrices;
-}
-
 
 EZ_STATICLINK_FILE(RendererCore, RendererCore_Meshes_Implementation_SkinnedMeshComponent);
 
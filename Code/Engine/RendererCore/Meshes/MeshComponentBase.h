@@ -39,8 +39,10 @@ protected:
     ezUInt32 data[] = {uiMeshIDHash, uiMaterialIDHash, m_uiSubMeshIndex, m_uiFlipWinding, uiAdditionalBatchData};
     m_uiBatchId = ezHashingUtils::xxHash32(data, sizeof(data));
 
-    // Sort by material and then by mesh
-    m_uiSortingKey = (uiMaterialIDHash << 16) | (uiMeshIDHash & 0xFFFE) | m_uiFlipWinding;
+    // Sort by material and then by mesh part. The part index is folded into the key so that parts of the same mesh don't end up
+    // interleaved by distance, which would split them into many small batches and prevent them from being instanced.
+    const ezUInt32 uiMeshPartHash = uiMeshIDHash ^ (m_uiSubMeshIndex << 1);
+    m_uiSortingKey = (uiMaterialIDHash << 16) | (uiMeshPartHash & 0xFFFE) | m_uiFlipWinding;
   }
 };
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <RendererCore/Meshes/MeshComponentBase.h>
+#include <RendererCore/Shader/Types.h>
 
 class EZ_RENDERERCORE_DLL ezSkinnedMeshRenderData : public ezMeshRenderData
 {
@@ -44,9 +45,8 @@ public:
   ~ezSkinnedMeshComponent();
 
 protected:
-  void CreateSkinningTransformBuffer(ezArrayPtr<const ezMat4> skinningMatrices);
-  void UpdateSkinningTransformBuffer(ezArrayPtr<const ezMat4> skinningMatrices);
+  void CreateSkinningTransformBuffer(ezArrayPtr<const ezShaderTransform> skinningMatrices);
 
   ezGALBufferHandle m_hSkinningTransformsBuffer;
-  ezArrayPtr<const ezMat4> m_SkinningMatrices;
+  ezArrayPtr<const ezShaderTransform> m_SkinningMatrices; ///< Allocated with the frame allocator, only valid for the current frame
 };
@@ -34,6 +34,12 @@ public:
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category);
   void AddFrameData(const ezRenderData* pFrameData);
 
+  /// \brief Appends all render data and frame data of \a other.
+  ///
+  /// Sorting keys are taken over as they are, so \a other needs to be extracted with the same camera.
+  /// Used to merge the data of extractors or extraction tasks that ran in parallel before sorting.
+  void AppendRenderData(const ezExtractedRenderData& other);
+
   void SortAndBatch();
 
   void Clear();
@@ -50,12 +56,25 @@ public:
 private:
   const ezRenderData* GetFrameData(const ezRTTI* pRtti) const;
 
+  struct RadixSortEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiSortingKey;
+    const ezRenderData* m_pRenderData;
+    ezUInt32 m_uiBatchId;
+  };
+
   struct DataPerCategory
   {
     ezDynamicArray<ezRenderDataBatch> m_Batches;
     ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_SortableRenderData;
+    ezDynamicArray<RadixSortEntry> m_RadixSortEntries; ///< Scratch memory for the radix sort, kept to avoid allocations every frame.
   };
 
+  static void SortAndBatch(DataPerCategory& dataPerCategory);
+  static void RadixSort(DataPerCategory& dataPerCategory);
+
   ezCamera m_Camera;
   ezViewData m_ViewData;
   ezTime m_WorldTime;
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/RenderData.h>
 
 class EZ_RENDERERCORE_DLL ezExtractor : public ezReflectedClass
@@ -27,7 +30,7 @@ protected:
   /// \brief returns true if the given object should be filtered by view tags.
   bool FilterByViewTags(const ezView& view, const ezGameObject* pObject) const;
 
-  /// \brief extracts the render data for the given object.
+  /// \brief extracts the render data for the given object. Can be called from multiple threads at the same time.
   void ExtractRenderData(
     const ezView& view, const ezGameObject* pObject, ezMsgExtractRenderData& msg, ezExtractedRenderData& extractedRenderData) const;
 
@@ -42,8 +45,8 @@ protected:
   ezHybridArray<ezHashedString, 4> m_DependsOn;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  mutable ezUInt32 m_uiNumCachedRenderData;
-  mutable ezUInt32 m_uiNumUncachedRenderData;
+  mutable ezAtomicInteger32 m_uiNumCachedRenderData;
+  mutable ezAtomicInteger32 m_uiNumUncachedRenderData;
 #endif
 };
 
@@ -55,8 +58,14 @@ class EZ_RENDERERCORE_DLL ezVisibleObjectsExtractor : public ezExtractor
 public:
   ezVisibleObjectsExtractor(const char* szName = "VisibleObjectsExtractor");
 
+  /// \brief Extracts the visible objects in parallel chunks, each into its own ezExtractedRenderData, which are merged in order afterwards.
   virtual void Extract(
     const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& extractedRenderData) override;
+
+private:
+  void ExtractVisibleObjects(const ezView& view, ezArrayPtr<const ezGameObject* const> visibleObjects, ezExtractedRenderData& extractedRenderData) const;
+
+  ezDeque<ezExtractedRenderData> m_ChunkData;
 };
 
 class EZ_RENDERERCORE_DLL ezSelectedObjectsExtractor : public ezExtractor
@@ -1,6 +1,7 @@
 #include <RendererCorePCH.h>
 
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
 ezExtractedRenderData::ezExtractedRenderData() {}
@@ -19,10 +20,64 @@ void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
   m_FrameData.PushBack(pFrameData);
 }
 
+void ezExtractedRenderData::AppendRenderData(const ezExtractedRenderData& other)
+{
+  m_DataPerCategory.EnsureCount(other.m_DataPerCategory.GetCount());
+
+  for (ezUInt32 uiCategory = 0; uiCategory < other.m_DataPerCategory.GetCount(); ++uiCategory)
+  {
+    m_DataPerCategory[uiCategory].m_SortableRenderData.PushBackRange(other.m_DataPerCategory[uiCategory].m_SortableRenderData);
+  }
+
+  m_FrameData.PushBackRange(other.m_FrameData);
+}
+
+namespace
+{
+  // Below this number of render data per category a comparison sort is faster than the radix sort.
+  static const ezUInt32 s_uiMinRadixSortCount = 256;
+
+  // Categories are sorted in parallel only if there is enough render data overall.
+  static const ezUInt32 s_uiMinParallelSortCount = 4096;
+} // namespace
+
 void ezExtractedRenderData::SortAndBatch()
 {
   EZ_PROFILE_SCOPE("SortAndBatch");
 
+  ezUInt32 uiTotalCount = 0;
+  for (auto& dataPerCategory : m_DataPerCategory)
+  {
+    uiTotalCount += dataPerCategory.m_SortableRenderData.GetCount();
+  }
+
+  if (uiTotalCount >= s_uiMinParallelSortCount)
+  {
+    ezParallelForParams params;
+    params.uiMaxTasksPerThread = 1;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, m_DataPerCategory.GetCount(),
+      [this](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          SortAndBatch(m_DataPerCategory[i]);
+        }
+      },
+      "SortAndBatchCategories", params);
+  }
+  else
+  {
+    for (auto& dataPerCategory : m_DataPerCategory)
+    {
+      SortAndBatch(dataPerCategory);
+    }
+  }
+}
+
+// static
+void ezExtractedRenderData::SortAndBatch(DataPerCategory& dataPerCategory)
+{
   struct RenderDataComparer
   {
     EZ_FORCE_INLINE bool Less(const ezRenderDataBatch::SortableRenderData& a, const ezRenderDataBatch::SortableRenderData& b) const
@@ -36,36 +91,121 @@ void ezExtractedRenderData::SortAndBatch()
     }
   };
 
-  for (auto& dataPerCategory : m_DataPerCategory)
-  {
-    if (dataPerCategory.m_SortableRenderData.IsEmpty())
-      continue;
+  if (dataPerCategory.m_SortableRenderData.IsEmpty())
+    return;
 
-    auto& data = dataPerCategory.m_SortableRenderData;
+  auto& data = dataPerCategory.m_SortableRenderData;
 
-    // Sort
+  // Sort
+  if (data.GetCount() >= s_uiMinRadixSortCount)
+  {
+    RadixSort(dataPerCategory);
+  }
+  else
+  {
     data.Sort(RenderDataComparer());
+  }
 
-    // Find batches
-    ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
-    ezUInt32 uiCurrentBatchStartIndex = 0;
-    const ezRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
+  // Find batches
+  ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
+  ezUInt32 uiCurrentBatchStartIndex = 0;
+  const ezRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
 
-    for (ezUInt32 i = 1; i < data.GetCount(); ++i)
+  for (ezUInt32 i = 1; i < data.GetCount(); ++i)
+  {
+    auto pRenderData = data[i].m_pRenderData;
+
+    if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
     {
-      auto pRenderData = data[i].m_pRenderData;
+      dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
 
-      if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
-      {
-        dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
+      uiCurrentBatchId = pRenderData->m_uiBatchId;
+      uiCurrentBatchStartIndex = i;
+      pCurrentBatchType = pRenderData->GetDynamicRTTI();
+    }
+  }
+
+  dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
+}
+
+// static
+void ezExtractedRenderData::RadixSort(DataPerCategory& dataPerCategory)
+{
+  // LSD radix sort with 8 bit digits. The batch id is sorted first and since every pass is stable,
+  // the following passes over the sorting key keep it as secondary sort criterion.
+  // The batch id is fetched only once, so the render data isn't touched again while sorting.
+  const ezUInt32 uiNumBatchIdDigits = sizeof(ezUInt32);
+  const ezUInt32 uiNumDigits = uiNumBatchIdDigits + sizeof(ezUInt64);
+
+  auto& data = dataPerCategory.m_SortableRenderData;
+  const ezUInt32 uiCount = data.GetCount();
+
+  dataPerCategory.m_RadixSortEntries.SetCountUninitialized(uiCount * 2);
+  RadixSortEntry* pSource = dataPerCategory.m_RadixSortEntries.GetData();
+  RadixSortEntry* pTarget = pSource + uiCount;
+
+  ezUInt32 histograms[uiNumDigits][256] = {};
+
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    RadixSortEntry& entry = pSource[i];
+    entry.m_uiSortingKey = data[i].m_uiSortingKey;
+    entry.m_pRenderData = data[i].m_pRenderData;
+    entry.m_uiBatchId = entry.m_pRenderData->m_uiBatchId;
+
+    for (ezUInt32 uiDigit = 0; uiDigit < uiNumBatchIdDigits; ++uiDigit)
+    {
+      ++histograms[uiDigit][(entry.m_uiBatchId >> (uiDigit * 8)) & 0xFF];
+    }
+
+    for (ezUInt32 uiDigit = uiNumBatchIdDigits; uiDigit < uiNumDigits; ++uiDigit)
+    {
+      ++histograms[uiDigit][(entry.m_uiSortingKey >> ((uiDigit - uiNumBatchIdDigits) * 8)) & 0xFF];
+    }
+  }
 
-        uiCurrentBatchId = pRenderData->m_uiBatchId;
-        uiCurrentBatchStartIndex = i;
-        pCurrentBatchType = pRenderData->GetDynamicRTTI();
+  for (ezUInt32 uiDigit = 0; uiDigit < uiNumDigits; ++uiDigit)
+  {
+    const bool bBatchIdDigit = uiDigit < uiNumBatchIdDigits;
+    const ezUInt32 uiShift = (bBatchIdDigit ? uiDigit : uiDigit - uiNumBatchIdDigits) * 8;
+
+    ezUInt32* pOffsets = histograms[uiDigit];
+
+    // Skip the pass if all entries have the same value for this digit, e.g. the upper bytes of the batch id.
+    const ezUInt32 uiFirstValue = bBatchIdDigit ? (pSource[0].m_uiBatchId >> uiShift) & 0xFF : (pSource[0].m_uiSortingKey >> uiShift) & 0xFF;
+    if (pOffsets[uiFirstValue] == uiCount)
+      continue;
+
+    ezUInt32 uiOffset = 0;
+    for (ezUInt32 uiValue = 0; uiValue < 256; ++uiValue)
+    {
+      const ezUInt32 uiValueCount = pOffsets[uiValue];
+      pOffsets[uiValue] = uiOffset;
+      uiOffset += uiValueCount;
+    }
+
+    if (bBatchIdDigit)
+    {
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        pTarget[pOffsets[(pSource[i].m_uiBatchId >> uiShift) & 0xFF]++] = pSource[i];
+      }
+    }
+    else
+    {
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        pTarget[pOffsets[(pSource[i].m_uiSortingKey >> uiShift) & 0xFF]++] = pSource[i];
       }
     }
 
-    dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
+    ezMath::Swap(pSource, pTarget);
+  }
+
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    data[i].m_uiSortingKey = pSource[i].m_uiSortingKey;
+    data[i].m_pRenderData = pSource[i].m_pRenderData;
   }
 }
 
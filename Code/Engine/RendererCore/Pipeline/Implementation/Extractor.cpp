@@ -3,6 +3,7 @@
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/Extractor.h>
@@ -23,6 +24,11 @@ ezCVarString CVarVisObjectName(
 ezCVarBool CVarExtractionStats("r_ExtractionStats", false, ezCVarFlags::Default, "Display some stats of the render data extraction");
 #endif
 
+ezCVarBool CVarParallelObjectExtraction(
+  "r_ParallelObjectExtraction", true, ezCVarFlags::Default, "Extracts the render data of visible objects in parallel chunks");
+ezCVarInt CVarObjectExtractionChunkSize(
+  "r_ObjectExtractionChunkSize", 64, ezCVarFlags::Default, "Minimum number of visible objects that are extracted by one task");
+
 namespace
 {
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -231,8 +237,8 @@ void ezExtractor::ExtractRenderData(
   }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  m_uiNumCachedRenderData += msg.m_ExtractedRenderData.GetCount() - uiNumUncachedRenderData;
-  m_uiNumUncachedRenderData += uiNumUncachedRenderData;
+  m_uiNumCachedRenderData.Add(msg.m_ExtractedRenderData.GetCount() - uiNumUncachedRenderData);
+  m_uiNumUncachedRenderData.Add(uiNumUncachedRenderData);
 #endif
 }
 
@@ -258,9 +264,6 @@ ezVisibleObjectsExtractor::ezVisibleObjectsExtractor(const char* szName)
 void ezVisibleObjectsExtractor::Extract(
   const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& extractedRenderData)
 {
-  ezMsgExtractRenderData msg;
-  msg.m_pView = &view;
-
   EZ_LOCK(view.GetWorld()->GetReadMarker());
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -270,21 +273,43 @@ void ezVisibleObjectsExtractor::Extract(
   m_uiNumUncachedRenderData = 0;
 #endif
 
-  for (auto pObject : visibleObjects)
+  ezParallelForParams params;
+  params.uiBinSize = ezMath::Max(CVarObjectExtractionChunkSize.GetValue(), 1);
+  // message handlers may wait for other tasks, e.g. when they block until a resource is loaded or when the debug renderer
+  // processes large batches in parallel
+  params.nestingMode = ezTaskNesting::Maybe;
+
+  const ezUInt32 uiNumObjects = visibleObjects.GetCount();
+  const ezUInt32 uiNumChunks = CVarParallelObjectExtraction ? params.DetermineMultiplicity(uiNumObjects) : 0;
+
+  if (uiNumChunks <= 1)
   {
-    ExtractRenderData(view, pObject, msg, extractedRenderData);
+    ExtractVisibleObjects(view, visibleObjects, extractedRenderData);
+  }
+  else
+  {
+    const ezUInt32 uiObjectsPerChunk = params.DetermineItemsPerInvocation(uiNumObjects, uiNumChunks);
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (CVarVisBounds || CVarVisLocalBBox || CVarVisSpatialData)
+    m_ChunkData.SetCount(uiNumChunks);
+    for (auto& chunkData : m_ChunkData)
     {
-      if ((CVarVisObjectName.GetValue().IsEmpty() ||
-            ezStringUtils::FindSubString_NoCase(pObject->GetName(), CVarVisObjectName.GetValue()) != nullptr) &&
-          !CVarVisObjectSelection)
-      {
-        VisualizeObject(view, pObject);
-      }
+      chunkData.Clear();
+      chunkData.SetCamera(extractedRenderData.GetCamera());
+    }
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumObjects,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        const ezUInt32 uiChunkIndex = uiStartIndex / uiObjectsPerChunk;
+        ExtractVisibleObjects(view, visibleObjects.GetArrayPtr().GetSubArray(uiStartIndex, uiEndIndex - uiStartIndex), m_ChunkData[uiChunkIndex]);
+      },
+      "ExtractVisibleObjects", params);
+
+    // Merge in chunk order so the result is the same as with serial extraction.
+    for (const auto& chunkData : m_ChunkData)
+    {
+      extractedRenderData.AppendRenderData(chunkData);
     }
-#endif
   }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -298,15 +323,39 @@ void ezVisibleObjectsExtractor::Extract(
 
     ezDebugRenderer::Draw2DText(hView, "Extraction Stats", ezVec2I32(10, 200), ezColor::LimeGreen);
 
-    sb.Format("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.Format("Num Cached Render Data: {0}", (ezInt32)m_uiNumCachedRenderData);
     ezDebugRenderer::Draw2DText(hView, sb, ezVec2I32(10, 220), ezColor::LimeGreen);
 
-    sb.Format("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.Format("Num Uncached Render Data: {0}", (ezInt32)m_uiNumUncachedRenderData);
     ezDebugRenderer::Draw2DText(hView, sb, ezVec2I32(10, 240), ezColor::LimeGreen);
   }
 #endif
 }
 
+void ezVisibleObjectsExtractor::ExtractVisibleObjects(
+  const ezView& view, ezArrayPtr<const ezGameObject* const> visibleObjects, ezExtractedRenderData& extractedRenderData) const
+{
+  ezMsgExtractRenderData msg;
+  msg.m_pView = &view;
+
+  for (auto pObject : visibleObjects)
+  {
+    ExtractRenderData(view, pObject, msg, extractedRenderData);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (CVarVisBounds || CVarVisLocalBBox || CVarVisSpatialData)
+    {
+      if ((CVarVisObjectName.GetValue().IsEmpty() ||
+            ezStringUtils::FindSubString_NoCase(pObject->GetName(), CVarVisObjectName.GetValue()) != nullptr) &&
+          !CVarVisObjectSelection)
+      {
+        VisualizeObject(view, pObject);
+      }
+    }
+#endif
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSelectedObjectsExtractor, 1, ezRTTINoAllocator)
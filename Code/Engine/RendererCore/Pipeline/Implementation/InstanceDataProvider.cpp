@@ -1,8 +1,10 @@
 #include <RendererCorePCH.h>
 
+#include <Foundation/Utilities/Stats.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/InstanceDataProvider.h>
 #include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
 #include <RendererFoundation/Profiling/Profiling.h>
 
 #include <RendererCore/../../../Data/Base/Shaders/Common/ObjectConstants.h>
@@ -62,6 +64,9 @@ void ezInstanceData::UpdateInstanceData(ezRenderContext* pRenderContext, ezUInt3
   pConstants->InstanceDataOffset = m_uiBufferOffset;
 
   m_uiBufferOffset += uiCount;
+
+  ++m_uiNumDrawCalls;
+  m_uiNumInstances += uiCount;
 }
 
 void ezInstanceData::CreateBuffer(ezUInt32 uiSize)
@@ -94,17 +99,57 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezInstanceDataProvider, 1, ezRTTIDefaultAllocato
   }
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
-ezInstanceDataProvider::ezInstanceDataProvider() {}
+ezInstanceData* ezInstanceDataProvider::s_pSharedData = nullptr;
+ezUInt32 ezInstanceDataProvider::s_uiSharedDataRefCount = 0;
 
-ezInstanceDataProvider::~ezInstanceDataProvider() {}
+namespace
+{
+  static constexpr ezUInt32 s_uiSharedInstanceDataCount = 16 * 1024;
+}
 
-void* ezInstanceDataProvider::UpdateData(const ezRenderViewContext& renderViewContext, const ezExtractedRenderData& extractedData)
+ezInstanceDataProvider::ezInstanceDataProvider()
+{
+  if (s_uiSharedDataRefCount++ == 0)
+  {
+    s_pSharedData = EZ_DEFAULT_NEW(ezInstanceData, s_uiSharedInstanceDataCount);
+
+    ezRenderWorld::GetRenderEvent().AddEventHandler(&ezInstanceDataProvider::OnRenderEvent);
+  }
+}
+
+ezInstanceDataProvider::~ezInstanceDataProvider()
 {
-  m_Data.Reset();
+  if (--s_uiSharedDataRefCount == 0)
+  {
+    ezRenderWorld::GetRenderEvent().RemoveEventHandler(&ezInstanceDataProvider::OnRenderEvent);
 
-  return &m_Data;
+    EZ_DEFAULT_DELETE(s_pSharedData);
+  }
 }
 
+void* ezInstanceDataProvider::UpdateData(const ezRenderViewContext& renderViewContext, const ezExtractedRenderData& extractedData)
+{
+  // Nothing to do here. The shared data is not reset per view, GetInstanceData wraps around once the buffer is full
+  // and the following update discards the buffer.
+  return s_pSharedData;
+}
+
+// static
+void ezInstanceDataProvider::OnRenderEvent(const ezRenderWorldRenderEvent& e)
+{
+  if (e.m_Type != ezRenderWorldRenderEvent::Type::BeginRender)
+    return;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  // report the counters of the previous frame
+  ezStats::SetStat("Instancing/DrawCalls", s_pSharedData->m_uiNumDrawCalls);
+  ezStats::SetStat("Instancing/Instances", s_pSharedData->m_uiNumInstances);
+  ezStats::SetStat("Instancing/DrawCallsSaved", s_pSharedData->m_uiNumInstances - s_pSharedData->m_uiNumDrawCalls);
+#endif
+
+  s_pSharedData->m_uiNumDrawCalls = 0;
+  s_pSharedData->m_uiNumInstances = 0;
+}
 
 
 EZ_STATICLINK_FILE(RendererCore, RendererCore_Pipeline_Implementation_InstanceDataProvider);
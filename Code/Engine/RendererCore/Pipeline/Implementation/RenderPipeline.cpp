@@ -1,7 +1,10 @@
 #include <RendererCorePCH.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Clock.h>
+#include <Foundation/Utilities/Stats.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/GPUResourcePool/GPUResourcePool.h>
 #include <RendererCore/Pipeline/Extractor.h>
@@ -19,6 +22,8 @@ ezCVarBool ezRenderPipeline::s_DebugCulling("r_DebugCulling", false, ezCVarFlags
 ezCVarBool CVarCullingStats("r_CullingStats", false, ezCVarFlags::Default, "Display some stats of the visibility culling");
 #endif
 
+ezCVarBool CVarParallelExtractors("r_ParallelExtractors", true, ezCVarFlags::Default, "Runs independent extractors of a render pipeline in parallel");
+
 ezRenderPipeline::ezRenderPipeline()
   : m_PipelineState(PipelineState::Uninitialized)
 {
@@ -520,6 +525,8 @@ bool ezRenderPipeline::CreateRenderTargetUsage(const ezView& view)
           texData.m_bTargetTexture = false;
           texData.m_uiFirstUsageIdx = i;
           texData.m_uiLastUsageIdx = i;
+          texData.m_uiMemoryRegion = 0xFFFF;
+          texData.m_uiMemorySize = 0;
           texData.m_UsedBy.PushBack(pConn);
         }
       }
@@ -594,9 +601,167 @@ bool ezRenderPipeline::CreateRenderTargetUsage(const ezView& view)
   m_TextureUsageIdxSortedByFirstUsage.Sort(FirstUsageComparer(m_TextureUsage));
   m_TextureUsageIdxSortedByLastUsage.Sort(LastUsageComparer(m_TextureUsage));
 
+  PlanTransientMemory();
+
   return true;
 }
 
+void ezRenderPipeline::PlanTransientMemory()
+{
+  ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
+
+  ezHybridArray<TransientTexture, 32> textures;
+  textures.SetCount(m_TextureUsageIdxSortedByFirstUsage.GetCount());
+
+  for (ezUInt32 i = 0; i < textures.GetCount(); ++i)
+  {
+    TextureUsageData& usageData = m_TextureUsage[m_TextureUsageIdxSortedByFirstUsage[i]];
+    const ezGALTextureCreationDescription& desc = usageData.m_UsedBy[0]->m_Desc;
+
+    usageData.m_uiMemorySize = pDevice->GetMemoryConsumptionForTexture(desc);
+
+    TransientTexture& texture = textures[i];
+    texture.m_uiFirstUsageIdx = usageData.m_uiFirstUsageIdx;
+    texture.m_uiLastUsageIdx = usageData.m_uiLastUsageIdx;
+    texture.m_uiDescHash = desc.CalculateHash();
+    texture.m_uiMemorySize = usageData.m_uiMemorySize;
+  }
+
+  PlanTransientMemory(textures, m_TransientMemoryPlan);
+
+  for (ezUInt32 i = 0; i < textures.GetCount(); ++i)
+  {
+    m_TextureUsage[m_TextureUsageIdxSortedByFirstUsage[i]].m_uiMemoryRegion = textures[i].m_uiMemoryRegion;
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  const float fPooledMB = float(m_TransientMemoryPlan.m_uiPooledMemory) / (1024.0f * 1024.0f);
+  const float fAliasedMB = float(m_TransientMemoryPlan.m_uiAliasedMemory) / (1024.0f * 1024.0f);
+
+  ezLog::Dev("{0} pool textures: {1} Mb with the resource pool, {2} Mb in {3} aliased memory regions", m_TextureUsageIdxSortedByFirstUsage.GetCount(),
+    ezArgF(fPooledMB, 2), ezArgF(fAliasedMB, 2), m_TransientMemoryPlan.m_Regions.GetCount());
+
+  ezStringBuilder sStatName;
+  ezStringBuilder sOut;
+
+  sStatName.Format("Render Pipeline/{0}/Transient Memory Pooled", m_sName);
+  sOut.Format("{0} (Mb)", ezArgF(fPooledMB, 4));
+  ezStats::SetStat(sStatName, sOut.GetData());
+
+  sStatName.Format("Render Pipeline/{0}/Transient Memory Aliased", m_sName);
+  sOut.Format("{0} (Mb)", ezArgF(fAliasedMB, 4));
+  ezStats::SetStat(sStatName, sOut.GetData());
+#endif
+}
+
+// static
+void ezRenderPipeline::PlanTransientMemory(ezArrayPtr<TransientTexture> textures, TransientMemoryPlan& out_Plan)
+{
+  out_Plan.m_Regions.Clear();
+  out_Plan.m_uiPooledMemory = 0;
+  out_Plan.m_uiAliasedMemory = 0;
+
+  // Pool textures are acquired before their first usage pass and returned after their last usage pass, so two of them can share
+  // memory if their [first, last] intervals don't overlap. Since the intervals are visited sorted by their start, greedily assigning
+  // each one to a free slot is an optimal coloring of the interval graph. The same simulation is run twice, once the way the resource
+  // pool works today, where only textures with identical descriptions can be reused, and once with memory regions that can hold any
+  // texture that fits.
+  struct PooledTexture
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiDescHash;
+    ezUInt16 m_uiBusyUntilIdx;
+  };
+  ezHybridArray<PooledTexture, 32> pooledTextures;
+  ezHybridArray<ezUInt16, 32> regionBusyUntilIdx;
+
+  for (ezUInt32 i = 0; i < textures.GetCount(); ++i)
+  {
+    TransientTexture& texture = textures[i];
+    EZ_ASSERT_DEV(i == 0 || textures[i - 1].m_uiFirstUsageIdx <= texture.m_uiFirstUsageIdx, "Textures must be sorted by their first usage");
+
+    // Resource pool
+    {
+      bool bReused = false;
+      for (PooledTexture& pooledTexture : pooledTextures)
+      {
+        if (pooledTexture.m_uiDescHash == texture.m_uiDescHash && pooledTexture.m_uiBusyUntilIdx < texture.m_uiFirstUsageIdx)
+        {
+          pooledTexture.m_uiBusyUntilIdx = texture.m_uiLastUsageIdx;
+          bReused = true;
+          break;
+        }
+      }
+
+      if (!bReused)
+      {
+        PooledTexture& pooledTexture = pooledTextures.ExpandAndGetRef();
+        pooledTexture.m_uiDescHash = texture.m_uiDescHash;
+        pooledTexture.m_uiBusyUntilIdx = texture.m_uiLastUsageIdx;
+        out_Plan.m_uiPooledMemory += texture.m_uiMemorySize;
+      }
+    }
+
+    // Memory regions, prefer the smallest free region that fits, otherwise grow the largest free one.
+    {
+      ezUInt32 uiBestFit = ezInvalidIndex;
+      ezUInt32 uiLargest = ezInvalidIndex;
+
+      for (ezUInt32 r = 0; r < out_Plan.m_Regions.GetCount(); ++r)
+      {
+        if (regionBusyUntilIdx[r] >= texture.m_uiFirstUsageIdx)
+          continue;
+
+        const ezUInt64 uiRegionSize = out_Plan.m_Regions[r];
+        if (uiRegionSize >= texture.m_uiMemorySize)
+        {
+          if (uiBestFit == ezInvalidIndex || uiRegionSize < out_Plan.m_Regions[uiBestFit])
+            uiBestFit = r;
+        }
+        else if (uiLargest == ezInvalidIndex || uiRegionSize > out_Plan.m_Regions[uiLargest])
+        {
+          uiLargest = r;
+        }
+      }
+
+      ezUInt32 uiRegion = uiBestFit != ezInvalidIndex ? uiBestFit : uiLargest;
+      if (uiRegion == ezInvalidIndex)
+      {
+        uiRegion = out_Plan.m_Regions.GetCount();
+        out_Plan.m_Regions.PushBack(0);
+        regionBusyUntilIdx.PushBack(0);
+      }
+
+      out_Plan.m_Regions[uiRegion] = ezMath::Max(out_Plan.m_Regions[uiRegion], texture.m_uiMemorySize);
+      regionBusyUntilIdx[uiRegion] = texture.m_uiLastUsageIdx;
+      texture.m_uiMemoryRegion = static_cast<ezUInt16>(uiRegion);
+    }
+  }
+
+  for (ezUInt64 uiRegionSize : out_Plan.m_Regions)
+  {
+    out_Plan.m_uiAliasedMemory += uiRegionSize;
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  // Validate the plan, no two textures that are alive at the same time may share a region.
+  for (ezUInt32 i = 0; i < textures.GetCount(); ++i)
+  {
+    const TransientTexture& a = textures[i];
+    EZ_ASSERT_DEBUG(out_Plan.m_Regions[a.m_uiMemoryRegion] >= a.m_uiMemorySize, "Memory region is too small");
+
+    for (ezUInt32 j = i + 1; j < textures.GetCount(); ++j)
+    {
+      const TransientTexture& b = textures[j];
+      EZ_ASSERT_DEBUG(a.m_uiMemoryRegion != b.m_uiMemoryRegion || a.m_uiLastUsageIdx < b.m_uiFirstUsageIdx ||
+                        b.m_uiLastUsageIdx < a.m_uiFirstUsageIdx,
+        "Pool textures with overlapping lifetimes were assigned to the same memory region");
+    }
+  }
+#endif
+}
+
 bool ezRenderPipeline::InitRenderPipelinePasses()
 {
   ezLogBlock b("Init Render Pipeline Passes");
@@ -769,6 +934,9 @@ void ezRenderPipeline::ClearRenderPassGraphTextures()
   m_TextureUsage.Clear();
   m_TextureUsageIdxSortedByFirstUsage.Clear();
   m_TextureUsageIdxSortedByLastUsage.Clear();
+  m_TransientMemoryPlan.m_Regions.Clear();
+  m_TransientMemoryPlan.m_uiPooledMemory = 0;
+  m_TransientMemoryPlan.m_uiAliasedMemory = 0;
 
   // ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
 
@@ -885,13 +1053,26 @@ void ezRenderPipeline::ExtractData(const ezView& view)
   data.SetViewDebugContext(view.GetHandle());
 
   // Extract object render data
+  ezUInt32 uiNumActiveExtractors = 0;
   for (auto& pExtractor : m_Extractors)
   {
-    if (pExtractor->m_bActive)
+    uiNumActiveExtractors += pExtractor->m_bActive ? 1 : 0;
+  }
+
+  if (CVarParallelExtractors && uiNumActiveExtractors > 1)
+  {
+    ExtractDataParallel(view, data);
+  }
+  else
+  {
+    for (auto& pExtractor : m_Extractors)
     {
-      EZ_PROFILE_SCOPE(pExtractor->m_sName.GetData());
+      if (pExtractor->m_bActive)
+      {
+        EZ_PROFILE_SCOPE(pExtractor->m_sName.GetData());
 
-      pExtractor->Extract(view, m_visibleObjects, data);
+        pExtractor->Extract(view, m_visibleObjects, data);
+      }
     }
   }
 
@@ -910,6 +1091,93 @@ void ezRenderPipeline::ExtractData(const ezView& view)
   m_CurrentExtractThread = (ezThreadID)0;
 }
 
+void ezRenderPipeline::ExtractDataParallel(const ezView& view, ezExtractedRenderData& data)
+{
+  const ezUInt32 uiNumExtractors = m_Extractors.GetCount();
+
+  m_pExtractView = &view;
+  m_ExtractorData.SetCount(uiNumExtractors);
+
+  while (m_ExtractorTasks.GetCount() < uiNumExtractors)
+  {
+    const ezUInt32 uiExtractorIndex = m_ExtractorTasks.GetCount();
+    m_ExtractorTasks.PushBack(EZ_DEFAULT_NEW(ezDelegateTask<ezUInt32>, "", ezMakeDelegate(&ezRenderPipeline::RunExtractor, this), uiExtractorIndex));
+  }
+
+  ezHybridArray<ezTaskGroupID, 16> taskGroups;
+  taskGroups.SetCount(uiNumExtractors);
+
+  for (ezUInt32 i = 0; i < uiNumExtractors; ++i)
+  {
+    const ezExtractor* pExtractor = m_Extractors[i].Borrow();
+    if (!pExtractor->m_bActive)
+      continue;
+
+    // Sorting keys are computed while adding render data, so every extractor needs to see the same camera.
+    ezExtractedRenderData& extractorData = m_ExtractorData[i];
+    extractorData.Clear();
+    extractorData.SetCamera(data.GetCamera());
+    extractorData.SetViewData(data.GetViewData());
+    extractorData.SetWorldTime(data.GetWorldTime());
+    extractorData.SetWorldDebugContext(data.GetWorldDebugContext());
+    extractorData.SetViewDebugContext(data.GetViewDebugContext());
+
+    // Extractors may use parallel for loops themselves, so the task has to be allowed to wait.
+    m_ExtractorTasks[i]->ConfigureTask(pExtractor->m_sName.GetData(), ezTaskNesting::Maybe);
+
+    taskGroups[i] = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+    ezTaskSystem::AddTaskToGroup(taskGroups[i], m_ExtractorTasks[i]);
+
+    // The extractors are sorted by their dependencies, so the groups of all dependencies have already been created.
+    for (auto& sDependency : pExtractor->m_DependsOn)
+    {
+      for (ezUInt32 j = 0; j < i; ++j)
+      {
+        if (m_Extractors[j]->m_bActive && sDependency == m_Extractors[j]->GetDynamicRTTI()->GetTypeNameHash())
+        {
+          ezTaskSystem::AddTaskGroupDependency(taskGroups[i], taskGroups[j]);
+        }
+      }
+    }
+  }
+
+  for (ezUInt32 i = 0; i < uiNumExtractors; ++i)
+  {
+    if (m_Extractors[i]->m_bActive)
+    {
+      ezTaskSystem::StartTaskGroup(taskGroups[i]);
+    }
+  }
+
+  {
+    EZ_PROFILE_SCOPE("Wait for Extractors");
+
+    for (ezUInt32 i = 0; i < uiNumExtractors; ++i)
+    {
+      if (m_Extractors[i]->m_bActive)
+      {
+        ezTaskSystem::WaitForGroup(taskGroups[i]);
+      }
+    }
+  }
+
+  // Merge in extractor order so the result doesn't depend on how the tasks were scheduled.
+  for (ezUInt32 i = 0; i < uiNumExtractors; ++i)
+  {
+    if (m_Extractors[i]->m_bActive)
+    {
+      data.AppendRenderData(m_ExtractorData[i]);
+    }
+  }
+
+  m_pExtractView = nullptr;
+}
+
+void ezRenderPipeline::RunExtractor(const ezUInt32& uiExtractorIndex)
+{
+  m_Extractors[uiExtractorIndex]->Extract(*m_pExtractView, m_visibleObjects, m_ExtractorData[uiExtractorIndex]);
+}
+
 void ezRenderPipeline::FindVisibleObjects(const ezView& view)
 {
   EZ_PROFILE_SCOPE("Visibility Culling");
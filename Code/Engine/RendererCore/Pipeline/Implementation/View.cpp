@@ -130,6 +130,8 @@ void ezView::ExtractData()
   extractionEvent.m_uiFrameCounter = ezRenderWorld::GetFrameCounter();
   ezRenderWorld::s_ExtractionEvent.Broadcast(extractionEvent);
 
+  ezRenderWorld::AcquireRenderDataCache(*this);
+
   m_pRenderPipeline->m_sName = m_sName;
   m_pRenderPipeline->ExtractData(*this);
 
@@ -5,6 +5,7 @@
 #include <RendererCore/Shader/ConstantBufferStorage.h>
 
 struct ezPerInstanceData;
+struct ezRenderWorldRenderEvent;
 class ezInstanceDataProvider;
 class ezInstancedMeshComponent;
 
@@ -35,6 +36,9 @@ private:
   ezUInt32 m_uiBufferSize;
   ezUInt32 m_uiBufferOffset;
   ezDynamicArray<ezPerInstanceData, ezAlignedAllocatorWrapper> m_perInstanceData;
+
+  ezUInt32 m_uiNumDrawCalls = 0;
+  ezUInt32 m_uiNumInstances = 0;
 };
 
 class EZ_RENDERERCORE_DLL ezInstanceDataProvider : public ezFrameDataProvider<ezInstanceData>
@@ -48,5 +52,10 @@ public:
 private:
   virtual void* UpdateData(const ezRenderViewContext& renderViewContext, const ezExtractedRenderData& extractedData) override;
 
-  ezInstanceData m_Data;
+  static void OnRenderEvent(const ezRenderWorldRenderEvent& e);
+
+  // All pipelines share one large instance data buffer that is used as a ring buffer across views and frames,
+  // so that instances are appended without discarding the buffer for every view.
+  static ezInstanceData* s_pSharedData;
+  static ezUInt32 s_uiSharedDataRefCount;
 };
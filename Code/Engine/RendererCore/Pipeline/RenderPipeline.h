@@ -1,9 +1,11 @@
 #pragma once
 
 #include <Foundation/Configuration/CVar.h>
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Types/SharedPtr.h>
 #include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
@@ -11,6 +13,7 @@ class ezProfilingId;
 class ezView;
 class ezRenderPipelinePass;
 class ezFrameDataProviderBase;
+class ezTask;
 
 class EZ_RENDERERCORE_DLL ezRenderPipeline : public ezRefCounted
 {
@@ -54,6 +57,31 @@ public:
   ezRenderDataBatchList GetRenderDataBatchesWithCategory(
     ezRenderData::Category category, ezRenderDataBatch::Filter filter = ezRenderDataBatch::Filter()) const;
 
+  /// \brief Lifetime and size of a pool texture, see PlanTransientMemory().
+  struct TransientTexture
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt16 m_uiFirstUsageIdx = 0;
+    ezUInt16 m_uiLastUsageIdx = 0;
+    ezUInt32 m_uiDescHash = 0; ///< Only textures with the same description can be reused by the resource pool.
+    ezUInt64 m_uiMemorySize = 0;
+    ezUInt16 m_uiMemoryRegion = 0; ///< Written by PlanTransientMemory(), index into TransientMemoryPlan::m_Regions.
+  };
+
+  struct TransientMemoryPlan
+  {
+    ezDynamicArray<ezUInt64> m_Regions; ///< A region is as large as its largest occupant.
+    ezUInt64 m_uiPooledMemory = 0;      ///< Peak memory of the textures when only identical descriptions share memory.
+    ezUInt64 m_uiAliasedMemory = 0;     ///< Peak memory of the textures when they are placed into m_Regions.
+  };
+
+  /// \brief Assigns pool textures to memory regions so that textures whose [first, last] usage intervals overlap never share a region.
+  ///
+  /// The textures must be sorted by their first usage. Also computes the peak memory that the resource pool needs for the same textures.
+  /// The GAL has no API for placing textures into shared memory yet, so the plan only serves as a report for now.
+  static void PlanTransientMemory(ezArrayPtr<TransientTexture> textures, TransientMemoryPlan& out_Plan);
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   static ezCVarBool s_DebugCulling;
 #endif
@@ -70,6 +98,7 @@ private:
   bool SortPasses();
   bool InitRenderTargetDescriptions(const ezView& view);
   bool CreateRenderTargetUsage(const ezView& view);
+  void PlanTransientMemory();
   bool InitRenderPipelinePasses();
   void SortExtractors();
   void UpdateViewData(const ezView& view, ezUInt32 uiDataIndex);
@@ -82,6 +111,8 @@ private:
   ezFrameDataProviderBase* GetFrameDataProvider(const ezRTTI* pRtti) const;
 
   void ExtractData(const ezView& view);
+  void ExtractDataParallel(const ezView& view, ezExtractedRenderData& data);
+  void RunExtractor(const ezUInt32& uiExtractorIndex);
   void FindVisibleObjects(const ezView& view);
 
   void Render(ezRenderContext* pRenderer);
@@ -122,6 +153,8 @@ private: // Member data
     ezUInt16 m_uiFirstUsageIdx;
     ezUInt16 m_uiLastUsageIdx;
     bool m_bTargetTexture;
+    ezUInt16 m_uiMemoryRegion; ///< Index into m_TransientMemoryPlan.m_Regions, only valid for pool textures.
+    ezUInt64 m_uiMemorySize;
   };
   ezDynamicArray<TextureUsageData> m_TextureUsage;
   ezDynamicArray<ezUInt16> m_TextureUsageIdxSortedByFirstUsage; ///< Indices map into m_TextureUsage
@@ -129,10 +162,18 @@ private: // Member data
 
   ezHashTable<ezRenderPipelinePassConnection*, ezUInt32> m_ConnectionToTextureIndex;
 
+  /// \brief Memory plan for the pool textures, computed from their lifetimes by PlanTransientMemory.
+  TransientMemoryPlan m_TransientMemoryPlan;
+
   // Extractors
   ezDynamicArray<ezUniquePtr<ezExtractor>> m_Extractors;
   ezDynamicArray<ezUniquePtr<ezExtractor>> m_SortedExtractors;
 
+  // Parallel extraction: every extractor writes into its own data which is merged into m_Data once all extractors have finished.
+  const ezView* m_pExtractView = nullptr;
+  ezDeque<ezExtractedRenderData> m_ExtractorData;
+  ezDynamicArray<ezSharedPtr<ezTask>> m_ExtractorTasks;
+
   // Data Providers
   mutable ezDynamicArray<ezUniquePtr<ezFrameDataProviderBase>> m_DataProviders;
   mutable ezHashTable<const ezRTTI*, ezUInt32> m_TypeToDataProviderIndex;
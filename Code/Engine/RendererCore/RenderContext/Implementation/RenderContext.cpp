@@ -14,6 +14,31 @@
 #include <RendererFoundation/Resources/RenderTargetView.h>
 #include <RendererFoundation/Resources/Texture.h>
 
+namespace
+{
+  template <typename T>
+  bool SetBoundResource(ezDynamicArray<T>& boundResources, ezUInt32 uiNameIndex, const T& resource)
+  {
+    if (uiNameIndex >= boundResources.GetCount())
+    {
+      boundResources.SetCount(uiNameIndex + 1);
+    }
+    else if (boundResources[uiNameIndex] == resource)
+    {
+      return false;
+    }
+
+    boundResources[uiNameIndex] = resource;
+    return true;
+  }
+
+  template <typename T>
+  T GetBoundResource(const ezDynamicArray<T>& boundResources, ezUInt32 uiNameIndex)
+  {
+    return uiNameIndex < boundResources.GetCount() ? boundResources[uiNameIndex] : T();
+  }
+} // namespace
+
 ezRenderContext* ezRenderContext::s_DefaultInstance = nullptr;
 ezHybridArray<ezRenderContext*, 4> ezRenderContext::s_Instances;
 
@@ -208,72 +233,32 @@ void ezRenderContext::BindTextureCube(const ezTempHashedString& sSlotName, const
 
 void ezRenderContext::BindTexture2D(const ezTempHashedString& sSlotName, ezGALResourceViewHandle hResourceView)
 {
-  ezGALResourceViewHandle* pOldResourceView = nullptr;
-  if (m_BoundTextures2D.TryGetValue(sSlotName.GetHash(), pOldResourceView))
-  {
-    if (*pOldResourceView == hResourceView)
-      return;
-
-    *pOldResourceView = hResourceView;
-  }
-  else
-  {
-    m_BoundTextures2D.Insert(sSlotName.GetHash(), hResourceView);
-  }
+  if (!SetBoundResource(m_BoundTextures2D, GetSlotNameIndex(ezShaderBindingLayout::Group::Textures, sSlotName), hResourceView))
+    return;
 
   m_StateFlags.Add(ezRenderContextFlags::TextureBindingChanged);
 }
 
 void ezRenderContext::BindTexture3D(const ezTempHashedString& sSlotName, ezGALResourceViewHandle hResourceView)
 {
-  ezGALResourceViewHandle* pOldResourceView = nullptr;
-  if (m_BoundTextures3D.TryGetValue(sSlotName.GetHash(), pOldResourceView))
-  {
-    if (*pOldResourceView == hResourceView)
-      return;
-
-    *pOldResourceView = hResourceView;
-  }
-  else
-  {
-    m_BoundTextures3D.Insert(sSlotName.GetHash(), hResourceView);
-  }
+  if (!SetBoundResource(m_BoundTextures3D, GetSlotNameIndex(ezShaderBindingLayout::Group::Textures, sSlotName), hResourceView))
+    return;
 
   m_StateFlags.Add(ezRenderContextFlags::TextureBindingChanged);
 }
 
 void ezRenderContext::BindTextureCube(const ezTempHashedString& sSlotName, ezGALResourceViewHandle hResourceView)
 {
-  ezGALResourceViewHandle* pOldResourceView = nullptr;
-  if (m_BoundTexturesCube.TryGetValue(sSlotName.GetHash(), pOldResourceView))
-  {
-    if (*pOldResourceView == hResourceView)
-      return;
-
-    *pOldResourceView = hResourceView;
-  }
-  else
-  {
-    m_BoundTexturesCube.Insert(sSlotName.GetHash(), hResourceView);
-  }
+  if (!SetBoundResource(m_BoundTexturesCube, GetSlotNameIndex(ezShaderBindingLayout::Group::Textures, sSlotName), hResourceView))
+    return;
 
   m_StateFlags.Add(ezRenderContextFlags::TextureBindingChanged);
 }
 
 void ezRenderContext::BindUAV(const ezTempHashedString& sSlotName, ezGALUnorderedAccessViewHandle hUnorderedAccessView)
 {
-  ezGALUnorderedAccessViewHandle* pOldResourceView = nullptr;
-  if (m_BoundUAVs.TryGetValue(sSlotName.GetHash(), pOldResourceView))
-  {
-    if (*pOldResourceView == hUnorderedAccessView)
-      return;
-
-    *pOldResourceView = hUnorderedAccessView;
-  }
-  else
-  {
-    m_BoundUAVs.Insert(sSlotName.GetHash(), hUnorderedAccessView);
-  }
+  if (!SetBoundResource(m_BoundUAVs, GetSlotNameIndex(ezShaderBindingLayout::Group::UAVs, sSlotName), hUnorderedAccessView))
+    return;
 
   m_StateFlags.Add(ezRenderContextFlags::UAVBindingChanged);
 }
@@ -286,74 +271,40 @@ void ezRenderContext::BindSamplerState(const ezTempHashedString& sSlotName, ezGA
   EZ_ASSERT_DEBUG(sSlotName != "PointSampler", "'PointSampler' is a resevered sampler name and must not be set manually.");
   EZ_ASSERT_DEBUG(sSlotName != "PointClampSampler", "'PointClampSampler' is a resevered sampler name and must not be set manually.");
 
-  ezGALSamplerStateHandle* pOldSamplerState = nullptr;
-  if (m_BoundSamplers.TryGetValue(sSlotName.GetHash(), pOldSamplerState))
-  {
-    if (*pOldSamplerState == hSamplerSate)
-      return;
-
-    *pOldSamplerState = hSamplerSate;
-  }
-  else
-  {
-    m_BoundSamplers.Insert(sSlotName.GetHash(), hSamplerSate);
-  }
+  if (!SetBoundResource(m_BoundSamplers, GetSlotNameIndex(ezShaderBindingLayout::Group::Samplers, sSlotName), hSamplerSate))
+    return;
 
   m_StateFlags.Add(ezRenderContextFlags::SamplerBindingChanged);
 }
 
 void ezRenderContext::BindBuffer(const ezTempHashedString& sSlotName, ezGALResourceViewHandle hResourceView)
 {
-  ezGALResourceViewHandle* pOldResourceView = nullptr;
-  if (m_BoundBuffer.TryGetValue(sSlotName.GetHash(), pOldResourceView))
-  {
-    if (*pOldResourceView == hResourceView)
-      return;
-
-    *pOldResourceView = hResourceView;
-  }
-  else
-  {
-    m_BoundBuffer.Insert(sSlotName.GetHash(), hResourceView);
-  }
+  if (!SetBoundResource(m_BoundBuffer, GetSlotNameIndex(ezShaderBindingLayout::Group::Buffers, sSlotName), hResourceView))
+    return;
 
   m_StateFlags.Add(ezRenderContextFlags::BufferBindingChanged);
 }
 
 void ezRenderContext::BindConstantBuffer(const ezTempHashedString& sSlotName, ezGALBufferHandle hConstantBuffer)
 {
-  BoundConstantBuffer* pBoundConstantBuffer = nullptr;
-  if (m_BoundConstantBuffers.TryGetValue(sSlotName.GetHash(), pBoundConstantBuffer))
-  {
-    if (pBoundConstantBuffer->m_hConstantBuffer == hConstantBuffer)
-      return;
+  BoundConstantBuffer& boundConstantBuffer = GetBoundConstantBuffer(GetSlotNameIndex(ezShaderBindingLayout::Group::ConstantBuffers, sSlotName));
+  if (boundConstantBuffer.m_hConstantBuffer == hConstantBuffer && boundConstantBuffer.m_hConstantBufferStorage.IsInvalidated())
+    return;
 
-    pBoundConstantBuffer->m_hConstantBuffer = hConstantBuffer;
-    pBoundConstantBuffer->m_hConstantBufferStorage.Invalidate();
-  }
-  else
-  {
-    m_BoundConstantBuffers.Insert(sSlotName.GetHash(), BoundConstantBuffer(hConstantBuffer));
-  }
+  boundConstantBuffer.m_hConstantBuffer = hConstantBuffer;
+  boundConstantBuffer.m_hConstantBufferStorage.Invalidate();
 
   m_StateFlags.Add(ezRenderContextFlags::ConstantBufferBindingChanged);
 }
 
 void ezRenderContext::BindConstantBuffer(const ezTempHashedString& sSlotName, ezConstantBufferStorageHandle hConstantBufferStorage)
 {
-  BoundConstantBuffer* pBoundConstantBuffer = nullptr;
-  if (m_BoundConstantBuffers.TryGetValue(sSlotName.GetHash(), pBoundConstantBuffer))
-  {
-    if (pBoundConstantBuffer->m_hConstantBufferStorage == hConstantBufferStorage)
-      return;
+  BoundConstantBuffer& boundConstantBuffer = GetBoundConstantBuffer(GetSlotNameIndex(ezShaderBindingLayout::Group::ConstantBuffers, sSlotName));
+  if (boundConstantBuffer.m_hConstantBufferStorage == hConstantBufferStorage && boundConstantBuffer.m_hConstantBuffer.IsInvalidated())
+    return;
 
-    pBoundConstantBuffer->m_hConstantBuffer.Invalidate();
-    pBoundConstantBuffer->m_hConstantBufferStorage = hConstantBufferStorage;
-  }
-  else
-  {
-    m_BoundConstantBuffers.Insert(sSlotName.GetHash(), BoundConstantBuffer(hConstantBufferStorage));
-  }
+  boundConstantBuffer.m_hConstantBuffer.Invalidate();
+  boundConstantBuffer.m_hConstantBufferStorage = hConstantBufferStorage;
 
   m_StateFlags.Add(ezRenderContextFlags::ConstantBufferBindingChanged);
 }
@@ -520,54 +471,28 @@ ezResult ezRenderContext::ApplyContextStates(bool bForce)
 
     if (bForce || m_StateFlags.IsSet(ezRenderContextFlags::UAVBindingChanged))
     {
-      // RWTextures/UAV are usually only suppoprted in compute and pixel shader.
-      if (auto pBin = pShaderPermutation->GetShaderStageBinary(ezGALShaderStage::ComputeShader))
-      {
-        ApplyUAVBindings(pBin);
-      }
-      if (auto pBin = pShaderPermutation->GetShaderStageBinary(ezGALShaderStage::PixelShader))
-      {
-        ApplyUAVBindings(pBin);
-      }
+      ApplyUAVBindings(pShaderPermutation->GetBindingLayout());
 
       m_StateFlags.Remove(ezRenderContextFlags::UAVBindingChanged);
     }
 
     if (bForce || m_StateFlags.IsSet(ezRenderContextFlags::TextureBindingChanged))
     {
-      for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
-      {
-        if (auto pBin = pShaderPermutation->GetShaderStageBinary((ezGALShaderStage::Enum)stage))
-        {
-          ApplyTextureBindings((ezGALShaderStage::Enum)stage, pBin);
-        }
-      }
+      ApplyTextureBindings(pShaderPermutation->GetBindingLayout());
 
       m_StateFlags.Remove(ezRenderContextFlags::TextureBindingChanged);
     }
 
     if (bForce || m_StateFlags.IsSet(ezRenderContextFlags::SamplerBindingChanged))
     {
-      for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
-      {
-        if (auto pBin = pShaderPermutation->GetShaderStageBinary((ezGALShaderStage::Enum)stage))
-        {
-          ApplySamplerBindings((ezGALShaderStage::Enum)stage, pBin);
-        }
-      }
+      ApplySamplerBindings(pShaderPermutation->GetBindingLayout());
 
       m_StateFlags.Remove(ezRenderContextFlags::SamplerBindingChanged);
     }
 
     if (bForce || m_StateFlags.IsSet(ezRenderContextFlags::BufferBindingChanged))
     {
-      for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
-      {
-        if (auto pBin = pShaderPermutation->GetShaderStageBinary((ezGALShaderStage::Enum)stage))
-        {
-          ApplyBufferBindings((ezGALShaderStage::Enum)stage, pBin);
-        }
-      }
+      ApplyBufferBindings(pShaderPermutation->GetBindingLayout());
 
       m_StateFlags.Remove(ezRenderContextFlags::BufferBindingChanged);
     }
@@ -582,13 +507,7 @@ ezResult ezRenderContext::ApplyContextStates(bool bForce)
 
     if (bForce || m_StateFlags.IsSet(ezRenderContextFlags::ConstantBufferBindingChanged))
     {
-      for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
-      {
-        if (auto pBin = pShaderPermutation->GetShaderStageBinary((ezGALShaderStage::Enum)stage))
-        {
-          ApplyConstantBufferBindings(pBin);
-        }
-      }
+      ApplyConstantBufferBindings(pShaderPermutation->GetBindingLayout());
 
       m_StateFlags.Remove(ezRenderContextFlags::ConstantBufferBindingChanged);
     }
@@ -648,11 +567,13 @@ void ezRenderContext::ResetContextState()
   m_BoundBuffer.Clear();
 
   m_BoundSamplers.Clear();
-  m_BoundSamplers.Insert(ezTempHashedString::ComputeHash("LinearSampler"), GetDefaultSamplerState(ezDefaultSamplerFlags::LinearFiltering));
-  m_BoundSamplers.Insert(ezTempHashedString::ComputeHash("LinearClampSampler"),
+  SetBoundResource(m_BoundSamplers, GetSlotNameIndex(ezShaderBindingLayout::Group::Samplers, "LinearSampler"),
+    GetDefaultSamplerState(ezDefaultSamplerFlags::LinearFiltering));
+  SetBoundResource(m_BoundSamplers, GetSlotNameIndex(ezShaderBindingLayout::Group::Samplers, "LinearClampSampler"),
     GetDefaultSamplerState(ezDefaultSamplerFlags::LinearFiltering | ezDefaultSamplerFlags::Clamp));
-  m_BoundSamplers.Insert(ezTempHashedString::ComputeHash("PointSampler"), GetDefaultSamplerState(ezDefaultSamplerFlags::PointFiltering));
-  m_BoundSamplers.Insert(ezTempHashedString::ComputeHash("PointClampSampler"),
+  SetBoundResource(m_BoundSamplers, GetSlotNameIndex(ezShaderBindingLayout::Group::Samplers, "PointSampler"),
+    GetDefaultSamplerState(ezDefaultSamplerFlags::PointFiltering));
+  SetBoundResource(m_BoundSamplers, GetSlotNameIndex(ezShaderBindingLayout::Group::Samplers, "PointClampSampler"),
     GetDefaultSamplerState(ezDefaultSamplerFlags::PointFiltering | ezDefaultSamplerFlags::Clamp));
 
   m_BoundUAVs.Clear();
@@ -918,9 +839,12 @@ void ezRenderContext::UploadConstants()
 {
   BindConstantBuffer("ezGlobalConstants", m_hGlobalConstantBufferStorage);
 
-  for (auto it = m_BoundConstantBuffers.GetIterator(); it.IsValid(); ++it)
+  for (const BoundConstantBuffer& boundConstantBuffer : m_BoundConstantBuffers)
   {
-    ezConstantBufferStorageHandle hConstantBufferStorage = it.Value().m_hConstantBufferStorage;
+    ezConstantBufferStorageHandle hConstantBufferStorage = boundConstantBuffer.m_hConstantBufferStorage;
+    if (hConstantBufferStorage.IsInvalidated())
+      continue;
+
     ezConstantBufferStorageBase* pConstantBufferStorage = nullptr;
     if (TryGetConstantBufferStorage(hConstantBufferStorage, pConstantBufferStorage))
     {
@@ -1047,27 +971,43 @@ ezMaterialResource* ezRenderContext::ApplyMaterialState()
   return nullptr;
 }
 
-void ezRenderContext::ApplyConstantBufferBindings(const ezShaderStageBinary* pBinary)
+ezUInt32 ezRenderContext::GetSlotNameIndex(ezShaderBindingLayout::Group::Enum group, const ezTempHashedString& sSlotName)
 {
-  for (const auto& binding : pBinary->m_ShaderResourceBindings)
+  ezUInt32 uiNameIndex = 0;
+  if (!m_SlotNameIndices[group].TryGetValue(sSlotName.GetHash(), uiNameIndex))
   {
-    if (binding.m_Type != ezShaderResourceBinding::ConstantBuffer)
-      continue;
+    uiNameIndex = ezShaderBindingLayout::GetNameIndex(group, sSlotName.GetHash());
+    m_SlotNameIndices[group].Insert(sSlotName.GetHash(), uiNameIndex);
+  }
 
-    const ezUInt32 uiResourceHash = binding.m_sName.GetHash();
+  return uiNameIndex;
+}
 
-    BoundConstantBuffer boundConstantBuffer;
-    if (!m_BoundConstantBuffers.TryGetValue(uiResourceHash, boundConstantBuffer))
-    {
-      ezLog::Error("No resource is bound for constant buffer slot '{0}'", binding.m_sName);
-      m_pGALContext->SetConstantBuffer(binding.m_iSlot, ezGALBufferHandle());
-      continue;
-    }
+ezRenderContext::BoundConstantBuffer& ezRenderContext::GetBoundConstantBuffer(ezUInt32 uiNameIndex)
+{
+  if (uiNameIndex >= m_BoundConstantBuffers.GetCount())
+  {
+    m_BoundConstantBuffers.SetCount(uiNameIndex + 1);
+  }
+
+  return m_BoundConstantBuffers[uiNameIndex];
+}
+
+void ezRenderContext::ApplyConstantBufferBindings(const ezShaderBindingLayout& layout)
+{
+  for (const auto& binding : layout.GetBindings(ezShaderBindingLayout::Group::ConstantBuffers))
+  {
+    const BoundConstantBuffer boundConstantBuffer = GetBoundResource(m_BoundConstantBuffers, binding.m_uiNameIndex);
 
     if (!boundConstantBuffer.m_hConstantBuffer.IsInvalidated())
     {
       m_pGALContext->SetConstantBuffer(binding.m_iSlot, boundConstantBuffer.m_hConstantBuffer);
     }
+    else if (boundConstantBuffer.m_hConstantBufferStorage.IsInvalidated())
+    {
+      ezLog::Error("No resource is bound for constant buffer slot '{0}'", binding.m_sName);
+      m_pGALContext->SetConstantBuffer(binding.m_iSlot, ezGALBufferHandle());
+    }
     else
     {
       ezConstantBufferStorageBase* pConstantBufferStorage = nullptr;
@@ -1084,83 +1024,56 @@ void ezRenderContext::ApplyConstantBufferBindings(const ezShaderStageBinary* pBi
   }
 }
 
-void ezRenderContext::ApplyTextureBindings(ezGALShaderStage::Enum stage, const ezShaderStageBinary* pBinary)
+void ezRenderContext::ApplyTextureBindings(const ezShaderBindingLayout& layout)
 {
-  for (const auto& binding : pBinary->m_ShaderResourceBindings)
+  for (const auto& binding : layout.GetBindings(ezShaderBindingLayout::Group::Textures))
   {
-    // we currently only support 2D and cube textures
-
-    const ezUInt32 uiResourceHash = binding.m_sName.GetHash();
     ezGALResourceViewHandle hResourceView;
 
     if (binding.m_Type >= ezShaderResourceBinding::Texture2D && binding.m_Type <= ezShaderResourceBinding::Texture2DMSArray)
     {
-      m_BoundTextures2D.TryGetValue(uiResourceHash, hResourceView);
-      m_pGALContext->SetResourceView(stage, binding.m_iSlot, hResourceView);
+      hResourceView = GetBoundResource(m_BoundTextures2D, binding.m_uiNameIndex);
     }
-
-    if (binding.m_Type == ezShaderResourceBinding::Texture3D)
+    else if (binding.m_Type == ezShaderResourceBinding::Texture3D)
     {
-      m_BoundTextures3D.TryGetValue(uiResourceHash, hResourceView);
-      m_pGALContext->SetResourceView(stage, binding.m_iSlot, hResourceView);
+      hResourceView = GetBoundResource(m_BoundTextures3D, binding.m_uiNameIndex);
     }
-
-    if (binding.m_Type >= ezShaderResourceBinding::TextureCube && binding.m_Type <= ezShaderResourceBinding::TextureCubeArray)
+    else
     {
-      m_BoundTexturesCube.TryGetValue(uiResourceHash, hResourceView);
-      m_pGALContext->SetResourceView(stage, binding.m_iSlot, hResourceView);
+      hResourceView = GetBoundResource(m_BoundTexturesCube, binding.m_uiNameIndex);
     }
+
+    m_pGALContext->SetResourceView(binding.m_Stage, binding.m_iSlot, hResourceView);
   }
 }
 
-void ezRenderContext::ApplyUAVBindings(const ezShaderStageBinary* pBinary)
+void ezRenderContext::ApplyUAVBindings(const ezShaderBindingLayout& layout)
 {
-  for (const auto& binding : pBinary->m_ShaderResourceBindings)
+  for (const auto& binding : layout.GetBindings(ezShaderBindingLayout::Group::UAVs))
   {
-    if (binding.m_Type < ezShaderResourceBinding::RWTexture1D || binding.m_Type > ezShaderResourceBinding::RWStructuredBufferWithCounter)
-      continue;
-
-    const ezUInt32 uiResourceHash = binding.m_sName.GetHash();
-
-    ezGALUnorderedAccessViewHandle hResourceView;
-    m_BoundUAVs.TryGetValue(uiResourceHash, hResourceView);
-
-    m_pGALContext->SetUnorderedAccessView(binding.m_iSlot, hResourceView);
+    m_pGALContext->SetUnorderedAccessView(binding.m_iSlot, GetBoundResource(m_BoundUAVs, binding.m_uiNameIndex));
   }
 }
 
-void ezRenderContext::ApplySamplerBindings(ezGALShaderStage::Enum stage, const ezShaderStageBinary* pBinary)
+void ezRenderContext::ApplySamplerBindings(const ezShaderBindingLayout& layout)
 {
-  for (const auto& binding : pBinary->m_ShaderResourceBindings)
+  for (const auto& binding : layout.GetBindings(ezShaderBindingLayout::Group::Samplers))
   {
-    if (binding.m_Type != ezShaderResourceBinding::Sampler)
-      continue;
-
-    const ezUInt32 uiResourceHash = binding.m_sName.GetHash();
-
-    ezGALSamplerStateHandle hSamplerState;
-    if (!m_BoundSamplers.TryGetValue(uiResourceHash, hSamplerState))
+    ezGALSamplerStateHandle hSamplerState = GetBoundResource(m_BoundSamplers, binding.m_uiNameIndex);
+    if (hSamplerState.IsInvalidated())
     {
       hSamplerState = GetDefaultSamplerState(ezDefaultSamplerFlags::LinearFiltering); // Bind a default state to avoid DX11 errors.
     }
 
-    m_pGALContext->SetSamplerState(stage, binding.m_iSlot, hSamplerState);
+    m_pGALContext->SetSamplerState(binding.m_Stage, binding.m_iSlot, hSamplerState);
   }
 }
 
-void ezRenderContext::ApplyBufferBindings(ezGALShaderStage::Enum stage, const ezShaderStageBinary* pBinary)
+void ezRenderContext::ApplyBufferBindings(const ezShaderBindingLayout& layout)
 {
-  for (const auto& binding : pBinary->m_ShaderResourceBindings)
+  for (const auto& binding : layout.GetBindings(ezShaderBindingLayout::Group::Buffers))
   {
-    if (binding.m_Type != ezShaderResourceBinding::GenericBuffer)
-      continue;
-
-    const ezUInt32 uiResourceHash = binding.m_sName.GetHash();
-
-    ezGALResourceViewHandle hResourceView;
-    m_BoundBuffer.TryGetValue(uiResourceHash, hResourceView);
-
-    m_pGALContext->SetResourceView(stage, binding.m_iSlot, hResourceView);
+    m_pGALContext->SetResourceView(binding.m_Stage, binding.m_iSlot, GetBoundResource(m_BoundBuffer, binding.m_uiNameIndex));
   }
 }
 
@@ -7,6 +7,7 @@
 #include <RendererCore/Declarations.h>
 #include <RendererCore/RenderContext/Implementation/RenderContextStructs.h>
 #include <RendererCore/Shader/ConstantBufferStorage.h>
+#include <RendererCore/Shader/ShaderPermutationResource.h>
 #include <RendererCore/Shader/ShaderStageBinary.h>
 #include <RendererCore/ShaderCompiler/PermutationGenerator.h>
 #include <RendererFoundation/Context/Context.h>
@@ -202,12 +203,16 @@ private:
   ezEnum<ezTextureFilterSetting> m_DefaultTextureFilter;
   bool m_bAllowAsyncShaderLoading;
 
-  ezHashTable<ezUInt32, ezGALResourceViewHandle> m_BoundTextures2D;
-  ezHashTable<ezUInt32, ezGALResourceViewHandle> m_BoundTextures3D;
-  ezHashTable<ezUInt32, ezGALResourceViewHandle> m_BoundTexturesCube;
-  ezHashTable<ezUInt32, ezGALUnorderedAccessViewHandle> m_BoundUAVs;
-  ezHashTable<ezUInt32, ezGALSamplerStateHandle> m_BoundSamplers;
-  ezHashTable<ezUInt32, ezGALResourceViewHandle> m_BoundBuffer;
+  // Maps the hashes of the slot names passed to the Bind functions to ezShaderBindingLayout::GetNameIndex(), per binding group.
+  // The bound resources below are indexed by these name indices.
+  ezHashTable<ezUInt32, ezUInt32> m_SlotNameIndices[ezShaderBindingLayout::Group::ENUM_COUNT];
+
+  ezDynamicArray<ezGALResourceViewHandle> m_BoundTextures2D;
+  ezDynamicArray<ezGALResourceViewHandle> m_BoundTextures3D;
+  ezDynamicArray<ezGALResourceViewHandle> m_BoundTexturesCube;
+  ezDynamicArray<ezGALUnorderedAccessViewHandle> m_BoundUAVs;
+  ezDynamicArray<ezGALSamplerStateHandle> m_BoundSamplers;
+  ezDynamicArray<ezGALResourceViewHandle> m_BoundBuffer;
 
   struct BoundConstantBuffer
   {
@@ -227,7 +232,7 @@ private:
     ezConstantBufferStorageHandle m_hConstantBufferStorage;
   };
 
-  ezHashTable<ezUInt32, BoundConstantBuffer> m_BoundConstantBuffers;
+  ezDynamicArray<BoundConstantBuffer> m_BoundConstantBuffers;
 
   ezConstantBufferStorageHandle m_hGlobalConstantBufferStorage;
 
@@ -272,9 +277,11 @@ private: // Per Renderer States
   void BindShaderInternal(const ezShaderResourceHandle& hShader, ezBitflags<ezShaderBindFlags> flags);
   ezShaderPermutationResource* ApplyShaderState();
   ezMaterialResource* ApplyMaterialState();
-  void ApplyConstantBufferBindings(const ezShaderStageBinary* pBinary);
-  void ApplyTextureBindings(ezGALShaderStage::Enum stage, const ezShaderStageBinary* pBinary);
-  void ApplyUAVBindings(const ezShaderStageBinary* pBinary);
-  void ApplySamplerBindings(ezGALShaderStage::Enum stage, const ezShaderStageBinary* pBinary);
-  void ApplyBufferBindings(ezGALShaderStage::Enum stage, const ezShaderStageBinary* pBinary);
+  ezUInt32 GetSlotNameIndex(ezShaderBindingLayout::Group::Enum group, const ezTempHashedString& sSlotName);
+  BoundConstantBuffer& GetBoundConstantBuffer(ezUInt32 uiNameIndex);
+  void ApplyConstantBufferBindings(const ezShaderBindingLayout& layout);
+  void ApplyTextureBindings(const ezShaderBindingLayout& layout);
+  void ApplyUAVBindings(const ezShaderBindingLayout& layout);
+  void ApplySamplerBindings(const ezShaderBindingLayout& layout);
+  void ApplyBufferBindings(const ezShaderBindingLayout& layout);
 };
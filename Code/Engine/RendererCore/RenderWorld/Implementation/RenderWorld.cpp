@@ -1,7 +1,9 @@
 #include <RendererCorePCH.h>
 
+#include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashSet.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <RendererCore/Pipeline/RenderPipeline.h>
 #include <RendererCore/Pipeline/View.h>
@@ -57,6 +59,9 @@ namespace
   static ezHashTable<ezComponentHandle, CachedRenderDataPerComponent> s_CachedRenderData;
   static ezDynamicArray<const ezRenderData*> s_DeletedRenderData;
 
+  static ezMutex s_RenderDataCachesMutex;
+  static ezHashTable<ezUInt32, ezInternal::RenderDataCache*> s_RenderDataCaches;
+
   enum
   {
     MaxNumNewCacheEntries = 32
@@ -65,6 +70,10 @@ namespace
 
 namespace ezInternal
 {
+  /// \brief Cached render data of static objects, shared by all views that show the same world with the same camera usage hint.
+  ///
+  /// Components may extract different render data depending on the camera usage hint, e.g. lights don't extract anything for shadow
+  /// views, so the usage hint is part of the key.
   struct RenderDataCache
   {
     RenderDataCache(ezAllocatorBase* pAllocator)
@@ -90,6 +99,13 @@ namespace ezInternal
 
     ezStaticArray<NewEntryPerComponent, MaxNumNewCacheEntries> m_NewEntriesPerComponent;
     ezAtomicInteger32 m_NewEntriesCount;
+
+    // Several views extract the same static objects, so every component is only added once per frame.
+    ezMutex m_NewEntriesMutex;
+    ezHashSet<ezComponentHandle> m_NewEntriesComponents;
+
+    ezUInt32 m_uiKey = 0;
+    ezUInt32 m_uiNumViews = 0;
   };
 
 #if EZ_ENABLED(EZ_PLATFORM_64BIT)
@@ -130,7 +146,7 @@ ezViewHandle ezRenderWorld::CreateView(const char* szName, ezView*& out_pView)
   pView->SetName(szName);
   pView->InitializePins();
 
-  pView->m_pRenderDataCache = EZ_NEW(s_pCacheAllocator, ezInternal::RenderDataCache, s_pCacheAllocator);
+  pView->m_pRenderDataCache = nullptr;
 
   s_ViewCreatedEvent.Broadcast(pView);
 
@@ -150,7 +166,7 @@ void ezRenderWorld::DeleteView(const ezViewHandle& hView)
 
   s_ViewDeletedEvent.Broadcast(pView);
 
-  EZ_DELETE(s_pCacheAllocator, pView->m_pRenderDataCache);
+  DeleteCachedRenderData(*pView);
 
   {
     EZ_LOCK(s_PipelinesToRebuildMutex);
@@ -234,22 +250,28 @@ ezArrayPtr<ezViewHandle> ezRenderWorld::GetMainViews()
 void ezRenderWorld::CacheRenderData(const ezView& view, const ezGameObjectHandle& hOwnerObject, const ezComponentHandle& hOwnerComponent,
   ezArrayPtr<ezInternal::RenderDataCacheEntry> cacheEntries)
 {
-  if (CVarCacheRenderData)
+  if (CVarCacheRenderData && view.m_pRenderDataCache != nullptr)
   {
-    ezUInt32 uiNewEntriesCount = view.m_pRenderDataCache->m_NewEntriesCount;
-    if (uiNewEntriesCount >= MaxNumNewCacheEntries)
+    ezInternal::RenderDataCache* pCache = view.m_pRenderDataCache;
+
+    if (pCache->m_NewEntriesCount >= MaxNumNewCacheEntries)
     {
       return;
     }
 
-    uiNewEntriesCount = view.m_pRenderDataCache->m_NewEntriesCount.Increment();
-    if (uiNewEntriesCount <= MaxNumNewCacheEntries)
+    EZ_LOCK(pCache->m_NewEntriesMutex);
+
+    if (pCache->m_NewEntriesCount >= MaxNumNewCacheEntries || pCache->m_NewEntriesComponents.Insert(hOwnerComponent))
     {
-      auto& newEntry = view.m_pRenderDataCache->m_NewEntriesPerComponent[uiNewEntriesCount - 1];
-      newEntry.m_hOwnerObject = hOwnerObject;
-      newEntry.m_hOwnerComponent = hOwnerComponent;
-      newEntry.m_CacheEntries = cacheEntries;
+      return;
     }
+
+    const ezUInt32 uiNewEntriesCount = pCache->m_NewEntriesCount.Increment();
+
+    auto& newEntry = pCache->m_NewEntriesPerComponent[uiNewEntriesCount - 1];
+    newEntry.m_hOwnerObject = hOwnerObject;
+    newEntry.m_hOwnerComponent = hOwnerComponent;
+    newEntry.m_CacheEntries = cacheEntries;
   }
 }
 
@@ -258,12 +280,11 @@ void ezRenderWorld::DeleteAllCachedRenderData()
   EZ_ASSERT_DEV(!s_bInExtract, "Cannot delete cached render data during extraction");
 
   {
-    EZ_LOCK(s_ViewsMutex);
+    EZ_LOCK(s_RenderDataCachesMutex);
 
-    for (auto it = s_Views.GetIterator(); it.IsValid(); ++it)
+    for (auto it = s_RenderDataCaches.GetIterator(); it.IsValid(); ++it)
     {
-      ezView* pView = it.Value();
-      pView->m_pRenderDataCache->m_EntriesPerObject.Clear();
+      it.Value()->m_EntriesPerObject.Clear();
     }
   }
 
@@ -286,14 +307,17 @@ void ezRenderWorld::DeleteCachedRenderData(const ezGameObjectHandle& hOwnerObjec
 
   ezUInt32 uiCacheIndex = hOwnerObject.GetInternalID().m_InstanceIndex;
 
-  for (auto it = s_Views.GetIterator(); it.IsValid(); ++it)
   {
-    ezView* pView = it.Value();
-    auto& entriesPerObject = pView->m_pRenderDataCache->m_EntriesPerObject;
+    EZ_LOCK(s_RenderDataCachesMutex);
 
-    if (uiCacheIndex < entriesPerObject.GetCount())
+    for (auto it = s_RenderDataCaches.GetIterator(); it.IsValid(); ++it)
     {
-      entriesPerObject[uiCacheIndex].Clear();
+      auto& entriesPerObject = it.Value()->m_EntriesPerObject;
+
+      if (uiCacheIndex < entriesPerObject.GetCount())
+      {
+        entriesPerObject[uiCacheIndex].Clear();
+      }
     }
   }
 
@@ -311,8 +335,21 @@ void ezRenderWorld::DeleteCachedRenderData(const ezGameObjectHandle& hOwnerObjec
 
 void ezRenderWorld::DeleteCachedRenderData(ezView& view)
 {
-  view.m_pRenderDataCache->m_EntriesPerObject.Clear();
-  view.m_pRenderDataCache->m_NewEntriesCount = 0;
+  ezInternal::RenderDataCache* pCache = view.m_pRenderDataCache;
+  if (pCache == nullptr)
+    return;
+
+  view.m_pRenderDataCache = nullptr;
+
+  EZ_LOCK(s_RenderDataCachesMutex);
+
+  // The cache is shared with other views, so it is only deleted once the last view doesn't use it anymore.
+  --pCache->m_uiNumViews;
+  if (pCache->m_uiNumViews == 0)
+  {
+    s_RenderDataCaches.Remove(pCache->m_uiKey);
+    EZ_DELETE(s_pCacheAllocator, pCache);
+  }
 }
 
 void ezRenderWorld::DeleteCachedRenderDataRecursive(const ezGameObject* pOwnerObject)
@@ -331,7 +368,7 @@ void ezRenderWorld::DeleteCachedRenderDataRecursive(const ezGameObject* pOwnerOb
 
 ezArrayPtr<ezInternal::RenderDataCacheEntry> ezRenderWorld::GetCachedRenderData(const ezView& view, const ezGameObjectHandle& hOwner)
 {
-  if (CVarCacheRenderData)
+  if (CVarCacheRenderData && view.m_pRenderDataCache != nullptr)
   {
     auto& entriesPerObject = view.m_pRenderDataCache->m_EntriesPerObject;
     ezUInt32 uiCacheIndex = hOwner.GetInternalID().m_InstanceIndex;
@@ -344,6 +381,33 @@ ezArrayPtr<ezInternal::RenderDataCacheEntry> ezRenderWorld::GetCachedRenderData(
   return ezArrayPtr<ezInternal::RenderDataCacheEntry>();
 }
 
+void ezRenderWorld::AcquireRenderDataCache(ezView& view)
+{
+  const ezUInt32 uiKey = (static_cast<ezUInt32>(view.GetWorld()->GetIndex()) << 8) | view.GetCameraUsageHint().GetValue();
+
+  if (view.m_pRenderDataCache != nullptr)
+  {
+    if (view.m_pRenderDataCache->m_uiKey == uiKey)
+      return;
+
+    DeleteCachedRenderData(view);
+  }
+
+  EZ_LOCK(s_RenderDataCachesMutex);
+
+  ezInternal::RenderDataCache* pCache = nullptr;
+  if (!s_RenderDataCaches.TryGetValue(uiKey, pCache))
+  {
+    pCache = EZ_NEW(s_pCacheAllocator, ezInternal::RenderDataCache, s_pCacheAllocator);
+    pCache->m_uiKey = uiKey;
+
+    s_RenderDataCaches.Insert(uiKey, pCache);
+  }
+
+  ++pCache->m_uiNumViews;
+  view.m_pRenderDataCache = pCache;
+}
+
 void ezRenderWorld::AddViewToRender(const ezViewHandle& hView)
 {
   ezView* pView = nullptr;
@@ -576,17 +640,20 @@ void ezRenderWorld::UpdateRenderDataCache()
 {
   EZ_PROFILE_SCOPE("Update Render Data Cache");
 
-  for (auto it = s_Views.GetIterator(); it.IsValid(); ++it)
+  EZ_LOCK(s_RenderDataCachesMutex);
+
+  for (auto it = s_RenderDataCaches.GetIterator(); it.IsValid(); ++it)
   {
-    ezView* pView = it.Value();
-    ezUInt32 uiNumNewEntries = ezMath::Min<ezInt32>(pView->m_pRenderDataCache->m_NewEntriesCount, MaxNumNewCacheEntries);
-    pView->m_pRenderDataCache->m_NewEntriesCount = 0;
+    ezInternal::RenderDataCache* pCache = it.Value();
+    ezUInt32 uiNumNewEntries = pCache->m_NewEntriesCount;
+    pCache->m_NewEntriesCount = 0;
+    pCache->m_NewEntriesComponents.Clear();
 
-    auto& entriesPerObject = pView->m_pRenderDataCache->m_EntriesPerObject;
+    auto& entriesPerObject = pCache->m_EntriesPerObject;
 
     for (ezUInt32 uiNewEntryIndex = 0; uiNewEntryIndex < uiNumNewEntries; ++uiNewEntryIndex)
     {
-      auto& newEntries = pView->m_pRenderDataCache->m_NewEntriesPerComponent[uiNewEntryIndex];
+      auto& newEntries = pCache->m_NewEntriesPerComponent[uiNewEntryIndex];
       EZ_ASSERT_DEV(!newEntries.m_hOwnerObject.IsInvalidated(), "Implementation error");
 
       // find or create cached render data
@@ -620,7 +687,7 @@ void ezRenderWorld::UpdateRenderDataCache()
         }
       }
 
-      // add entry for this view
+      // add entry for this cache
       const ezUInt32 uiCacheIndex = newEntries.m_hOwnerObject.GetInternalID().m_InstanceIndex;
       entriesPerObject.EnsureCount(uiCacheIndex + 1);
 
@@ -630,7 +697,14 @@ void ezRenderWorld::UpdateRenderDataCache()
       {
         if (!cacheEntries.Contains(newEntry))
         {
-          cacheEntries.PushBack(newEntry);
+          // keep the entries sorted by component index, the extractor relies on that
+          ezUInt32 uiInsertIndex = cacheEntries.GetCount();
+          while (uiInsertIndex > 0 && cacheEntries[uiInsertIndex - 1].m_uiComponentIndex > newEntry.m_uiComponentIndex)
+          {
+            --uiInsertIndex;
+          }
+
+          cacheEntries.Insert(newEntry, uiInsertIndex);
         }
       }
     }
@@ -685,6 +759,17 @@ void ezRenderWorld::OnEngineShutdown()
 {
   ClearRenderDataCache();
 
+  {
+    EZ_LOCK(s_RenderDataCachesMutex);
+
+    for (auto it = s_RenderDataCaches.GetIterator(); it.IsValid(); ++it)
+    {
+      EZ_DELETE(s_pCacheAllocator, it.Value());
+    }
+
+    s_RenderDataCaches.Clear();
+  }
+
   EZ_DEFAULT_DELETE(s_pCacheAllocator);
 
   s_FilteredRenderPipelines[0].Clear();
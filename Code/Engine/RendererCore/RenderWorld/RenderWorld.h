@@ -51,12 +51,14 @@ public:
   static void ClearMainViews();
   static ezArrayPtr<ezViewHandle> GetMainViews();
 
+  /// \brief Render data of static objects is cached per world and camera usage hint and shared by all views that match both.
   static void CacheRenderData(const ezView& view, const ezGameObjectHandle& hOwnerObject, const ezComponentHandle& hOwnerComponent,
     ezArrayPtr<ezInternal::RenderDataCacheEntry> cacheEntries);
 
   static void DeleteAllCachedRenderData();
   static void DeleteCachedRenderData(const ezGameObjectHandle& hOwnerObject, const ezComponentHandle& hOwnerComponent);
   static void DeleteCachedRenderDataRecursive(const ezGameObject* pOwnerObject);
+  /// \brief Detaches the view from its shared render data cache. The view picks up the matching cache again on its next extraction.
   static void DeleteCachedRenderData(ezView& view);
   static ezArrayPtr<ezInternal::RenderDataCacheEntry> GetCachedRenderData(const ezView& view, const ezGameObjectHandle& hOwner);
 
@@ -114,6 +116,7 @@ private:
 
   static void ClearRenderDataCache();
   static void UpdateRenderDataCache();
+  static void AcquireRenderDataCache(ezView& view);
 
   static void AddRenderPipelineToRebuild(ezRenderPipeline* pRenderPipeline, const ezViewHandle& hView);
   static void RebuildPipelines();
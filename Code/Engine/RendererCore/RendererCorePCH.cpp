@@ -11,6 +11,7 @@ EZ_STATICLINK_LIBRARY(RendererCore)
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_AnimationPose);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_EditableSkeleton);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_JointMapping);
+  EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_LocalAnimationPose);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_Skeleton);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_SkeletonBuilder);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_SkeletonResource);
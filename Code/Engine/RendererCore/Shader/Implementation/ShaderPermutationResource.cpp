@@ -17,6 +17,120 @@ EZ_RESOURCE_IMPLEMENT_COMMON_CODE(ezShaderPermutationResource);
 
 static ezShaderPermutationResourceLoader g_PermutationResourceLoader;
 
+namespace
+{
+  ezMutex s_NameIndicesMutex;
+  ezHashTable<ezUInt32, ezUInt32> s_NameIndices[ezShaderBindingLayout::Group::ENUM_COUNT];
+
+  ezShaderBindingLayout::Group::Enum GetBindingGroup(ezShaderResourceBinding::ResourceType type)
+  {
+    // we currently only support 2D, 3D and cube textures
+    if ((type >= ezShaderResourceBinding::Texture2D && type <= ezShaderResourceBinding::Texture2DMSArray) ||
+        (type >= ezShaderResourceBinding::Texture3D && type <= ezShaderResourceBinding::TextureCubeArray))
+      return ezShaderBindingLayout::Group::Textures;
+
+    if (type >= ezShaderResourceBinding::RWTexture1D && type <= ezShaderResourceBinding::RWStructuredBufferWithCounter)
+      return ezShaderBindingLayout::Group::UAVs;
+
+    if (type == ezShaderResourceBinding::Sampler)
+      return ezShaderBindingLayout::Group::Samplers;
+
+    if (type == ezShaderResourceBinding::GenericBuffer)
+      return ezShaderBindingLayout::Group::Buffers;
+
+    if (type == ezShaderResourceBinding::ConstantBuffer)
+      return ezShaderBindingLayout::Group::ConstantBuffers;
+
+    return ezShaderBindingLayout::Group::ENUM_COUNT;
+  }
+} // namespace
+
+void ezShaderBindingLayout::Build(ezShaderStageBinary* const* pStageBinaries)
+{
+  Clear();
+
+  ezHybridArray<Binding, 32> bindingsPerGroup[Group::ENUM_COUNT];
+
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    const ezShaderStageBinary* pBinary = pStageBinaries[stage];
+    if (pBinary == nullptr)
+      continue;
+
+    for (const auto& shaderBinding : pBinary->GetShaderResourceBindings())
+    {
+      const Group::Enum group = GetBindingGroup(shaderBinding.m_Type);
+      if (group == Group::ENUM_COUNT)
+        continue;
+
+      // UAVs are usually only supported in compute and pixel shader.
+      if (group == Group::UAVs && stage != ezGALShaderStage::ComputeShader && stage != ezGALShaderStage::PixelShader)
+        continue;
+
+      Binding binding;
+      binding.m_sName = shaderBinding.m_sName;
+      binding.m_uiNameIndex = GetNameIndex(group, shaderBinding.m_sName.GetHash());
+      binding.m_iSlot = shaderBinding.m_iSlot;
+      binding.m_Type = shaderBinding.m_Type;
+      binding.m_Stage = (ezGALShaderStage::Enum)stage;
+
+      // UAVs and constant buffers are not bound per stage, so they only need to be bound once.
+      if (group == Group::UAVs || group == Group::ConstantBuffers)
+      {
+        bool bAlreadyBound = false;
+        for (const auto& existingBinding : bindingsPerGroup[group])
+        {
+          if (existingBinding.m_sName == binding.m_sName && existingBinding.m_iSlot == binding.m_iSlot)
+          {
+            bAlreadyBound = true;
+            break;
+          }
+        }
+
+        if (bAlreadyBound)
+          continue;
+      }
+
+      bindingsPerGroup[group].PushBack(binding);
+    }
+  }
+
+  for (ezUInt32 group = 0; group < Group::ENUM_COUNT; ++group)
+  {
+    m_uiGroupStart[group] = m_Bindings.GetCount();
+    m_Bindings.PushBackRange(bindingsPerGroup[group]);
+  }
+
+  m_uiGroupStart[Group::ENUM_COUNT] = m_Bindings.GetCount();
+}
+
+void ezShaderBindingLayout::Clear()
+{
+  m_Bindings.Clear();
+
+  for (ezUInt32 i = 0; i <= Group::ENUM_COUNT; ++i)
+  {
+    m_uiGroupStart[i] = 0;
+  }
+}
+
+// static
+ezUInt32 ezShaderBindingLayout::GetNameIndex(Group::Enum group, ezUInt32 uiNameHash)
+{
+  EZ_LOCK(s_NameIndicesMutex);
+
+  ezHashTable<ezUInt32, ezUInt32>& nameIndices = s_NameIndices[group];
+
+  ezUInt32 uiIndex = 0;
+  if (!nameIndices.TryGetValue(uiNameHash, uiIndex))
+  {
+    uiIndex = nameIndices.GetCount();
+    nameIndices.Insert(uiNameHash, uiIndex);
+  }
+
+  return uiIndex;
+}
+
 ezShaderPermutationResource::ezShaderPermutationResource()
   : ezResource(DoUpdate::OnAnyThread, 1)
 {
@@ -32,6 +146,8 @@ ezResourceLoadDesc ezShaderPermutationResource::UnloadData(Unload WhatToUnload)
 {
   m_bShaderPermutationValid = false;
 
+  m_BindingLayout.Clear();
+
   auto pDevice = ezGALDevice::GetDefaultDevice();
 
   if (!m_hShader.IsInvalidated())
@@ -145,6 +261,8 @@ ezResourceLoadDesc ezShaderPermutationResource::UpdateContent(ezStreamReader* St
 
   m_PermutationVars = PermutationBinary.m_PermutationVars;
 
+  m_BindingLayout.Build(m_pShaderStageBinaries);
+
   m_bShaderPermutationValid = true;
 
   ModifyMemoryUsage().m_uiMemoryGPU = uiGPUMem;
@@ -14,6 +14,54 @@ struct ezShaderPermutationResourceDescriptor
 {
 };
 
+/// \brief The resource bindings of all shader stages of a permutation, flattened and grouped by the kind of binding.
+///
+/// This is built once when the permutation is loaded, so that ezRenderContext only needs to walk a small array per binding group
+/// instead of filtering the binding lists of every stage binary on each draw.
+struct EZ_RENDERERCORE_DLL ezShaderBindingLayout
+{
+  struct Group
+  {
+    enum Enum
+    {
+      Textures,
+      UAVs,
+      Samplers,
+      Buffers,
+      ConstantBuffers,
+
+      ENUM_COUNT
+    };
+  };
+
+  struct Binding
+  {
+    ezHashedString m_sName;
+    ezUInt32 m_uiNameIndex; ///< See GetNameIndex().
+    ezInt32 m_iSlot;
+    ezShaderResourceBinding::ResourceType m_Type;
+    ezGALShaderStage::Enum m_Stage; ///< UAVs and constant buffers are bound for all stages, their stage is the first one that uses them.
+  };
+
+  void Build(ezShaderStageBinary* const* pStageBinaries);
+  void Clear();
+
+  /// \brief Returns a small index that is unique for the binding name with the given hash within the given group.
+  ///
+  /// The same name always maps to the same index, so bound resources can be stored in arrays that are addressed with
+  /// Binding::m_uiNameIndex instead of being looked up by name for every binding on each draw.
+  static ezUInt32 GetNameIndex(Group::Enum group, ezUInt32 uiNameHash);
+
+  ezArrayPtr<const Binding> GetBindings(Group::Enum group) const
+  {
+    return m_Bindings.GetArrayPtr().GetSubArray(m_uiGroupStart[group], m_uiGroupStart[group + 1] - m_uiGroupStart[group]);
+  }
+
+private:
+  ezDynamicArray<Binding> m_Bindings;
+  ezUInt32 m_uiGroupStart[Group::ENUM_COUNT + 1] = {};
+};
+
 class EZ_RENDERERCORE_DLL ezShaderPermutationResource : public ezResource
 {
   EZ_ADD_DYNAMIC_REFLECTION(ezShaderPermutationResource, ezResource);
@@ -34,6 +82,8 @@ public:
 
   ezArrayPtr<const ezPermutationVar> GetPermutationVars() const { return m_PermutationVars; }
 
+  const ezShaderBindingLayout& GetBindingLayout() const { return m_BindingLayout; }
+
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
   virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override;
@@ -53,6 +103,8 @@ private:
   ezGALRasterizerStateHandle m_hRasterizerState;
 
   ezHybridArray<ezPermutationVar, 16> m_PermutationVars;
+
+  ezShaderBindingLayout m_BindingLayout;
 };
 
 
@@ -4,6 +4,7 @@
 
 #include <Foundation/Math/Mat3.h>
 #include <Foundation/Math/Transform.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
 
 /// \brief A wrapper class that converts a ezMat3 into the correct data layout for shaders.
 class ezShaderMat3
@@ -47,6 +48,17 @@ public:
     }
   }
 
+  /// \brief Stores the upper three rows of the matrix, the last row is expected to be (0, 0, 0, 1).
+  EZ_FORCE_INLINE void operator=(const ezSimdMat4f& t)
+  {
+    ezSimdVec4f r0, r1, r2, r3;
+    t.GetRows(r0, r1, r2, r3);
+
+    r0.Store<4>(m_Data + 0);
+    r1.Store<4>(m_Data + 4);
+    r2.Store<4>(m_Data + 8);
+  }
+
   inline void operator=(const ezMat3& t)
   {
     float data[9];
@@ -68,6 +80,9 @@ public:
     m_Data[11] = 0;
   }
 
+  /// \brief Returns the translation, which is stored in the last column of the three rows.
+  EZ_ALWAYS_INLINE ezVec3 GetTranslationVector() const { return ezVec3(m_Data[3], m_Data[7], m_Data[11]); }
+
 private:
   float m_Data[12];
 };
@@ -147,6 +147,16 @@ public:
 
   void ClearStatisticsCounters();
 
+  ezUInt32 GetDrawCallCount() const;
+
+  ezUInt32 GetDispatchCallCount() const;
+
+  /// \brief Number of state changes that were passed on to the platform since the last call to ClearStatisticsCounters().
+  ezUInt32 GetStateChangeCount() const;
+
+  /// \brief Number of state changes that were filtered out because the state was already set.
+  ezUInt32 GetRedundantStateChangeCount() const;
+
   ezGALDevice* GetDevice() const;
 
 protected:
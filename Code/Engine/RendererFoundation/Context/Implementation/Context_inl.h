@@ -4,6 +4,26 @@ EZ_ALWAYS_INLINE ezGALDevice* ezGALContext::GetDevice() const
   return m_pDevice;
 }
 
+EZ_ALWAYS_INLINE ezUInt32 ezGALContext::GetDrawCallCount() const
+{
+  return m_uiDrawCalls;
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezGALContext::GetDispatchCallCount() const
+{
+  return m_uiDispatchCalls;
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezGALContext::GetStateChangeCount() const
+{
+  return m_uiStateChanges;
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezGALContext::GetRedundantStateChangeCount() const
+{
+  return m_uiRedundantStateChanges;
+}
+
 EZ_ALWAYS_INLINE void ezGALContext::CountDrawCall()
 {
   m_uiDrawCalls++;
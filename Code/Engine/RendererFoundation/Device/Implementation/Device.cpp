@@ -2,6 +2,7 @@
 
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Utilities/Stats.h>
 #include <RendererFoundation/Context/Context.h>
 #include <RendererFoundation/Device/Device.h>
 #include <RendererFoundation/Device/SwapChain.h>
@@ -1276,6 +1277,15 @@ void ezGALDevice::BeginFrame()
 
     BeginFramePlatform();
   }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  // report the counters of the previous frame
+  ezStats::SetStat("GAL/DrawCalls", m_pPrimaryContext->GetDrawCallCount());
+  ezStats::SetStat("GAL/DispatchCalls", m_pPrimaryContext->GetDispatchCallCount());
+  ezStats::SetStat("GAL/StateChanges", m_pPrimaryContext->GetStateChangeCount());
+  ezStats::SetStat("GAL/RedundantStateChanges", m_pPrimaryContext->GetRedundantStateChangeCount());
+#endif
+
   m_pPrimaryContext->ClearStatisticsCounters();
 
   {
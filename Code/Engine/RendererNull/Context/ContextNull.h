@@ -0,0 +1,275 @@
+#pragma once
+
+#include <RendererFoundation/Context/Context.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief All commands that are counted and recorded by ezGALContextNull.
+struct ezGALNullCommand
+{
+  typedef ezUInt8 StorageType;
+
+  enum Enum
+  {
+    Clear,
+    ClearUnorderedAccessView,
+    Draw,
+    DrawIndexed,
+    DrawIndexedInstanced,
+    DrawIndexedInstancedIndirect,
+    DrawInstanced,
+    DrawInstancedIndirect,
+    DrawAuto,
+    BeginStreamOut,
+    EndStreamOut,
+    Dispatch,
+    DispatchIndirect,
+    SetShader,
+    SetIndexBuffer,
+    SetVertexBuffer,
+    SetVertexDeclaration,
+    SetPrimitiveTopology,
+    SetConstantBuffer,
+    SetSamplerState,
+    SetResourceView,
+    SetRenderTargetSetup,
+    SetUnorderedAccessView,
+    SetBlendState,
+    SetDepthStencilState,
+    SetRasterizerState,
+    SetViewport,
+    SetScissorRect,
+    SetStreamOutBuffer,
+    InsertFence,
+    IsFenceReached,
+    WaitForFence,
+    BeginQuery,
+    EndQuery,
+    GetQueryResult,
+    InsertTimestamp,
+    CopyBuffer,
+    CopyBufferRegion,
+    UpdateBuffer,
+    CopyTexture,
+    CopyTextureRegion,
+    UpdateTexture,
+    ResolveTexture,
+    ReadbackTexture,
+    CopyTextureReadbackResult,
+    GenerateMipMaps,
+    Flush,
+    PushMarker,
+    PopMarker,
+    InsertEventMarker,
+
+    ENUM_COUNT,
+
+    Default = Draw
+  };
+};
+
+/// \brief A single entry of the command stream recorded by ezGALContextNull.
+///
+/// Only the main object a command operates on and up to three integer arguments are stored (e.g. vertex count, instance count
+/// and start vertex for draw calls), which is enough to compare the command streams of two runs.
+struct ezGALNullRecordedCommand
+{
+  EZ_DECLARE_POD_TYPE();
+
+  const void* m_pObject;
+  ezUInt32 m_uiArgs[3];
+  ezUInt8 m_uiSlot; ///< The slot or shader stage for commands that bind something, zero otherwise.
+  ezEnum<ezGALNullCommand> m_Command;
+};
+
+/// \brief The null implementation of the graphics context.
+///
+/// No GPU work is done. Every command is validated against the state that has been bound on the context, counted and, if enabled,
+/// appended to a compact command stream. This allows to profile and regression test the CPU side of rendering on machines
+/// without a graphics card.
+class EZ_RENDERERNULL_DLL ezGALContextNull : public ezGALContext
+{
+public:
+  /// \brief Returns how often the given command was issued since the last call to ResetCommandCounts().
+  EZ_ALWAYS_INLINE ezUInt32 GetCommandCount(ezGALNullCommand::Enum command) const { return m_CommandCounts[command]; }
+
+  /// \brief Returns how many commands failed validation since the last call to ResetCommandCounts().
+  EZ_ALWAYS_INLINE ezUInt32 GetValidationErrorCount() const { return m_uiValidationErrors; }
+
+  void ResetCommandCounts();
+
+  /// \brief Enables or disables recording of the command stream. Recording is disabled by default.
+  void SetCommandRecordingEnabled(bool bEnable) { m_bRecordCommands = bEnable; }
+
+  bool IsCommandRecordingEnabled() const { return m_bRecordCommands; }
+
+  /// \brief Returns all commands that were recorded since the last call to ClearRecordedCommands().
+  ezArrayPtr<const ezGALNullRecordedCommand> GetRecordedCommands() const { return m_RecordedCommands; }
+
+  void ClearRecordedCommands() { m_RecordedCommands.Clear(); }
+
+  /// \brief Returns how many markers were pushed but not popped yet.
+  ezUInt32 GetMarkerDepth() const { return m_uiMarkerDepth; }
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALContextNull(ezGALDevice* pDevice);
+
+  ~ezGALContextNull();
+
+  // Draw functions
+
+  virtual void ClearPlatform(const ezColor& ClearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear,
+    ezUInt8 uiStencilClear) override;
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4 clearValues) override;
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4U32 clearValues) override;
+
+  virtual void DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex) override;
+
+  virtual void DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex) override;
+
+  virtual void DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex) override;
+
+  virtual void DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  virtual void DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex) override;
+
+  virtual void DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  virtual void DrawAutoPlatform() override;
+
+  virtual void BeginStreamOutPlatform() override;
+
+  virtual void EndStreamOutPlatform() override;
+
+  // Dispatch
+
+  virtual void DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ) override;
+
+  virtual void DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+
+  // State setting functions
+
+  virtual void SetShaderPlatform(const ezGALShader* pShader) override;
+
+  virtual void SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer) override;
+
+  virtual void SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer) override;
+
+  virtual void SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration) override;
+
+  virtual void SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum Topology) override;
+
+  virtual void SetConstantBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer) override;
+
+  virtual void SetSamplerStatePlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALSamplerState* pSamplerState) override;
+
+  virtual void SetResourceViewPlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALResourceView* pResourceView) override;
+
+  virtual void SetRenderTargetSetupPlatform(
+    ezArrayPtr<const ezGALRenderTargetView*> pRenderTargetViews, const ezGALRenderTargetView* pDepthStencilView) override;
+
+  virtual void SetUnorderedAccessViewPlatform(ezUInt32 uiSlot, const ezGALUnorderedAccessView* pUnorderedAccessView) override;
+
+  virtual void SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask) override;
+
+  virtual void SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue) override;
+
+  virtual void SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState) override;
+
+  virtual void SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth) override;
+
+  virtual void SetScissorRectPlatform(const ezRectU32& rect) override;
+
+  virtual void SetStreamOutBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer, ezUInt32 uiOffset) override;
+
+  // Fence & Query functions
+
+  virtual void InsertFencePlatform(const ezGALFence* pFence) override;
+
+  virtual bool IsFenceReachedPlatform(const ezGALFence* pFence) override;
+
+  virtual void WaitForFencePlatform(const ezGALFence* pFence) override;
+
+  virtual void BeginQueryPlatform(const ezGALQuery* pQuery) override;
+
+  virtual void EndQueryPlatform(const ezGALQuery* pQuery) override;
+
+  virtual ezResult GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& uiQueryResult) override;
+
+  // Timestamp functions
+
+  virtual void InsertTimestampPlatform(ezGALTimestampHandle hTimestamp) override;
+
+  // Resource update functions
+
+  virtual void CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource) override;
+
+  virtual void CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset,
+    ezUInt32 uiByteCount) override;
+
+  virtual void UpdateBufferPlatform(
+    const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> pSourceData, ezGALUpdateMode::Enum updateMode) override;
+
+  virtual void CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource) override;
+
+  virtual void CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+    const ezVec3U32& DestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource,
+    const ezBoundingBoxu32& Box) override;
+
+  virtual void UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+    const ezBoundingBoxu32& DestinationBox, const ezGALSystemMemoryDescription& pSourceData) override;
+
+  virtual void ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+    const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource) override;
+
+  virtual void ReadbackTexturePlatform(const ezGALTexture* pTexture) override;
+
+  virtual void CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, const ezArrayPtr<ezGALSystemMemoryDescription>* pData) override;
+
+  virtual void GenerateMipMapsPlatform(const ezGALResourceView* pResourceView) override;
+
+  // Misc
+
+  virtual void FlushPlatform() override;
+
+  // Debug helper functions
+
+  virtual void PushMarkerPlatform(const char* szMarker) override;
+
+  virtual void PopMarkerPlatform() override;
+
+  virtual void InsertEventMarkerPlatform(const char* szMarker) override;
+
+private:
+  void AddCommand(ezGALNullCommand::Enum command, const void* pObject = nullptr, ezUInt32 uiArg0 = 0, ezUInt32 uiArg1 = 0, ezUInt32 uiArg2 = 0,
+    ezUInt32 uiSlot = 0);
+
+  void ValidationError(const char* szCommand, const char* szError);
+
+  void ValidateDraw(const char* szCommand, bool bIndexed);
+
+  void ValidateIndirectArguments(const char* szCommand, const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes,
+    ezUInt32 uiArgumentSize);
+
+  void ValidateBufferRange(const char* szCommand, const ezGALBuffer* pBuffer, ezUInt32 uiOffset, ezUInt32 uiByteCount);
+
+  void ValidateSubresource(const char* szCommand, const ezGALTexture* pTexture, const ezGALTextureSubresource& SubResource);
+
+  ezUInt32 m_CommandCounts[ezGALNullCommand::ENUM_COUNT];
+  ezUInt32 m_uiValidationErrors = 0;
+
+  bool m_bRecordCommands = false;
+  ezDynamicArray<ezGALNullRecordedCommand> m_RecordedCommands;
+
+  // Bound state that is needed for validation
+  const ezGALShader* m_pBoundShader = nullptr;
+  const ezGALBuffer* m_pBoundIndexBuffer = nullptr;
+  bool m_bStreamOutActive = false;
+  ezUInt32 m_uiMarkerDepth = 0;
+};
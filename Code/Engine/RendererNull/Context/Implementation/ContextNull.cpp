@@ -0,0 +1,466 @@
+#include <RendererNullPCH.h>
+
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererFoundation/Resources/Texture.h>
+#include <RendererFoundation/Shader/Shader.h>
+#include <RendererNull/Context/ContextNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+ezGALContextNull::ezGALContextNull(ezGALDevice* pDevice)
+  : ezGALContext(pDevice)
+{
+  ResetCommandCounts();
+}
+
+ezGALContextNull::~ezGALContextNull() = default;
+
+void ezGALContextNull::ResetCommandCounts()
+{
+  ezMemoryUtils::ZeroFill(m_CommandCounts, ezGALNullCommand::ENUM_COUNT);
+  m_uiValidationErrors = 0;
+}
+
+// Draw functions
+
+void ezGALContextNull::ClearPlatform(
+  const ezColor& ClearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear)
+{
+  const ezUInt32 uiFlags = (bClearDepth ? 1u : 0u) | (bClearStencil ? 2u : 0u);
+  AddCommand(ezGALNullCommand::Clear, nullptr, uiRenderTargetClearMask, uiFlags, uiStencilClear);
+}
+
+void ezGALContextNull::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4 clearValues)
+{
+  AddCommand(ezGALNullCommand::ClearUnorderedAccessView, pUnorderedAccessView);
+}
+
+void ezGALContextNull::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4U32 clearValues)
+{
+  AddCommand(ezGALNullCommand::ClearUnorderedAccessView, pUnorderedAccessView);
+}
+
+void ezGALContextNull::DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
+{
+  ValidateDraw("Draw", false);
+  AddCommand(ezGALNullCommand::Draw, m_pBoundShader, uiVertexCount, 1, uiStartVertex);
+}
+
+void ezGALContextNull::DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  ValidateDraw("DrawIndexed", true);
+  AddCommand(ezGALNullCommand::DrawIndexed, m_pBoundShader, uiIndexCount, 1, uiStartIndex);
+}
+
+void ezGALContextNull::DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
+{
+  ValidateDraw("DrawIndexedInstanced", true);
+  AddCommand(ezGALNullCommand::DrawIndexedInstanced, m_pBoundShader, uiIndexCountPerInstance, uiInstanceCount, uiStartIndex);
+}
+
+void ezGALContextNull::DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  ValidateDraw("DrawIndexedInstancedIndirect", true);
+  ValidateIndirectArguments("DrawIndexedInstancedIndirect", pIndirectArgumentBuffer, uiArgumentOffsetInBytes, 5 * sizeof(ezUInt32));
+  AddCommand(ezGALNullCommand::DrawIndexedInstancedIndirect, pIndirectArgumentBuffer, uiArgumentOffsetInBytes);
+}
+
+void ezGALContextNull::DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
+{
+  ValidateDraw("DrawInstanced", false);
+  AddCommand(ezGALNullCommand::DrawInstanced, m_pBoundShader, uiVertexCountPerInstance, uiInstanceCount, uiStartVertex);
+}
+
+void ezGALContextNull::DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  ValidateDraw("DrawInstancedIndirect", false);
+  ValidateIndirectArguments("DrawInstancedIndirect", pIndirectArgumentBuffer, uiArgumentOffsetInBytes, 4 * sizeof(ezUInt32));
+  AddCommand(ezGALNullCommand::DrawInstancedIndirect, pIndirectArgumentBuffer, uiArgumentOffsetInBytes);
+}
+
+void ezGALContextNull::DrawAutoPlatform()
+{
+  ValidateDraw("DrawAuto", false);
+  AddCommand(ezGALNullCommand::DrawAuto, m_pBoundShader);
+}
+
+void ezGALContextNull::BeginStreamOutPlatform()
+{
+  if (m_bStreamOutActive)
+  {
+    ValidationError("BeginStreamOut", "Stream out is already active");
+  }
+
+  m_bStreamOutActive = true;
+  AddCommand(ezGALNullCommand::BeginStreamOut);
+}
+
+void ezGALContextNull::EndStreamOutPlatform()
+{
+  if (!m_bStreamOutActive)
+  {
+    ValidationError("EndStreamOut", "Stream out is not active");
+  }
+
+  m_bStreamOutActive = false;
+  AddCommand(ezGALNullCommand::EndStreamOut);
+}
+
+// Dispatch
+
+void ezGALContextNull::DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ)
+{
+  if (m_pBoundShader == nullptr || !m_pBoundShader->GetDescription().HasByteCodeForStage(ezGALShaderStage::ComputeShader))
+  {
+    ValidationError("Dispatch", "No compute shader bound");
+  }
+
+  AddCommand(ezGALNullCommand::Dispatch, m_pBoundShader, uiThreadGroupCountX, uiThreadGroupCountY, uiThreadGroupCountZ);
+}
+
+void ezGALContextNull::DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  if (m_pBoundShader == nullptr || !m_pBoundShader->GetDescription().HasByteCodeForStage(ezGALShaderStage::ComputeShader))
+  {
+    ValidationError("DispatchIndirect", "No compute shader bound");
+  }
+
+  ValidateIndirectArguments("DispatchIndirect", pIndirectArgumentBuffer, uiArgumentOffsetInBytes, 3 * sizeof(ezUInt32));
+  AddCommand(ezGALNullCommand::DispatchIndirect, pIndirectArgumentBuffer, uiArgumentOffsetInBytes);
+}
+
+
+// State setting functions
+
+void ezGALContextNull::SetShaderPlatform(const ezGALShader* pShader)
+{
+  m_pBoundShader = pShader;
+  AddCommand(ezGALNullCommand::SetShader, pShader);
+}
+
+void ezGALContextNull::SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer)
+{
+  m_pBoundIndexBuffer = pIndexBuffer;
+  AddCommand(ezGALNullCommand::SetIndexBuffer, pIndexBuffer);
+}
+
+void ezGALContextNull::SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer)
+{
+  AddCommand(ezGALNullCommand::SetVertexBuffer, pVertexBuffer, 0, 0, 0, uiSlot);
+}
+
+void ezGALContextNull::SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration)
+{
+  AddCommand(ezGALNullCommand::SetVertexDeclaration, pVertexDeclaration);
+}
+
+void ezGALContextNull::SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum Topology)
+{
+  AddCommand(ezGALNullCommand::SetPrimitiveTopology, nullptr, Topology);
+}
+
+void ezGALContextNull::SetConstantBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer)
+{
+  if (pBuffer != nullptr && pBuffer->GetDescription().m_BufferType != ezGALBufferType::ConstantBuffer)
+  {
+    ValidationError("SetConstantBuffer", "Buffer is not a constant buffer");
+  }
+
+  AddCommand(ezGALNullCommand::SetConstantBuffer, pBuffer, 0, 0, 0, uiSlot);
+}
+
+void ezGALContextNull::SetSamplerStatePlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALSamplerState* pSamplerState)
+{
+  AddCommand(ezGALNullCommand::SetSamplerState, pSamplerState, uiSlot, 0, 0, Stage);
+}
+
+void ezGALContextNull::SetResourceViewPlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALResourceView* pResourceView)
+{
+  AddCommand(ezGALNullCommand::SetResourceView, pResourceView, uiSlot, 0, 0, Stage);
+}
+
+void ezGALContextNull::SetRenderTargetSetupPlatform(
+  ezArrayPtr<const ezGALRenderTargetView*> pRenderTargetViews, const ezGALRenderTargetView* pDepthStencilView)
+{
+  AddCommand(ezGALNullCommand::SetRenderTargetSetup, pDepthStencilView, pRenderTargetViews.GetCount());
+}
+
+void ezGALContextNull::SetUnorderedAccessViewPlatform(ezUInt32 uiSlot, const ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  AddCommand(ezGALNullCommand::SetUnorderedAccessView, pUnorderedAccessView, 0, 0, 0, uiSlot);
+}
+
+void ezGALContextNull::SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask)
+{
+  AddCommand(ezGALNullCommand::SetBlendState, pBlendState, uiSampleMask);
+}
+
+void ezGALContextNull::SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+  AddCommand(ezGALNullCommand::SetDepthStencilState, pDepthStencilState, uiStencilRefValue);
+}
+
+void ezGALContextNull::SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState)
+{
+  AddCommand(ezGALNullCommand::SetRasterizerState, pRasterizerState);
+}
+
+void ezGALContextNull::SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+  AddCommand(ezGALNullCommand::SetViewport, nullptr, static_cast<ezUInt32>(rect.width), static_cast<ezUInt32>(rect.height));
+}
+
+void ezGALContextNull::SetScissorRectPlatform(const ezRectU32& rect)
+{
+  AddCommand(ezGALNullCommand::SetScissorRect, nullptr, rect.width, rect.height);
+}
+
+void ezGALContextNull::SetStreamOutBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer, ezUInt32 uiOffset)
+{
+  AddCommand(ezGALNullCommand::SetStreamOutBuffer, pBuffer, uiOffset, 0, 0, uiSlot);
+}
+
+// Fence & Query functions
+
+void ezGALContextNull::InsertFencePlatform(const ezGALFence* pFence)
+{
+  AddCommand(ezGALNullCommand::InsertFence, pFence);
+}
+
+bool ezGALContextNull::IsFenceReachedPlatform(const ezGALFence* pFence)
+{
+  AddCommand(ezGALNullCommand::IsFenceReached, pFence);
+
+  // Without a GPU every fence is reached as soon as it has been inserted.
+  return true;
+}
+
+void ezGALContextNull::WaitForFencePlatform(const ezGALFence* pFence)
+{
+  AddCommand(ezGALNullCommand::WaitForFence, pFence);
+}
+
+void ezGALContextNull::BeginQueryPlatform(const ezGALQuery* pQuery)
+{
+  AddCommand(ezGALNullCommand::BeginQuery, pQuery);
+}
+
+void ezGALContextNull::EndQueryPlatform(const ezGALQuery* pQuery)
+{
+  AddCommand(ezGALNullCommand::EndQuery, pQuery);
+}
+
+ezResult ezGALContextNull::GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& uiQueryResult)
+{
+  AddCommand(ezGALNullCommand::GetQueryResult, pQuery);
+
+  uiQueryResult = 0;
+  return EZ_SUCCESS;
+}
+
+// Timestamp functions
+
+void ezGALContextNull::InsertTimestampPlatform(ezGALTimestampHandle hTimestamp)
+{
+  static_cast<ezGALDeviceNull*>(GetDevice())->SetTimestamp(hTimestamp, ezTime::Now());
+
+  AddCommand(ezGALNullCommand::InsertTimestamp, nullptr, static_cast<ezUInt32>(hTimestamp.m_uiIndex));
+}
+
+// Resource update functions
+
+void ezGALContextNull::CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  if (pDestination->GetSize() != pSource->GetSize())
+  {
+    ValidationError("CopyBuffer", "Source and destination buffer have different sizes");
+  }
+
+  AddCommand(ezGALNullCommand::CopyBuffer, pDestination, pSource->GetSize());
+}
+
+void ezGALContextNull::CopyBufferRegionPlatform(
+  const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount)
+{
+  ValidateBufferRange("CopyBufferRegion", pDestination, uiDestOffset, uiByteCount);
+  ValidateBufferRange("CopyBufferRegion", pSource, uiSourceOffset, uiByteCount);
+
+  AddCommand(ezGALNullCommand::CopyBufferRegion, pDestination, uiDestOffset, uiSourceOffset, uiByteCount);
+}
+
+void ezGALContextNull::UpdateBufferPlatform(
+  const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> pSourceData, ezGALUpdateMode::Enum updateMode)
+{
+  ValidateBufferRange("UpdateBuffer", pDestination, uiDestOffset, pSourceData.GetCount());
+
+  AddCommand(ezGALNullCommand::UpdateBuffer, pDestination, uiDestOffset, pSourceData.GetCount(), updateMode);
+}
+
+void ezGALContextNull::CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource)
+{
+  const ezGALTextureCreationDescription& destDesc = pDestination->GetDescription();
+  const ezGALTextureCreationDescription& sourceDesc = pSource->GetDescription();
+
+  if (destDesc.m_uiWidth != sourceDesc.m_uiWidth || destDesc.m_uiHeight != sourceDesc.m_uiHeight || destDesc.m_uiDepth != sourceDesc.m_uiDepth)
+  {
+    ValidationError("CopyTexture", "Source and destination texture have different dimensions");
+  }
+
+  AddCommand(ezGALNullCommand::CopyTexture, pDestination);
+}
+
+void ezGALContextNull::CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+  const ezVec3U32& DestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource, const ezBoundingBoxu32& Box)
+{
+  ValidateSubresource("CopyTextureRegion", pDestination, DestinationSubResource);
+  ValidateSubresource("CopyTextureRegion", pSource, SourceSubResource);
+
+  AddCommand(ezGALNullCommand::CopyTextureRegion, pDestination, DestinationSubResource.m_uiMipLevel, DestinationSubResource.m_uiArraySlice);
+}
+
+void ezGALContextNull::UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+  const ezBoundingBoxu32& DestinationBox, const ezGALSystemMemoryDescription& pSourceData)
+{
+  ValidateSubresource("UpdateTexture", pDestination, DestinationSubResource);
+
+  AddCommand(ezGALNullCommand::UpdateTexture, pDestination, DestinationSubResource.m_uiMipLevel, DestinationSubResource.m_uiArraySlice);
+}
+
+void ezGALContextNull::ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+  const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource)
+{
+  ValidateSubresource("ResolveTexture", pDestination, DestinationSubResource);
+  ValidateSubresource("ResolveTexture", pSource, SourceSubResource);
+
+  if (pSource->GetDescription().m_SampleCount == ezGALMSAASampleCount::None)
+  {
+    ValidationError("ResolveTexture", "Source texture is not multisampled");
+  }
+
+  AddCommand(ezGALNullCommand::ResolveTexture, pDestination, DestinationSubResource.m_uiMipLevel, DestinationSubResource.m_uiArraySlice);
+}
+
+void ezGALContextNull::ReadbackTexturePlatform(const ezGALTexture* pTexture)
+{
+  if (!pTexture->GetDescription().m_ResourceAccess.m_bReadBack)
+  {
+    ValidationError("ReadbackTexture", "Texture was not created with read back access");
+  }
+
+  AddCommand(ezGALNullCommand::ReadbackTexture, pTexture);
+}
+
+void ezGALContextNull::CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, const ezArrayPtr<ezGALSystemMemoryDescription>* pData)
+{
+  // There is no texture content, the target memory is left untouched.
+  AddCommand(ezGALNullCommand::CopyTextureReadbackResult, pTexture, pData->GetCount());
+}
+
+void ezGALContextNull::GenerateMipMapsPlatform(const ezGALResourceView* pResourceView)
+{
+  AddCommand(ezGALNullCommand::GenerateMipMaps, pResourceView);
+}
+
+// Misc
+
+void ezGALContextNull::FlushPlatform()
+{
+  AddCommand(ezGALNullCommand::Flush);
+}
+
+// Debug helper functions
+
+void ezGALContextNull::PushMarkerPlatform(const char* szMarker)
+{
+  ++m_uiMarkerDepth;
+  AddCommand(ezGALNullCommand::PushMarker, nullptr, m_uiMarkerDepth);
+}
+
+void ezGALContextNull::PopMarkerPlatform()
+{
+  if (m_uiMarkerDepth == 0)
+  {
+    ValidationError("PopMarker", "No marker has been pushed");
+  }
+  else
+  {
+    --m_uiMarkerDepth;
+  }
+
+  AddCommand(ezGALNullCommand::PopMarker, nullptr, m_uiMarkerDepth);
+}
+
+void ezGALContextNull::InsertEventMarkerPlatform(const char* szMarker)
+{
+  AddCommand(ezGALNullCommand::InsertEventMarker);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void ezGALContextNull::AddCommand(ezGALNullCommand::Enum command, const void* pObject, ezUInt32 uiArg0, ezUInt32 uiArg1, ezUInt32 uiArg2, ezUInt32 uiSlot)
+{
+  ++m_CommandCounts[command];
+
+  if (m_bRecordCommands)
+  {
+    ezGALNullRecordedCommand& cmd = m_RecordedCommands.ExpandAndGetRef();
+    cmd.m_pObject = pObject;
+    cmd.m_uiArgs[0] = uiArg0;
+    cmd.m_uiArgs[1] = uiArg1;
+    cmd.m_uiArgs[2] = uiArg2;
+    cmd.m_uiSlot = static_cast<ezUInt8>(uiSlot);
+    cmd.m_Command = command;
+  }
+}
+
+void ezGALContextNull::ValidationError(const char* szCommand, const char* szError)
+{
+  ++m_uiValidationErrors;
+  ezLog::Error("{0}: {1}", szCommand, szError);
+}
+
+void ezGALContextNull::ValidateDraw(const char* szCommand, bool bIndexed)
+{
+  if (m_pBoundShader == nullptr || !m_pBoundShader->GetDescription().HasByteCodeForStage(ezGALShaderStage::VertexShader))
+  {
+    ValidationError(szCommand, "No vertex shader bound");
+  }
+
+  if (bIndexed && m_pBoundIndexBuffer == nullptr)
+  {
+    ValidationError(szCommand, "No index buffer bound");
+  }
+}
+
+void ezGALContextNull::ValidateIndirectArguments(
+  const char* szCommand, const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes, ezUInt32 uiArgumentSize)
+{
+  if (!pIndirectArgumentBuffer->GetDescription().m_bUseForIndirectArguments)
+  {
+    ValidationError(szCommand, "Buffer was not created for indirect arguments");
+  }
+
+  ValidateBufferRange(szCommand, pIndirectArgumentBuffer, uiArgumentOffsetInBytes, uiArgumentSize);
+}
+
+void ezGALContextNull::ValidateBufferRange(const char* szCommand, const ezGALBuffer* pBuffer, ezUInt32 uiOffset, ezUInt32 uiByteCount)
+{
+  if (static_cast<ezUInt64>(uiOffset) + uiByteCount > pBuffer->GetSize())
+  {
+    ValidationError(szCommand, "Range exceeds the buffer size");
+  }
+}
+
+void ezGALContextNull::ValidateSubresource(const char* szCommand, const ezGALTexture* pTexture, const ezGALTextureSubresource& SubResource)
+{
+  const ezGALTextureCreationDescription& desc = pTexture->GetDescription();
+  const ezUInt32 uiNumSlices = desc.m_uiArraySize * (desc.m_Type == ezGALTextureType::TextureCube ? 6 : 1);
+
+  if (SubResource.m_uiMipLevel >= desc.m_uiMipLevelCount || SubResource.m_uiArraySlice >= uiNumSlices)
+  {
+    ValidationError(szCommand, "Sub-resource is out of range");
+  }
+}
+
+
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Context_Implementation_ContextNull);
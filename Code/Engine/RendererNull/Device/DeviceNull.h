@@ -0,0 +1,146 @@
+#pragma once
+
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class ezGALContextNull;
+
+/// \brief A device implementation of the graphics abstraction layer that doesn't talk to any graphics API.
+///
+/// All objects are created without native counterparts and all commands are only validated, counted and optionally recorded by
+/// ezGALContextNull. This is meant for measuring the CPU cost of extraction and rendering in benchmarks and on build machines
+/// that have no graphics card. Use ezGameApplication::SetOverrideDefaultDeviceCreator() to run a game application with it.
+class EZ_RENDERERNULL_DLL ezGALDeviceNull : public ezGALDevice
+{
+public:
+  ezGALDeviceNull(const ezGALDeviceCreationDescription& Description);
+
+  virtual ~ezGALDeviceNull();
+
+  /// \brief Number of live objects and the memory that buffers and textures would occupy on a real device.
+  struct Statistics
+  {
+    ezUInt32 m_uiNumBuffers = 0;
+    ezUInt32 m_uiNumTextures = 0;
+    ezUInt32 m_uiNumViews = 0; ///< Resource views, render target views and unordered access views.
+    ezUInt32 m_uiNumShaders = 0;
+    ezUInt32 m_uiNumStates = 0; ///< Blend, depth stencil, rasterizer and sampler states as well as vertex declarations.
+    ezUInt32 m_uiNumQueries = 0;
+    ezUInt32 m_uiNumPresents = 0;
+    ezUInt64 m_uiBufferMemory = 0;
+    ezUInt64 m_uiTextureMemory = 0;
+  };
+
+  const Statistics& GetStatistics() const { return m_Statistics; }
+
+  ezGALContextNull* GetNullContext() const;
+
+  // These functions need to be implemented by a render API abstraction
+protected:
+  // Init & shutdown functions
+
+  virtual ezResult InitPlatform() override;
+
+  virtual ezResult ShutdownPlatform() override;
+
+
+  // State creation functions
+
+  virtual ezGALBlendState* CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description) override;
+
+  virtual void DestroyBlendStatePlatform(ezGALBlendState* pBlendState) override;
+
+  virtual ezGALDepthStencilState* CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description) override;
+
+  virtual void DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState) override;
+
+  virtual ezGALRasterizerState* CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description) override;
+
+  virtual void DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState) override;
+
+  virtual ezGALSamplerState* CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description) override;
+
+  virtual void DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState) override;
+
+
+  // Resource creation functions
+
+  virtual ezGALShader* CreateShaderPlatform(const ezGALShaderCreationDescription& Description) override;
+
+  virtual void DestroyShaderPlatform(ezGALShader* pShader) override;
+
+  virtual ezGALBuffer* CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData) override;
+
+  virtual void DestroyBufferPlatform(ezGALBuffer* pBuffer) override;
+
+  virtual ezGALTexture* CreateTexturePlatform(
+    const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+
+  virtual void DestroyTexturePlatform(ezGALTexture* pTexture) override;
+
+  virtual ezGALResourceView* CreateResourceViewPlatform(
+    ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description) override;
+
+  virtual void DestroyResourceViewPlatform(ezGALResourceView* pResourceView) override;
+
+  virtual ezGALRenderTargetView* CreateRenderTargetViewPlatform(
+    ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description) override;
+
+  virtual void DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView) override;
+
+  virtual ezGALUnorderedAccessView* CreateUnorderedAccessViewPlatform(
+    ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description) override;
+
+  virtual void DestroyUnorderedAccessViewPlatform(ezGALUnorderedAccessView* pUnorderedAccessView) override;
+
+  // Other rendering creation functions
+
+  virtual ezGALSwapChain* CreateSwapChainPlatform(const ezGALSwapChainCreationDescription& Description) override;
+
+  virtual void DestroySwapChainPlatform(ezGALSwapChain* pSwapChain) override;
+
+  virtual ezGALFence* CreateFencePlatform() override;
+
+  virtual void DestroyFencePlatform(ezGALFence* pFence) override;
+
+  virtual ezGALQuery* CreateQueryPlatform(const ezGALQueryCreationDescription& Description) override;
+
+  virtual void DestroyQueryPlatform(ezGALQuery* pQuery) override;
+
+  virtual ezGALVertexDeclaration* CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description) override;
+
+  virtual void DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration) override;
+
+  // Timestamp functions
+
+  virtual ezGALTimestampHandle GetTimestampPlatform() override;
+
+  virtual ezResult GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result) override;
+
+  // Swap chain functions
+
+  virtual void PresentPlatform(ezGALSwapChain* pSwapChain, bool bVSync) override;
+
+  // Misc functions
+
+  virtual void BeginFramePlatform() override;
+
+  virtual void EndFramePlatform() override;
+
+  virtual void SetPrimarySwapChainPlatform(ezGALSwapChain* pSwapChain) override;
+
+  virtual void FillCapabilitiesPlatform() override;
+
+private:
+  friend class ezGALContextNull;
+
+  void SetTimestamp(ezGALTimestampHandle hTimestamp, ezTime time);
+
+  Statistics m_Statistics;
+
+  ezUInt64 m_uiFrameCounter = 0;
+
+  // Timestamps are written by the context on the CPU, the ring buffer has the same size as on real devices.
+  ezDynamicArray<ezTime> m_Timestamps;
+  ezUInt32 m_uiNextTimestamp = 0;
+};
@@ -0,0 +1,477 @@
+#include <RendererNullPCH.h>
+
+#include <Foundation/Math/Declarations.h>
+#include <RendererNull/Context/ContextNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Resources/ResourcesNull.h>
+
+ezGALDeviceNull::ezGALDeviceNull(const ezGALDeviceCreationDescription& Description)
+  : ezGALDevice(Description)
+{
+}
+
+ezGALDeviceNull::~ezGALDeviceNull() = default;
+
+ezGALContextNull* ezGALDeviceNull::GetNullContext() const
+{
+  return GetPrimaryContext<ezGALContextNull>();
+}
+
+// Init & shutdown functions
+
+ezResult ezGALDeviceNull::InitPlatform()
+{
+  EZ_LOG_BLOCK("ezGALDeviceNull::InitPlatform");
+
+  // Create primary context object
+  m_pPrimaryContext = EZ_NEW(&m_Allocator, ezGALContextNull, this);
+  EZ_ASSERT_RELEASE(m_pPrimaryContext != nullptr, "Couldn't create primary context!");
+
+  // Use the same conventions as the DX11 device so that CPU side results are comparable.
+  ezClipSpaceDepthRange::Default = ezClipSpaceDepthRange::ZeroToOne;
+
+  m_Timestamps.SetCount(1024);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDeviceNull::ShutdownPlatform()
+{
+  m_Timestamps.Clear();
+
+  EZ_DELETE(&m_Allocator, m_pPrimaryContext);
+
+  return EZ_SUCCESS;
+}
+
+
+// State creation functions
+
+ezGALBlendState* ezGALDeviceNull::CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description)
+{
+  ezGALBlendStateNull* pState = EZ_NEW(&m_Allocator, ezGALBlendStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiNumStates;
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyBlendStatePlatform(ezGALBlendState* pBlendState)
+{
+  ezGALBlendStateNull* pState = static_cast<ezGALBlendStateNull*>(pBlendState);
+  pState->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pState);
+
+  --m_Statistics.m_uiNumStates;
+}
+
+ezGALDepthStencilState* ezGALDeviceNull::CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description)
+{
+  ezGALDepthStencilStateNull* pState = EZ_NEW(&m_Allocator, ezGALDepthStencilStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiNumStates;
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState)
+{
+  ezGALDepthStencilStateNull* pState = static_cast<ezGALDepthStencilStateNull*>(pDepthStencilState);
+  pState->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pState);
+
+  --m_Statistics.m_uiNumStates;
+}
+
+ezGALRasterizerState* ezGALDeviceNull::CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description)
+{
+  ezGALRasterizerStateNull* pState = EZ_NEW(&m_Allocator, ezGALRasterizerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiNumStates;
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState)
+{
+  ezGALRasterizerStateNull* pState = static_cast<ezGALRasterizerStateNull*>(pRasterizerState);
+  pState->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pState);
+
+  --m_Statistics.m_uiNumStates;
+}
+
+ezGALSamplerState* ezGALDeviceNull::CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description)
+{
+  ezGALSamplerStateNull* pState = EZ_NEW(&m_Allocator, ezGALSamplerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiNumStates;
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState)
+{
+  ezGALSamplerStateNull* pState = static_cast<ezGALSamplerStateNull*>(pSamplerState);
+  pState->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pState);
+
+  --m_Statistics.m_uiNumStates;
+}
+
+
+// Resource creation functions
+
+ezGALShader* ezGALDeviceNull::CreateShaderPlatform(const ezGALShaderCreationDescription& Description)
+{
+  ezGALShaderNull* pShader = EZ_NEW(&m_Allocator, ezGALShaderNull, Description);
+
+  if (!pShader->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pShader);
+    return nullptr;
+  }
+
+  ++m_Statistics.m_uiNumShaders;
+  return pShader;
+}
+
+void ezGALDeviceNull::DestroyShaderPlatform(ezGALShader* pShader)
+{
+  ezGALShaderNull* pNullShader = static_cast<ezGALShaderNull*>(pShader);
+  pNullShader->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullShader);
+
+  --m_Statistics.m_uiNumShaders;
+}
+
+ezGALBuffer* ezGALDeviceNull::CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  ezGALBufferNull* pBuffer = EZ_NEW(&m_Allocator, ezGALBufferNull, Description);
+
+  if (!pBuffer->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pBuffer);
+    return nullptr;
+  }
+
+  ++m_Statistics.m_uiNumBuffers;
+  m_Statistics.m_uiBufferMemory += Description.m_uiTotalSize;
+  return pBuffer;
+}
+
+void ezGALDeviceNull::DestroyBufferPlatform(ezGALBuffer* pBuffer)
+{
+  --m_Statistics.m_uiNumBuffers;
+  m_Statistics.m_uiBufferMemory -= pBuffer->GetSize();
+
+  ezGALBufferNull* pNullBuffer = static_cast<ezGALBufferNull*>(pBuffer);
+  pNullBuffer->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullBuffer);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateTexturePlatform(
+  const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  ezGALTextureNull* pTexture = EZ_NEW(&m_Allocator, ezGALTextureNull, Description);
+
+  if (!pTexture->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pTexture);
+    return nullptr;
+  }
+
+  ++m_Statistics.m_uiNumTextures;
+  m_Statistics.m_uiTextureMemory += pTexture->GetMemorySize();
+  return pTexture;
+}
+
+void ezGALDeviceNull::DestroyTexturePlatform(ezGALTexture* pTexture)
+{
+  ezGALTextureNull* pNullTexture = static_cast<ezGALTextureNull*>(pTexture);
+
+  --m_Statistics.m_uiNumTextures;
+  m_Statistics.m_uiTextureMemory -= pNullTexture->GetMemorySize();
+
+  pNullTexture->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullTexture);
+}
+
+ezGALResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description)
+{
+  ezGALResourceViewNull* pResourceView = EZ_NEW(&m_Allocator, ezGALResourceViewNull, pResource, Description);
+
+  if (!pResourceView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pResourceView);
+    return nullptr;
+  }
+
+  ++m_Statistics.m_uiNumViews;
+  return pResourceView;
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALResourceView* pResourceView)
+{
+  ezGALResourceViewNull* pNullResourceView = static_cast<ezGALResourceViewNull*>(pResourceView);
+  pNullResourceView->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullResourceView);
+
+  --m_Statistics.m_uiNumViews;
+}
+
+ezGALRenderTargetView* ezGALDeviceNull::CreateRenderTargetViewPlatform(
+  ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+{
+  ezGALRenderTargetViewNull* pRTView = EZ_NEW(&m_Allocator, ezGALRenderTargetViewNull, pTexture, Description);
+
+  if (!pRTView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pRTView);
+    return nullptr;
+  }
+
+  ++m_Statistics.m_uiNumViews;
+  return pRTView;
+}
+
+void ezGALDeviceNull::DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView)
+{
+  ezGALRenderTargetViewNull* pNullRenderTargetView = static_cast<ezGALRenderTargetViewNull*>(pRenderTargetView);
+  pNullRenderTargetView->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullRenderTargetView);
+
+  --m_Statistics.m_uiNumViews;
+}
+
+ezGALUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(
+  ezGALResourceBase* pTextureOfBuffer, const ezGALUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALUnorderedAccessViewNull* pUnorderedAccessView = EZ_NEW(&m_Allocator, ezGALUnorderedAccessViewNull, pTextureOfBuffer, Description);
+
+  if (!pUnorderedAccessView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pUnorderedAccessView);
+    return nullptr;
+  }
+
+  ++m_Statistics.m_uiNumViews;
+  return pUnorderedAccessView;
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALUnorderedAccessViewNull* pNullUnorderedAccessView = static_cast<ezGALUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pNullUnorderedAccessView->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullUnorderedAccessView);
+
+  --m_Statistics.m_uiNumViews;
+}
+
+
+
+// Other rendering creation functions
+
+ezGALSwapChain* ezGALDeviceNull::CreateSwapChainPlatform(const ezGALSwapChainCreationDescription& Description)
+{
+  ezGALSwapChainNull* pSwapChain = EZ_NEW(&m_Allocator, ezGALSwapChainNull, Description);
+
+  if (!pSwapChain->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pSwapChain);
+    return nullptr;
+  }
+
+  return pSwapChain;
+}
+
+void ezGALDeviceNull::DestroySwapChainPlatform(ezGALSwapChain* pSwapChain)
+{
+  ezGALSwapChainNull* pNullSwapChain = static_cast<ezGALSwapChainNull*>(pSwapChain);
+  pNullSwapChain->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullSwapChain);
+}
+
+ezGALFence* ezGALDeviceNull::CreateFencePlatform()
+{
+  ezGALFenceNull* pFence = EZ_NEW(&m_Allocator, ezGALFenceNull);
+
+  if (!pFence->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pFence);
+    return nullptr;
+  }
+
+  return pFence;
+}
+
+void ezGALDeviceNull::DestroyFencePlatform(ezGALFence* pFence)
+{
+  ezGALFenceNull* pNullFence = static_cast<ezGALFenceNull*>(pFence);
+  pNullFence->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullFence);
+}
+
+ezGALQuery* ezGALDeviceNull::CreateQueryPlatform(const ezGALQueryCreationDescription& Description)
+{
+  ezGALQueryNull* pQuery = EZ_NEW(&m_Allocator, ezGALQueryNull, Description);
+
+  if (!pQuery->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pQuery);
+    return nullptr;
+  }
+
+  ++m_Statistics.m_uiNumQueries;
+  return pQuery;
+}
+
+void ezGALDeviceNull::DestroyQueryPlatform(ezGALQuery* pQuery)
+{
+  ezGALQueryNull* pNullQuery = static_cast<ezGALQueryNull*>(pQuery);
+  pNullQuery->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullQuery);
+
+  --m_Statistics.m_uiNumQueries;
+}
+
+ezGALVertexDeclaration* ezGALDeviceNull::CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description)
+{
+  ezGALVertexDeclarationNull* pVertexDeclaration = EZ_NEW(&m_Allocator, ezGALVertexDeclarationNull, Description);
+
+  if (!pVertexDeclaration->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pVertexDeclaration);
+    return nullptr;
+  }
+
+  ++m_Statistics.m_uiNumStates;
+  return pVertexDeclaration;
+}
+
+void ezGALDeviceNull::DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration)
+{
+  ezGALVertexDeclarationNull* pNullVertexDeclaration = static_cast<ezGALVertexDeclarationNull*>(pVertexDeclaration);
+  pNullVertexDeclaration->DeInitPlatform(this);
+  EZ_DELETE(&m_Allocator, pNullVertexDeclaration);
+
+  --m_Statistics.m_uiNumStates;
+}
+
+// Timestamp functions
+
+ezGALTimestampHandle ezGALDeviceNull::GetTimestampPlatform()
+{
+  ezUInt32 uiIndex = m_uiNextTimestamp;
+  m_uiNextTimestamp = (m_uiNextTimestamp + 1) % m_Timestamps.GetCount();
+  return {uiIndex, m_uiFrameCounter};
+}
+
+ezResult ezGALDeviceNull::GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result)
+{
+  // Older timestamps have been overwritten in the meantime
+  if (hTimestamp.m_uiFrameCounter + 4 < m_uiFrameCounter)
+  {
+    return EZ_FAILURE;
+  }
+
+  result = m_Timestamps[static_cast<ezUInt32>(hTimestamp.m_uiIndex)];
+  return EZ_SUCCESS;
+}
+
+void ezGALDeviceNull::SetTimestamp(ezGALTimestampHandle hTimestamp, ezTime time)
+{
+  m_Timestamps[static_cast<ezUInt32>(hTimestamp.m_uiIndex)] = time;
+}
+
+// Swap chain functions
+
+void ezGALDeviceNull::PresentPlatform(ezGALSwapChain* pSwapChain, bool bVSync)
+{
+  ++m_Statistics.m_uiNumPresents;
+}
+
+// Misc functions
+
+void ezGALDeviceNull::BeginFramePlatform() {}
+
+void ezGALDeviceNull::EndFramePlatform()
+{
+  ezGALContextNull* pContext = GetNullContext();
+  if (pContext->GetMarkerDepth() != 0)
+  {
+    ezLog::Warning("{0} debug markers have not been popped at the end of the frame.", pContext->GetMarkerDepth());
+  }
+
+  ++m_uiFrameCounter;
+}
+
+void ezGALDeviceNull::SetPrimarySwapChainPlatform(ezGALSwapChain* pSwapChain) {}
+
+void ezGALDeviceNull::FillCapabilitiesPlatform()
+{
+  m_Capabilities.m_sAdapterName = "Null Device";
+  m_Capabilities.m_uiDedicatedVRAM = 0;
+  m_Capabilities.m_uiDedicatedSystemRAM = 0;
+  m_Capabilities.m_uiSharedSystemRAM = 0;
+  m_Capabilities.m_bHardwareAccelerated = false;
+
+  m_Capabilities.m_bMultithreadedResourceCreation = true;
+
+  // Report the same capabilities as a DX11.1 device so that all code paths are exercised.
+  m_Capabilities.m_bB5G6R5Textures = true;
+  m_Capabilities.m_bNoOverwriteBufferUpdate = true;
+
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    m_Capabilities.m_bShaderStageSupported[stage] = true;
+  }
+
+  m_Capabilities.m_bInstancing = true;
+  m_Capabilities.m_b32BitIndices = true;
+  m_Capabilities.m_bIndirectDraw = true;
+  m_Capabilities.m_bStreamOut = true;
+  m_Capabilities.m_uiMaxConstantBuffers = 14;
+  m_Capabilities.m_bTextureArrays = true;
+  m_Capabilities.m_bCubemapArrays = true;
+  m_Capabilities.m_uiMaxTextureDimension = 16384;
+  m_Capabilities.m_uiMaxCubemapDimension = 16384;
+  m_Capabilities.m_uiMax3DTextureDimension = 2048;
+  m_Capabilities.m_uiMaxAnisotropy = 16;
+  m_Capabilities.m_uiMaxRendertargets = EZ_GAL_MAX_RENDERTARGET_COUNT;
+  m_Capabilities.m_uiUAVCount = 64;
+  m_Capabilities.m_bAlphaToCoverage = true;
+  m_Capabilities.m_bConservativeRasterization = true;
+}
+
+
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_DeviceNull);
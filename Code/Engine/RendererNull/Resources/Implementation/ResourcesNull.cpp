@@ -0,0 +1,340 @@
+#include <RendererNullPCH.h>
+
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/Resources/ResourcesNull.h>
+#include <System/Window/Window.h>
+
+ezGALBufferNull::ezGALBufferNull(const ezGALBufferCreationDescription& Description)
+  : ezGALBuffer(Description)
+{
+}
+
+ezGALBufferNull::~ezGALBufferNull() = default;
+
+ezResult ezGALBufferNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  if (pInitialData.GetCount() > m_Description.m_uiTotalSize)
+  {
+    ezLog::Error("Initial data of {0} bytes does not fit into a buffer of {1} bytes.", pInitialData.GetCount(), m_Description.m_uiTotalSize);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+void ezGALBufferNull::SetDebugNamePlatform(const char* szName) const {}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALTextureNull::ezGALTextureNull(const ezGALTextureCreationDescription& Description)
+  : ezGALTexture(Description)
+{
+}
+
+ezGALTextureNull::~ezGALTextureNull() = default;
+
+ezUInt64 ezGALTextureNull::GetMemorySize() const
+{
+  const ezUInt64 uiBitsPerElement = ezGALResourceFormat::GetBitsPerElement(m_Description.m_Format);
+
+  ezUInt64 uiBits = 0;
+  for (ezUInt32 uiMipLevel = 0; uiMipLevel < m_Description.m_uiMipLevelCount; ++uiMipLevel)
+  {
+    const ezUInt64 uiWidth = ezMath::Max(m_Description.m_uiWidth >> uiMipLevel, 1u);
+    const ezUInt64 uiHeight = ezMath::Max(m_Description.m_uiHeight >> uiMipLevel, 1u);
+    const ezUInt64 uiDepth = ezMath::Max(m_Description.m_uiDepth >> uiMipLevel, 1u);
+
+    uiBits += uiWidth * uiHeight * uiDepth * uiBitsPerElement;
+  }
+
+  const ezUInt64 uiNumFaces = m_Description.m_Type == ezGALTextureType::TextureCube ? 6 : 1;
+  return (uiBits / 8) * m_Description.m_uiArraySize * uiNumFaces * m_Description.m_SampleCount.GetValue();
+}
+
+ezResult ezGALTextureNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  if (!pInitialData.IsEmpty())
+  {
+    const ezUInt32 uiNumFaces = m_Description.m_Type == ezGALTextureType::TextureCube ? 6 : 1;
+    const ezUInt32 uiInitialDataCount = m_Description.m_uiMipLevelCount * m_Description.m_uiArraySize * uiNumFaces;
+
+    if (pInitialData.GetCount() != uiInitialDataCount)
+    {
+      ezLog::Error("The array of initial data values ({0}) does not match the number of sub-resources ({1}).", pInitialData.GetCount(), uiInitialDataCount);
+      return EZ_FAILURE;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureNull::ReplaceExisitingNativeObject(void* pExisitingNativeObject)
+{
+  return EZ_SUCCESS;
+}
+
+void ezGALTextureNull::SetDebugNamePlatform(const char* szName) const {}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALResourceViewNull::ezGALResourceViewNull(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description)
+  : ezGALResourceView(pResource, Description)
+{
+}
+
+ezGALResourceViewNull::~ezGALResourceViewNull() = default;
+
+ezResult ezGALResourceViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALResourceViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALRenderTargetViewNull::ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+  : ezGALRenderTargetView(pTexture, Description)
+{
+}
+
+ezGALRenderTargetViewNull::~ezGALRenderTargetViewNull() = default;
+
+ezResult ezGALRenderTargetViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALRenderTargetViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALUnorderedAccessViewNull::ezGALUnorderedAccessViewNull(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description)
+  : ezGALUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALUnorderedAccessViewNull::~ezGALUnorderedAccessViewNull() = default;
+
+ezResult ezGALUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALFenceNull::ezGALFenceNull() = default;
+
+ezGALFenceNull::~ezGALFenceNull() = default;
+
+ezResult ezGALFenceNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALFenceNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALQueryNull::ezGALQueryNull(const ezGALQueryCreationDescription& Description)
+  : ezGALQuery(Description)
+{
+}
+
+ezGALQueryNull::~ezGALQueryNull() = default;
+
+ezResult ezGALQueryNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALQueryNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+void ezGALQueryNull::SetDebugNamePlatform(const char* szName) const {}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALShaderNull::ezGALShaderNull(const ezGALShaderCreationDescription& Description)
+  : ezGALShader(Description)
+{
+}
+
+ezGALShaderNull::~ezGALShaderNull() = default;
+
+void ezGALShaderNull::SetDebugName(const char* szName) const {}
+
+ezResult ezGALShaderNull::InitPlatform(ezGALDevice* pDevice)
+{
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    if (m_Description.HasByteCodeForStage((ezGALShaderStage::Enum)stage))
+    {
+      return EZ_SUCCESS;
+    }
+  }
+
+  ezLog::Error("Shader has no byte code for any stage.");
+  return EZ_FAILURE;
+}
+
+ezResult ezGALShaderNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALVertexDeclarationNull::ezGALVertexDeclarationNull(const ezGALVertexDeclarationCreationDescription& Description)
+  : ezGALVertexDeclaration(Description)
+{
+}
+
+ezGALVertexDeclarationNull::~ezGALVertexDeclarationNull() = default;
+
+ezResult ezGALVertexDeclarationNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALVertexDeclarationNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALBlendStateNull::ezGALBlendStateNull(const ezGALBlendStateCreationDescription& Description)
+  : ezGALBlendState(Description)
+{
+}
+
+ezGALBlendStateNull::~ezGALBlendStateNull() = default;
+
+ezResult ezGALBlendStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBlendStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALDepthStencilStateNull::ezGALDepthStencilStateNull(const ezGALDepthStencilStateCreationDescription& Description)
+  : ezGALDepthStencilState(Description)
+{
+}
+
+ezGALDepthStencilStateNull::~ezGALDepthStencilStateNull() = default;
+
+ezResult ezGALDepthStencilStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDepthStencilStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALRasterizerStateNull::ezGALRasterizerStateNull(const ezGALRasterizerStateCreationDescription& Description)
+  : ezGALRasterizerState(Description)
+{
+}
+
+ezGALRasterizerStateNull::~ezGALRasterizerStateNull() = default;
+
+ezResult ezGALRasterizerStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALRasterizerStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALSamplerStateNull::ezGALSamplerStateNull(const ezGALSamplerStateCreationDescription& Description)
+  : ezGALSamplerState(Description)
+{
+}
+
+ezGALSamplerStateNull::~ezGALSamplerStateNull() = default;
+
+ezResult ezGALSamplerStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALSamplerStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALSwapChainNull::ezGALSwapChainNull(const ezGALSwapChainCreationDescription& Description)
+  : ezGALSwapChain(Description)
+{
+}
+
+ezGALSwapChainNull::~ezGALSwapChainNull() = default;
+
+ezResult ezGALSwapChainNull::InitPlatform(ezGALDevice* pDevice)
+{
+  ezGALTextureCreationDescription TexDesc;
+  TexDesc.m_uiWidth = m_Description.m_pWindow->GetClientAreaSize().width;
+  TexDesc.m_uiHeight = m_Description.m_pWindow->GetClientAreaSize().height;
+  TexDesc.m_SampleCount = m_Description.m_SampleCount;
+  TexDesc.m_Format = m_Description.m_BackBufferFormat;
+  TexDesc.m_bAllowShaderResourceView = false;
+  TexDesc.m_bCreateRenderTarget = true;
+  TexDesc.m_ResourceAccess.m_bImmutable = true;
+  TexDesc.m_ResourceAccess.m_bReadBack = m_Description.m_bAllowScreenshots;
+
+  m_hBackBufferTexture = pDevice->CreateTexture(TexDesc);
+  if (m_hBackBufferTexture.IsInvalidated())
+  {
+    ezLog::Error("Couldn't create backbuffer texture object!");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_ResourcesNull);
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <RendererFoundation/Device/SwapChain.h>
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererFoundation/Resources/Fence.h>
+#include <RendererFoundation/Resources/Query.h>
+#include <RendererFoundation/Resources/RenderTargetView.h>
+#include <RendererFoundation/Resources/ResourceView.h>
+#include <RendererFoundation/Resources/Texture.h>
+#include <RendererFoundation/Resources/UnorderedAccesView.h>
+#include <RendererFoundation/Shader/Shader.h>
+#include <RendererFoundation/Shader/VertexDeclaration.h>
+#include <RendererFoundation/State/State.h>
+#include <RendererNull/RendererNullDLL.h>
+
+// The null renderer does not create any native objects. All classes in this file only exist to satisfy the GAL interface,
+// their InitPlatform functions always succeed.
+
+class EZ_RENDERERNULL_DLL ezGALBufferNull : public ezGALBuffer
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALBufferNull(const ezGALBufferCreationDescription& Description);
+
+  virtual ~ezGALBufferNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALTextureNull : public ezGALTexture
+{
+public:
+  /// \brief Returns the number of bytes the texture would occupy in GPU memory, including all mip levels and array slices.
+  ezUInt64 GetMemorySize() const;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALTextureNull(const ezGALTextureCreationDescription& Description);
+
+  virtual ~ezGALTextureNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult ReplaceExisitingNativeObject(void* pExisitingNativeObject) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALResourceViewNull : public ezGALResourceView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALResourceViewNull(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description);
+
+  virtual ~ezGALResourceViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALRenderTargetViewNull : public ezGALRenderTargetView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description);
+
+  virtual ~ezGALRenderTargetViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALUnorderedAccessViewNull : public ezGALUnorderedAccessView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALUnorderedAccessViewNull(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description);
+
+  virtual ~ezGALUnorderedAccessViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALFenceNull : public ezGALFence
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALFenceNull();
+
+  virtual ~ezGALFenceNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALQueryNull : public ezGALQuery
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALQueryNull(const ezGALQueryCreationDescription& Description);
+
+  virtual ~ezGALQueryNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALShaderNull : public ezGALShader
+{
+public:
+  virtual void SetDebugName(const char* szName) const override;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALShaderNull(const ezGALShaderCreationDescription& Description);
+
+  virtual ~ezGALShaderNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALVertexDeclarationNull : public ezGALVertexDeclaration
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALVertexDeclarationNull(const ezGALVertexDeclarationCreationDescription& Description);
+
+  virtual ~ezGALVertexDeclarationNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALBlendStateNull : public ezGALBlendState
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALBlendStateNull(const ezGALBlendStateCreationDescription& Description);
+
+  virtual ~ezGALBlendStateNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALDepthStencilStateNull : public ezGALDepthStencilState
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALDepthStencilStateNull(const ezGALDepthStencilStateCreationDescription& Description);
+
+  virtual ~ezGALDepthStencilStateNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALRasterizerStateNull : public ezGALRasterizerState
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALRasterizerStateNull(const ezGALRasterizerStateCreationDescription& Description);
+
+  virtual ~ezGALRasterizerStateNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALSamplerStateNull : public ezGALSamplerState
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALSamplerStateNull(const ezGALSamplerStateCreationDescription& Description);
+
+  virtual ~ezGALSamplerStateNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+/// \brief A swap chain without a native counterpart. Creates a back buffer texture with the size of the window's client area.
+class EZ_RENDERERNULL_DLL ezGALSwapChainNull : public ezGALSwapChain
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALSwapChainNull(const ezGALSwapChainCreationDescription& Description);
+
+  virtual ~ezGALSwapChainNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/DataProcessing/Stream/ProcessingStream.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
 #include <Foundation/Reflection/Reflection.h>
 #include <ParticlePlugin/Module/ParticleModule.h>
@@ -37,5 +38,14 @@ protected:
   virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override {}
   virtual void StepParticleSystem(const ezTime& tDiff, ezUInt32 uiNumNewParticles) { m_TimeDiff = tDiff; }
 
+  /// \brief Returns the first \a uiNumElements elements of the stream as one contiguous array, e.g. to process them with the functions in
+  /// ezParticleBehaviorKernels instead of iterating over them one by one.
+  template <typename Type>
+  static ezArrayPtr<Type> GetStreamElements(const ezProcessingStream* pStream, ezUInt64 uiNumElements)
+  {
+    EZ_ASSERT_DEBUG(pStream->GetElementStride() == sizeof(Type), "Stream element type does not match the requested type");
+    return ezArrayPtr<Type>(static_cast<Type*>(pStream->GetWritableData()), static_cast<ezUInt32>(uiNumElements));
+  }
+
   ezTime m_TimeDiff;
 };
@@ -0,0 +1,155 @@
+#include <ParticlePluginPCH.h>
+
+#include <ParticlePlugin/Behavior/ParticleBehaviorKernels.h>
+
+// static
+void ezParticleBehaviorKernels::AddVec3(ezArrayPtr<ezVec3> values, const ezVec3& vValue)
+{
+  // four ezVec3 are twelve floats, ie. exactly three ezSimdVec4f, in which the components of vValue repeat with an offset
+  const ezSimdVec4f vAdd0(vValue.x, vValue.y, vValue.z, vValue.x);
+  const ezSimdVec4f vAdd1(vValue.y, vValue.z, vValue.x, vValue.y);
+  const ezSimdVec4f vAdd2(vValue.z, vValue.x, vValue.y, vValue.z);
+
+  const ezUInt32 uiNumBatches = values.GetCount() / 4;
+  float* pData = &values.GetPtr()->x;
+
+  for (ezUInt32 i = 0; i < uiNumBatches; ++i, pData += 12)
+  {
+    ezSimdVec4f v0, v1, v2;
+    v0.Load<4>(pData + 0);
+    v1.Load<4>(pData + 4);
+    v2.Load<4>(pData + 8);
+
+    (v0 + vAdd0).Store<4>(pData + 0);
+    (v1 + vAdd1).Store<4>(pData + 4);
+    (v2 + vAdd2).Store<4>(pData + 8);
+  }
+
+  for (ezUInt32 i = uiNumBatches * 4; i < values.GetCount(); ++i)
+  {
+    values[i] += vValue;
+  }
+}
+
+// static
+void ezParticleBehaviorKernels::ScaleVec3(ezArrayPtr<ezVec3> values, float fScale)
+{
+  const ezSimdVec4f vScale(fScale);
+
+  const ezUInt32 uiNumBatches = values.GetCount() / 4;
+  float* pData = &values.GetPtr()->x;
+
+  for (ezUInt32 i = 0; i < uiNumBatches; ++i, pData += 12)
+  {
+    ezSimdVec4f v0, v1, v2;
+    v0.Load<4>(pData + 0);
+    v1.Load<4>(pData + 4);
+    v2.Load<4>(pData + 8);
+
+    v0.CompMul(vScale).Store<4>(pData + 0);
+    v1.CompMul(vScale).Store<4>(pData + 4);
+    v2.CompMul(vScale).Store<4>(pData + 8);
+  }
+
+  for (ezUInt32 i = uiNumBatches * 4; i < values.GetCount(); ++i)
+  {
+    values[i] *= fScale;
+  }
+}
+
+// static
+void ezParticleBehaviorKernels::AddVec4(ezArrayPtr<ezSimdVec4f> values, const ezSimdVec4f& vValue)
+{
+  const ezUInt32 uiNumBatches = values.GetCount() / 4;
+  ezSimdVec4f* pData = values.GetPtr();
+
+  for (ezUInt32 i = 0; i < uiNumBatches; ++i, pData += 4)
+  {
+    pData[0] += vValue;
+    pData[1] += vValue;
+    pData[2] += vValue;
+    pData[3] += vValue;
+  }
+
+  for (ezUInt32 i = uiNumBatches * 4; i < values.GetCount(); ++i)
+  {
+    values[i] += vValue;
+  }
+}
+
+// static
+void ezParticleBehaviorKernels::FadeOutAlpha(ezArrayPtr<const ezFloat16Vec2> lifeTimes, ezArrayPtr<ezColorLinear16f> colors, float fStartAlpha, float fExponent, ezUInt32 uiFirst, ezUInt32 uiStride)
+{
+  EZ_ASSERT_DEBUG(lifeTimes.GetCount() == colors.GetCount(), "Streams need to have the same number of elements");
+  EZ_ASSERT_DEBUG(uiStride > 0, "Invalid stride");
+
+  const ezUInt32 uiNumElements = lifeTimes.GetCount();
+  const ezSimdVec4f vStartAlpha(fStartAlpha);
+  const ezSimdVec4f vOne(1.0f);
+  const bool bClamp = fStartAlpha > 1.0f;
+  const bool bLinear = fExponent == 1.0f;
+
+  ezUInt32 uiIndex = uiFirst;
+
+  // the half floats have to be converted one by one, the math is done for four particles at once
+  while (uiIndex + 3 * uiStride < uiNumElements)
+  {
+    float fRemaining[4];
+    float fTotalInv[4];
+    for (ezUInt32 lane = 0; lane < 4; ++lane)
+    {
+      const ezFloat16Vec2& lifeTime = lifeTimes[uiIndex + lane * uiStride];
+      fRemaining[lane] = lifeTime.x;
+      fTotalInv[lane] = lifeTime.y;
+    }
+
+    ezSimdVec4f vFraction;
+    vFraction.Load<4>(fRemaining);
+
+    ezSimdVec4f vTotalInv;
+    vTotalInv.Load<4>(fTotalInv);
+
+    vFraction = vFraction.CompMul(vTotalInv);
+
+    if (!bLinear)
+    {
+      float fFraction[4];
+      vFraction.Store<4>(fFraction);
+
+      for (ezUInt32 lane = 0; lane < 4; ++lane)
+      {
+        fFraction[lane] = ezMath::Pow(fFraction[lane], fExponent);
+      }
+
+      vFraction.Load<4>(fFraction);
+    }
+
+    ezSimdVec4f vAlpha = vFraction.CompMul(vStartAlpha);
+
+    if (bClamp)
+    {
+      vAlpha = vAlpha.CompMin(vOne);
+    }
+
+    float fAlpha[4];
+    vAlpha.Store<4>(fAlpha);
+
+    for (ezUInt32 lane = 0; lane < 4; ++lane)
+    {
+      colors[uiIndex + lane * uiStride].a = fAlpha[lane];
+    }
+
+    uiIndex += 4 * uiStride;
+  }
+
+  for (; uiIndex < uiNumElements; uiIndex += uiStride)
+  {
+    const float fLifeTimeFraction = lifeTimes[uiIndex].x * lifeTimes[uiIndex].y;
+    const float fAlpha = fStartAlpha * ezMath::Pow(fLifeTimeFraction, fExponent);
+
+    colors[uiIndex].a = bClamp ? ezMath::Min(1.0f, fAlpha) : fAlpha;
+  }
+}
+
+
+EZ_STATICLINK_FILE(ParticlePlugin, ParticlePlugin_Behavior_ParticleBehaviorKernels);
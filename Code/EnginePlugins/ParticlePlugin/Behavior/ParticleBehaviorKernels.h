@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Foundation/Math/Color16f.h>
+#include <Foundation/Math/Float16.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <ParticlePlugin/ParticlePluginDLL.h>
+
+/// \brief SIMD functions that particle behaviors use to process whole streams at once.
+///
+/// All functions take the contiguous data of a stream (see ezParticleBehavior::GetStreamElements()), process four particles per
+/// iteration with ezSimdVec4f and handle the remaining particles at the end individually. Only unaligned loads and stores are used,
+/// so the arrays may start at any element.
+struct EZ_PARTICLEPLUGIN_DLL ezParticleBehaviorKernels
+{
+  /// \brief Adds \a vValue to all elements, e.g. gravity to the velocity stream.
+  static void AddVec3(ezArrayPtr<ezVec3> values, const ezVec3& vValue);
+
+  /// \brief Multiplies all elements with \a fScale, e.g. friction with the velocity stream.
+  static void ScaleVec3(ezArrayPtr<ezVec3> values, float fScale);
+
+  /// \brief Adds \a vValue to all elements of a Float4 stream, e.g. a movement to the position stream.
+  static void AddVec4(ezArrayPtr<ezSimdVec4f> values, const ezSimdVec4f& vValue);
+
+  /// \brief Sets the alpha of every \a uiStride-th particle, starting with \a uiFirst, to the remaining life time fraction to the power of
+  /// \a fExponent, scaled by \a fStartAlpha and clamped to one.
+  static void FadeOutAlpha(ezArrayPtr<const ezFloat16Vec2> lifeTimes, ezArrayPtr<ezColorLinear16f> colors, float fStartAlpha, float fExponent, ezUInt32 uiFirst, ezUInt32 uiStride);
+};
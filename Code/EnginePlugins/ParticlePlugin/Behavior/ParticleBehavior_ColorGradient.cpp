@@ -174,69 +174,46 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
 
   const ezColorGradient& gradient = pGradient->GetDescriptor().m_Gradient;
 
-  ezProcessingStreamIterator<ezColorLinear16f> itColor(m_pStreamColor, uiNumElements, 0);
-
-  // skip the first n particles
-  itColor.Advance(m_uiFirstToUpdate);
+  ezArrayPtr<ezColorLinear16f> colors = GetStreamElements<ezColorLinear16f>(m_pStreamColor, uiNumElements);
+  ezArrayPtr<const ezFloat16Vec2> lifeTimes;
+  ezArrayPtr<const ezVec3> velocities;
 
   if (m_GradientMode == ezParticleColorGradientMode::Age)
-  {
-    ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
+    lifeTimes = GetStreamElements<const ezFloat16Vec2>(m_pStreamLifeTime, uiNumElements);
+  else
+    velocities = GetStreamElements<const ezVec3>(m_pStreamVelocity, uiNumElements);
+
+  const float fInvMaxSpeed = 1.0f / m_fMaxSpeed;
 
-    // skip the first n particles
-    itLifeTime.Advance(m_uiFirstToUpdate);
+  // only every n-th particle is updated, to reduce the number of particles that need to be evaluated,
+  // since sampling the color gradient is pretty expensive
+  // those are gathered into small batches, such that the gradient can evaluate multiple positions at once
+  constexpr ezUInt32 uiBatchSize = 64;
+  float positions[uiBatchSize];
+  ezColor rgba[uiBatchSize];
 
-    while (!itLifeTime.HasReachedEnd())
+  for (ezUInt32 uiBatchStart = m_uiFirstToUpdate; uiBatchStart < colors.GetCount(); uiBatchStart += uiBatchSize * m_uiCurrentUpdateInterval)
+  {
+    ezUInt32 uiBatchCount = 0;
+    for (ezUInt32 i = uiBatchStart; i < colors.GetCount() && uiBatchCount < uiBatchSize; i += m_uiCurrentUpdateInterval, ++uiBatchCount)
     {
-      // if (itLifeTime.Current().y > 0)
+      if (m_GradientMode == ezParticleColorGradientMode::Age)
       {
-        const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-        const float posx = 1.0f - fLifeTimeFraction;
-
-        ezColor rgba;
-        ezUInt8 alpha;
-        gradient.EvaluateColor(posx, rgba);
-        gradient.EvaluateAlpha(posx, alpha);
-        rgba.a = ezMath::ColorByteToFloat(alpha);
-
-        itColor.Current() = rgba * m_TintColor;
+        const float fLifeTimeFraction = lifeTimes[i].x * lifeTimes[i].y;
+        positions[uiBatchCount] = 1.0f - fLifeTimeFraction;
+      }
+      else
+      {
+        // no need to clamp the range, the color lookup will already do that
+        positions[uiBatchCount] = velocities[i].GetLength() * fInvMaxSpeed;
       }
-
-      // skip the next n items
-      // this is to reduce the number of particles that need to be fully evaluated,
-      // since sampling the color gradient is pretty expensive
-      itLifeTime.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
     }
-  }
-  else if (m_GradientMode == ezParticleColorGradientMode::Speed)
-  {
-    ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
 
-    // skip the first n particles
-    itVelocity.Advance(m_uiFirstToUpdate);
+    gradient.EvaluateColorAndAlpha(ezMakeArrayPtr(positions, uiBatchCount), ezMakeArrayPtr(rgba, uiBatchCount));
 
-    while (!itVelocity.HasReachedEnd())
+    for (ezUInt32 j = 0; j < uiBatchCount; ++j)
     {
-      // if (itLifeTime.Current().y > 0)
-      {
-        const float fSpeed = itVelocity.Current().GetLength();
-        const float posx = fSpeed / m_fMaxSpeed; // no need to clamp the range, the color lookup will already do that
-
-        ezColor rgba;
-        ezUInt8 alpha;
-        gradient.EvaluateColor(posx, rgba);
-        gradient.EvaluateAlpha(posx, alpha);
-        rgba.a = ezMath::ColorByteToFloat(alpha);
-
-        itColor.Current() = rgba * m_TintColor;
-      }
-
-      // skip the next n items
-      // this is to reduce the number of particles that need to be fully evaluated,
-      // since sampling the color gradient is pretty expensive
-      itVelocity.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
+      colors[uiBatchStart + j * m_uiCurrentUpdateInterval] = rgba[j] * m_TintColor;
     }
   }
 
@@ -1,8 +1,8 @@
 #include <ParticlePluginPCH.h>
 
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Math/Color16f.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <ParticlePlugin/Behavior/ParticleBehaviorKernels.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_FadeOut.h>
 #include <ParticlePlugin/Effect/ParticleEffectInstance.h>
 
@@ -72,51 +72,14 @@ void ezParticleBehavior_FadeOut::Process(ezUInt64 uiNumElements)
 
   EZ_PROFILE_SCOPE("PFX: Fade Out");
 
-  ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
-  ezProcessingStreamIterator<ezColorLinear16f> itColor(m_pStreamColor, uiNumElements, 0);
+  const ezUInt32 uiFirstToUpdate = m_uiFirstToUpdate;
 
-  // skip the first n particles
-  {
-    for (ezUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
-    {
-      itLifeTime.Advance();
-      itColor.Advance();
-    }
-
-    ++m_uiFirstToUpdate;
-    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
-      m_uiFirstToUpdate = 0;
-  }
+  ++m_uiFirstToUpdate;
+  if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
+    m_uiFirstToUpdate = 0;
 
-  if (m_fStartAlpha <= 1.0f)
-  {
-    while (!itLifeTime.HasReachedEnd())
-    {
-      const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-      itColor.Current().a = m_fStartAlpha * ezMath::Pow(fLifeTimeFraction, m_fExponent);
-
-      for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-      {
-        itLifeTime.Advance();
-        itColor.Advance();
-      }
-    }
-  }
-  else
-  {
-    // this case has to clamp alpha to 1
-    while (!itLifeTime.HasReachedEnd())
-    {
-      const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-      itColor.Current().a = ezMath::Min(1.0f, m_fStartAlpha * ezMath::Pow(fLifeTimeFraction, m_fExponent));
-
-      for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-      {
-        itLifeTime.Advance();
-        itColor.Advance();
-      }
-    }
-  }
+  // alpha is clamped to 1 inside the kernel, if the start alpha is larger than that
+  ezParticleBehaviorKernels::FadeOutAlpha(GetStreamElements<const ezFloat16Vec2>(m_pStreamLifeTime, uiNumElements), GetStreamElements<ezColorLinear16f>(m_pStreamColor, uiNumElements), m_fStartAlpha, m_fExponent, uiFirstToUpdate, m_uiCurrentUpdateInterval);
 
   /// \todo Use level of detail to reduce the update interval further
   /// up close, with a high interval, animations appear choppy, especially when fading stuff out at the end
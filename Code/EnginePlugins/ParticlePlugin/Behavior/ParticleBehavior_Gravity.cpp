@@ -2,10 +2,10 @@
 
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <GameEngine/Interfaces/PhysicsWorldModule.h>
+#include <ParticlePlugin/Behavior/ParticleBehaviorKernels.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Gravity.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
 #include <ParticlePlugin/System/ParticleSystemInstance.h>
@@ -75,6 +75,11 @@ void ezParticleBehavior_Gravity::CreateRequiredStreams()
 }
 
 void ezParticleBehavior_Gravity::Process(ezUInt64 uiNumElements)
+{
+  ProcessRange(0, uiNumElements);
+}
+
+void ezParticleBehavior_Gravity::ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
 {
   EZ_PROFILE_SCOPE("PFX: Gravity");
 
@@ -83,14 +88,7 @@ void ezParticleBehavior_Gravity::Process(ezUInt64 uiNumElements)
   const float tDiff = (float)m_TimeDiff.GetSeconds();
   const ezVec3 addGravity = vGravity * m_fGravityFactor * tDiff;
 
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
-
-  while (!itVelocity.HasReachedEnd())
-  {
-    itVelocity.Current() += addGravity;
-
-    itVelocity.Advance();
-  }
+  ezParticleBehaviorKernels::AddVec3(GetStreamElements<ezVec3>(m_pStreamVelocity, uiStartIndex + uiNumElements).GetSubArray(static_cast<ezUInt32>(uiStartIndex)), addGravity);
 }
 
 void ezParticleBehavior_Gravity::RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule)
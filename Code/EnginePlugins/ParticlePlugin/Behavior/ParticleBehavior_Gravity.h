@@ -32,11 +32,13 @@ public:
   float m_fGravityFactor;
 
   virtual void CreateRequiredStreams() override;
+  virtual bool SupportsParallelProcessing() const override { return true; }
 
 protected:
   friend class ezParticleBehaviorFactory_Gravity;
 
   virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   void RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule) override;
 
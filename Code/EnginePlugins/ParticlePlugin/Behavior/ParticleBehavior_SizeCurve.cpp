@@ -112,9 +112,6 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
 
   EZ_PROFILE_SCOPE("PFX: Size Curve");
 
-  ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
-  ezProcessingStreamIterator<ezFloat16> itSize(m_pStreamSize, uiNumElements, 0);
-
   ezResourceLock<ezCurve1DResource> pCurve(m_hCurve, ezResourceAcquireMode::BlockTillLoaded);
 
   if (pCurve.GetAcquireResult() == ezResourceAcquireResult::MissingFallback)
@@ -128,39 +125,48 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
   double fMinX, fMaxX;
   curve.QueryExtents(fMinX, fMaxX);
 
-  // skip the first n particles
-  {
-    for (ezUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
-    {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
+  double fMinY, fMaxY;
+  curve.QueryExtremeValues(fMinY, fMaxY);
+
+  // same as ConvertNormalizedPos() and NormalizeValue(), but without recomputing the ranges for every particle
+  const float fPosOffset = (float)fMinX;
+  const float fPosScale = (float)(fMaxX - fMinX);
+  const float fValueOffset = (float)fMinY;
+  const float fValueScale = fMinY < fMaxY ? (float)(m_fCurveScale / (fMaxY - fMinY)) : 0.0f;
+
+  const ezUInt32 uiFirstToUpdate = m_uiFirstToUpdate;
+  const ezUInt32 uiUpdateInterval = m_uiCurrentUpdateInterval;
 
+  // adjust which index is the first to update
+  {
     ++m_uiFirstToUpdate;
     if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
       m_uiFirstToUpdate = 0;
   }
 
-  while (!itLifeTime.HasReachedEnd())
-  {
-    // if (itLifeTime.Current().y > 0)
-    {
-      const float fLifeTimeFraction = 1.0f - (itLifeTime.Current().x * itLifeTime.Current().y);
+  ezArrayPtr<const ezFloat16Vec2> lifeTimes = GetStreamElements<const ezFloat16Vec2>(m_pStreamLifeTime, uiNumElements);
+  ezArrayPtr<ezFloat16> sizes = GetStreamElements<ezFloat16>(m_pStreamSize, uiNumElements);
 
-      const double evalPos = curve.ConvertNormalizedPos(fLifeTimeFraction);
-      double val = curve.Evaluate(evalPos);
-      val = curve.NormalizeValue(val);
+  // only every n-th particle is updated, to reduce the number of particles that need to be evaluated
+  // those are gathered into small batches, such that the curve can evaluate multiple positions at once
+  constexpr ezUInt32 uiBatchSize = 64;
+  float positions[uiBatchSize];
+  float values[uiBatchSize];
 
-      itSize.Current() = m_fBaseSize + (float)val * m_fCurveScale;
+  for (ezUInt32 uiBatchStart = uiFirstToUpdate; uiBatchStart < sizes.GetCount(); uiBatchStart += uiBatchSize * uiUpdateInterval)
+  {
+    ezUInt32 uiBatchCount = 0;
+    for (ezUInt32 i = uiBatchStart; i < sizes.GetCount() && uiBatchCount < uiBatchSize; i += uiUpdateInterval, ++uiBatchCount)
+    {
+      const float fLifeTimeFraction = 1.0f - (lifeTimes[i].x * lifeTimes[i].y);
+      positions[uiBatchCount] = fPosOffset + fLifeTimeFraction * fPosScale;
     }
 
-    // skip the next n items
-    // this is to reduce the number of particles that need to be fully evaluated,
-    // since sampling the curve is expensive
-    for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
+    curve.Evaluate(ezMakeArrayPtr(positions, uiBatchCount), ezMakeArrayPtr(values, uiBatchCount));
+
+    for (ezUInt32 j = 0; j < uiBatchCount; ++j)
     {
-      itLifeTime.Advance();
-      itSize.Advance();
+      sizes[uiBatchStart + j * uiUpdateInterval] = m_fBaseSize + (values[j] - fValueOffset) * fValueScale;
     }
   }
 }
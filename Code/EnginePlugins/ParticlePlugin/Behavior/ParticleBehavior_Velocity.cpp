@@ -2,11 +2,11 @@
 
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <GameEngine/Interfaces/PhysicsWorldModule.h>
 #include <GameEngine/Interfaces/WindWorldModule.h>
+#include <ParticlePlugin/Behavior/ParticleBehaviorKernels.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Velocity.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
 #include <ParticlePlugin/System/ParticleSystemInstance.h>
@@ -107,39 +107,43 @@ void ezParticleBehavior_Velocity::CreateRequiredStreams()
   CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
 }
 
-void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
+void ezParticleBehavior_Velocity::StepParticleSystem(const ezTime& tDiff, ezUInt32 uiNumNewParticles)
 {
-  EZ_PROFILE_SCOPE("PFX: Velocity");
+  SUPER::StepParticleSystem(tDiff, uiNumNewParticles);
 
-  const float tDiff = (float)m_TimeDiff.GetSeconds();
+  const float fDiff = (float)m_TimeDiff.GetSeconds();
   const ezVec3 vDown = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity().GetNormalized() : ezVec3(0.0f, 0.0f, -1.0f);
-  const ezVec3 vRise = vDown * tDiff * -m_fRiseSpeed;
+  const ezVec3 vRise = vDown * fDiff * -m_fRiseSpeed;
 
   ezVec3 vWind(0);
   if (m_pWindModule != nullptr)
   {
-    vWind = m_pWindModule->GetWindAt(GetOwnerSystem()->GetTransform().m_vPosition) * m_fWindInfluence * tDiff;
+    vWind = m_pWindModule->GetWindAt(GetOwnerSystem()->GetTransform().m_vPosition) * m_fWindInfluence * fDiff;
   }
 
-  const ezVec3 vAddPos0 = vRise + vWind;
-
-  ezSimdVec4f vAddPos;
-  vAddPos.Load<3>(&vAddPos0.x);
+  m_vAddPosition = vRise + vWind;
 
   const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
-  const float fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
+  m_fFrictionFactor = ezMath::Pow(0.5f, fDiff * fFriction);
+}
 
-  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
+{
+  ProcessRange(0, uiNumElements);
+}
 
-  while (!itPosition.HasReachedEnd())
-  {
-    itPosition.Current() += vAddPos;
-    itVelocity.Current() *= fFrictionFactor;
+void ezParticleBehavior_Velocity::ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
+  EZ_PROFILE_SCOPE("PFX: Velocity");
 
-    itPosition.Advance();
-    itVelocity.Advance();
-  }
+  ezSimdVec4f vAddPos;
+  vAddPos.Load<3>(&m_vAddPosition.x);
+
+  const ezUInt64 uiEndIndex = uiStartIndex + uiNumElements;
+  const ezUInt32 uiStart = static_cast<ezUInt32>(uiStartIndex);
+
+  ezParticleBehaviorKernels::AddVec4(GetStreamElements<ezSimdVec4f>(m_pStreamPosition, uiEndIndex).GetSubArray(uiStart), vAddPos);
+  ezParticleBehaviorKernels::ScaleVec3(GetStreamElements<ezVec3>(m_pStreamVelocity, uiEndIndex).GetSubArray(uiStart), m_fFrictionFactor);
 }
 
 void ezParticleBehavior_Velocity::RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule)
@@ -33,6 +33,7 @@ class EZ_PARTICLEPLUGIN_DLL ezParticleBehavior_Velocity final : public ezParticl
 
 public:
   virtual void CreateRequiredStreams() override;
+  virtual bool SupportsParallelProcessing() const override { return true; }
 
   float m_fRiseSpeed = 0;
   float m_fFriction = 0;
@@ -41,7 +42,9 @@ public:
 protected:
   friend class ezParticleBehaviorFactory_Velocity;
 
+  virtual void StepParticleSystem(const ezTime& tDiff, ezUInt32 uiNumNewParticles) override;
   virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   void RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule) override;
 
@@ -51,4 +54,8 @@ protected:
 
   ezProcessingStream* m_pStreamPosition;
   ezProcessingStream* m_pStreamVelocity;
+
+  // computed once per step, so that the world modules are not queried from multiple threads
+  ezVec3 m_vAddPosition = ezVec3::ZeroVector();
+  float m_fFrictionFactor = 1.0f;
 };
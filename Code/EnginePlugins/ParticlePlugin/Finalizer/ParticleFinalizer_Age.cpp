@@ -89,7 +89,7 @@ void ezParticleFinalizer_Age::InitializeElements(ezUInt64 uiStartIndex, ezUInt64
   }
   else // random range
   {
-    ezRandom& rng = GetRNG();
+    ezRandom rng = CreateRangeRNG(uiStartIndex);
 
     for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
     {
@@ -104,14 +104,23 @@ void ezParticleFinalizer_Age::InitializeElements(ezUInt64 uiStartIndex, ezUInt64
 }
 
 void ezParticleFinalizer_Age::Process(ezUInt64 uiNumElements)
+{
+  ProcessRange(0, uiNumElements);
+}
+
+void ezParticleFinalizer_Age::ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
 {
   EZ_PROFILE_SCOPE("PFX: Age");
 
   ezFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetWritableData<ezFloat16Vec2>();
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
+  const ezUInt64 uiEndIndex = uiStartIndex + uiNumElements;
+
+  // collect the dead particles in blocks of 32 and remove each block at once
+  ezUInt32 uiKillMask = 0;
 
-  for (ezUInt32 i = 0; i < uiNumElements; ++i)
+  for (ezUInt64 i = uiStartIndex; i < uiEndIndex; ++i)
   {
     pLifeTime[i].x = pLifeTime[i].x - tDiff;
 
@@ -119,8 +128,13 @@ void ezParticleFinalizer_Age::Process(ezUInt64 uiNumElements)
     {
       pLifeTime[i].x = 0;
 
-      /// \todo Get current element index from iterator ?
-      m_pStreamGroup->RemoveElement(i);
+      uiKillMask |= static_cast<ezUInt32>(EZ_BIT(i % 32));
+    }
+
+    if ((i % 32 == 31 || i + 1 == uiEndIndex) && uiKillMask != 0)
+    {
+      m_pStreamGroup->RemoveElements(ezMakeArrayPtr<const ezUInt32>(&uiKillMask, 1), i - (i % 32));
+      uiKillMask = 0;
     }
   }
 }
@@ -127,7 +127,7 @@ void ezParticleInitializer_BoxPosition::InitializeElements(ezUInt64 uiStartIndex
 
   ezSimdVec4f* pPosition = m_pStreamPosition->GetWritableData<ezSimdVec4f>();
 
-  ezRandom& rng = GetRNG();
+  ezRandom rng = CreateRangeRNG(uiStartIndex);
 
   if (m_vSize.IsZero())
   {
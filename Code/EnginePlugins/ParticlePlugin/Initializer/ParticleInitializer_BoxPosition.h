@@ -34,6 +34,7 @@ public:
   ezVec3 m_vSize;
 
   virtual void CreateRequiredStreams() override;
+  virtual bool SupportsParallelProcessing() const override { return true; }
 
 protected:
   virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
@@ -86,7 +86,7 @@ void ezParticleInitializer_VelocityCone::InitializeElements(ezUInt64 uiStartInde
 
   ezVec3* pVelocity = m_pStreamVelocity->GetWritableData<ezVec3>();
 
-  ezRandom& rng = GetRNG();
+  ezRandom rng = CreateRangeRNG(uiStartIndex);
 
   // const float dist = 1.0f / ezMath::Tan(m_Angle);
 
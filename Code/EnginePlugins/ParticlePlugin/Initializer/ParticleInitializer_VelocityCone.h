@@ -33,6 +33,7 @@ public:
   ezVarianceTypeFloat m_Speed;
 
   virtual void CreateRequiredStreams() override;
+  virtual bool SupportsParallelProcessing() const override { return true; }
 
 protected:
   virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
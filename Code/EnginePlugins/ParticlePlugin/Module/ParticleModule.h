@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStream.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
 #include <ParticlePlugin/Declarations.h>
@@ -55,7 +56,28 @@ protected:
 
   ezRandom& GetRNG() const { return GetOwnerEffect()->GetRNG(); }
 
+  /// \brief Returns a random number generator for the elements starting at \a uiStartIndex.
+  ///
+  /// Modules that support parallel processing must use this instead of GetRNG(), because the effect's generator must not be used from multiple
+  /// threads. The result only depends on the system's random seed for this frame, the index of this module within the system and the start
+  /// index, so it is the same regardless of which thread processes which chunk, but different modules never get the same sequence.
+  ezRandom CreateRangeRNG(ezUInt64 uiStartIndex) const
+  {
+    ezRandom rng;
+    rng.InitializeFromHashedSeed(ComputeRangeSeed(m_pOwnerSystem->GetRandomSeed(), m_uiModuleIndex, uiStartIndex));
+    return rng;
+  }
+
+public:
+  /// \brief Computes the seed that CreateRangeRNG() uses for the module with index \a uiModuleIndex within its system.
+  static ezUInt64 ComputeRangeSeed(ezUInt64 uiSystemSeed, ezUInt32 uiModuleIndex, ezUInt64 uiStartIndex)
+  {
+    const ezUInt64 data[2] = {uiModuleIndex, uiStartIndex};
+    return ezHashingUtils::xxHash64(data, sizeof(data), uiSystemSeed);
+  }
+
 private:
   ezParticleSystemInstance* m_pOwnerSystem;
   ezParticleStreamBinding m_StreamBinding;
+  ezUInt32 m_uiModuleIndex = 0; ///< Set by ezParticleSystemInstance, used to give each module its own random sequences
 };
@@ -65,6 +65,7 @@ EZ_STATICLINK_LIBRARY(ParticlePlugin)
     return;
 
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Behavior_ParticleBehavior);
+  EZ_STATICLINK_REFERENCE(ParticlePlugin_Behavior_ParticleBehaviorKernels);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Behavior_ParticleBehavior_ColorGradient);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Behavior_ParticleBehavior_Gravity);
   EZ_STATICLINK_REFERENCE(ParticlePlugin_Behavior_ParticleBehavior_Raycast);
@@ -19,6 +19,7 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezParticleSystemDescriptor, 1, ezRTTIDefaultAllo
     EZ_MEMBER_PROPERTY("LifeTime", m_LifeTime)->AddAttributes(new ezDefaultValueAttribute(ezTime::Seconds(2)), new ezClampValueAttribute(ezTime::Seconds(0.0), ezVariant())),
     EZ_MEMBER_PROPERTY("LifeScaleParam", m_sLifeScaleParameter),
     EZ_MEMBER_PROPERTY("OnDeathEvent", m_sOnDeathEvent),
+    EZ_MEMBER_PROPERTY("ParallelUpdateThreshold", m_uiParallelUpdateThreshold)->AddAttributes(new ezDefaultValueAttribute(8192)),
     EZ_ARRAY_MEMBER_PROPERTY("Emitters", m_EmitterFactories)->AddFlags(ezPropertyFlags::PointerOwner)->AddAttributes(new ezMaxArraySizeAttribute(1)),
     EZ_SET_ACCESSOR_PROPERTY("Initializers", GetInitializerFactories, AddInitializerFactory, RemoveInitializerFactory)->AddFlags(ezPropertyFlags::PointerOwner)->AddAttributes(new ezPreventDuplicatesAttribute()),
     EZ_SET_ACCESSOR_PROPERTY("Behaviors", GetBehaviorFactories, AddBehaviorFactory, RemoveBehaviorFactory)->AddFlags(ezPropertyFlags::PointerOwner)->AddAttributes(new ezPreventDuplicatesAttribute()),
@@ -32,6 +33,7 @@ EZ_END_DYNAMIC_REFLECTED_TYPE;
 ezParticleSystemDescriptor::ezParticleSystemDescriptor()
 {
   m_bVisible = true;
+  m_uiParallelUpdateThreshold = 8192;
 }
 
 ezParticleSystemDescriptor::~ezParticleSystemDescriptor()
@@ -154,6 +156,7 @@ enum class ParticleSystemVersion
   Version_5, // added default processors
   Version_6, // changed lifetime variance
   Version_7, // added life scale param
+  Version_8, // added parallel update threshold
 
   // insert new version numbers above
   Version_Count,
@@ -194,6 +197,7 @@ void ezParticleSystemDescriptor::Save(ezStreamWriter& stream) const
   stream << m_LifeTime.m_fVariance;
   stream << m_sOnDeathEvent;
   stream << m_sLifeScaleParameter;
+  stream << m_uiParallelUpdateThreshold;
   stream << uiNumEmitters;
   stream << uiNumInitializers;
   stream << uiNumBehaviors;
@@ -270,6 +274,11 @@ void ezParticleSystemDescriptor::Load(ezStreamReader& stream)
     stream >> m_sLifeScaleParameter;
   }
 
+  if (uiVersion >= 8)
+  {
+    stream >> m_uiParallelUpdateThreshold;
+  }
+
   stream >> uiNumEmitters;
 
   if (uiVersion >= 2)
@@ -42,6 +42,9 @@ public:
 
   bool m_bVisible;
 
+  /// \brief Once this many particles are alive or spawned at once, modules that support it are updated on multiple threads. Zero disables it.
+  ezUInt32 m_uiParallelUpdateThreshold;
+
   ezVarianceTypeTime m_LifeTime;
   ezString m_sOnDeathEvent;
   ezString m_sLifeScaleParameter;
@@ -107,6 +107,8 @@ void ezParticleSystemInstance::ConfigureFromTemplate(const ezParticleSystemDescr
 {
   m_bVisible = pTemplate->m_bVisible;
 
+  m_StreamGroup.SetParallelProcessingThreshold(pTemplate->m_uiParallelUpdateThreshold);
+
   for (auto& info : m_StreamInfo)
   {
     info.m_bGetsInitialized = false;
@@ -177,6 +179,9 @@ void ezParticleSystemInstance::CreateStreamProcessors(const ezParticleSystemDesc
   m_StreamGroup.SetSize(uiMaxParticles);
   m_StreamInfo.Clear();
 
+  // every module gets its own index, so that modules that process the same range of particles don't produce the same random values
+  ezUInt32 uiModuleIndex = 0;
+
   // emitters
   {
     m_Emitters.Clear();
@@ -184,6 +189,7 @@ void ezParticleSystemInstance::CreateStreamProcessors(const ezParticleSystemDesc
     for (const auto pFactory : pTemplate->GetEmitterFactories())
     {
       ezParticleEmitter* pEmitter = pFactory->CreateEmitter(this);
+      pEmitter->m_uiModuleIndex = uiModuleIndex++;
       m_StreamGroup.AddProcessor(pEmitter);
       m_Emitters.PushBack(pEmitter);
     }
@@ -196,6 +202,7 @@ void ezParticleSystemInstance::CreateStreamProcessors(const ezParticleSystemDesc
     for (const auto pFactory : pTemplate->GetInitializerFactories())
     {
       ezParticleInitializer* pInitializer = pFactory->CreateInitializer(this);
+      pInitializer->m_uiModuleIndex = uiModuleIndex++;
       m_StreamGroup.AddProcessor(pInitializer);
       m_Initializers.PushBack(pInitializer);
     }
@@ -208,6 +215,7 @@ void ezParticleSystemInstance::CreateStreamProcessors(const ezParticleSystemDesc
     for (const auto pFactory : pTemplate->GetBehaviorFactories())
     {
       ezParticleBehavior* pBehavior = pFactory->CreateBehavior(this);
+      pBehavior->m_uiModuleIndex = uiModuleIndex++;
       m_StreamGroup.AddProcessor(pBehavior);
       m_Behaviors.PushBack(pBehavior);
     }
@@ -220,6 +228,7 @@ void ezParticleSystemInstance::CreateStreamProcessors(const ezParticleSystemDesc
     for (const auto pFactory : pTemplate->GetFinalizerFactories())
     {
       ezParticleFinalizer* pFinalizer = pFactory->CreateFinalizer(this);
+      pFinalizer->m_uiModuleIndex = uiModuleIndex++;
       m_StreamGroup.AddProcessor(pFinalizer);
       m_Finalizers.PushBack(pFinalizer);
     }
@@ -232,6 +241,7 @@ void ezParticleSystemInstance::CreateStreamProcessors(const ezParticleSystemDesc
     for (const auto pFactory : pTemplate->GetTypeFactories())
     {
       ezParticleType* pType = pFactory->CreateType(this);
+      pType->m_uiModuleIndex = uiModuleIndex++;
       m_StreamGroup.AddProcessor(pType);
       m_Types.PushBack(pType);
     }
@@ -371,6 +381,8 @@ ezParticleSystemState::Enum ezParticleSystemInstance::Update(const ezTime& tDiff
 {
   EZ_PROFILE_SCOPE("PFX: System Update");
 
+  m_uiRandomSeed = m_pOwnerEffect->GetRNG().UInt();
+
   ezUInt32 uiSpawnedParticles = 0;
 
   if (m_bEmitterEnabled)
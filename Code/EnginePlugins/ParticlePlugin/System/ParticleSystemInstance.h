@@ -76,6 +76,9 @@ public:
 
   float GetSpawnCountMultiplier() const { return m_fSpawnCountMultiplier; }
 
+  /// \brief A random value that changes every Update(), used to seed the random number generators of modules that run in parallel.
+  ezUInt64 GetRandomSeed() const { return m_uiRandomSeed; }
+
 private:
   bool IsEmitterConfigEqual(const ezParticleSystemDescriptor* pTemplate) const;
   bool IsInitializerConfigEqual(const ezParticleSystemDescriptor* pTemplate) const;
@@ -98,6 +101,7 @@ private:
   ezTransform m_Transform;
   ezVec3 m_vParticleStartVelocity;
   float m_fSpawnCountMultiplier = 1.0f;
+  ezUInt64 m_uiRandomSeed = 0;
 
   ezProcessingStreamGroup m_StreamGroup;
 
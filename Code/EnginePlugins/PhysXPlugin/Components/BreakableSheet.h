@@ -6,6 +6,7 @@
 #include <RendererCore/Components/RenderComponent.h>
 #include <RendererCore/Material/MaterialResource.h>
 #include <RendererCore/Meshes/MeshResource.h>
+#include <RendererCore/Shader/Types.h>
 
 typedef ezComponentManagerSimple<class ezBreakableSheetComponent, ezComponentUpdateType::Always /* TODO: When simulating */>
   ezBreakableSheetComponentManager;
@@ -130,7 +131,7 @@ protected:
   bool m_bPiecesMovedThisFrame = false;
   ezMeshResourceHandle m_hUnbrokenMesh;
   ezMeshResourceHandle m_hPiecesMesh;
-  ezDynamicArray<ezMat4, ezAlignedAllocatorWrapper> m_PieceTransforms;
+  ezDynamicArray<ezShaderTransform> m_PieceTransforms;
   ezDynamicArray<ezBoundingBox> m_PieceBoundingBoxes;
   ezBoundingSphere m_BrokenPiecesBoundingSphere;
   ezUInt32 m_uiNumActiveBrokenPieceActors = 0;
@@ -126,7 +126,8 @@ void ezBreakableSheetComponent::Update()
           scaleMatrix.SetScalingMatrix(ezVec3(0, 0, 0));
           for (ezUInt32 i = 1; i < m_PieceTransforms.GetCount(); ++i)
           {
-            m_PieceTransforms[i] = m_PieceTransforms[i] * scaleMatrix;
+            scaleMatrix.SetTranslationVector(m_PieceTransforms[i].GetTranslationVector());
+            m_PieceTransforms[i] = scaleMatrix;
           }
 
           m_bPiecesMovedThisFrame = true;
@@ -285,10 +286,10 @@ void ezBreakableSheetComponent::OnMsgExtractRenderData(ezMsgExtractRenderData& m
     // We only supply this pointer if any transform changed
     if (m_bPiecesMovedThisFrame)
     {
-      auto pMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, m_PieceTransforms.GetCount());
-      pMatrices.CopyFrom(m_PieceTransforms);
+      auto pTransforms = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezShaderTransform, m_PieceTransforms.GetCount());
+      pTransforms.CopyFrom(m_PieceTransforms);
 
-      pSkinnedRenderData->m_pNewSkinningMatricesData = pMatrices.ToByteArray();
+      pSkinnedRenderData->m_pNewSkinningMatricesData = pTransforms.ToByteArray();
     }
 
     pRenderData = pSkinnedRenderData;
@@ -724,7 +725,7 @@ void ezBreakableSheetComponent::CreateMeshes()
         m_PieceTransforms.Reserve(static_cast<ezUInt32>(diagram.numsites) - uiNumBorderPieces + 1);
         if (m_bFixedBorder)
         {
-          m_PieceTransforms.PushBack(ezMat4::IdentityMatrix());
+          m_PieceTransforms.ExpandAndGetRef() = ezMat4::IdentityMatrix();
         }
 
         // Build geometry from cells
@@ -743,7 +744,7 @@ void ezBreakableSheetComponent::CreateMeshes()
           {
             iNonBorderPieces++;
             iPieceMatrixIndex = iNonBorderPieces;
-            m_PieceTransforms.PushBack(ezMat4::IdentityMatrix());
+            m_PieceTransforms.ExpandAndGetRef() = ezMat4::IdentityMatrix();
           }
 
           const jcv_site* site = &sites[i];
@@ -824,7 +825,7 @@ void ezBreakableSheetComponent::CreateMeshes()
 
   // Create the buffer for the skinning matrices
   ezGALBufferCreationDescription BufferDesc;
-  BufferDesc.m_uiStructSize = sizeof(ezMat4);
+  BufferDesc.m_uiStructSize = sizeof(ezShaderTransform);
   BufferDesc.m_uiTotalSize = BufferDesc.m_uiStructSize * m_PieceTransforms.GetCount();
   BufferDesc.m_bUseAsStructuredBuffer = true;
   BufferDesc.m_bAllowShaderResourceView = true;
@@ -1204,5 +1205,5 @@ void ezBreakableSheetComponent::SetPieceTransform(const physx::PxTransform& tran
   ezSimdTransform localTransform;
   localTransform.SetLocalTransform(globalTransform, t);
 
-  m_PieceTransforms[uiPieceIndex] = ezSimdConversion::ToMat4(localTransform.GetAsMat4());
+  m_PieceTransforms[uiPieceIndex] = localTransform.GetAsMat4();
 }
@@ -244,6 +244,11 @@ public:
     if (ext.IsEqual_NoCase("mp3") || ext.IsEqual_NoCase("ogg"))
       return ezArchiveBuilder::InclusionMode::Uncompressed;
 
+    // large files are split into independently compressed frames, so that they can be decompressed in parallel
+    ezFileStats stats;
+    if (ezFileSystem::GetFileStats(szFile, stats).Succeeded() && stats.m_uiFileSize >= 16 * ezArchiveTOC::DefaultFrameSize)
+      return ezArchiveBuilder::InclusionMode::Compress_zstd_chunked;
+
     return ezArchiveBuilder::InclusionMode::Compress_zstd;
   }
 
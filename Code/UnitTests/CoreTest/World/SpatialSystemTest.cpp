@@ -23,14 +23,22 @@ namespace
 
     void OnUpdateLocalBounds(ezMsgUpdateLocalBounds& msg)
     {
-      auto& rng = GetWorld()->GetRandomNumberGenerator();
+      ezBoundingBox bounds;
 
-      float x = (float)rng.DoubleMinMax(1.0, 100.0);
-      float y = (float)rng.DoubleMinMax(1.0, 100.0);
-      float z = (float)rng.DoubleMinMax(1.0, 100.0);
+      if (m_fFixedHalfExtent > 0.0f)
+      {
+        bounds.SetCenterAndHalfExtents(ezVec3::ZeroVector(), ezVec3(m_fFixedHalfExtent));
+      }
+      else
+      {
+        auto& rng = GetWorld()->GetRandomNumberGenerator();
 
-      ezBoundingBox bounds;
-      bounds.SetCenterAndHalfExtents(ezVec3::ZeroVector(), ezVec3(x, y, z));
+        float x = (float)rng.DoubleMinMax(1.0, 100.0);
+        float y = (float)rng.DoubleMinMax(1.0, 100.0);
+        float z = (float)rng.DoubleMinMax(1.0, 100.0);
+
+        bounds.SetCenterAndHalfExtents(ezVec3::ZeroVector(), ezVec3(x, y, z));
+      }
 
       ezSpatialData::Category category = m_SpecialCategory;
       if (category == ezInvalidSpatialDataCategory)
@@ -42,6 +50,7 @@ namespace
     }
 
     ezSpatialData::Category m_SpecialCategory = ezInvalidSpatialDataCategory;
+    float m_fFixedHalfExtent = 0.0f;
   };
 
   // clang-format off
@@ -249,3 +258,153 @@ EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
 
   world.Update();
 }
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystemChangeTracking)
+{
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  ezSpatialSystem* pSpatialSystem = world.GetSpatialSystem();
+
+  const ezUInt32 uiStaticCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+  const ezUInt32 uiDynamicCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+  // looks along the positive x axis, everything behind the origin is outside
+  ezFrustum frustum;
+  frustum.SetFrustum(ezVec3::ZeroVector(), ezVec3(1, 0, 0), ezVec3(0, 0, 1), ezAngle::Degree(90), ezAngle::Degree(90), 0.1f, 100.0f);
+
+  const ezVec3 vInside(50, 0, 0);
+  const ezVec3 vOutside(-50, 0, 0);
+
+  auto CreateStaticObject = [&](const ezVec3& vPosition) {
+    ezGameObjectDesc desc;
+    desc.m_LocalPosition = vPosition;
+
+    ezGameObject* pObject = nullptr;
+    ezGameObjectHandle hObject = world.CreateObject(desc, pObject);
+
+    TestBoundsComponent* pComponent = nullptr;
+    TestBoundsComponent::CreateComponent(pObject, pComponent);
+    pComponent->m_fFixedHalfExtent = 1.0f;
+
+    return hObject;
+  };
+
+  world.Update();
+
+  ezGameObjectHandle hInsideObject;
+  ezGameObjectHandle hOutsideObject;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Added objects")
+  {
+    ezUInt64 uiSinceFrame = pSpatialSystem->GetFrameCounter();
+
+    hOutsideObject = CreateStaticObject(vOutside);
+    world.Update();
+
+    EZ_TEST_BOOL(!pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiSinceFrame));
+
+    uiSinceFrame = pSpatialSystem->GetFrameCounter();
+
+    hInsideObject = CreateStaticObject(vInside);
+    world.Update();
+
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiSinceFrame));
+
+    // dynamic data is not tracked by default, so the query has to be conservative
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiDynamicCategoryBitmask, pSpatialSystem->GetFrameCounter()));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Moved objects")
+  {
+    ezGameObject* pInsideObject = nullptr;
+    ezGameObject* pOutsideObject = nullptr;
+    EZ_TEST_BOOL(world.TryGetObject(hInsideObject, pInsideObject));
+    EZ_TEST_BOOL(world.TryGetObject(hOutsideObject, pOutsideObject));
+
+    ezUInt64 uiSinceFrame = pSpatialSystem->GetFrameCounter();
+
+    pOutsideObject->SetLocalPosition(vOutside * 1.5f);
+    world.Update();
+
+    EZ_TEST_BOOL(!pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiSinceFrame));
+
+    // moving into the frustum
+    uiSinceFrame = pSpatialSystem->GetFrameCounter();
+
+    pOutsideObject->SetLocalPosition(vInside * 1.5f);
+    world.Update();
+
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiSinceFrame));
+
+    // moving out of the frustum, only the old bounds are inside
+    uiSinceFrame = pSpatialSystem->GetFrameCounter();
+
+    pOutsideObject->SetLocalPosition(vOutside);
+    world.Update();
+
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiSinceFrame));
+
+    // moving inside of the frustum
+    uiSinceFrame = pSpatialSystem->GetFrameCounter();
+
+    pInsideObject->SetLocalPosition(vInside * 0.5f);
+    world.Update();
+
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiSinceFrame));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "StartNewFrame")
+  {
+    const ezUInt64 uiChangeFrame = pSpatialSystem->GetFrameCounter() - 1;
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiChangeFrame));
+
+    pSpatialSystem->StartNewFrame();
+
+    // the change is still known, but it does not show up for queries that start after it
+    EZ_TEST_INT(pSpatialSystem->GetFrameCounter(), uiChangeFrame + 2);
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiChangeFrame));
+    EZ_TEST_BOOL(!pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, pSpatialSystem->GetFrameCounter()));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      world.Update();
+      EZ_TEST_BOOL(!pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, pSpatialSystem->GetFrameCounter()));
+    }
+
+    // the change has left the tracked history, so queries that reach back that far have to be conservative
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiChangeFrame));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Removed objects")
+  {
+    ezUInt64 uiSinceFrame = pSpatialSystem->GetFrameCounter();
+
+    world.DeleteObjectNow(hOutsideObject);
+    world.Update();
+
+    EZ_TEST_BOOL(!pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiSinceFrame));
+
+    // the object does not exist anymore, but the area where it was has to be reported as changed
+    uiSinceFrame = pSpatialSystem->GetFrameCounter();
+
+    world.DeleteObjectNow(hInsideObject);
+
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiSinceFrame));
+
+    world.Update();
+
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiSinceFrame));
+
+    // an object that is added and removed again before anyone looked at it is still a change
+    uiSinceFrame = pSpatialSystem->GetFrameCounter();
+
+    ezGameObjectHandle hTempObject = CreateStaticObject(vInside);
+    world.Update();
+    world.DeleteObjectNow(hTempObject);
+    world.Update();
+
+    EZ_TEST_BOOL(pSpatialSystem->HasChangedDataInFrustum(frustum, uiStaticCategoryBitmask, uiSinceFrame));
+  }
+}
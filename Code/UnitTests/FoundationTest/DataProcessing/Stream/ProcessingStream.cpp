@@ -5,7 +5,14 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Time/Time.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
 
 EZ_CREATE_SIMPLE_TEST_GROUP(DataProcessing);
 
@@ -52,6 +59,118 @@ protected:
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(AddOneStreamProcessor, 1, ezRTTIDefaultAllocator<AddOneStreamProcessor>)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
+// ID processor, gives every new element a unique number
+
+class IdStreamProcessor : public ezProcessingStreamProcessor
+{
+  EZ_ADD_DYNAMIC_REFLECTION(IdStreamProcessor, ezProcessingStreamProcessor);
+
+public:
+  IdStreamProcessor()
+    : m_pStream(nullptr)
+  {
+  }
+
+  void SetStreamName(ezHashedString StreamName) { m_StreamName = StreamName; }
+
+protected:
+  virtual ezResult UpdateStreamBindings() override
+  {
+    m_pStream = m_pStreamGroup->GetStreamByName(m_StreamName);
+
+    return m_pStream ? EZ_SUCCESS : EZ_FAILURE;
+  }
+
+  virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override
+  {
+    ezProcessingStreamIterator<ezUInt32> streamIterator(m_pStream, uiNumElements, uiStartIndex);
+
+    while (!streamIterator.HasReachedEnd())
+    {
+      streamIterator.Current() = m_uiNextId++;
+
+      streamIterator.Advance();
+    }
+  }
+
+  virtual void Process(ezUInt64 uiNumElements) override {}
+
+  ezHashedString m_StreamName;
+  ezProcessingStream* m_pStream;
+  ezUInt32 m_uiNextId = 0;
+};
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(IdStreamProcessor, 1, ezRTTIDefaultAllocator<IdStreamProcessor>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+// Parallel processor, initializes elements to their index, increments them and removes every third element
+
+class ParallelStreamProcessor : public ezProcessingStreamProcessor
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ParallelStreamProcessor, ezProcessingStreamProcessor);
+
+public:
+  ParallelStreamProcessor()
+    : m_pStream(nullptr)
+  {
+  }
+
+  void SetStreamName(ezHashedString StreamName) { m_StreamName = StreamName; }
+
+  virtual bool SupportsParallelProcessing() const override { return true; }
+
+  ezAtomicInteger32 m_iNumRanges;
+  ezAtomicInteger32 m_iNumMisalignedRanges;
+
+protected:
+  virtual ezResult UpdateStreamBindings() override
+  {
+    m_pStream = m_pStreamGroup->GetStreamByName(m_StreamName);
+
+    return m_pStream ? EZ_SUCCESS : EZ_FAILURE;
+  }
+
+  virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override
+  {
+    ezUInt32* pData = m_pStream->GetWritableData<ezUInt32>();
+
+    for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
+    {
+      pData[i] = static_cast<ezUInt32>(i);
+    }
+  }
+
+  virtual void Process(ezUInt64 uiNumElements) override { ProcessRange(0, uiNumElements); }
+
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override
+  {
+    m_iNumRanges.Increment();
+
+    if (uiStartIndex % 32 != 0)
+    {
+      m_iNumMisalignedRanges.Increment();
+    }
+
+    ezUInt32* pData = m_pStream->GetWritableData<ezUInt32>();
+
+    for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
+    {
+      pData[i] += 1;
+
+      if (pData[i] % 3 == 0)
+      {
+        m_pStreamGroup->RemoveElement(i);
+      }
+    }
+  }
+
+  ezHashedString m_StreamName;
+  ezProcessingStream* m_pStream;
+};
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ParallelStreamProcessor, 1, ezRTTIDefaultAllocator<ParallelStreamProcessor>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
 EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
 {
   ezProcessingStreamGroup Group;
@@ -157,3 +276,236 @@ EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStreamRemoveElements)
+{
+  constexpr ezUInt32 uiNumElements = 1000;
+
+  ezProcessingStreamGroup Group;
+  ezProcessingStream* pIdStream = Group.AddStream("ID", ezProcessingStream::DataType::Int);
+  ezProcessingStream* pCopyStream = Group.AddStream("Copy", ezProcessingStream::DataType::Int);
+
+  IdStreamProcessor* pIdProcessor = EZ_DEFAULT_NEW(IdStreamProcessor);
+  pIdProcessor->SetStreamName(pIdStream->GetName());
+  Group.AddProcessor(pIdProcessor);
+
+  IdStreamProcessor* pCopyProcessor = EZ_DEFAULT_NEW(IdStreamProcessor);
+  pCopyProcessor->SetStreamName(pCopyStream->GetName());
+  Group.AddProcessor(pCopyProcessor);
+
+  Group.SetSize(uiNumElements);
+
+  ezDynamicArray<ezUInt32> removedIds;
+  ezEventSubscriptionID subscription = Group.m_ElementRemovedEvent.AddEventHandler([&](const ezStreamGroupElementRemovedEvent& e) {
+    // the data of a removed element must still be accessible in the event
+    removedIds.PushBack(pIdStream->GetData<ezUInt32>()[e.m_uiElementIndex]);
+  });
+
+  ezRandom rng;
+  rng.Initialize(42);
+
+  // checks that exactly the expected elements are left and that all streams were moved the same way
+  auto CheckRemainingElements = [&](const ezSet<ezUInt32>& expected) {
+    EZ_TEST_INT(Group.GetNumActiveElements(), expected.GetCount());
+
+    const ezUInt32* pIds = pIdStream->GetData<ezUInt32>();
+    const ezUInt32* pCopies = pCopyStream->GetData<ezUInt32>();
+
+    ezSet<ezUInt32> remaining;
+    for (ezUInt32 i = 0; i < Group.GetNumActiveElements(); ++i)
+    {
+      EZ_TEST_INT(pIds[i], pCopies[i]);
+      remaining.Insert(pIds[i]);
+    }
+
+    EZ_TEST_BOOL(remaining == expected);
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RemoveElement")
+  {
+    Group.InitializeElements(uiNumElements);
+    Group.Process();
+    EZ_TEST_INT(Group.GetNumActiveElements(), uiNumElements);
+
+    for (ezUInt32 iteration = 0; iteration < 5; ++iteration)
+    {
+      const ezUInt32* pIds = pIdStream->GetData<ezUInt32>();
+
+      ezSet<ezUInt32> expected;
+      ezSet<ezUInt32> expectedRemoved;
+
+      for (ezUInt32 i = 0; i < Group.GetNumActiveElements(); ++i)
+      {
+        if (rng.Bool())
+        {
+          Group.RemoveElement(i);
+
+          // removing an element twice must only remove it once
+          Group.RemoveElement(i);
+
+          expectedRemoved.Insert(pIds[i]);
+        }
+        else
+        {
+          expected.Insert(pIds[i]);
+        }
+      }
+
+      removedIds.Clear();
+      Group.Process();
+
+      CheckRemainingElements(expected);
+
+      EZ_TEST_INT(removedIds.GetCount(), expectedRemoved.GetCount());
+      for (ezUInt32 id : removedIds)
+      {
+        EZ_TEST_BOOL(expectedRemoved.Contains(id));
+      }
+    }
+
+    // remove everything
+    for (ezUInt32 i = 0; i < Group.GetNumActiveElements(); ++i)
+    {
+      Group.RemoveElement(i);
+    }
+
+    Group.Process();
+    EZ_TEST_INT(Group.GetNumActiveElements(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RemoveElements")
+  {
+    Group.InitializeElements(uiNumElements);
+    Group.Process();
+    EZ_TEST_INT(Group.GetNumActiveElements(), uiNumElements);
+
+    for (ezUInt32 iteration = 0; iteration < 5; ++iteration)
+    {
+      const ezUInt32* pIds = pIdStream->GetData<ezUInt32>();
+      const ezUInt32 uiNumActive = static_cast<ezUInt32>(Group.GetNumActiveElements());
+
+      ezDynamicArray<ezUInt32> mask;
+      mask.SetCount((uiNumActive + 31) / 32, 0);
+
+      ezSet<ezUInt32> expected;
+
+      for (ezUInt32 i = 0; i < uiNumActive; ++i)
+      {
+        if (rng.Bool())
+          mask[i / 32] |= static_cast<ezUInt32>(EZ_BIT(i % 32));
+        else
+          expected.Insert(pIds[i]);
+      }
+
+      // pass the mask in two parts, to test the offset
+      const ezUInt32 uiSplit = mask.GetCount() / 2;
+      Group.RemoveElements(mask.GetArrayPtr().GetSubArray(0, uiSplit));
+      Group.RemoveElements(mask.GetArrayPtr().GetSubArray(uiSplit), uiSplit * 32);
+
+      Group.Process();
+
+      CheckRemainingElements(expected);
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Remove Half Of 100k Elements")
+  {
+    constexpr ezUInt32 uiNumStressElements = 100000;
+    constexpr ezUInt32 uiNumFrames = 20;
+
+    Group.SetSize(uiNumStressElements);
+
+    ezTime tRemoveElement;
+    ezTime tRemoveElements;
+
+    ezDynamicArray<ezUInt32> mask;
+
+    for (ezUInt32 frame = 0; frame < uiNumFrames; ++frame)
+    {
+      Group.InitializeElements(uiNumStressElements - Group.GetNumActiveElements());
+      Group.Process();
+
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < Group.GetNumActiveElements(); i += 2)
+      {
+        Group.RemoveElement(i);
+      }
+      Group.Process();
+      tRemoveElement += ezTime::Now() - t0;
+
+      Group.InitializeElements(uiNumStressElements - Group.GetNumActiveElements());
+      Group.Process();
+
+      mask.SetCount(uiNumStressElements / 32);
+      for (ezUInt32& uiWord : mask)
+      {
+        uiWord = 0x55555555u;
+      }
+
+      t0 = ezTime::Now();
+      Group.RemoveElements(mask);
+      Group.Process();
+      tRemoveElements += ezTime::Now() - t0;
+    }
+
+    ezLog::Info("[test]RemoveElement: {0} ms per frame", ezArgF(tRemoveElement.GetMilliseconds() / uiNumFrames, 3));
+    ezLog::Info("[test]RemoveElements: {0} ms per frame", ezArgF(tRemoveElements.GetMilliseconds() / uiNumFrames, 3));
+  }
+
+  Group.m_ElementRemovedEvent.RemoveEventHandler(subscription);
+}
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStreamParallel)
+{
+  constexpr ezUInt32 uiNumElements = 20000;
+
+  // runs the same processors with and without parallel processing, the results have to be identical
+  ezProcessingStreamGroup groups[2];
+  ParallelStreamProcessor* processors[2];
+
+  for (ezUInt32 g = 0; g < 2; ++g)
+  {
+    ezProcessingStream* pStream = groups[g].AddStream("Value", ezProcessingStream::DataType::Int);
+
+    processors[g] = EZ_DEFAULT_NEW(ParallelStreamProcessor);
+    processors[g]->SetStreamName(pStream->GetName());
+    groups[g].AddProcessor(processors[g]);
+
+    groups[g].SetSize(uiNumElements);
+  }
+
+  groups[1].SetParallelProcessingThreshold(1000);
+  EZ_TEST_INT(groups[1].GetParallelProcessingThreshold(), 1000);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Process")
+  {
+    for (ezUInt32 frame = 0; frame < 5; ++frame)
+    {
+      for (ezUInt32 g = 0; g < 2; ++g)
+      {
+        groups[g].InitializeElements(uiNumElements);
+        groups[g].Process();
+      }
+
+      EZ_TEST_INT(groups[0].GetNumActiveElements(), groups[1].GetNumActiveElements());
+
+      const ezUInt32* pSerial = groups[0].GetStreamByName("Value")->GetData<ezUInt32>();
+      const ezUInt32* pParallel = groups[1].GetStreamByName("Value")->GetData<ezUInt32>();
+
+      for (ezUInt32 i = 0; i < groups[0].GetNumActiveElements(); ++i)
+      {
+        if (pSerial[i] != pParallel[i])
+        {
+          EZ_TEST_INT(pSerial[i], pParallel[i]);
+          break;
+        }
+      }
+    }
+
+    // the serial group sees everything at once
+    EZ_TEST_INT(processors[0]->m_iNumRanges, 5);
+
+    EZ_TEST_BOOL(processors[1]->m_iNumRanges > 5);
+    EZ_TEST_INT(processors[1]->m_iNumMisalignedRanges, 0);
+  }
+}
@@ -1,11 +1,16 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
+#include <Foundation/IO/Archive/ArchiveReader.h>
+#include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/Archive/DataDirTypeArchive.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/System/Process.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
 
@@ -149,7 +154,168 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mapped Data")
+  {
+    // File2.jpg is stored uncompressed, so its data can be accessed in-place
+    ezFileReader file;
+    if (EZ_TEST_BOOL(file.Open(":archive/FolderA/File2.jpg").Succeeded()).Failed())
+      return;
+
+    ezArrayPtr<const ezUInt8> data = file.GetMappedData();
+    EZ_TEST_INT(data.GetCount(), file.GetFileSize());
+    EZ_TEST_BOOL(ezMemoryUtils::IsAligned(data.GetPtr(), ezArchiveUtils::UncompressedEntryAlignment));
+
+    // File1 is empty, so the values in File2 start at zero
+    bool bAllEqual = true;
+    for (ezUInt32 i = 0; i < data.GetCount() / sizeof(ezUInt64); ++i)
+    {
+      ezUInt64 uiStored;
+      ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&uiStored), data.GetPtr() + i * sizeof(ezUInt64), sizeof(ezUInt64));
+      bAllEqual = bAllEqual && (uiStored == i);
+    }
+    EZ_TEST_BOOL(bAllEqual);
+  }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Chunked Entries")
+  {
+    ezArchiveReader archive;
+    if (EZ_TEST_BOOL(archive.OpenArchive(sArchiveFile).Succeeded()).Failed())
+      return;
+
+    // File6.txt is large enough to be split into frames by the ArchiveTool
+    const ezUInt32 uiEntryIdx = archive.GetArchiveTOC().FindEntry("File6.txt");
+    if (EZ_TEST_BOOL(uiEntryIdx != ezInvalidIndex).Failed())
+      return;
+
+    const ezArchiveEntry& entry = archive.GetArchiveTOC().m_Entries[uiEntryIdx];
+    EZ_TEST_BOOL(entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked);
+    EZ_TEST_INT(entry.m_uiUncompressedDataSize, uiMinFileSize * 5 * sizeof(ezUInt64));
+
+    // the values in File6 start after the ones written to the previous files
+    const ezUInt64 uiFirstValue = uiMinFileSize * (1 + 2 + 3 + 4);
+
+    ezDynamicArray<ezUInt64> values;
+    values.SetCountUninitialized(uiMinFileSize * 5);
+    EZ_TEST_BOOL(archive.DecompressEntry(uiEntryIdx, values.GetByteArrayPtr()).Succeeded());
+
+    bool bAllEqual = true;
+    for (ezUInt32 i = 0; i < values.GetCount(); ++i)
+    {
+      bAllEqual = bAllEqual && (values[i] == uiFirstValue + i);
+    }
+    EZ_TEST_BOOL(bAllEqual);
+
+    // random access only decompresses the frame that contains the read position
+    ezArchiveChunkedEntryReader reader;
+    archive.ConfigureChunkedEntryReader(uiEntryIdx, reader);
+
+    const ezUInt32 uiPositions[] = {values.GetCount() - 1, 0, values.GetCount() / 2, 12345};
+    for (ezUInt32 uiPos : uiPositions)
+    {
+      reader.SetReadPosition(uiPos * sizeof(ezUInt64));
+
+      ezUInt64 uiValue = 0;
+      reader >> uiValue;
+      EZ_TEST_INT(uiValue, uiFirstValue + uiPos);
+    }
+
+    EZ_TEST_INT(reader.GetReadPosition(), 12346 * sizeof(ezUInt64));
+    EZ_TEST_INT(reader.SkipBytes(entry.m_uiUncompressedDataSize), entry.m_uiUncompressedDataSize - 12346 * sizeof(ezUInt64));
+  }
+#  endif
+
   ezFileSystem::RemoveDataDirectoryGroup("Clear");
 }
 
 #endif
+
+#if (EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS) && EZ_ENABLED(EZ_SUPPORTS_FILE_STATS) && defined(BUILDSYSTEM_ENABLE_ZSTD_SUPPORT))
+
+namespace
+{
+  class ezArchiveBuilderTestImpl : public ezArchiveBuilder
+  {
+  public:
+    mutable ezUInt32 m_uiNumProgressCallbacks = 0;
+
+  protected:
+    virtual bool WriteFileProgressCallback(ezUInt64 bytesWritten, ezUInt64 bytesTotal) const override
+    {
+      ++m_uiNumProgressCallbacks;
+      return true;
+    }
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveBuilder)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveBuilderTest");
+  sOutputFolder.MakeCleanPath();
+
+  // make sure it is empty
+  ezOSFile::DeleteFolder(sOutputFolder);
+  ezOSFile::CreateDirectoryStructure(sOutputFolder);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Generate Data")
+  {
+    ezStringBuilder sFile;
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < 8; ++uiFileIdx)
+    {
+      sFile.Format("{}/File{}.txt", sOutputFolder, uiFileIdx);
+
+      ezOSFile file;
+      if (EZ_TEST_BOOL(file.Open(sFile, ezFileOpenMode::Write).Succeeded()).Failed())
+        return;
+
+      ezDynamicArray<ezUInt64> values;
+      values.SetCountUninitialized(1024 * 16 * (uiFileIdx + 1));
+
+      for (ezUInt32 i = 0; i < values.GetCount(); ++i)
+      {
+        values[i] = i / 4 + uiFileIdx;
+      }
+
+      EZ_TEST_BOOL(file.Write(values.GetData(), values.GetCount() * sizeof(ezUInt64)).Succeeded());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel and serial compression are identical")
+  {
+    ezMemoryStreamStorage serialStorage;
+    ezMemoryStreamStorage parallelStorage;
+
+    {
+      ezArchiveBuilderTestImpl builder;
+      builder.AddFolder(sOutputFolder, ezArchiveCompressionMode::Compressed_zstd);
+      EZ_TEST_INT(builder.m_Entries.GetCount(), 8);
+
+      // without any bytes in flight, every entry is compressed by the writing thread
+      builder.m_uiMaxBytesInFlight = 0;
+
+      ezMemoryStreamWriter writer(&serialStorage);
+      EZ_TEST_BOOL(builder.WriteArchive(writer).Succeeded());
+      EZ_TEST_BOOL(builder.m_uiNumProgressCallbacks > 0);
+    }
+
+    {
+      ezArchiveBuilderTestImpl builder;
+      builder.AddFolder(sOutputFolder, ezArchiveCompressionMode::Compressed_zstd);
+
+      ezMemoryStreamWriter writer(&parallelStorage);
+      EZ_TEST_BOOL(builder.WriteArchive(writer).Succeeded());
+
+      // the progress callback is only called for entries that were not compressed on a worker thread
+      EZ_TEST_INT(builder.m_uiNumProgressCallbacks, 0);
+    }
+
+    EZ_TEST_INT(parallelStorage.GetStorageSize(), serialStorage.GetStorageSize());
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(parallelStorage.GetData(), serialStorage.GetData(), serialStorage.GetStorageSize()));
+  }
+
+  ezOSFile::DeleteFolder(sOutputFolder);
+}
+
+#endif
@@ -205,6 +205,45 @@ Only concrete and clocks.\n\
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "File Lookup Cache")
+  {
+    ezStringBuilder sAbs = sOutputFolder1Resolved;
+    sAbs.AppendPath("FileLookupCacheTest.txt");
+
+    EZ_TEST_BOOL(!ezFileSystem::IsFileLookupCacheEnabled());
+
+    ezFileSystem::SetFileLookupCacheEnabled(true, true);
+
+    ezFileReader FileIn;
+    EZ_TEST_BOOL(FileIn.Open("FileLookupCacheTest.txt") == EZ_FAILURE);
+
+    // create the file without going through ezFileSystem, the cache still thinks it does not exist
+    {
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sAbs, ezFileOpenMode::Write).Succeeded());
+      EZ_TEST_BOOL(file.Write("Test", 4).Succeeded());
+    }
+
+    EZ_TEST_BOOL(FileIn.Open("FileLookupCacheTest.txt") == EZ_FAILURE);
+
+    ezFileSystem::InvalidateFileLookupCache();
+
+    EZ_TEST_BOOL(FileIn.Open("FileLookupCacheTest.txt") == EZ_SUCCESS);
+    EZ_TEST_INT(FileIn.GetFileSize(), 4);
+    FileIn.Close();
+
+    // this is now a cache hit
+    EZ_TEST_BOOL(FileIn.Open("FileLookupCacheTest.txt") == EZ_SUCCESS);
+    EZ_TEST_STRING(FileIn.GetFilePathAbsolute(), sAbs);
+    FileIn.Close();
+
+    // a stale entry for a file that was removed must not be able to open anything
+    EZ_TEST_BOOL(ezOSFile::DeleteFile(sAbs).Succeeded());
+    EZ_TEST_BOOL(FileIn.Open("FileLookupCacheTest.txt") == EZ_FAILURE);
+
+    ezFileSystem::SetFileLookupCacheEnabled(false);
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetFileStats")
   {
     const char* szPath = ":output1/" LongPath "/FileSystemTest.txt";
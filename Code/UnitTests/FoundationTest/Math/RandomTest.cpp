@@ -1,5 +1,6 @@
 #include <FoundationTestPCH.h>
 
+#include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Containers/StaticArray.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
@@ -13,6 +14,44 @@
 #  include <Texture/Image/Image.h>
 #endif
 
+namespace
+{
+  /// Pearson correlation coefficient of two equally long sequences.
+  double ComputeCorrelation(ezArrayPtr<const double> a, ezArrayPtr<const double> b)
+  {
+    const double fCount = a.GetCount();
+    double fSumA = 0.0, fSumB = 0.0, fSumAB = 0.0, fSumAA = 0.0, fSumBB = 0.0;
+
+    for (ezUInt32 i = 0; i < a.GetCount(); ++i)
+    {
+      fSumA += a[i];
+      fSumB += b[i];
+      fSumAB += a[i] * b[i];
+      fSumAA += a[i] * a[i];
+      fSumBB += b[i] * b[i];
+    }
+
+    const double fCov = fSumAB / fCount - (fSumA / fCount) * (fSumB / fCount);
+    const double fVarA = fSumAA / fCount - ezMath::Square(fSumA / fCount);
+    const double fVarB = fSumBB / fCount - ezMath::Square(fSumB / fCount);
+    return fCov / ezMath::Sqrt(fVarA * fVarB);
+  }
+
+  // the same seed derivation as ezParticleModule::ComputeRangeSeed(), which gives every module its own sequence per range of particles
+  void FillRangeValues(ezUInt64 uiSystemSeed, ezUInt32 uiModuleIndex, ezUInt64 uiStartIndex, ezDynamicArray<double>& out_Values)
+  {
+    const ezUInt64 data[2] = {uiModuleIndex, uiStartIndex};
+
+    ezRandom rng;
+    rng.InitializeFromHashedSeed(ezHashingUtils::xxHash64(data, sizeof(data), uiSystemSeed));
+
+    for (double& value : out_Values)
+    {
+      value = rng.DoubleZeroToOneExclusive();
+    }
+  }
+} // namespace
+
 
 EZ_CREATE_SIMPLE_TEST(Math, Random)
 {
@@ -281,6 +320,104 @@ EZ_CREATE_SIMPLE_TEST(Math, Random)
       EZ_TEST_INT(temp[i], r2.UInt());
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InitializeFromHashedSeed")
+  {
+    ezRandom r, r2;
+
+    // the same seed gives the same sequence
+    r.InitializeFromHashedSeed(17);
+    r2.InitializeFromHashedSeed(17);
+
+    for (int i = 0; i < 100; ++i)
+    {
+      EZ_TEST_INT(r.UInt(), r2.UInt());
+    }
+
+    // seeds that only differ in a single bit give unrelated sequences
+    const ezUInt32 uiNumValues = 1000;
+
+    ezDynamicArray<double> a, b;
+    a.SetCount(uiNumValues);
+    b.SetCount(uiNumValues);
+
+    for (ezUInt64 uiBit = 0; uiBit < 64; ++uiBit)
+    {
+      r.InitializeFromHashedSeed(17);
+      r2.InitializeFromHashedSeed(17 ^ (1ull << uiBit));
+
+      ezUInt32 uiEqual = 0;
+
+      for (ezUInt32 i = 0; i < uiNumValues; ++i)
+      {
+        const ezUInt32 uiA = r.UInt();
+        const ezUInt32 uiB = r2.UInt();
+
+        if (uiA == uiB)
+          ++uiEqual;
+
+        a[i] = uiA / 4294967296.0;
+        b[i] = uiB / 4294967296.0;
+      }
+
+      EZ_TEST_INT(uiEqual, 0);
+      EZ_TEST_BOOL(ezMath::Abs(ComputeCorrelation(a, b)) < 0.15);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InitializeFromHashedSeed with combined seeds")
+  {
+    const ezUInt64 uiSystemSeed = 0x0011AABBCCDDE11FULL;
+    const ezUInt32 uiNumValues = 1000;
+
+    ezDynamicArray<double> a, b;
+    a.SetCount(uiNumValues);
+    b.SetCount(uiNumValues);
+
+    // deterministic
+    FillRangeValues(uiSystemSeed, 3, 256, a);
+    FillRangeValues(uiSystemSeed, 3, 256, b);
+
+    for (ezUInt32 i = 0; i < uiNumValues; ++i)
+    {
+      EZ_TEST_DOUBLE(a[i], b[i], 0.0);
+    }
+
+    // e.g. an age finalizer and a box position initializer that process the same range of particles
+    const ezUInt64 startIndices[] = {0, 1, 64, 256, 4096};
+
+    for (ezUInt64 uiStartIndex : startIndices)
+    {
+      for (ezUInt32 uiModuleA = 0; uiModuleA < 8; ++uiModuleA)
+      {
+        FillRangeValues(uiSystemSeed, uiModuleA, uiStartIndex, a);
+
+        for (ezUInt32 uiModuleB = uiModuleA + 1; uiModuleB < 8; ++uiModuleB)
+        {
+          FillRangeValues(uiSystemSeed, uiModuleB, uiStartIndex, b);
+
+          ezUInt32 uiEqual = 0;
+          for (ezUInt32 i = 0; i < uiNumValues; ++i)
+          {
+            if (a[i] == b[i])
+              ++uiEqual;
+          }
+
+          EZ_TEST_INT(uiEqual, 0);
+          EZ_TEST_BOOL(ezMath::Abs(ComputeCorrelation(a, b)) < 0.15);
+        }
+      }
+    }
+
+    // the module index and the start index must not cancel each other out
+    FillRangeValues(uiSystemSeed, 1, 0, a);
+    FillRangeValues(uiSystemSeed, 0, 1, b);
+    EZ_TEST_BOOL(ezMath::Abs(ComputeCorrelation(a, b)) < 0.15);
+
+    FillRangeValues(uiSystemSeed, 2, 64, a);
+    FillRangeValues(uiSystemSeed, 2, 128, b);
+    EZ_TEST_BOOL(ezMath::Abs(ComputeCorrelation(a, b)) < 0.15);
+  }
 }
 
 static void SaveToImage(ezDynamicArray<ezUInt32>& Values, ezUInt32 uiMaxValue, const char* szFile)
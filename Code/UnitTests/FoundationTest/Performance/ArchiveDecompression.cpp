@@ -0,0 +1,155 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveChunkedEntryReader.h>
+#include <Foundation/IO/Archive/ArchiveReader.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS) && EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE) && defined(BUILDSYSTEM_ENABLE_ZSTD_SUPPORT)
+
+namespace
+{
+  // increase this to benchmark multi-GB entries
+  constexpr ezUInt64 s_uiEntrySizeMB = 512;
+  constexpr ezUInt32 s_uiNumRandomReads = 1000;
+
+  ezResult WriteTestArchive(const char* szArchive, const char* szSourceFile, ezArchiveCompressionMode mode)
+  {
+    ezArchiveBuilder builder;
+    auto& e = builder.m_Entries.ExpandAndGetRef();
+    e.m_sAbsSourcePath = szSourceFile;
+    e.m_sRelTargetPath = "Data.bin";
+    e.m_CompressionMode = mode;
+
+    return builder.WriteArchive(szArchive);
+  }
+
+  void BenchmarkArchive(const char* szArchive, const char* szMode)
+  {
+    ezArchiveReader archive;
+    if (EZ_TEST_BOOL(archive.OpenArchive(szArchive).Succeeded()).Failed())
+      return;
+
+    const ezUInt32 uiEntryIdx = archive.GetArchiveTOC().FindEntry("Data.bin");
+    const ezArchiveEntry& entry = archive.GetArchiveTOC().m_Entries[uiEntryIdx];
+
+    ezDynamicArray<ezUInt8> data;
+    data.SetCountUninitialized(static_cast<ezUInt32>(entry.m_uiUncompressedDataSize));
+
+    // sequential decompression through a stream reader
+    {
+      ezUniquePtr<ezStreamReader> pReader = archive.CreateEntryReader(uiEntryIdx);
+
+      ezTime t0 = ezTime::Now();
+      EZ_TEST_INT(pReader->ReadBytes(data.GetData(), data.GetCount()), data.GetCount());
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]{0}: stream decompression of {1}: {2}ms", szMode, ezArgFileSize(entry.m_uiUncompressedDataSize),
+        ezArgF((t1 - t0).GetMilliseconds(), 2));
+    }
+
+    // whole entry decompression, parallel for chunked entries
+    {
+      ezTime t0 = ezTime::Now();
+      EZ_TEST_BOOL(archive.DecompressEntry(uiEntryIdx, data).Succeeded());
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]{0}: DecompressEntry of {1}: {2}ms", szMode, ezArgFileSize(entry.m_uiUncompressedDataSize),
+        ezArgF((t1 - t0).GetMilliseconds(), 2));
+    }
+
+    // random access of a few bytes each
+    {
+      ezUInt64 uiValue = 0;
+      ezTime t0 = ezTime::Now();
+
+      if (entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked)
+      {
+        ezArchiveChunkedEntryReader reader;
+        archive.ConfigureChunkedEntryReader(uiEntryIdx, reader);
+
+        for (ezUInt32 i = 0; i < s_uiNumRandomReads; ++i)
+        {
+          reader.SetReadPosition(((i * 7919ull) % (entry.m_uiUncompressedDataSize / sizeof(ezUInt64))) * sizeof(ezUInt64));
+          reader >> uiValue;
+        }
+      }
+      else
+      {
+        // the stream has to be decompressed from the start to reach any position
+        for (ezUInt32 i = 0; i < s_uiNumRandomReads / 100; ++i)
+        {
+          ezUniquePtr<ezStreamReader> pReader = archive.CreateEntryReader(uiEntryIdx);
+          pReader->SkipBytes(((i * 7919ull) % (entry.m_uiUncompressedDataSize / sizeof(ezUInt64))) * sizeof(ezUInt64));
+          *pReader >> uiValue;
+        }
+      }
+
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]{0}: {1} random reads: {2}ms", szMode,
+        entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked ? s_uiNumRandomReads : s_uiNumRandomReads / 100,
+        ezArgF((t1 - t0).GetMilliseconds(), 2));
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, ArchiveDecompression)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchivePerf");
+  sOutputFolder.MakeCleanPath();
+
+  const ezStringBuilder sSourceFile(sOutputFolder, "/Data.bin");
+  const ezStringBuilder sArchiveZstd(sOutputFolder, "/Zstd.ezArchive");
+  const ezStringBuilder sArchiveChunked(sOutputFolder, "/Chunked.ezArchive");
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Zstd vs. Chunked Zstd")
+  {
+    ezOSFile::DeleteFolder(sOutputFolder);
+    ezOSFile::CreateDirectoryStructure(sOutputFolder);
+
+    {
+      ezOSFile file;
+      if (EZ_TEST_BOOL(file.Open(sSourceFile, ezFileOpenMode::Write).Succeeded()).Failed())
+        return;
+
+      ezDynamicArray<ezUInt64> values;
+      values.SetCountUninitialized(1024 * 1024 / sizeof(ezUInt64));
+
+      ezUInt64 uiValue = 0;
+      for (ezUInt64 mb = 0; mb < s_uiEntrySizeMB; ++mb)
+      {
+        for (ezUInt64& v : values)
+        {
+          v = uiValue++;
+        }
+
+        EZ_TEST_BOOL(file.Write(values.GetData(), values.GetCount() * sizeof(ezUInt64)).Succeeded());
+      }
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      EZ_TEST_BOOL(WriteTestArchive(sArchiveZstd, sSourceFile, ezArchiveCompressionMode::Compressed_zstd).Succeeded());
+      ezTime t1 = ezTime::Now();
+      EZ_TEST_BOOL(WriteTestArchive(sArchiveChunked, sSourceFile, ezArchiveCompressionMode::Compressed_zstd_chunked).Succeeded());
+      ezTime t2 = ezTime::Now();
+
+      ezLog::Info("[test]Writing archives: zstd {0}ms, chunked zstd {1}ms", ezArgF((t1 - t0).GetMilliseconds(), 2),
+        ezArgF((t2 - t1).GetMilliseconds(), 2));
+    }
+
+    BenchmarkArchive(sArchiveZstd, "zstd");
+    BenchmarkArchive(sArchiveChunked, "chunked zstd");
+
+    ezOSFile::DeleteFolder(sOutputFolder);
+  }
+}
+
+#endif
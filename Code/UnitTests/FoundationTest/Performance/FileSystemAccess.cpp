@@ -0,0 +1,122 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Time.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+namespace
+{
+  enum constants
+  {
+    NUM_THREADS = 16,
+    NUM_FILES = 1024,
+    NUM_FILE_OPENS = 100000,
+    NUM_EXTRA_DATA_DIRS = 8,
+    FILE_SIZE = 1024,
+  };
+
+  ezAtomicInteger32 g_iFailedReads;
+
+  class FileReadThread : public ezThread
+  {
+  public:
+    FileReadThread()
+      : ezThread("File Read Thread")
+    {
+    }
+
+    ezUInt32 m_uiFirstFile = 0;
+
+    virtual ezUInt32 Run() override
+    {
+      ezUInt8 buffer[FILE_SIZE];
+      ezStringBuilder sFile;
+
+      for (ezUInt32 i = 0; i < NUM_FILE_OPENS / NUM_THREADS; ++i)
+      {
+        sFile.Format("FileSystemPerf/File{0}.bin", (m_uiFirstFile + i) % NUM_FILES);
+
+        ezFileReader file;
+        if (file.Open(sFile).Failed() || file.ReadBytes(buffer, FILE_SIZE) != FILE_SIZE)
+        {
+          g_iFailedReads.Increment();
+        }
+      }
+
+      return 0;
+    }
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, FileSystemAccess)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.MakeCleanPath();
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Concurrent File Reads")
+  {
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "FileSystemPerf", "fsperf", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+
+    // files are searched in all data directories, so mount a few more that don't contain them
+    for (ezUInt32 i = 0; i < NUM_EXTRA_DATA_DIRS; ++i)
+    {
+      ezStringBuilder sDir = sOutputFolder;
+      sDir.AppendFormat("/FileSystemPerf/Empty{0}", i);
+      EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sDir).Succeeded());
+      EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sDir, "FileSystemPerf") == EZ_SUCCESS);
+    }
+
+    ezUInt8 content[FILE_SIZE] = {};
+
+    for (ezUInt32 i = 0; i < NUM_FILES; ++i)
+    {
+      ezStringBuilder sFile;
+      sFile.Format(":fsperf/FileSystemPerf/File{0}.bin", i);
+
+      ezFileWriter file;
+      EZ_TEST_BOOL(file.Open(sFile).Succeeded());
+      EZ_TEST_BOOL(file.WriteBytes(content, FILE_SIZE).Succeeded());
+    }
+
+    g_iFailedReads = 0;
+
+    FileReadThread threads[NUM_THREADS];
+
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < NUM_THREADS; ++i)
+    {
+      threads[i].m_uiFirstFile = i * (NUM_FILES / NUM_THREADS);
+      threads[i].Start();
+    }
+
+    for (ezUInt32 i = 0; i < NUM_THREADS; ++i)
+    {
+      threads[i].Join();
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    EZ_TEST_INT(g_iFailedReads, 0);
+
+    ezLog::Info("[test]Opened and read {0} files from {1} threads: {2}ms", (ezUInt32)NUM_FILE_OPENS, (ezUInt32)NUM_THREADS,
+      ezArgF((t1 - t0).GetMilliseconds(), 2));
+
+    for (ezUInt32 i = 0; i < NUM_FILES; ++i)
+    {
+      ezStringBuilder sFile;
+      sFile.Format(":fsperf/FileSystemPerf/File{0}.bin", i);
+      ezFileSystem::DeleteFile(sFile);
+    }
+
+    ezFileSystem::RemoveDataDirectoryGroup("FileSystemPerf");
+  }
+}
@@ -212,4 +212,38 @@ EZ_CREATE_SIMPLE_TEST(Threading, ParallelFor)
     // check the resulting sum
     EZ_TEST_INT(uiNumbersSum, 4 * uiNumbersCheckSum);
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel For (Indexed) Nested")
+  {
+    // reset
+    ResetSharedVariables();
+
+    // test
+    // every outer task waits for an inner parallel for, which is only allowed with ezTaskNesting::Maybe
+    ezParallelForParams outerParams = parallelForParams;
+    outerParams.nestingMode = ezTaskNesting::Maybe;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, ::s_uiTotalNumberOfTaskItems,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        ezParallelForParams innerParams;
+        innerParams.uiBinSize = 5;
+
+        ezTaskSystem::ParallelForIndexed(
+          0, uiEndIndex - uiStartIndex,
+          [&](ezUInt32 uiInnerStartIndex, ezUInt32 uiInnerEndIndex) {
+            EZ_LOCK(dataAccessMutex);
+
+            for (ezUInt32 uiIndex = uiStartIndex + uiInnerStartIndex; uiIndex < uiStartIndex + uiInnerEndIndex; ++uiIndex)
+            {
+              uiNumbersSum += numbers[uiIndex];
+            }
+          },
+          "ParallelForIndexed Nested Test (Inner)", innerParams);
+      },
+      "ParallelForIndexed Nested Test (Outer)", outerParams);
+
+    // check results
+    EZ_TEST_INT(uiNumbersSum, uiNumbersCheckSum);
+  }
 }
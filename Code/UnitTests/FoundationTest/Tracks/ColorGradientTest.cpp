@@ -0,0 +1,198 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Tracks/ColorGradient.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+namespace
+{
+  void BuildTestGradient(ezColorGradient& gradient)
+  {
+    gradient.Clear();
+    gradient.AddColorControlPoint(0.5, ezColorGammaUB(0, 255, 0));
+    gradient.AddColorControlPoint(0.0, ezColorGammaUB(255, 0, 0));
+    gradient.AddColorControlPoint(1.0, ezColorGammaUB(0, 0, 255));
+    gradient.AddAlphaControlPoint(0.0, 255);
+    gradient.AddAlphaControlPoint(1.0, 0);
+    gradient.AddIntensityControlPoint(0.2, 1.0f);
+    gradient.AddIntensityControlPoint(0.8, 4.0f);
+    gradient.SortControlPoints();
+  }
+
+  void BuildTestPositions(ezDynamicArray<float>& positions, ezUInt32 uiNumPositions)
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    positions.SetCountUninitialized(uiNumPositions);
+
+    for (ezUInt32 i = 0; i < uiNumPositions; ++i)
+    {
+      positions[i] = rng.FloatMinMax(-0.5f, 1.5f);
+    }
+  }
+
+  float GetMaxDifference(const ezColor& lhs, const ezColor& rhs)
+  {
+    return ezMath::Max(ezMath::Abs(lhs.r - rhs.r), ezMath::Abs(lhs.g - rhs.g), ezMath::Abs(lhs.b - rhs.b), ezMath::Abs(lhs.a - rhs.a));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Tracks, ColorGradient)
+{
+  ezColorGradient gradient;
+  BuildTestGradient(gradient);
+
+  // an odd number, to also cover the partially filled last block
+  ezDynamicArray<float> positions;
+  BuildTestPositions(positions, 1003);
+
+  ezDynamicArray<ezColor> colors;
+  colors.SetCount(positions.GetCount());
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batch Evaluate without lookup table")
+  {
+    EZ_TEST_BOOL(!gradient.HasBakedLookupTable());
+
+    gradient.Evaluate(positions, colors);
+
+    for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+    {
+      ezColor hdr;
+      gradient.Evaluate(positions[i], hdr);
+
+      EZ_TEST_BOOL(colors[i].IsEqualRGBA(hdr, 0.00001f));
+    }
+
+    gradient.EvaluateColorAndAlpha(positions, colors);
+
+    for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+    {
+      ezColor rgba;
+      ezUInt8 alpha;
+      gradient.EvaluateColor(positions[i], rgba);
+      gradient.EvaluateAlpha(positions[i], alpha);
+      rgba.a = ezMath::ColorByteToFloat(alpha);
+
+      EZ_TEST_BOOL(colors[i].IsEqualRGBA(rgba, 0.00001f));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batch Evaluate with lookup table")
+  {
+    gradient.CreateBakedLookupTable();
+    EZ_TEST_BOOL(gradient.HasBakedLookupTable());
+
+    float fMaxError = 0.0f;
+
+    gradient.Evaluate(positions, colors);
+
+    for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+    {
+      ezColor hdr;
+      gradient.Evaluate(positions[i], hdr);
+
+      // the intensity scales the error of the color channels
+      fMaxError = ezMath::Max(fMaxError, GetMaxDifference(colors[i], hdr) / 4.0f);
+    }
+
+    gradient.EvaluateColorAndAlpha(positions, colors);
+
+    for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+    {
+      ezColor rgba;
+      ezUInt8 alpha;
+      gradient.EvaluateColor(positions[i], rgba);
+      gradient.EvaluateAlpha(positions[i], alpha);
+      rgba.a = ezMath::ColorByteToFloat(alpha);
+
+      fMaxError = ezMath::Max(fMaxError, GetMaxDifference(colors[i], rgba));
+    }
+
+    // alpha is quantized to bytes before it is interpolated
+    EZ_TEST_BOOL(fMaxError <= 0.01f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Modifications discard the lookup table")
+  {
+    gradient.CreateBakedLookupTable(64);
+    gradient.SortControlPoints();
+    EZ_TEST_BOOL(!gradient.HasBakedLookupTable());
+
+    gradient.CreateBakedLookupTable(64);
+    gradient.Clear();
+    EZ_TEST_BOOL(!gradient.HasBakedLookupTable());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Step keys")
+  {
+    BuildTestGradient(gradient);
+    EZ_TEST_BOOL(!gradient.HasStepKeys(256));
+
+    // the color keys are only one and a half samples apart here
+    EZ_TEST_BOOL(gradient.HasStepKeys(4));
+
+    // a sudden jump in the alpha curve alone is enough
+    gradient.AddAlphaControlPoint(0.5, 255);
+    gradient.AddAlphaControlPoint(0.502, 0);
+    gradient.SortControlPoints();
+    EZ_TEST_BOOL(gradient.HasStepKeys(256));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Empty gradient")
+  {
+    gradient.Clear();
+    gradient.CreateBakedLookupTable();
+
+    gradient.Evaluate(positions, colors);
+
+    for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(colors[i].IsEqualRGBA(ezColor::White, 0.0f));
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Evaluate Performance")
+  {
+    constexpr ezUInt32 uiNumPositions = 1000000;
+
+    ezColorGradient largeGradient;
+    for (ezUInt32 i = 0; i < 16; ++i)
+    {
+      largeGradient.AddColorControlPoint(i / 15.0, ezColorGammaUB(static_cast<ezUInt8>(i * 16), static_cast<ezUInt8>(255 - i * 16), static_cast<ezUInt8>(i * 8)));
+      largeGradient.AddAlphaControlPoint(i / 15.0, static_cast<ezUInt8>(i % 2 == 0 ? 255 : 64));
+    }
+    largeGradient.SortControlPoints();
+
+    ezDynamicArray<float> largePositions;
+    BuildTestPositions(largePositions, uiNumPositions);
+
+    ezDynamicArray<ezColor> largeColors;
+    largeColors.SetCount(uiNumPositions);
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumPositions; ++i)
+      {
+        largeGradient.Evaluate(largePositions[i], largeColors[i]);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Exact gradient evaluation: {0} values/ms", ezArgF(uiNumPositions / (t1 - t0).GetMilliseconds(), 0));
+    }
+
+    largeGradient.CreateBakedLookupTable();
+
+    {
+      ezTime t0 = ezTime::Now();
+      largeGradient.Evaluate(largePositions, largeColors);
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Baked batch gradient evaluation: {0} values/ms", ezArgF(uiNumPositions / (t1 - t0).GetMilliseconds(), 0));
+    }
+  }
+}
@@ -0,0 +1,175 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Tracks/Curve1D.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+namespace
+{
+  void BuildTestCurve(ezCurve1D& curve)
+  {
+    curve.Clear();
+    curve.AddControlPoint(2.5).m_Position.y = -1.0;
+    curve.AddControlPoint(0.0).m_Position.y = 0.0;
+    curve.AddControlPoint(4.0).m_Position.y = 1.0;
+    curve.AddControlPoint(1.0).m_Position.y = 2.0;
+    curve.SortControlPoints();
+    curve.CreateLinearApproximation();
+  }
+
+  void BuildTestPositions(ezDynamicArray<float>& positions, ezUInt32 uiNumPositions, float fMin, float fMax)
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    positions.SetCountUninitialized(uiNumPositions);
+
+    for (ezUInt32 i = 0; i < uiNumPositions; ++i)
+    {
+      positions[i] = rng.FloatMinMax(fMin, fMax);
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Tracks, Curve1D)
+{
+  ezCurve1D curve;
+  BuildTestCurve(curve);
+
+  // an odd number, to also cover the partially filled last block
+  ezDynamicArray<float> positions;
+  BuildTestPositions(positions, 1003, -1.0f, 5.0f);
+
+  ezDynamicArray<float> values;
+  values.SetCount(positions.GetCount());
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batch Evaluate without lookup table")
+  {
+    EZ_TEST_BOOL(!curve.HasBakedLookupTable());
+
+    curve.Evaluate(positions, values);
+
+    for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+    {
+      EZ_TEST_FLOAT(values[i], (float)curve.Evaluate(positions[i]), 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batch Evaluate with lookup table")
+  {
+    curve.CreateBakedLookupTable();
+    EZ_TEST_BOOL(curve.HasBakedLookupTable());
+
+    curve.Evaluate(positions, values);
+
+    double fMinY, fMaxY;
+    curve.QueryExtremeValues(fMinY, fMaxY);
+    const float fMaxAllowedError = (float)(fMaxY - fMinY) * 0.005f;
+
+    float fMaxError = 0.0f;
+    for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+    {
+      fMaxError = ezMath::Max(fMaxError, ezMath::Abs(values[i] - (float)curve.Evaluate(positions[i])));
+    }
+
+    EZ_TEST_BOOL(fMaxError <= fMaxAllowedError);
+
+    // positions outside the curve are clamped to the first and last value
+    const float outside[3] = {-100.0f, 0.0f, 100.0f};
+    float result[3];
+    curve.Evaluate(ezMakeArrayPtr(outside), ezMakeArrayPtr(result));
+
+    EZ_TEST_FLOAT(result[0], 0.0f, 0.00001f);
+    EZ_TEST_FLOAT(result[1], 0.0f, 0.00001f);
+    EZ_TEST_FLOAT(result[2], 1.0f, 0.00001f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Modifications discard the lookup table")
+  {
+    curve.CreateBakedLookupTable(64);
+    EZ_TEST_BOOL(curve.HasBakedLookupTable());
+
+    curve.ModifyControlPoint(0).m_Position.y = 3.0;
+    curve.CreateLinearApproximation();
+    EZ_TEST_BOOL(!curve.HasBakedLookupTable());
+
+    curve.CreateBakedLookupTable(64);
+    curve.Clear();
+    EZ_TEST_BOOL(!curve.HasBakedLookupTable());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Step keys")
+  {
+    BuildTestCurve(curve);
+    EZ_TEST_BOOL(!curve.HasStepKeys(256));
+
+    // the control points are only one unit apart, which is less than two samples here
+    EZ_TEST_BOOL(curve.HasStepKeys(3));
+
+    curve.AddControlPoint(1.01).m_Position.y = -2.0;
+    curve.SortControlPoints();
+    curve.CreateLinearApproximation();
+    EZ_TEST_BOOL(curve.HasStepKeys(256));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Single control point")
+  {
+    curve.Clear();
+    curve.AddControlPoint(1.0).m_Position.y = 3.0;
+    curve.SortControlPoints();
+    curve.CreateLinearApproximation();
+    curve.CreateBakedLookupTable();
+
+    curve.Evaluate(positions, values);
+
+    for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+    {
+      EZ_TEST_FLOAT(values[i], 3.0f, 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Evaluate Performance")
+  {
+    constexpr ezUInt32 uiNumPositions = 1000000;
+
+    // a curve with many control points, which makes the search for the right segment more expensive
+    ezCurve1D largeCurve;
+    for (ezUInt32 i = 0; i < 32; ++i)
+    {
+      largeCurve.AddControlPoint(i).m_Position.y = ezMath::Sin(ezAngle::Degree(i * 50.0f));
+    }
+    largeCurve.SortControlPoints();
+    largeCurve.CreateLinearApproximation();
+
+    ezDynamicArray<float> largePositions;
+    BuildTestPositions(largePositions, uiNumPositions, 0.0f, 31.0f);
+
+    ezDynamicArray<float> largeValues;
+    largeValues.SetCount(uiNumPositions);
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumPositions; ++i)
+      {
+        largeValues[i] = (float)largeCurve.Evaluate(largePositions[i]);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Exact curve evaluation: {0} values/ms", ezArgF(uiNumPositions / (t1 - t0).GetMilliseconds(), 0));
+    }
+
+    largeCurve.CreateBakedLookupTable();
+
+    {
+      ezTime t0 = ezTime::Now();
+      largeCurve.Evaluate(largePositions, largeValues);
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Baked batch curve evaluation: {0} values/ms", ezArgF(uiNumPositions / (t1 - t0).GetMilliseconds(), 0));
+    }
+  }
+}
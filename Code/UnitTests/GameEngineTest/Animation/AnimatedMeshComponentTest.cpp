@@ -0,0 +1,258 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/Graphics/Geometry.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <GameEngine/Animation/Skeletal/AnimatedMeshComponent.h>
+#include <RendererCore/AnimationSystem/AnimationClipResource.h>
+#include <RendererCore/AnimationSystem/Declarations.h>
+#include <RendererCore/AnimationSystem/SkeletonBuilder.h>
+#include <RendererCore/AnimationSystem/SkeletonResource.h>
+#include <RendererCore/Meshes/MeshBufferResource.h>
+#include <RendererCore/Meshes/MeshResource.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+namespace
+{
+  constexpr ezUInt16 s_uiNumJoints = 32;
+  constexpr ezUInt16 s_uiNumFrames = 30;
+
+  /// Records the last pose that the ezAnimatedMeshComponent on the same object sent.
+  typedef ezComponentManager<class PoseRecorderComponent, ezBlockStorageType::Compact> PoseRecorderComponentManager;
+
+  class PoseRecorderComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(PoseRecorderComponent, ezComponent, PoseRecorderComponentManager);
+
+  public:
+    void OnAnimationPoseUpdated(ezMsgAnimationPoseUpdated& msg)
+    {
+      m_Pose = msg.m_pPose->GetAllTransforms();
+      ++m_uiNumPoseUpdates;
+    }
+
+    ezDynamicArray<ezMat4> m_Pose;
+    ezUInt32 m_uiNumPoseUpdates = 0;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(PoseRecorderComponent, 1, ezComponentMode::Static)
+  {
+    EZ_BEGIN_MESSAGEHANDLERS
+    {
+      EZ_MESSAGE_HANDLER(ezMsgAnimationPoseUpdated, OnAnimationPoseUpdated)
+    }
+    EZ_END_MESSAGEHANDLERS;
+  }
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  void BuildTestSkeleton(ezSkeleton& skeleton)
+  {
+    ezSkeletonBuilder builder;
+
+    ezStringBuilder sName;
+    for (ezUInt32 i = 0; i < s_uiNumJoints; ++i)
+    {
+      ezTransform t;
+      t.SetIdentity();
+      t.m_vPosition.Set(0, 0, 1);
+
+      sName.Format("Joint{0}", i);
+      builder.AddJoint(sName, t, i > 0 ? (i - 1) / 2 : 0xFFFFFFFFu);
+    }
+
+    builder.BuildSkeleton(skeleton);
+  }
+
+  void BuildTestClip(ezAnimationClipResourceDescriptor& clip)
+  {
+    clip.Configure(s_uiNumJoints, s_uiNumFrames, 30, false);
+
+    ezStringBuilder sName;
+    for (ezUInt32 i = 0; i < s_uiNumJoints; ++i)
+    {
+      sName.Format("Joint{0}", i);
+
+      ezHashedString sJointName;
+      sJointName.Assign(sName.GetData());
+      clip.AddJointName(sJointName);
+
+      ezArrayPtr<ezTransform> keyframes = clip.GetJointKeyframes(static_cast<ezUInt16>(i));
+      for (ezUInt32 f = 0; f < s_uiNumFrames; ++f)
+      {
+        keyframes[f].m_vPosition.Set(0.1f * i, 0.0f, 1.0f);
+        keyframes[f].m_qRotation.SetFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::Degree((f + i) * 12.0f));
+        keyframes[f].m_vScale.Set(1.0f);
+      }
+    }
+  }
+
+  /// Does the same as ezAnimatedMeshComponent::UpdatePose(), but on the main thread.
+  void ComputeSerialPose(ezAnimationClipSampler& sampler, const ezSkeleton& skeleton, ezTime tDiff, ezAnimationPose& out_Pose)
+  {
+    ezLocalAnimationPose localPose;
+    localPose.Configure(skeleton);
+
+    ezTransform rootMotion;
+    rootMotion.SetIdentity();
+
+    sampler.Step(tDiff);
+    sampler.Execute(skeleton, localPose, &rootMotion);
+    localPose.ConvertToMatrices(out_Pose);
+
+    out_Pose.ConvertFromLocalSpaceToObjectSpace(skeleton);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Animation, AnimatedMeshComponent)
+{
+  ezGALDeviceCreationDescription deviceDesc;
+  deviceDesc.m_bCreatePrimarySwapChain = false;
+
+  // the meshes and skinning buffers are created on the default device, which doesn't need a GPU here
+  ezGALDeviceNull device(deviceDesc);
+  if (EZ_TEST_BOOL(device.Init().Succeeded()).Failed())
+    return;
+
+  ezGALDevice::SetDefaultDevice(&device);
+
+  ezSkeletonResourceHandle hSkeleton;
+  {
+    ezSkeletonResourceDescriptor desc;
+    BuildTestSkeleton(desc.m_Skeleton);
+    hSkeleton = ezResourceManager::CreateResource<ezSkeletonResource>("AnimatedMeshComponentTestSkeleton", std::move(desc));
+  }
+
+  ezAnimationClipResourceHandle hClip;
+  {
+    ezAnimationClipResourceDescriptor desc;
+    BuildTestClip(desc);
+    hClip = ezResourceManager::CreateResource<ezAnimationClipResource>("AnimatedMeshComponentTestClip", std::move(desc));
+  }
+
+  ezMeshResourceHandle hMesh;
+  {
+    ezGeometry geom;
+    geom.AddBox(ezVec3(1.0f), ezColor::White);
+
+    ezMeshBufferResourceDescriptor bufferDesc;
+    bufferDesc.AddStream(ezGALVertexAttributeSemantic::Position, ezGALResourceFormat::XYZFloat);
+    bufferDesc.AllocateStreamsFromGeometry(geom, ezGALPrimitiveTopology::Triangles);
+
+    ezMeshBufferResourceHandle hMeshBuffer =
+      ezResourceManager::CreateResource<ezMeshBufferResource>("AnimatedMeshComponentTestMeshBuffer", std::move(bufferDesc));
+
+    ezResourceLock<ezMeshBufferResource> pMeshBuffer(hMeshBuffer, ezResourceAcquireMode::BlockTillLoaded);
+
+    ezMeshResourceDescriptor desc;
+    desc.UseExistingMeshBuffer(hMeshBuffer);
+    desc.AddSubMesh(pMeshBuffer->GetPrimitiveCount(), 0, 0);
+    desc.SetMaterial(0, "");
+    desc.SetSkeleton(hSkeleton);
+    desc.ComputeBounds();
+
+    hMesh = ezResourceManager::CreateResource<ezMeshResource>("AnimatedMeshComponentTestMesh", std::move(desc));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel pose update matches serial update")
+  {
+    // enough components to split the async update into many batches
+    constexpr ezUInt32 uiNumMeshes = 256;
+    constexpr ezUInt32 uiNumFramesToUpdate = 20;
+
+    ezWorldDesc worldDesc("AnimatedMeshComponentTest");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    world.GetClock().SetFixedTimeStep(ezTime::Seconds(1.0 / 30.0));
+
+    ezDynamicArray<PoseRecorderComponent*> recorders;
+    recorders.Reserve(uiNumMeshes);
+
+    // the serial reference, every mesh plays the clip at a different speed
+    ezDynamicArray<ezAnimationClipSampler> samplers;
+    samplers.SetCount(uiNumMeshes);
+
+    for (ezUInt32 i = 0; i < uiNumMeshes; ++i)
+    {
+      const float fSpeed = 0.5f + i * 0.01f;
+
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = true;
+      desc.m_LocalPosition.Set((float)i, 0, 0);
+
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
+
+      ezAnimatedMeshComponent* pMeshComponent = nullptr;
+      ezAnimatedMeshComponent::CreateComponent(pObject, pMeshComponent);
+      pMeshComponent->SetMesh(hMesh);
+      pMeshComponent->SetAnimationClip(hClip);
+      pMeshComponent->SetLoopAnimation(true);
+      pMeshComponent->SetAnimationSpeed(fSpeed);
+
+      PoseRecorderComponent* pRecorder = nullptr;
+      PoseRecorderComponent::CreateComponent(pObject, pRecorder);
+      recorders.PushBack(pRecorder);
+
+      samplers[i].SetAnimationClip(hClip);
+      samplers[i].SetLooping(true);
+      samplers[i].SetPlaybackSpeed(fSpeed);
+      samplers[i].RestartAnimation();
+    }
+
+    const ezUInt32 uiNumBuffersBefore = device.GetStatistics().m_uiNumBuffers;
+
+    ezResourceLock<ezSkeletonResource> pSkeleton(hSkeleton, ezResourceAcquireMode::BlockTillLoaded);
+    const ezSkeleton& skeleton = pSkeleton->GetDescriptor().m_Skeleton;
+
+    ezAnimationPose serialPose;
+    serialPose.Configure(skeleton);
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFramesToUpdate; ++uiFrame)
+    {
+      world.Update();
+
+      // every mesh got its skinning buffer when the simulation started
+      if (uiFrame == 0)
+      {
+        EZ_TEST_INT(device.GetStatistics().m_uiNumBuffers, uiNumBuffersBefore + uiNumMeshes);
+      }
+
+      const ezTime tDiff = world.GetClock().GetTimeDiff();
+
+      bool bAllUpdated = true;
+      bool bSamePose = true;
+
+      for (ezUInt32 i = 0; i < uiNumMeshes; ++i)
+      {
+        const PoseRecorderComponent* pRecorder = recorders[i];
+        // the components are initialized at the start of the first update, so every update produces a pose
+        bAllUpdated &= (pRecorder->m_uiNumPoseUpdates == uiFrame + 1);
+
+        ComputeSerialPose(samplers[i], skeleton, tDiff, serialPose);
+
+        if (pRecorder->m_Pose.GetCount() != serialPose.GetTransformCount())
+        {
+          bSamePose = false;
+          continue;
+        }
+
+        for (ezUInt16 j = 0; j < serialPose.GetTransformCount(); ++j)
+        {
+          bSamePose &= pRecorder->m_Pose[j].IsEqual(serialPose.GetTransform(j), 0.0001f);
+        }
+      }
+
+      EZ_TEST_BOOL(bAllUpdated);
+      EZ_TEST_BOOL(bSamePose);
+    }
+  }
+
+  hMesh.Invalidate();
+  hClip.Invalidate();
+  hSkeleton.Invalidate();
+  ezResourceManager::FreeAllUnusedResources();
+
+  device.Shutdown();
+}
@@ -0,0 +1,575 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Time.h>
+#include <RendererCore/AnimationSystem/AnimationClipResource.h>
+#include <RendererCore/AnimationSystem/AnimationPose.h>
+#include <RendererCore/AnimationSystem/JointMapping.h>
+#include <RendererCore/AnimationSystem/LocalAnimationPose.h>
+#include <RendererCore/AnimationSystem/SkeletonBuilder.h>
+#include <RendererCore/Shader/Types.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+namespace
+{
+  constexpr ezUInt16 s_uiNumJoints = 100;
+  constexpr ezUInt16 s_uiNumFrames = 30;
+
+  void BuildTestSkeleton(ezSkeleton& skeleton, ezUInt32 uiNumJoints = s_uiNumJoints)
+  {
+    ezSkeletonBuilder builder;
+
+    ezStringBuilder sName;
+    for (ezUInt32 i = 0; i < uiNumJoints; ++i)
+    {
+      ezTransform t;
+      t.SetIdentity();
+      t.m_vPosition.Set(0, 0, 1);
+
+      sName.Format("Joint{0}", i);
+      builder.AddJoint(sName, t, i > 0 ? (i - 1) / 2 : 0xFFFFFFFFu);
+    }
+
+    builder.BuildSkeleton(skeleton);
+  }
+
+  void BuildTestClip(ezAnimationClipResourceDescriptor& clip)
+  {
+    clip.Configure(s_uiNumJoints, s_uiNumFrames, 30, false);
+
+    // add the joints in reverse order, so that the clip indices differ from the skeleton indices
+    ezStringBuilder sName;
+    for (ezUInt32 i = 0; i < s_uiNumJoints; ++i)
+    {
+      sName.Format("Joint{0}", s_uiNumJoints - 1 - i);
+
+      ezHashedString sJointName;
+      sJointName.Assign(sName.GetData());
+      clip.AddJointName(sJointName);
+
+      ezArrayPtr<ezTransform> keyframes = clip.GetJointKeyframes(static_cast<ezUInt16>(i));
+      for (ezUInt32 f = 0; f < s_uiNumFrames; ++f)
+      {
+        keyframes[f].m_vPosition.Set((float)i, (float)f, 1.0f);
+        keyframes[f].m_qRotation.SetFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::Degree(f * 10.0f));
+        keyframes[f].m_vScale.Set(1.0f);
+      }
+    }
+  }
+
+  float GetRotationError(const ezQuat& q0, const ezQuat& q1)
+  {
+    const float fDot = ezMath::Abs(q0.v.Dot(q1.v) + q0.w * q1.w);
+    return 2.0f * ezMath::ACos(ezMath::Min(fDot, 1.0f)).GetRadian();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Animation, AnimationSampling)
+{
+  ezSkeleton skeleton;
+  BuildTestSkeleton(skeleton);
+
+  ezAnimationClipResourceDescriptor clip;
+  BuildTestClip(clip);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Skeleton Revision")
+  {
+    ezSkeleton copy = skeleton;
+    EZ_TEST_INT(copy.GetRevision(), skeleton.GetRevision());
+
+    BuildTestSkeleton(copy);
+    EZ_TEST_BOOL(copy.GetRevision() != skeleton.GetRevision());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cached Joint Mapping")
+  {
+    ezAnimationClipResourceDescriptor clipCopy = clip;
+    ezAnimationClipResourceHandle hClip =
+      ezResourceManager::CreateResource<ezAnimationClipResource>("AnimationSamplingTestClip", std::move(clipCopy));
+
+    {
+      ezResourceLock<ezAnimationClipResource> pClip(hClip, ezResourceAcquireMode::BlockTillLoaded);
+
+      const ezJointMapping& mapping = pClip->GetJointMapping(skeleton);
+      EZ_TEST_INT(mapping.GetAllMappings().GetCount(), s_uiNumJoints);
+      EZ_TEST_BOOL(&pClip->GetJointMapping(skeleton) == &mapping);
+
+      // a copy has the same revision and shares the mapping
+      ezSkeleton copy = skeleton;
+      EZ_TEST_BOOL(&pClip->GetJointMapping(copy) == &mapping);
+
+      // rebuilding the skeleton bumps the revision, the mapping has to match the new joints
+      const ezUInt32 uiOldRevision = copy.GetRevision();
+      BuildTestSkeleton(copy, s_uiNumJoints / 2);
+      EZ_TEST_BOOL(copy.GetRevision() != uiOldRevision);
+
+      const ezJointMapping& rebuiltMapping = pClip->GetJointMapping(copy);
+      EZ_TEST_INT(rebuiltMapping.GetAllMappings().GetCount(), s_uiNumJoints / 2);
+      EZ_TEST_BOOL(&rebuiltMapping != &mapping);
+
+      // the mapping of the original skeleton is still there
+      EZ_TEST_BOOL(&pClip->GetJointMapping(skeleton) == &mapping);
+      EZ_TEST_INT(mapping.GetAllMappings().GetCount(), s_uiNumJoints);
+
+      // rebuilding again replaces the outdated mapping of that skeleton instead of adding one per revision
+      BuildTestSkeleton(copy, s_uiNumJoints / 4);
+
+      const ezJointMapping& rebuiltMapping2 = pClip->GetJointMapping(copy);
+      EZ_TEST_INT(rebuiltMapping2.GetAllMappings().GetCount(), s_uiNumJoints / 4);
+      EZ_TEST_BOOL(&rebuiltMapping2 == &rebuiltMapping);
+    }
+
+    hClip.Invalidate();
+    ezResourceManager::FreeAllUnusedResources();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SetPoseToBlendedKeyframe with joint mapping")
+  {
+    ezJointMapping mapping;
+    mapping.CreateMapping(skeleton, clip);
+    EZ_TEST_INT(mapping.GetAllMappings().GetCount(), s_uiNumJoints);
+
+    ezAnimationPose poseByName;
+    poseByName.Configure(skeleton);
+    clip.SetPoseToBlendedKeyframe(poseByName, skeleton, 3, 0.25f);
+
+    ezAnimationPose poseByMapping;
+    poseByMapping.Configure(skeleton);
+    clip.SetPoseToBlendedKeyframe(poseByMapping, mapping, 3, 0.25f);
+
+    for (ezUInt16 i = 0; i < s_uiNumJoints; ++i)
+    {
+      EZ_TEST_BOOL(poseByMapping.IsTransformValid(i));
+      EZ_TEST_BOOL(poseByMapping.GetTransform(i).IsIdentical(poseByName.GetTransform(i)));
+    }
+
+    // joint i in the skeleton is joint (s_uiNumJoints - 1 - i) in the clip
+    EZ_TEST_VEC3(poseByMapping.GetTransform(10).GetTranslationVector(), ezVec3(s_uiNumJoints - 1 - 10, 3.25f, 1.0f), 0.0001f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compress")
+  {
+    ezAnimationClipCompressionSettings settings;
+
+    ezAnimationClipResourceDescriptor compressed = clip;
+    compressed.Compress(settings);
+
+    EZ_TEST_BOOL(compressed.IsCompressed());
+    EZ_TEST_BOOL(compressed.GetHeapMemoryUsage() < clip.GetHeapMemoryUsage());
+
+    float fMaxTranslationError = 0.0f;
+    float fMaxRotationError = 0.0f;
+    float fMaxScaleError = 0.0f;
+
+    for (ezUInt16 j = 0; j < s_uiNumJoints; ++j)
+    {
+      for (ezUInt16 f = 0; f < s_uiNumFrames; ++f)
+      {
+        const ezTransform original = clip.GetJointKeyframe(j, f);
+        const ezTransform decoded = compressed.GetJointKeyframe(j, f);
+
+        fMaxTranslationError = ezMath::Max(fMaxTranslationError, (original.m_vPosition - decoded.m_vPosition).GetLength());
+        fMaxRotationError = ezMath::Max(fMaxRotationError, GetRotationError(original.m_qRotation, decoded.m_qRotation));
+        fMaxScaleError = ezMath::Max(fMaxScaleError, (original.m_vScale - decoded.m_vScale).GetLength());
+      }
+    }
+
+    EZ_TEST_BOOL(fMaxTranslationError <= settings.m_fMaxTranslationError);
+    EZ_TEST_BOOL(fMaxRotationError <= settings.m_MaxRotationError.GetRadian() + ezMath::DefaultEpsilon<float>());
+    EZ_TEST_BOOL(fMaxScaleError <= settings.m_fMaxScaleError);
+
+    ezJointMapping mapping;
+    mapping.CreateMapping(skeleton, clip);
+
+    ezAnimationPose pose;
+    pose.Configure(skeleton);
+    clip.SetPoseToBlendedKeyframe(pose, mapping, 7, 0.5f);
+
+    ezAnimationPose poseCompressed;
+    poseCompressed.Configure(skeleton);
+    compressed.SetPoseToBlendedKeyframe(poseCompressed, mapping, 7, 0.5f);
+
+    for (ezUInt16 i = 0; i < s_uiNumJoints; ++i)
+    {
+      EZ_TEST_BOOL(poseCompressed.GetTransform(i).IsEqual(pose.GetTransform(i), 0.01f));
+    }
+
+    // round trip through the serialized format
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezMemoryStreamReader reader(&storage);
+
+    compressed.Save(writer);
+
+    ezAnimationClipResourceDescriptor loaded;
+    loaded.Load(reader);
+
+    EZ_TEST_BOOL(loaded.IsCompressed());
+
+    for (ezUInt16 j = 0; j < s_uiNumJoints; ++j)
+    {
+      for (ezUInt16 f = 0; f < s_uiNumFrames; ++f)
+      {
+        EZ_TEST_BOOL(loaded.GetJointKeyframe(j, f).IsEqual(compressed.GetJointKeyframe(j, f), 0.0f));
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Sampling Performance")
+  {
+    constexpr ezUInt32 uiNumSamples = 10000;
+
+    ezAnimationPose pose;
+    pose.Configure(skeleton);
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumSamples; ++i)
+      {
+        clip.SetPoseToBlendedKeyframe(pose, skeleton, i % (s_uiNumFrames - 1), 0.5f);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Sampling with joint lookup by name: {0} samples/sec", ezArgF(uiNumSamples / (t1 - t0).GetSeconds(), 0));
+    }
+
+    {
+      ezJointMapping mapping;
+      mapping.CreateMapping(skeleton, clip);
+
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumSamples; ++i)
+      {
+        clip.SetPoseToBlendedKeyframe(pose, mapping, i % (s_uiNumFrames - 1), 0.5f);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Sampling with joint mapping: {0} samples/sec", ezArgF(uiNumSamples / (t1 - t0).GetSeconds(), 0));
+    }
+
+    {
+      ezAnimationClipResourceDescriptor compressed = clip;
+      compressed.Compress(ezAnimationClipCompressionSettings());
+
+      ezJointMapping mapping;
+      mapping.CreateMapping(skeleton, compressed);
+
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumSamples; ++i)
+      {
+        compressed.SetPoseToBlendedKeyframe(pose, mapping, i % (s_uiNumFrames - 1), 0.5f);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Sampling compressed keyframes: {0} samples/sec", ezArgF(uiNumSamples / (t1 - t0).GetSeconds(), 0));
+      ezLog::Info("[test]Keyframe memory: {0} uncompressed, {1} compressed", ezArgFileSize(clip.GetHeapMemoryUsage()),
+        ezArgFileSize(compressed.GetHeapMemoryUsage()));
+    }
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(Animation, LocalAnimationPose)
+{
+  ezSkeleton skeleton;
+  BuildTestSkeleton(skeleton);
+
+  ezAnimationClipResourceDescriptor clip;
+  BuildTestClip(clip);
+
+  ezJointMapping mapping;
+  mapping.CreateMapping(skeleton, clip);
+
+  ezAnimationPose matrixPose;
+  matrixPose.Configure(skeleton);
+
+  ezAnimationPose referencePose;
+  referencePose.Configure(skeleton);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SetTransform / GetTransform")
+  {
+    ezLocalAnimationPose pose;
+    pose.Configure(skeleton);
+    EZ_TEST_INT(pose.GetJointCount(), s_uiNumJoints);
+
+    ezTransform t;
+    t.m_vPosition.Set(1, 2, 3);
+    t.m_qRotation.SetFromAxisAndAngle(ezVec3(0, 1, 0), ezAngle::Degree(30));
+    t.m_vScale.Set(2, 3, 4);
+
+    pose.SetTransform(s_uiNumJoints - 1, ezSimdConversion::ToTransform(t));
+    EZ_TEST_BOOL(ezSimdConversion::ToTransform(pose.GetTransform(s_uiNumJoints - 1)).IsEqual(t, 0.0f));
+    EZ_TEST_BOOL(ezSimdConversion::ToTransform(pose.GetTransform(0)).IsEqual(skeleton.GetJointByIndex(0).GetBindPoseLocalTransform(), 0.0f));
+
+    pose.ConvertToMatrices(matrixPose);
+    EZ_TEST_BOOL(matrixPose.GetTransform(s_uiNumJoints - 1).IsEqual(t.GetAsMat4(), 0.0001f));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SetPoseToBlendedKeyframe")
+  {
+    ezLocalAnimationPose pose;
+    pose.Configure(skeleton);
+    clip.SetPoseToBlendedKeyframe(pose, mapping, 5, 0.3f);
+    pose.ConvertToMatrices(matrixPose);
+
+    clip.SetPoseToBlendedKeyframe(referencePose, mapping, 5, 0.3f);
+
+    for (ezUInt16 i = 0; i < s_uiNumJoints; ++i)
+    {
+      EZ_TEST_BOOL(matrixPose.GetTransform(i).IsEqual(referencePose.GetTransform(i), 0.0001f));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "BlendTowards / BlendTowardsMasked")
+  {
+    ezLocalAnimationPose pose0;
+    pose0.Configure(skeleton);
+    clip.SetPoseToBlendedKeyframe(pose0, mapping, 2, 0.0f);
+
+    ezLocalAnimationPose pose1;
+    pose1.Configure(skeleton);
+    clip.SetPoseToBlendedKeyframe(pose1, mapping, 3, 0.0f);
+
+    // blending neighboring keyframes by half has to match sampling in between, up to the difference of nlerp and slerp
+    ezLocalAnimationPose blended = pose0;
+    blended.BlendTowards(pose1, 0.5f);
+    blended.ConvertToMatrices(matrixPose);
+
+    clip.SetPoseToBlendedKeyframe(referencePose, mapping, 2, 0.5f);
+
+    for (ezUInt16 i = 0; i < s_uiNumJoints; ++i)
+    {
+      EZ_TEST_BOOL(matrixPose.GetTransform(i).IsEqual(referencePose.GetTransform(i), 0.001f));
+    }
+
+    // only blend the odd joints
+    ezDynamicArray<float> weights;
+    weights.SetCount(s_uiNumJoints);
+    for (ezUInt32 i = 0; i < s_uiNumJoints; ++i)
+    {
+      weights[i] = (i % 2) ? 1.0f : 0.0f;
+    }
+
+    ezLocalAnimationPose masked = pose0;
+    masked.BlendTowardsMasked(pose1, weights);
+
+    for (ezUInt16 i = 0; i < s_uiNumJoints; ++i)
+    {
+      const ezLocalAnimationPose& expected = (i % 2) ? pose1 : pose0;
+      EZ_TEST_BOOL(ezSimdConversion::ToTransform(masked.GetTransform(i)).IsEqual(ezSimdConversion::ToTransform(expected.GetTransform(i)), 0.0001f));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MakeAdditive / AddAdditive")
+  {
+    ezLocalAnimationPose reference;
+    reference.Configure(skeleton);
+    clip.SetPoseToBlendedKeyframe(reference, mapping, 0, 0.0f);
+
+    ezLocalAnimationPose target;
+    target.Configure(skeleton);
+    clip.SetPoseToBlendedKeyframe(target, mapping, 10, 0.0f);
+
+    ezLocalAnimationPose additive = target;
+    additive.MakeAdditive(reference);
+
+    ezLocalAnimationPose result = reference;
+    result.AddAdditive(additive, 1.0f);
+
+    for (ezUInt16 i = 0; i < s_uiNumJoints; ++i)
+    {
+      const ezTransform t0 = ezSimdConversion::ToTransform(result.GetTransform(i));
+      const ezTransform t1 = ezSimdConversion::ToTransform(target.GetTransform(i));
+
+      EZ_TEST_VEC3(t0.m_vPosition, t1.m_vPosition, 0.0001f);
+      EZ_TEST_VEC3(t0.m_vScale, t1.m_vScale, 0.0001f);
+      EZ_TEST_FLOAT(GetRotationError(t0.m_qRotation, t1.m_qRotation), 0.0f, 0.001f);
+    }
+
+    result = reference;
+    result.AddAdditive(additive, 0.0f);
+    EZ_TEST_BOOL(ezSimdConversion::ToTransform(result.GetTransform(5)).IsEqual(ezSimdConversion::ToTransform(reference.GetTransform(5)), 0.0001f));
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Blending Performance")
+  {
+    constexpr ezUInt32 uiNumSamples = 10000;
+
+    // sample two clips and blend them, once with matrices and once with the local pose
+    {
+      ezAnimationPose pose0, pose1;
+      pose0.Configure(skeleton);
+      pose1.Configure(skeleton);
+
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumSamples; ++i)
+      {
+        const ezUInt16 uiFrame = i % (s_uiNumFrames - 1);
+        clip.SetPoseToBlendedKeyframe(pose0, mapping, uiFrame, 0.5f);
+        clip.SetPoseToBlendedKeyframe(pose1, mapping, s_uiNumFrames - 2 - uiFrame, 0.5f);
+
+        for (ezUInt16 j = 0; j < s_uiNumJoints; ++j)
+        {
+          ezMat4 m0 = pose0.GetTransform(j);
+          const ezMat4& m1 = pose1.GetTransform(j);
+
+          ezVec3 vScale0 = m0.GetScalingFactors();
+          ezVec3 vScale1 = m1.GetScalingFactors();
+
+          ezQuat q0, q1;
+          q0.SetFromMat3(m0.GetRotationalPart());
+          q1.SetFromMat3(m1.GetRotationalPart());
+
+          ezTransform res;
+          res.m_vPosition = ezMath::Lerp(m0.GetTranslationVector(), m1.GetTranslationVector(), 0.5f);
+          res.m_qRotation.SetSlerp(q0, q1, 0.5f);
+          res.m_vScale = ezMath::Lerp(vScale0, vScale1, 0.5f);
+          pose0.SetTransform(j, res.GetAsMat4());
+        }
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Sample and blend two clips with ezAnimationPose: {0} poses/sec", ezArgF(uiNumSamples / (t1 - t0).GetSeconds(), 0));
+    }
+
+    {
+      ezLocalAnimationPose pose0, pose1;
+      pose0.Configure(skeleton);
+      pose1.Configure(skeleton);
+
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumSamples; ++i)
+      {
+        const ezUInt16 uiFrame = i % (s_uiNumFrames - 1);
+        clip.SetPoseToBlendedKeyframe(pose0, mapping, uiFrame, 0.5f);
+        clip.SetPoseToBlendedKeyframe(pose1, mapping, s_uiNumFrames - 2 - uiFrame, 0.5f);
+
+        pose0.BlendTowards(pose1, 0.5f);
+        pose0.ConvertToMatrices(matrixPose);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Sample and blend two clips with ezLocalAnimationPose: {0} poses/sec", ezArgF(uiNumSamples / (t1 - t0).GetSeconds(), 0));
+    }
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(Animation, AnimationPoseConversion)
+{
+  ezSkeleton skeleton;
+  BuildTestSkeleton(skeleton);
+
+  ezAnimationClipResourceDescriptor clip;
+  BuildTestClip(clip);
+
+  ezJointMapping mapping;
+  mapping.CreateMapping(skeleton, clip);
+
+  ezAnimationPose localPose;
+  localPose.Configure(skeleton);
+  clip.SetPoseToBlendedKeyframe(localPose, mapping, 7, 0.3f);
+
+  // the scalar implementation that the optimized conversions have to match
+  ezDynamicArray<ezMat4> referenceObjectSpace;
+  for (ezUInt16 i = 0; i < s_uiNumJoints; ++i)
+  {
+    const ezSkeletonJoint& joint = skeleton.GetJointByIndex(i);
+
+    if (joint.IsRootJoint())
+      referenceObjectSpace.PushBack(localPose.GetTransform(i));
+    else
+      referenceObjectSpace.PushBack(referenceObjectSpace[joint.GetParentIndex()] * localPose.GetTransform(i));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ConvertFromLocalSpaceToObjectSpace")
+  {
+    ezAnimationPose pose = localPose;
+    pose.ConvertFromLocalSpaceToObjectSpace(skeleton);
+
+    for (ezUInt16 i = 0; i < s_uiNumJoints; ++i)
+    {
+      EZ_TEST_BOOL(pose.GetTransform(i).IsEqual(referenceObjectSpace[i], 0.001f));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ComputeSkinningTransforms")
+  {
+    ezAnimationPose pose = localPose;
+    pose.ConvertFromLocalSpaceToObjectSpace(skeleton);
+
+    ezDynamicArray<ezShaderTransform> skinningTransforms;
+    skinningTransforms.SetCount(s_uiNumJoints);
+    pose.ComputeSkinningTransforms(skeleton, skinningTransforms);
+
+    // the pose itself stays in object space
+    EZ_TEST_BOOL(pose.GetTransform(s_uiNumJoints - 1).IsEqual(referenceObjectSpace[s_uiNumJoints - 1], 0.001f));
+
+    pose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
+
+    for (ezUInt16 i = 0; i < s_uiNumJoints; ++i)
+    {
+      float expected[16];
+      pose.GetTransform(i).GetAsArray(expected, ezMatrixLayout::RowMajor);
+
+      // ezShaderTransform stores the upper three rows of the matrix
+      const float* pActual = reinterpret_cast<const float*>(&skinningTransforms[i]);
+
+      for (ezUInt32 e = 0; e < 12; ++e)
+      {
+        EZ_TEST_FLOAT(pActual[e], expected[e], 0.001f);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Conversion Performance")
+  {
+    constexpr ezUInt32 uiNumConversions = 10000;
+
+    ezAnimationPose pose;
+    pose.Configure(skeleton);
+
+    ezArrayPtr<ezMat4> renderMatrices = EZ_DEFAULT_NEW_ARRAY(ezMat4, s_uiNumJoints);
+    ezArrayPtr<ezShaderTransform> renderTransforms = EZ_DEFAULT_NEW_ARRAY(ezShaderTransform, s_uiNumJoints);
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumConversions; ++i)
+      {
+        pose = localPose;
+
+        for (ezUInt16 j = 0; j < s_uiNumJoints; ++j)
+        {
+          const ezSkeletonJoint& joint = skeleton.GetJointByIndex(j);
+          if (!joint.IsRootJoint())
+            pose.SetTransform(j, pose.GetTransform(joint.GetParentIndex()) * pose.GetTransform(j));
+        }
+
+        pose.ConvertFromObjectSpaceToSkinningSpace(skeleton);
+        ezMemoryUtils::Copy(renderMatrices.GetPtr(), pose.GetAllTransforms().GetPtr(), s_uiNumJoints);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Scalar conversion to 4x4 skinning matrices: {0} poses/sec", ezArgF(uiNumConversions / (t1 - t0).GetSeconds(), 0));
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumConversions; ++i)
+      {
+        pose = localPose;
+        pose.ConvertFromLocalSpaceToObjectSpace(skeleton);
+        pose.ComputeSkinningTransforms(skeleton, renderTransforms);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]SIMD conversion to 3x4 skinning transforms: {0} poses/sec", ezArgF(uiNumConversions / (t1 - t0).GetSeconds(), 0));
+    }
+
+    EZ_DEFAULT_DELETE_ARRAY(renderMatrices);
+    EZ_DEFAULT_DELETE_ARRAY(renderTransforms);
+  }
+}
@@ -0,0 +1,246 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Time.h>
+#include <GameEngine/Animation/Skeletal/MotionMatchingDatabase.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+namespace
+{
+  // walk cycles with slightly different speeds and directions, so that neighboring keyframes are similar like in real clips
+  void BuildTestFrames(ezDynamicArray<ezMotionMatchingDatabase::Frame>& frames, ezUInt16 uiNumClips, ezUInt16 uiNumKeyframes)
+  {
+    for (ezUInt16 clip = 0; clip < uiNumClips; ++clip)
+    {
+      const ezAngle direction = ezAngle::Degree(clip * 360.0f / uiNumClips);
+      const float fSpeed = 1.0f + (clip % 4);
+      const ezVec3 vVelocity(ezMath::Cos(direction) * fSpeed, ezMath::Sin(direction) * fSpeed, 0.0f);
+
+      for (ezUInt16 kf = 0; kf < uiNumKeyframes; ++kf)
+      {
+        const ezAngle phase = ezAngle::Degree(kf * 15.0f);
+
+        ezMotionMatchingDatabase::Frame& frame = frames.ExpandAndGetRef();
+        frame.m_uiAnimClipIndex = clip;
+        frame.m_uiKeyframeIndex = kf;
+        frame.m_vLeftFootPosition.Set(0.2f, ezMath::Sin(phase) * 0.3f * fSpeed, ezMath::Max(0.0f, ezMath::Cos(phase)) * 0.1f);
+        frame.m_vRightFootPosition.Set(-0.2f, -ezMath::Sin(phase) * 0.3f * fSpeed, ezMath::Max(0.0f, -ezMath::Cos(phase)) * 0.1f);
+        frame.m_vLeftFootVelocity.SetZero();
+        frame.m_vRightFootVelocity.SetZero();
+        frame.m_vRootVelocity = vVelocity;
+      }
+    }
+  }
+
+  // unlike real clips, neighboring keyframes have nothing in common, so the cluster bounds are as loose as they get
+  void BuildRandomFrames(ezDynamicArray<ezMotionMatchingDatabase::Frame>& frames, ezRandom& rng, ezUInt16 uiNumClips, ezUInt16 uiNumKeyframes)
+  {
+    for (ezUInt16 clip = 0; clip < uiNumClips; ++clip)
+    {
+      for (ezUInt16 kf = 0; kf < uiNumKeyframes; ++kf)
+      {
+        ezMotionMatchingDatabase::Frame& frame = frames.ExpandAndGetRef();
+        frame.m_uiAnimClipIndex = clip;
+        frame.m_uiKeyframeIndex = kf;
+        frame.m_vLeftFootPosition.Set(rng.FloatMinMax(-0.5f, 0.5f), rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(0.0f, 0.1f));
+        frame.m_vRightFootPosition.Set(rng.FloatMinMax(-0.5f, 0.5f), rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(0.0f, 0.1f));
+        frame.m_vLeftFootVelocity.SetZero();
+        frame.m_vRightFootVelocity.SetZero();
+        frame.m_vRootVelocity.Set(rng.FloatMinMax(-3.0f, 3.0f), rng.FloatMinMax(-3.0f, 3.0f), 0.0f);
+      }
+    }
+  }
+
+  ezMotionMatchingDatabase::Query BuildRandomQuery(ezRandom& rng, ezUInt16 uiNumClips, ezUInt16 uiNumKeyframes)
+  {
+    ezMotionMatchingDatabase::Query query;
+    query.m_uiCurrentAnimClip = static_cast<ezUInt16>(rng.UIntInRange(uiNumClips));
+    query.m_uiCurrentKeyframe = static_cast<ezUInt16>(rng.UIntInRange(uiNumKeyframes));
+    query.m_vLeftFootPosition.Set(rng.FloatMinMax(-0.5f, 0.5f), rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(0.0f, 0.1f));
+    query.m_vRightFootPosition.Set(rng.FloatMinMax(-0.5f, 0.5f), rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(0.0f, 0.1f));
+    query.m_vTargetDir.Set(rng.FloatMinMax(-3.0f, 3.0f), rng.FloatMinMax(-3.0f, 3.0f), 0.0f);
+    return query;
+  }
+
+  ezUInt32 FindBestFrameBruteForce(ezArrayPtr<const ezMotionMatchingDatabase::Frame> frames, const ezMotionMatchingDatabase::Query& query)
+  {
+    float fBestScore = ezMath::MaxValue<float>();
+    ezUInt32 uiBestFrame = ezInvalidIndex;
+
+    for (ezUInt32 i = 0; i < frames.GetCount(); ++i)
+    {
+      const float fScore = ezMotionMatchingDatabase::ComputeScore(frames[i], query);
+      if (fScore < fBestScore)
+      {
+        fBestScore = fScore;
+        uiBestFrame = i;
+      }
+    }
+
+    return uiBestFrame;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Animation, MotionMatchingDatabase)
+{
+  constexpr ezUInt16 uiNumClips = 24;
+  constexpr ezUInt16 uiNumKeyframes = 120;
+
+  ezDynamicArray<ezMotionMatchingDatabase::Frame> frames;
+  BuildTestFrames(frames, uiNumClips, uiNumKeyframes);
+
+  ezMotionMatchingDatabase database;
+  database.Build(frames);
+
+  ezRandom rng;
+  rng.Initialize(42);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Build")
+  {
+    EZ_TEST_INT(database.GetFrameCount(), frames.GetCount());
+    EZ_TEST_INT(database.GetFrame(130).m_uiAnimClipIndex, 1);
+    EZ_TEST_INT(database.GetFrame(130).m_uiKeyframeIndex, 10);
+
+    ezMotionMatchingDatabase empty;
+    EZ_TEST_BOOL(empty.IsEmpty());
+
+    ezMotionMatchingDatabase::Query query = BuildRandomQuery(rng, uiNumClips, uiNumKeyframes);
+    EZ_TEST_INT(empty.FindBestFrame(query), ezInvalidIndex);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindBestFrame")
+  {
+    for (ezUInt32 i = 0; i < 500; ++i)
+    {
+      const ezMotionMatchingDatabase::Query query = BuildRandomQuery(rng, uiNumClips, uiNumKeyframes);
+
+      const ezUInt32 uiExpected = FindBestFrameBruteForce(frames, query);
+      const ezUInt32 uiResult = database.FindBestFrame(query);
+
+      EZ_TEST_BOOL(uiResult != ezInvalidIndex);
+      if (uiResult == ezInvalidIndex)
+        break;
+
+      // the SIMD evaluation may round differently, so only require an equally good match
+      const float fExpectedScore = ezMotionMatchingDatabase::ComputeScore(frames[uiExpected], query);
+      const float fScore = ezMotionMatchingDatabase::ComputeScore(frames[uiResult], query);
+      EZ_TEST_FLOAT(fScore, fExpectedScore, ezMath::Max(fExpectedScore * 0.0001f, 0.0001f));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindBestFrame with random features")
+  {
+    constexpr ezUInt16 uiNumRandomClips = 8;
+    constexpr ezUInt16 uiNumRandomKeyframes = 75;
+
+    ezDynamicArray<ezMotionMatchingDatabase::Frame> randomFrames;
+    BuildRandomFrames(randomFrames, rng, uiNumRandomClips, uiNumRandomKeyframes);
+
+    ezMotionMatchingDatabase randomDatabase;
+    randomDatabase.Build(randomFrames);
+
+    for (ezUInt32 i = 0; i < 500; ++i)
+    {
+      const ezMotionMatchingDatabase::Query query = BuildRandomQuery(rng, uiNumRandomClips, uiNumRandomKeyframes);
+
+      const ezUInt32 uiExpected = FindBestFrameBruteForce(randomFrames, query);
+      const ezUInt32 uiResult = randomDatabase.FindBestFrame(query);
+
+      EZ_TEST_BOOL(uiResult != ezInvalidIndex);
+      if (uiResult == ezInvalidIndex)
+        break;
+
+      const float fExpectedScore = ezMotionMatchingDatabase::ComputeScore(randomFrames[uiExpected], query);
+      const float fScore = ezMotionMatchingDatabase::ComputeScore(randomFrames[uiResult], query);
+      EZ_TEST_FLOAT(fScore, fExpectedScore, ezMath::Max(fExpectedScore * 0.0001f, 0.0001f));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Backwards transitions are blocked")
+  {
+    // the current keyframe matches perfectly, everything within the blocked range before it must never be returned
+    ezMotionMatchingDatabase::Query query;
+    query.m_uiCurrentAnimClip = 3;
+    query.m_uiCurrentKeyframe = 50;
+    query.m_vLeftFootPosition = frames[3 * uiNumKeyframes + 45].m_vLeftFootPosition;
+    query.m_vRightFootPosition = frames[3 * uiNumKeyframes + 45].m_vRightFootPosition;
+    query.m_vTargetDir = frames[3 * uiNumKeyframes + 45].m_vRootVelocity;
+
+    const ezUInt32 uiResult = database.FindBestFrame(query);
+    EZ_TEST_BOOL(uiResult != ezInvalidIndex);
+
+    const ezMotionMatchingDatabase::Frame& frame = database.GetFrame(uiResult);
+    EZ_TEST_BOOL(frame.m_uiAnimClipIndex != 3 || frame.m_uiKeyframeIndex >= 50 || frame.m_uiKeyframeIndex + 10 <= 50);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindBestFrames")
+  {
+    ezDynamicArray<ezMotionMatchingDatabase::Query> queries;
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      queries.PushBack(BuildRandomQuery(rng, uiNumClips, uiNumKeyframes));
+    }
+
+    ezDynamicArray<ezUInt32> results;
+    results.SetCount(queries.GetCount());
+    database.FindBestFrames(queries, results);
+
+    for (ezUInt32 i = 0; i < queries.GetCount(); ++i)
+    {
+      EZ_TEST_INT(results[i], database.FindBestFrame(queries[i]));
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Search Performance")
+  {
+    constexpr ezUInt32 uiNumQueries = 1000;
+
+    ezDynamicArray<ezMotionMatchingDatabase::Frame> largeFrames;
+    BuildTestFrames(largeFrames, 100, 600);
+
+    ezMotionMatchingDatabase largeDatabase;
+    largeDatabase.Build(largeFrames);
+
+    ezDynamicArray<ezMotionMatchingDatabase::Query> queries;
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      queries.PushBack(BuildRandomQuery(rng, 100, 600));
+    }
+
+    ezDynamicArray<ezUInt32> results;
+    results.SetCount(uiNumQueries);
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+      {
+        results[i] = FindBestFrameBruteForce(largeFrames, queries[i]);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Brute force search over {0} frames: {1} queries/sec", largeFrames.GetCount(), ezArgF(uiNumQueries / (t1 - t0).GetSeconds(), 0));
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+      {
+        results[i] = largeDatabase.FindBestFrame(queries[i]);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Database search over {0} frames: {1} queries/sec", largeFrames.GetCount(), ezArgF(uiNumQueries / (t1 - t0).GetSeconds(), 0));
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      largeDatabase.FindBestFrames(queries, results);
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Batched database search over {0} frames: {1} queries/sec", largeFrames.GetCount(), ezArgF(uiNumQueries / (t1 - t0).GetSeconds(), 0));
+    }
+  }
+}
@@ -0,0 +1,202 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Time.h>
+#include <ParticlePlugin/Behavior/ParticleBehaviorKernels.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+namespace
+{
+  ezVec3 RandomVec3(ezRandom& rng)
+  {
+    return ezVec3((float)rng.DoubleMinMax(-10.0, 10.0), (float)rng.DoubleMinMax(-10.0, 10.0), (float)rng.DoubleMinMax(-10.0, 10.0));
+  }
+
+  void BuildLifeTimes(ezRandom& rng, ezDynamicArray<ezFloat16Vec2>& lifeTimes, ezDynamicArray<ezColorLinear16f>& colors, ezUInt32 uiCount)
+  {
+    lifeTimes.SetCount(uiCount);
+    colors.SetCount(uiCount);
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const float fTotal = (float)rng.DoubleMinMax(0.5, 5.0);
+      lifeTimes[i] = ezVec2((float)rng.DoubleMinMax(0.0, fTotal), 1.0f / fTotal);
+      colors[i] = ezColor(0.5f, 0.25f, 0.75f, -1.0f);
+    }
+  }
+
+  void FadeOutAlphaReference(ezArrayPtr<const ezFloat16Vec2> lifeTimes, ezArrayPtr<ezColorLinear16f> colors, float fStartAlpha, float fExponent, ezUInt32 uiFirst, ezUInt32 uiStride)
+  {
+    for (ezUInt32 i = uiFirst; i < lifeTimes.GetCount(); i += uiStride)
+    {
+      const float fAlpha = fStartAlpha * ezMath::Pow(lifeTimes[i].x * lifeTimes[i].y, fExponent);
+      colors[i].a = fStartAlpha > 1.0f ? ezMath::Min(1.0f, fAlpha) : fAlpha;
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Particles, BehaviorKernels)
+{
+  ezRandom rng;
+  rng.Initialize(42);
+
+  // odd counts, so that the remainder after the SIMD batches gets processed as well
+  const ezUInt32 counts[] = {0, 1, 3, 4, 7, 64, 253};
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "AddVec3 / ScaleVec3")
+  {
+    for (ezUInt32 uiCount : counts)
+    {
+      ezDynamicArray<ezVec3> values;
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        values.PushBack(RandomVec3(rng));
+      }
+
+      ezDynamicArray<ezVec3> expected = values;
+
+      const ezVec3 vAdd = RandomVec3(rng);
+      const float fScale = (float)rng.DoubleMinMax(0.0, 1.0);
+
+      for (ezVec3& v : expected)
+      {
+        v = (v + vAdd) * fScale;
+      }
+
+      ezParticleBehaviorKernels::AddVec3(values, vAdd);
+      ezParticleBehaviorKernels::ScaleVec3(values, fScale);
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        EZ_TEST_VEC3(values[i], expected[i], 0.0001f);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "AddVec4")
+  {
+    for (ezUInt32 uiCount : counts)
+    {
+      ezDynamicArray<ezSimdVec4f, ezAlignedAllocatorWrapper> values;
+      ezDynamicArray<ezVec3> expected;
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        const ezVec3 v = RandomVec3(rng);
+        values.PushBack(ezSimdVec4f(v.x, v.y, v.z, 0.0f));
+        expected.PushBack(v);
+      }
+
+      const ezVec3 vAdd = RandomVec3(rng);
+
+      ezParticleBehaviorKernels::AddVec4(values, ezSimdVec4f(vAdd.x, vAdd.y, vAdd.z, 0.0f));
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        const ezVec3 vExpected = expected[i] + vAdd;
+        EZ_TEST_BOOL(values[i].IsEqual(ezSimdVec4f(vExpected.x, vExpected.y, vExpected.z, 0.0f), 0.0001f).AllSet<4>());
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FadeOutAlpha")
+  {
+    const float startAlphas[] = {0.8f, 1.0f, 2.5f};
+    const float exponents[] = {1.0f, 0.5f, 2.0f};
+
+    for (ezUInt32 uiCount : counts)
+    {
+      for (float fStartAlpha : startAlphas)
+      {
+        for (float fExponent : exponents)
+        {
+          for (ezUInt32 uiStride = 1; uiStride <= 3; ++uiStride)
+          {
+            for (ezUInt32 uiFirst = 0; uiFirst < uiStride; ++uiFirst)
+            {
+              ezDynamicArray<ezFloat16Vec2> lifeTimes;
+              ezDynamicArray<ezColorLinear16f> colors;
+              BuildLifeTimes(rng, lifeTimes, colors, uiCount);
+
+              ezDynamicArray<ezColorLinear16f> expected = colors;
+
+              ezParticleBehaviorKernels::FadeOutAlpha(lifeTimes, colors, fStartAlpha, fExponent, uiFirst, uiStride);
+              FadeOutAlphaReference(lifeTimes, expected, fStartAlpha, fExponent, uiFirst, uiStride);
+
+              for (ezUInt32 i = 0; i < uiCount; ++i)
+              {
+                // particles in between the updated ones must not be touched
+                EZ_TEST_FLOAT(colors[i].a, expected[i].a, 0.001f);
+                EZ_TEST_FLOAT(colors[i].r, 0.5f, 0.001f);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Kernel Performance")
+  {
+    constexpr ezUInt32 uiNumParticles = 100000;
+    constexpr ezUInt32 uiNumIterations = 100;
+
+    ezDynamicArray<ezVec3> values;
+    values.SetCount(uiNumParticles);
+
+    ezDynamicArray<ezFloat16Vec2> lifeTimes;
+    ezDynamicArray<ezColorLinear16f> colors;
+    BuildLifeTimes(rng, lifeTimes, colors, uiNumParticles);
+
+    const ezVec3 vAdd(0.0f, 0.0f, -0.1f);
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 iter = 0; iter < uiNumIterations; ++iter)
+      {
+        for (ezVec3& v : values)
+        {
+          v += vAdd;
+        }
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Scalar AddVec3: {0} ms", ezArgF((t1 - t0).GetMilliseconds(), 2));
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 iter = 0; iter < uiNumIterations; ++iter)
+      {
+        ezParticleBehaviorKernels::AddVec3(values, vAdd);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]SIMD AddVec3: {0} ms", ezArgF((t1 - t0).GetMilliseconds(), 2));
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 iter = 0; iter < uiNumIterations; ++iter)
+      {
+        FadeOutAlphaReference(lifeTimes, colors, 1.0f, 1.0f, 0, 1);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]Scalar FadeOutAlpha: {0} ms", ezArgF((t1 - t0).GetMilliseconds(), 2));
+    }
+
+    {
+      ezTime t0 = ezTime::Now();
+      for (ezUInt32 iter = 0; iter < uiNumIterations; ++iter)
+      {
+        ezParticleBehaviorKernels::FadeOutAlpha(lifeTimes, colors, 1.0f, 1.0f, 0, 1);
+      }
+      ezTime t1 = ezTime::Now();
+
+      ezLog::Info("[test]SIMD FadeOutAlpha: {0} ms", ezArgF((t1 - t0).GetMilliseconds(), 2));
+    }
+  }
+}
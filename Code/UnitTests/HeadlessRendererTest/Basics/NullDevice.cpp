@@ -0,0 +1,172 @@
+#include <HeadlessRendererTestPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <RendererNull/Context/ContextNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Renderer, NullDevice)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  ezGALDeviceCreationDescription deviceDesc;
+  deviceDesc.m_bCreatePrimarySwapChain = false;
+
+  ezGALDeviceNull device(deviceDesc);
+  if (EZ_TEST_BOOL(device.Init().Succeeded()).Failed())
+    return;
+
+  ezGALContextNull* pContext = device.GetNullContext();
+  const ezGALDeviceNull::Statistics initialStats = device.GetStatistics();
+
+  const ezUInt16 indices[] = {0, 1, 2};
+  ezGALBufferHandle hVertexBuffer = device.CreateVertexBuffer(sizeof(ezVec3), 3);
+  ezGALBufferHandle hIndexBuffer = device.CreateIndexBuffer(ezGALIndexType::UShort, 3, ezMakeArrayPtr(indices).ToByteArray());
+
+  ezGALTextureCreationDescription texDesc;
+  texDesc.m_uiWidth = 256;
+  texDesc.m_uiHeight = 128;
+  texDesc.m_Format = ezGALResourceFormat::RGBAUByteNormalized;
+  texDesc.m_bCreateRenderTarget = true;
+  ezGALTextureHandle hTexture = device.CreateTexture(texDesc);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Object Statistics")
+  {
+    const ezGALDeviceNull::Statistics& stats = device.GetStatistics();
+
+    EZ_TEST_INT(stats.m_uiNumBuffers, initialStats.m_uiNumBuffers + 2);
+    EZ_TEST_INT(stats.m_uiNumTextures, initialStats.m_uiNumTextures + 1);
+    EZ_TEST_INT(stats.m_uiBufferMemory, initialStats.m_uiBufferMemory + 3 * sizeof(ezVec3) + sizeof(indices));
+    EZ_TEST_INT(stats.m_uiTextureMemory, initialStats.m_uiTextureMemory + device.GetMemoryConsumptionForTexture(texDesc));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Command Counting and Recording")
+  {
+    device.BeginFrame();
+
+    pContext->ResetCommandCounts();
+    pContext->ClearRecordedCommands();
+    pContext->SetCommandRecordingEnabled(true);
+
+    pContext->PushMarker("NullDeviceTest");
+    pContext->SetVertexBuffer(0, hVertexBuffer);
+    pContext->SetIndexBuffer(hIndexBuffer);
+    pContext->SetPrimitiveTopology(ezGALPrimitiveTopology::Triangles);
+
+    {
+      // no shader is bound, so the draw call is reported as invalid
+      ezTestLogInterface log;
+      ezTestLogSystemScope logSystemScope(&log);
+      log.ExpectMessage("No vertex shader bound", ezLogMsgType::ErrorMsg);
+
+      pContext->DrawIndexed(3, 0);
+    }
+
+    pContext->PopMarker();
+
+    pContext->SetCommandRecordingEnabled(false);
+    device.EndFrame();
+
+    EZ_TEST_INT(pContext->GetCommandCount(ezGALNullCommand::DrawIndexed), 1);
+    EZ_TEST_INT(pContext->GetCommandCount(ezGALNullCommand::SetVertexBuffer), 1);
+    EZ_TEST_INT(pContext->GetCommandCount(ezGALNullCommand::PushMarker), 1);
+    EZ_TEST_INT(pContext->GetCommandCount(ezGALNullCommand::PopMarker), 1);
+    EZ_TEST_INT(pContext->GetValidationErrorCount(), 1);
+    EZ_TEST_INT(pContext->GetMarkerDepth(), 0);
+
+    ezArrayPtr<const ezGALNullRecordedCommand> commands = pContext->GetRecordedCommands();
+    if (EZ_TEST_INT(commands.GetCount(), 6).Succeeded())
+    {
+      EZ_TEST_BOOL(commands[0].m_Command == ezGALNullCommand::PushMarker);
+      EZ_TEST_BOOL(commands[1].m_Command == ezGALNullCommand::SetVertexBuffer);
+      EZ_TEST_BOOL(commands[1].m_pObject == device.GetBuffer(hVertexBuffer));
+      EZ_TEST_BOOL(commands[4].m_Command == ezGALNullCommand::DrawIndexed);
+      EZ_TEST_INT(commands[4].m_uiArgs[0], 3);
+      EZ_TEST_BOOL(commands[5].m_Command == ezGALNullCommand::PopMarker);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Destroy Objects")
+  {
+    device.DestroyBuffer(hVertexBuffer);
+    device.DestroyBuffer(hIndexBuffer);
+    device.DestroyTexture(hTexture);
+
+    // dead objects are destroyed at the end of the frame
+    device.BeginFrame();
+    device.EndFrame();
+
+    const ezGALDeviceNull::Statistics& stats = device.GetStatistics();
+
+    EZ_TEST_INT(stats.m_uiNumBuffers, initialStats.m_uiNumBuffers);
+    EZ_TEST_INT(stats.m_uiNumTextures, initialStats.m_uiNumTextures);
+    EZ_TEST_INT(stats.m_uiBufferMemory, initialStats.m_uiBufferMemory);
+    EZ_TEST_INT(stats.m_uiTextureMemory, initialStats.m_uiTextureMemory);
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Draw Submission")
+  {
+    // measures the CPU cost of the GAL layer for a typical per object draw loop, the null device itself does no work
+    const ezUInt8 dummyByteCode[] = {0};
+    ezGALShaderByteCode byteCode(ezMakeArrayPtr(dummyByteCode));
+
+    ezGALShaderHandle hShader;
+    {
+      ezGALShaderCreationDescription shaderDesc;
+      shaderDesc.m_ByteCodes[ezGALShaderStage::VertexShader] = &byteCode;
+      shaderDesc.m_ByteCodes[ezGALShaderStage::PixelShader] = &byteCode;
+      hShader = device.CreateShader(shaderDesc);
+    }
+
+    ezGALBufferHandle hVertexBuffers[2] = {device.CreateVertexBuffer(sizeof(ezVec3), 3), device.CreateVertexBuffer(sizeof(ezVec3), 3)};
+    ezGALBufferHandle hIndexBuffer2 = device.CreateIndexBuffer(ezGALIndexType::UShort, 3, ezMakeArrayPtr(indices).ToByteArray());
+    ezGALBufferHandle hConstantBuffer = device.CreateConstantBuffer(sizeof(ezMat4));
+
+    const ezUInt32 uiNumDraws = 100000;
+    ezMat4 objectTransform = ezMat4::IdentityMatrix();
+
+    device.BeginFrame();
+    pContext->ResetCommandCounts();
+
+    const ezTime t0 = ezTime::Now();
+
+    pContext->SetShader(hShader);
+    pContext->SetIndexBuffer(hIndexBuffer2);
+    pContext->SetPrimitiveTopology(ezGALPrimitiveTopology::Triangles);
+    pContext->SetConstantBuffer(0, hConstantBuffer);
+
+    for (ezUInt32 i = 0; i < uiNumDraws; ++i)
+    {
+      objectTransform.SetTranslationVector(ezVec3((float)i, 0, 0));
+
+      pContext->UpdateBuffer(hConstantBuffer, 0, ezArrayPtr<const ezMat4>(&objectTransform, 1).ToByteArray());
+      pContext->SetVertexBuffer(0, hVertexBuffers[i % 2]);
+      pContext->DrawIndexed(3, 0);
+    }
+
+    const ezTime t1 = ezTime::Now();
+
+    device.EndFrame();
+
+    EZ_TEST_INT(pContext->GetCommandCount(ezGALNullCommand::DrawIndexed), uiNumDraws);
+    EZ_TEST_INT(pContext->GetValidationErrorCount(), 0);
+
+    ezLog::Info("[test]{0} draws: {1} ms", uiNumDraws, ezArgF((t1 - t0).GetMilliseconds(), 2));
+
+    device.DestroyShader(hShader);
+    device.DestroyBuffer(hVertexBuffers[0]);
+    device.DestroyBuffer(hVertexBuffers[1]);
+    device.DestroyBuffer(hIndexBuffer2);
+    device.DestroyBuffer(hConstantBuffer);
+
+    // release the shader before the byte code goes out of scope
+    device.BeginFrame();
+    device.EndFrame();
+  }
+
+  device.Shutdown();
+}
@@ -0,0 +1,127 @@
+#include <HeadlessRendererTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+
+namespace
+{
+  ezUInt64 SortByRenderDataSortingKey(const ezRenderData* pRenderData, ezUInt32 uiRenderDataSortingKey, const ezCamera& camera)
+  {
+    // spread the key over the upper and lower bytes, so that every radix pass has to do some work
+    return (static_cast<ezUInt64>(uiRenderDataSortingKey) << 40) | uiRenderDataSortingKey;
+  }
+
+  struct ReferenceEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiSortingKey;
+    ezUInt32 m_uiBatchId;
+    ezUInt32 m_uiIndex;
+  };
+
+  struct ReferenceComparer
+  {
+    // the comparison sort that was used before, with the insertion order as last criterion to make it stable
+    EZ_ALWAYS_INLINE bool Less(const ReferenceEntry& a, const ReferenceEntry& b) const
+    {
+      if (a.m_uiSortingKey != b.m_uiSortingKey)
+        return a.m_uiSortingKey < b.m_uiSortingKey;
+
+      if (a.m_uiBatchId != b.m_uiBatchId)
+        return a.m_uiBatchId < b.m_uiBatchId;
+
+      return a.m_uiIndex < b.m_uiIndex;
+    }
+  };
+
+  void TestSortOrder(ezRenderData::Category category, ezUInt32 uiCount, bool bExpectStable, ezRandom& rng)
+  {
+    // few different keys and batch ids, so that there are many duplicates
+    ezDynamicArray<ezRenderData> renderData;
+    renderData.SetCount(uiCount);
+
+    ezDynamicArray<ReferenceEntry> reference;
+    reference.SetCount(uiCount);
+
+    ezExtractedRenderData extractedRenderData;
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      renderData[i].m_uiSortingKey = rng.UIntInRange(16);
+      renderData[i].m_uiBatchId = rng.UIntInRange(4) * 0x01010101u;
+
+      extractedRenderData.AddRenderData(&renderData[i], category);
+
+      reference[i].m_uiSortingKey = SortByRenderDataSortingKey(&renderData[i], renderData[i].m_uiSortingKey, ezCamera());
+      reference[i].m_uiBatchId = renderData[i].m_uiBatchId;
+      reference[i].m_uiIndex = i;
+    }
+
+    reference.Sort(ReferenceComparer());
+
+    extractedRenderData.SortAndBatch();
+
+    ezRenderDataBatchList batchList = extractedRenderData.GetRenderDataBatchesWithCategory(category);
+
+    ezUInt32 uiSortedIndex = 0;
+    bool bSameOrder = true;
+
+    for (ezUInt32 uiBatch = 0; uiBatch < batchList.GetBatchCount(); ++uiBatch)
+    {
+      const ezRenderDataBatch batch = batchList.GetBatch(uiBatch);
+
+      for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+      {
+        if (uiSortedIndex >= uiCount)
+        {
+          bSameOrder = false;
+          break;
+        }
+
+        const ezRenderData* pExpected = &renderData[reference[uiSortedIndex].m_uiIndex];
+        bSameOrder &= (pExpected->m_uiSortingKey == it->m_uiSortingKey);
+        bSameOrder &= (pExpected->m_uiBatchId == it->m_uiBatchId);
+
+        // render data with equal sorting key and batch id has to stay in the order it was added
+        if (bExpectStable)
+        {
+          bSameOrder &= (pExpected == it);
+        }
+
+        // every batch only contains render data with the same batch id
+        bSameOrder &= (it->m_uiBatchId == batch.GetFirstData<ezRenderData>()->m_uiBatchId);
+
+        ++uiSortedIndex;
+      }
+    }
+
+    EZ_TEST_INT(uiSortedIndex, uiCount);
+    EZ_TEST_BOOL(bSameOrder);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Renderer, RenderDataSorting)
+{
+  const ezRenderData::Category category = ezRenderData::RegisterCategory("RenderDataSortingTest", &SortByRenderDataSortingKey);
+
+  ezRandom rng;
+  rng.Initialize(42);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Comparison Sort")
+  {
+    // the quick sort is not stable, so only the keys have to match here
+    TestSortOrder(category, 100, false, rng);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Radix Sort")
+  {
+    TestSortOrder(category, 1000, true, rng);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Radix Sort in Parallel")
+  {
+    // enough render data to sort the categories in parallel
+    TestSortOrder(category, 5000, true, rng);
+  }
+}
@@ -0,0 +1,101 @@
+#include <HeadlessRendererTestPCH.h>
+
+#include <RendererCore/Pipeline/RenderPipeline.h>
+
+namespace
+{
+  ezRenderPipeline::TransientTexture MakeTexture(ezUInt16 uiFirstUsageIdx, ezUInt16 uiLastUsageIdx, ezUInt32 uiDescHash, ezUInt64 uiMemorySize)
+  {
+    ezRenderPipeline::TransientTexture texture;
+    texture.m_uiFirstUsageIdx = uiFirstUsageIdx;
+    texture.m_uiLastUsageIdx = uiLastUsageIdx;
+    texture.m_uiDescHash = uiDescHash;
+    texture.m_uiMemorySize = uiMemorySize;
+    return texture;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Renderer, TransientMemoryPlan)
+{
+  ezRenderPipeline::TransientMemoryPlan plan;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Chain of passes")
+  {
+    // Five passes, each reads the output of the previous one:
+    // A: 0-1, B: 1-2, C: 2-3 (same description as A), D: 3-4
+    ezRenderPipeline::TransientTexture textures[] = {
+      MakeTexture(0, 1, 1, 100),
+      MakeTexture(1, 2, 2, 50),
+      MakeTexture(2, 3, 1, 100),
+      MakeTexture(3, 4, 3, 200),
+    };
+
+    ezRenderPipeline::PlanTransientMemory(ezMakeArrayPtr(textures), plan);
+
+    // A and B as well as C and D are alive at the same time
+    EZ_TEST_BOOL(textures[0].m_uiMemoryRegion != textures[1].m_uiMemoryRegion);
+    EZ_TEST_BOOL(textures[1].m_uiMemoryRegion != textures[2].m_uiMemoryRegion);
+    EZ_TEST_BOOL(textures[2].m_uiMemoryRegion != textures[3].m_uiMemoryRegion);
+
+    // C takes the best fitting free region, D grows the one that B used
+    EZ_TEST_INT(textures[2].m_uiMemoryRegion, textures[0].m_uiMemoryRegion);
+    EZ_TEST_INT(textures[3].m_uiMemoryRegion, textures[1].m_uiMemoryRegion);
+
+    EZ_TEST_INT(plan.m_Regions.GetCount(), 2);
+    EZ_TEST_INT(plan.m_Regions[textures[0].m_uiMemoryRegion], 100);
+    EZ_TEST_INT(plan.m_Regions[textures[1].m_uiMemoryRegion], 200);
+
+    // the resource pool can only reuse A for C
+    EZ_TEST_INT(plan.m_uiPooledMemory, 350);
+    EZ_TEST_INT(plan.m_uiAliasedMemory, 300);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Overlapping lifetimes")
+  {
+    // all textures are alive during pass 2, nothing can be shared
+    ezRenderPipeline::TransientTexture textures[] = {
+      MakeTexture(0, 2, 1, 64),
+      MakeTexture(1, 3, 1, 64),
+      MakeTexture(2, 2, 2, 32),
+    };
+
+    ezRenderPipeline::PlanTransientMemory(ezMakeArrayPtr(textures), plan);
+
+    EZ_TEST_INT(plan.m_Regions.GetCount(), 3);
+    EZ_TEST_INT(plan.m_uiPooledMemory, 160);
+    EZ_TEST_INT(plan.m_uiAliasedMemory, 160);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Different descriptions")
+  {
+    // sequential lifetimes, but no two textures have the same description
+    ezRenderPipeline::TransientTexture textures[] = {
+      MakeTexture(0, 0, 1, 40),
+      MakeTexture(1, 1, 2, 10),
+      MakeTexture(2, 2, 3, 30),
+      MakeTexture(3, 3, 4, 20),
+    };
+
+    ezRenderPipeline::PlanTransientMemory(ezMakeArrayPtr(textures), plan);
+
+    EZ_TEST_INT(plan.m_Regions.GetCount(), 1);
+    EZ_TEST_INT(plan.m_Regions[0], 40);
+
+    for (const auto& texture : textures)
+    {
+      EZ_TEST_INT(texture.m_uiMemoryRegion, 0);
+    }
+
+    EZ_TEST_INT(plan.m_uiPooledMemory, 100);
+    EZ_TEST_INT(plan.m_uiAliasedMemory, 40);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "No textures")
+  {
+    ezRenderPipeline::PlanTransientMemory(ezArrayPtr<ezRenderPipeline::TransientTexture>(), plan);
+
+    EZ_TEST_BOOL(plan.m_Regions.IsEmpty());
+    EZ_TEST_INT(plan.m_uiPooledMemory, 0);
+    EZ_TEST_INT(plan.m_uiAliasedMemory, 0);
+  }
+}
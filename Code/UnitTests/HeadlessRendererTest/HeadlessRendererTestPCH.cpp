@@ -0,0 +1 @@
+#include <HeadlessRendererTestPCH.h>
@@ -19,7 +19,7 @@ struct EZ_ALIGN_16(ezPerInstanceData)
   StructuredBuffer<ezPerInstanceData> perInstanceData;
 
   #if defined(USE_SKINNING)
-    StructuredBuffer<float4x4> skinningMatrices;
+    StructuredBuffer<Transform> skinningMatrices;
   #endif
   
   Buffer<uint> perInstanceVertexColors;
@@ -28,20 +28,20 @@ static VS_GLOBALS G;
 
 float4 SkinPosition(float4 ObjectSpacePosition, float4 BoneWeights, uint4 BoneIndices)
 {
-  float4 OutPos  = mul(skinningMatrices[BoneIndices.x], ObjectSpacePosition) * BoneWeights.x;
-         OutPos += mul(skinningMatrices[BoneIndices.y], ObjectSpacePosition) * BoneWeights.y;
-         OutPos += mul(skinningMatrices[BoneIndices.z], ObjectSpacePosition) * BoneWeights.z;
-         OutPos += mul(skinningMatrices[BoneIndices.w], ObjectSpacePosition) * BoneWeights.w;
+  float4 OutPos  = mul(TransformToMatrix(skinningMatrices[BoneIndices.x]), ObjectSpacePosition) * BoneWeights.x;
+         OutPos += mul(TransformToMatrix(skinningMatrices[BoneIndices.y]), ObjectSpacePosition) * BoneWeights.y;
+         OutPos += mul(TransformToMatrix(skinningMatrices[BoneIndices.z]), ObjectSpacePosition) * BoneWeights.z;
+         OutPos += mul(TransformToMatrix(skinningMatrices[BoneIndices.w]), ObjectSpacePosition) * BoneWeights.w;
 
   return OutPos;
 }
 
 float3 SkinDirection(float3 ObjectSpaceDirection, float4 BoneWeights, uint4 BoneIndices)
 {
-  float3 OutDir  = mul((float3x3)skinningMatrices[BoneIndices.x], ObjectSpaceDirection) * BoneWeights.x;
-         OutDir += mul((float3x3)skinningMatrices[BoneIndices.y], ObjectSpaceDirection) * BoneWeights.y;
-         OutDir += mul((float3x3)skinningMatrices[BoneIndices.z], ObjectSpaceDirection) * BoneWeights.z;
-         OutDir += mul((float3x3)skinningMatrices[BoneIndices.w], ObjectSpaceDirection) * BoneWeights.w;
+  float3 OutDir  = mul(TransformToRotation(skinningMatrices[BoneIndices.x]), ObjectSpaceDirection) * BoneWeights.x;
+         OutDir += mul(TransformToRotation(skinningMatrices[BoneIndices.y]), ObjectSpaceDirection) * BoneWeights.y;
+         OutDir += mul(TransformToRotation(skinningMatrices[BoneIndices.z]), ObjectSpaceDirection) * BoneWeights.z;
+         OutDir += mul(TransformToRotation(skinningMatrices[BoneIndices.w]), ObjectSpaceDirection) * BoneWeights.w;
 
   return OutDir;
 }